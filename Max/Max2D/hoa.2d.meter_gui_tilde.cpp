@@ -50,7 +50,6 @@ typedef struct  _meter
     Hoa2D::Meter*   f_meter;
     Hoa2D::Vector*  f_vector;
     double          f_vector_coords[4];
-    long            f_ramp;
     
 	void*		f_clock;
 	int			f_startclock;
@@ -60,6 +59,7 @@ typedef struct  _meter
 	double      f_offset_of_channels;
 	double*		f_azimuth_of_channels;
     long*		f_overled;
+    double*		f_energies;
     
 	t_atom_long	f_dbperled;
 	t_atom_long	f_nhotleds;
@@ -395,6 +395,7 @@ void *meter_new(t_symbol *s, int argc, t_atom *argv)
 	
 	x->f_azimuth_of_channels = new double[MAX_UI_CHANNELS];
     x->f_overled             = new long[MAX_UI_CHANNELS];
+    x->f_energies            = new double[MAX_UI_CHANNELS];
     x->f_signals             = new double[MAX_UI_CHANNELS * SYS_MAXBLKSIZE];
     
     x->f_clock = clock_new(x,(method)meter_tick);
@@ -403,6 +404,7 @@ void *meter_new(t_symbol *s, int argc, t_atom *argv)
 	for (int i = 0; i < MAX_UI_CHANNELS; i++)
 	{
 		x->f_overled[i] = 0;
+		x->f_energies[i] = -999.;
 	}
 	
 	attr_dictionary_process(x, d);
@@ -431,6 +433,7 @@ void meter_free(t_meter *x)
     delete [] x->f_azimuth_of_channels;
     delete [] x->f_signals;
     delete [] x->f_overled;
+    delete [] x->f_energies;
 }
 
 t_max_err number_of_channels_set(t_meter *x, t_object *attr, long argc, t_atom *argv)
@@ -548,14 +551,12 @@ void meter_dsp64(t_meter *x, t_object *dsp64, short *count, double samplerate, l
 
 void meter_perform64(t_meter *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
 {
+    // The vector of the clock only reads the first sample of the channels
 	for(int i = 0; i < numins; i++)
     {
-        cblas_dcopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    for(x->f_ramp = 0; x->f_ramp < sampleframes; x->f_ramp++)
-    {
-        x->f_meter->process(x->f_signals + numins * x->f_ramp);
+        x->f_signals[i] = ins[i][0];
     }
+    x->f_meter->process(ins, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -572,9 +573,12 @@ void meter_tick(t_meter *x)
     else if(x->f_drawvector == VECTOR_ENERGY)
 		x->f_vector->processEnergy(x->f_signals, x->f_vector_coords + 2);
     
+    // The meter is only read by the clock, the painting uses the energies of the last snapshot
+    x->f_meter->update();
     for(int i = 0; i < x->f_meter->getNumberOfChannels(); i++)
     {
-        if(x->f_meter->getChannelEnergy(i) >= 0.)
+        x->f_energies[i] = x->f_meter->getChannelEnergy(i);
+        if(x->f_energies[i] >= 0.)
             x->f_overled[i] = OVERLED_DRAWTIME;
         else
             x->f_overled[i] -= x->f_interval;
@@ -854,7 +858,7 @@ void draw_leds(t_meter *x, t_object *view, t_rect *rect)
 		for(i = 0; i < nLoudSpeak; i++)
 		{
 			// dB (negatif) de -240 à 0;
-            meter_dB = x->f_meter->getChannelEnergy(i);
+            meter_dB = x->f_energies[i];
 			
 			channelWidth = radToDeg(x->f_meter->getChannelWidth(i));
             deg2 = degToRad(90+(channelWidth));
@@ -63,8 +63,8 @@ typedef struct  _hoa_meter_3d
     double*			f_signals;
     double			f_vector_coords[6];
     int*            f_over_leds;
+    double*         f_energies;
     
-    long            f_ramp;
 	int             f_startclock;
     
     double          f_radius;
@@ -299,15 +299,18 @@ void *hoa_meter_3d_new(t_symbol *s, int argc, t_atom *argv)
 	jbox_get_patching_rect((t_object*)x, &x->f_rect);
 	jbox_get_presentation_rect((t_object*)x, &x->f_presentation_rect);
     
-    x->f_ramp = 0;
 	x->f_meter  = new Hoa3D::Meter(numberOfChannels, 181, 360);
     x->f_vector = new Hoa3D::Vector(numberOfChannels);
     
     x->f_signals = new double[MAX_SPEAKER * SYS_MAXBLKSIZE];
     x->f_over_leds = new int[MAX_SPEAKER];
+    x->f_energies = new double[MAX_SPEAKER];
 	
     for(int i = 0; i < MAX_SPEAKER; i++)
+    {
         x->f_over_leds[i] = 0;
+        x->f_energies[i] = -91.;
+    }
 	
     x->f_clock = (t_clock*)clock_new(x,(method)hoa_meter_3d_tick);
 	x->f_startclock = 0;
@@ -334,6 +337,7 @@ void hoa_meter_3d_free(t_hoa_meter_3d *x)
     delete x->f_vector;
     delete [] x->f_signals;
     delete [] x->f_over_leds;
+    delete [] x->f_energies;
 }
 
 t_hoa_err hoa_getinfos(t_hoa_meter_3d* x, t_hoa_boxinfos* boxinfos)
@@ -600,14 +604,12 @@ void hoa_meter_3d_dsp64(t_hoa_meter_3d *x, t_object *dsp, short *count, double s
 
 void hoa_meter_3d_perform64(t_hoa_meter_3d *x, t_object *dsp, double **ins, long numins, double **outs, long no, long sampleframes, long f,void *up)
 {
+    // The vector of the clock only reads the first sample of the channels
 	for(int i = 0; i < numins; i++)
     {
-        cblas_dcopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    for(x->f_ramp = 0; x->f_ramp < sampleframes; x->f_ramp++)
-    {
-        x->f_meter->process(x->f_signals + numins * x->f_ramp);
+        x->f_signals[i] = ins[i][0];
     }
+    x->f_meter->process(ins, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -626,9 +628,12 @@ void hoa_meter_3d_tick(t_hoa_meter_3d *x)
     else if(x->f_vector_type == hoa_sym_3d_energy)
         x->f_vector->processEnergy(x->f_signals, x->f_vector_coords + 3);
     
+    // The meter is only read by the clock, the painting uses the energies of the last snapshot
+    x->f_meter->update();
     for (int i = 0; i < x->f_meter->getNumberOfChannels(); i++)
     {
         peak = x->f_meter->getChannelEnergy(i);
+        x->f_energies[i] = peak;
         if(peak >= 0.)
             x->f_over_leds[i] = 1000;
         else
@@ -797,13 +802,13 @@ void draw_leds(t_hoa_meter_3d *x, t_object *view, t_rect *rect)
 		{
 			if(x->f_over_leds[i])
 				mcolor = x->f_color_over_signal;
-            else if(x->f_meter->getChannelEnergy(i) < -90.)
+            else if(x->f_energies[i] < -90.)
                 mcolor = x->f_color_off_signal;
-            else if(x->f_meter->getChannelEnergy(i) < -30.)
+            else if(x->f_energies[i] < -30.)
                 mcolor = x->f_color_cold_signal;
-            else if(x->f_meter->getChannelEnergy(i) < -21)
+            else if(x->f_energies[i] < -21)
                 mcolor = x->f_color_tepid_signal;
-            else if(x->f_meter->getChannelEnergy(i) < -12)
+            else if(x->f_energies[i] < -12)
                 mcolor = x->f_color_warm_signal;
             else
                 mcolor = x->f_color_hot_signal;
@@ -862,13 +867,13 @@ void draw_leds(t_hoa_meter_3d *x, t_object *view, t_rect *rect)
             {
                 if(x->f_over_leds[i])
 					mcolor = x->f_color_over_signal;
-				else if(x->f_meter->getChannelEnergy(i) < -90.)
+				else if(x->f_energies[i] < -90.)
 					mcolor = x->f_color_off_signal;
-				else if(x->f_meter->getChannelEnergy(i) < -30.)
+				else if(x->f_energies[i] < -30.)
 					mcolor = x->f_color_cold_signal;
-				else if(x->f_meter->getChannelEnergy(i) < -21)
+				else if(x->f_energies[i] < -21)
 					mcolor = x->f_color_tepid_signal;
-				else if(x->f_meter->getChannelEnergy(i) < -12)
+				else if(x->f_energies[i] < -12)
 					mcolor = x->f_color_warm_signal;
 				else
 					mcolor = x->f_color_hot_signal;
@@ -35,7 +35,6 @@ typedef struct  _hoa_3d_scope
 {
 	t_pxjbox        j_box;
     Hoa3D::Scope*   f_scope;
-    int             f_index;
 	void*           f_clock;
 	int             f_startclock;
 	t_atom_long     f_interval;
@@ -49,6 +48,7 @@ typedef struct  _hoa_3d_scope
 	double          f_center;
 	double          f_radius;
     double*         f_signals;
+    double**        f_vectors;
     
 } t_hoa_3d_scope;
 
@@ -191,7 +191,9 @@ void *hoa_3d_scope_new(t_symbol *s, int argc, t_atom *argv)
 	x->f_scope      = new Hoa3D::Scope(x->f_order, NUMBEROFCIRCLEPOINTS_UI2 * 0.5, NUMBEROFCIRCLEPOINTS_UI2);
     x->f_order      = x->f_scope->getDecompositionOrder();
     x->f_signals    = new double[x->f_scope->getNumberOfHarmonics() * SYS_MAXBLKSIZE];
-    x->f_index      = 0;
+    x->f_vectors    = new double*[x->f_scope->getNumberOfHarmonics()];
+    for(unsigned int i = 0; i < x->f_scope->getNumberOfHarmonics(); i++)
+        x->f_vectors[i] = x->f_signals + i * SYS_MAXBLKSIZE;
     
     dsp_setupjbox((t_pxjbox *)x, x->f_scope->getNumberOfHarmonics());
     
@@ -216,7 +218,7 @@ t_hoa_err hoa_getinfos(t_hoa_3d_scope* x, t_hoa_boxinfos* boxinfos)
 
 void hoa_3d_scope_dsp64(t_hoa_3d_scope *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
 {
-    x->f_index = 0;
+    x->f_scope->setVectorSize(maxvectorsize);
     object_method(dsp64, gensym("dsp_add64"), x, hoa_3d_scope_perform64, 0, NULL);
     x->f_startclock = 1;
 }
@@ -225,14 +227,10 @@ void hoa_3d_scope_perform64(t_hoa_3d_scope *x, t_object *dsp64, double **ins, lo
 {
     for(int i = 0; i < numins; i++)
     {
-        cblas_dcopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    cblas_dscal(numins * sampleframes, x->f_gain, x->f_signals, 1);
-    x->f_index = 0;
-    while(--sampleframes)
-    {
-        x->f_index++;
+        cblas_dcopy(sampleframes, ins[i], 1, x->f_vectors[i], 1);
+        cblas_dscal(sampleframes, x->f_gain, x->f_vectors[i], 1);
     }
+    x->f_scope->accumulate(x->f_vectors, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -243,7 +241,7 @@ void hoa_3d_scope_perform64(t_hoa_3d_scope *x, t_object *dsp64, double **ins, lo
 
 void hoa_3d_scope_tick(t_hoa_3d_scope *x)
 {
-    x->f_scope->process(x->f_signals + x->f_index * x->f_scope->getNumberOfHarmonics());
+    x->f_scope->evaluate();
 
 	jbox_invalidate_layer((t_object *)x, NULL, hoa_sym_harmonics_layer);
 	jbox_redraw((t_jbox *)x);
@@ -259,6 +257,7 @@ void hoa_3d_scope_free(t_hoa_3d_scope *x)
     
     delete x->f_scope;
     delete [] x->f_signals;
+    delete [] x->f_vectors;
 }
 
 void hoa_3d_scope_assist(t_hoa_3d_scope *x, void *b, long m, long a, char *s)
@@ -511,9 +510,13 @@ t_max_err set_order(t_hoa_3d_scope *x, t_object *attr, long ac, t_atom *av)
             
             delete x->f_scope;
             delete [] x->f_signals;
+            delete [] x->f_vectors;
             x->f_scope      = new Hoa3D::Scope(order, NUMBEROFCIRCLEPOINTS_UI2, NUMBEROFCIRCLEPOINTS_UI);
             x->f_order      = x->f_scope->getDecompositionOrder();
             x->f_signals    = new double[x->f_scope->getNumberOfHarmonics() * SYS_MAXBLKSIZE];
+            x->f_vectors    = new double*[x->f_scope->getNumberOfHarmonics()];
+            for(unsigned int i = 0; i < x->f_scope->getNumberOfHarmonics(); i++)
+                x->f_vectors[i] = x->f_signals + i * SYS_MAXBLKSIZE;
             
             object_obex_lookup(x, gensym("#B"), (t_object **)&b);
             object_method(b, hoa_sym_dynlet_begin);
@@ -18,7 +18,7 @@
 #ifndef _FFTCONVOLVER_FFTCONVOLVER_H
 #define _FFTCONVOLVER_FFTCONVOLVER_H
 
-#include "AudioFFT.h"
+#include "../../ThirdParty/AudioFFT/AudioFFT.h"
 #include "Utilities.h"
 
 #include <vector>
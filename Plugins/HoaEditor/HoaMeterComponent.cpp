@@ -25,6 +25,7 @@ HoaMeterComponent::~HoaMeterComponent()
 
 void HoaMeterComponent::timerCallback()
 {
+    m_meter->update();
     repaint();
 }
 
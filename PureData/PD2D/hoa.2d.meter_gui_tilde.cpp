@@ -17,7 +17,6 @@ typedef struct  _hoa_meter
     
     t_float*        f_signals;
     t_float         f_vector_coords[4];
-    long            f_ramp;
 	int             f_startclock;
 	long            f_interval;
     
@@ -274,7 +273,6 @@ void *hoa_meter_new(t_symbol *s, int argc, t_atom *argv)
     
 	x = (t_hoa_meter *)eobj_new(hoa_meter_class);
     
-    x->f_ramp = 0;
     x->f_meter  = new Hoa2D::Meter(4);
     x->f_vector = new Hoa2D::Vector(4);
     x->f_signals = new t_float[MAX_SPEAKER * SYS_MAXBLKSIZE];
@@ -507,14 +505,12 @@ void hoa_meter_dsp(t_hoa_meter *x, t_object *dsp, short *count, double samplerat
 
 void hoa_meter_perform(t_hoa_meter *x, t_object *dsp, float **ins, long numins, float **outs, long no, long sampleframes, long f,void *up)
 {
+    // The vector of the clock only reads the first sample of the channels
 	for(int i = 0; i < numins; i++)
     {
-        cblas_scopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    for(x->f_ramp = 0; x->f_ramp < sampleframes; x->f_ramp++)
-    {
-        x->f_meter->process(x->f_signals + numins * x->f_ramp);
+        x->f_signals[i] = ins[i][0];
     }
+    x->f_meter->process(ins, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -533,6 +529,8 @@ void hoa_meter_tick(t_hoa_meter *x)
          x->f_vector->processEnergy(x->f_signals, x->f_vector_coords + 2);
     
     double peak;
+    // The clock and the painting run on the same thread, they read the snapshot taken once per tick
+    x->f_meter->update();
     for (int i = 0; i < x->f_meter->getNumberOfChannels(); i++)
     {
         peak = x->f_meter->getChannelEnergy(i);
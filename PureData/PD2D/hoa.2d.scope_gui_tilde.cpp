@@ -10,7 +10,6 @@ typedef struct  _hoa_scope
 {
 	t_edspbox   j_box;
     Hoa2D::Scope*   f_scope;
-    int             f_index;
 	t_clock*        f_clock;
 	int             f_startclock;
 	long            f_interval;
@@ -25,6 +24,7 @@ typedef struct  _hoa_scope
 	double          f_center;
 	double          f_radius;
     t_float*        f_signals;
+    t_float**       f_vectors;
    
 } t_hoa_scope;
 
@@ -165,7 +165,9 @@ void *hoa_scope_new(t_symbol *s, int argc, t_atom *argv)
 	x->f_scope      = new Hoa2D::Scope(x->f_order, NUMBEROFCIRCLEPOINTS_UI2);
     x->f_order      = x->f_scope->getDecompositionOrder();
     x->f_signals    = new t_float[x->f_scope->getNumberOfHarmonics() * SYS_MAXBLKSIZE];
-    x->f_index      = 0;
+    x->f_vectors    = new t_float*[x->f_scope->getNumberOfHarmonics()];
+    for(unsigned int i = 0; i < x->f_scope->getNumberOfHarmonics(); i++)
+        x->f_vectors[i] = x->f_signals + i * SYS_MAXBLKSIZE;
     
     eobj_dspsetup(x, x->f_scope->getNumberOfHarmonics(), 0);
     
@@ -198,7 +200,7 @@ t_hoa_err hoa_getinfos(t_hoa_scope* x, t_hoa_boxinfos* boxinfos)
 
 void hoa_scope_dsp(t_hoa_scope *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
 {
-    x->f_index = 0;
+    x->f_scope->setVectorSize(maxvectorsize);
     object_method(dsp64, gensym("dsp_add"), x, (method)hoa_scope_perform, 0, NULL);
     x->f_startclock = 1;
 }
@@ -207,14 +209,10 @@ void hoa_scope_perform(t_hoa_scope *x, t_object *dsp64, float **ins, long numins
 {
     for(int i = 0; i < numins; i++)
     {
-        cblas_scopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    cblas_sscal(numins * sampleframes, x->f_gain, x->f_signals, 1);
-    x->f_index = 0;
-    while(--sampleframes)
-    {
-        x->f_index++;
+        cblas_scopy(sampleframes, ins[i], 1, x->f_vectors[i], 1);
+        cblas_sscal(sampleframes, x->f_gain, x->f_vectors[i], 1);
     }
+    x->f_scope->accumulate(x->f_vectors, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -224,7 +222,7 @@ void hoa_scope_perform(t_hoa_scope *x, t_object *dsp64, float **ins, long numins
 
 void hoa_scope_tick(t_hoa_scope *x)
 {
-    x->f_scope->process(x->f_signals + x->f_index * x->f_scope->getNumberOfHarmonics());
+    x->f_scope->evaluate();
     
 	ebox_invalidate_layer((t_ebox *)x, hoa_sym_harmonics_layer);
 	ebox_redraw((t_ebox *)x);
@@ -239,6 +237,7 @@ void hoa_scope_free(t_hoa_scope *x)
     
     delete x->f_scope;
     delete [] x->f_signals;
+    delete [] x->f_vectors;
 }
 
 void hoa_scope_assist(t_hoa_scope *x, void *b, long m, long a, char *s)
@@ -292,9 +291,13 @@ t_pd_err set_order(t_hoa_scope *x, t_object *attr, long ac, t_atom *av)
             
             delete x->f_scope;
             delete [] x->f_signals;
+            delete [] x->f_vectors;
             x->f_scope      = new Hoa2D::Scope(order, NUMBEROFCIRCLEPOINTS_UI);
             x->f_order      = x->f_scope->getDecompositionOrder();
             x->f_signals    = new t_float[x->f_scope->getNumberOfHarmonics() * SYS_MAXBLKSIZE];
+            x->f_vectors    = new t_float*[x->f_scope->getNumberOfHarmonics()];
+            for(unsigned int i = 0; i < x->f_scope->getNumberOfHarmonics(); i++)
+                x->f_vectors[i] = x->f_signals + i * SYS_MAXBLKSIZE;
             
             eobj_resize_inputs((t_ebox *)x, x->f_scope->getNumberOfHarmonics());
             canvas_update_dsp();
@@ -18,7 +18,6 @@ typedef struct  _hoa_meter_3d
     t_float         f_vector_coords[6];
     int*            f_over_leds;
     
-    long            f_ramp;
 	int             f_startclock;
 	long            f_interval;
     
@@ -245,7 +244,6 @@ void *hoa_meter_3d_new(t_symbol *s, int argc, t_atom *argv)
     
 	x = (t_hoa_meter_3d *)eobj_new(hoa_meter_3d_class);
     
-    x->f_ramp = 0;
     x->f_signals = new t_float[MAX_SPEAKER * SYS_MAXBLKSIZE];
     x->f_over_leds = new int[MAX_CHANNELS];
     for(int i = 0; i < MAX_CHANNELS; i++)
@@ -579,14 +577,12 @@ void hoa_meter_3d_dsp(t_hoa_meter_3d *x, t_object *dsp, short *count, double sam
 
 void hoa_meter_3d_perform(t_hoa_meter_3d *x, t_object *dsp, float **ins, long numins, float **outs, long no, long sampleframes, long f,void *up)
 {
+    // The vector of the clock only reads the first sample of the channels
 	for(int i = 0; i < numins; i++)
     {
-        cblas_scopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    for(x->f_ramp = 0; x->f_ramp < sampleframes; x->f_ramp++)
-    {
-        x->f_meter->process(x->f_signals + numins * x->f_ramp);
+        x->f_signals[i] = ins[i][0];
     }
+    x->f_meter->process(ins, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -606,6 +602,8 @@ void hoa_meter_3d_tick(t_hoa_meter_3d *x)
     else if(x->f_vector_type == hoa_sym_3d_energy)
         x->f_vector->processEnergy(x->f_signals, x->f_vector_coords + 3);
     
+    // The clock and the painting run on the same thread, they read the snapshot taken once per tick
+    x->f_meter->update();
     for (int i = 0; i < x->f_meter->getNumberOfChannels(); i++)
     {
         peak = x->f_meter->getChannelEnergy(i);
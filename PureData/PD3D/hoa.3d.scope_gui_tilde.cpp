@@ -10,7 +10,6 @@ typedef struct  _hoa_scope_3D
 {
 	t_edspbox   j_box;
     Hoa3D::Scope*   f_scope;
-    int             f_index;
 	t_clock*        f_clock;
 	int             f_startclock;
 	long            f_interval;
@@ -25,6 +24,7 @@ typedef struct  _hoa_scope_3D
 	double          f_center;
 	double          f_radius;
     t_float*        f_signals;
+    t_float**       f_vectors;
    
 } t_hoa_scope_3D;
 
@@ -147,7 +147,9 @@ void *hoa_scope_3D_new(t_symbol *s, int argc, t_atom *argv)
 	x->f_scope      = new Hoa3D::Scope(x->f_order, NUMBEROFCIRCLEPOINTS_UI2 * 0.25, NUMBEROFCIRCLEPOINTS_UI2 * 0.5);
     x->f_order      = x->f_scope->getDecompositionOrder();
     x->f_signals    = new t_float[x->f_scope->getNumberOfHarmonics() * SYS_MAXBLKSIZE];
-    x->f_index      = 0;
+    x->f_vectors    = new t_float*[x->f_scope->getNumberOfHarmonics()];
+    for(unsigned int i = 0; i < x->f_scope->getNumberOfHarmonics(); i++)
+        x->f_vectors[i] = x->f_signals + i * SYS_MAXBLKSIZE;
     
     eobj_dspsetup(x, x->f_scope->getNumberOfHarmonics(), 0);
     
@@ -178,7 +180,7 @@ t_hoa_err hoa_getinfos(t_hoa_scope_3D* x, t_hoa_boxinfos* boxinfos)
 
 void hoa_scope_3D_dsp(t_hoa_scope_3D *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
 {
-    x->f_index = 0;
+    x->f_scope->setVectorSize(maxvectorsize);
     object_method(dsp64, gensym("dsp_add"), x, (method)hoa_scope_3D_perform, 0, NULL);
     x->f_startclock = 1;
 }
@@ -187,14 +189,10 @@ void hoa_scope_3D_perform(t_hoa_scope_3D *x, t_object *dsp64, float **ins, long
 {
     for(int i = 0; i < numins; i++)
     {
-        cblas_scopy(sampleframes, ins[i], 1, x->f_signals+i, numins);
-    }
-    cblas_sscal(numins * sampleframes, x->f_gain, x->f_signals, 1);
-    x->f_index = 0;
-    while(--sampleframes)
-    {
-        x->f_index++;
+        cblas_scopy(sampleframes, ins[i], 1, x->f_vectors[i], 1);
+        cblas_sscal(sampleframes, x->f_gain, x->f_vectors[i], 1);
     }
+    x->f_scope->accumulate(x->f_vectors, sampleframes);
     if(x->f_startclock)
 	{
 		x->f_startclock = 0;
@@ -204,7 +202,7 @@ void hoa_scope_3D_perform(t_hoa_scope_3D *x, t_object *dsp64, float **ins, long
 
 void hoa_scope_3D_tick(t_hoa_scope_3D *x)
 {
-    x->f_scope->process(x->f_signals + x->f_index * x->f_scope->getNumberOfHarmonics());
+    x->f_scope->evaluate();
     
 	ebox_invalidate_layer((t_ebox *)x, hoa_sym_harmonics_layer);
 	ebox_redraw((t_ebox *)x);
@@ -219,6 +217,7 @@ void hoa_scope_3D_free(t_hoa_scope_3D *x)
     
     delete x->f_scope;
     delete [] x->f_signals;
+    delete [] x->f_vectors;
 }
 
 void hoa_scope_3D_assist(t_hoa_scope_3D *x, void *b, long m, long a, char *s)
@@ -268,9 +267,13 @@ t_pd_err set_order(t_hoa_scope_3D *x, t_object *attr, long ac, t_atom *av)
             
             delete x->f_scope;
             delete [] x->f_signals;
+            delete [] x->f_vectors;
             x->f_scope      = new Hoa3D::Scope(order, NUMBEROFCIRCLEPOINTS_UI2 * 0.25, NUMBEROFCIRCLEPOINTS_UI2 * 0.5);
             x->f_order      = x->f_scope->getDecompositionOrder();
             x->f_signals    = new t_float[x->f_scope->getNumberOfHarmonics() * SYS_MAXBLKSIZE];
+            x->f_vectors    = new t_float*[x->f_scope->getNumberOfHarmonics()];
+            for(unsigned int i = 0; i < x->f_scope->getNumberOfHarmonics(); i++)
+                x->f_vectors[i] = x->f_signals + i * SYS_MAXBLKSIZE;
             
             eobj_resize_inputs((t_ebox *)x, x->f_scope->getNumberOfHarmonics());
             canvas_update_dsp();
@@ -0,0 +1,1140 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+// The benchmark measures the block processing of the classes in nanoseconds per sample and per channel, the number of
+// channels is the greater of the number of inputs and the number of outputs. Before each measure, the block processing
+// is checked against the scalar processing : the sample by sample methods of the class or, for the classes that only
+// process a frame of samples, the frame processing in double precision. The benchmark returns 1 if a check fails.
+//
+// Usage : HoaBenchmark [--filter=name] [--orders=min-max] [--blocks=min-max] [--sources=n,n,...]
+//                      [--min-time=seconds] [--isa=generic|sse2|avx2|avx512|neon] [--check]
+
+#include "../Hoa2D/Hoa2D.h"
+#include "../Hoa3D/Hoa3D.h"
+#include <time.h>
+#include <string.h>
+
+#define HOA_BENCHMARK_MAX_BLOCK 4096
+#define HOA_BENCHMARK_IMPULSE_SIZE 512
+#define HOA_BENCHMARK_MAX_MEMORY (1024u << 20)
+
+namespace Hoa
+{
+    //! The case of a benchmark.
+    /** A case owns an instance of a class processed with the block methods and an instance processed with the scalar methods. The inputs and the outputs are planar vectors.
+     */
+    template <typename T> class Case
+    {
+    protected:
+        unsigned int    m_number_of_inputs;
+        unsigned int    m_number_of_outputs;
+        T*              m_frame_inputs;
+        T*              m_frame_outputs;
+        double*         m_frame_inputs_double;
+        double*         m_frame_outputs_double;
+        
+        void allocate(const unsigned int numberOfInputs, const unsigned int numberOfOutputs)
+        {
+            delete [] m_frame_inputs;
+            delete [] m_frame_outputs;
+            delete [] m_frame_inputs_double;
+            delete [] m_frame_outputs_double;
+            m_number_of_inputs      = numberOfInputs;
+            m_number_of_outputs     = numberOfOutputs;
+            m_frame_inputs          = new T[m_number_of_inputs];
+            m_frame_outputs         = new T[m_number_of_outputs];
+            m_frame_inputs_double   = new double[m_number_of_inputs];
+            m_frame_outputs_double  = new double[m_number_of_outputs];
+        };
+        
+        inline void gather(T** inputs, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_number_of_inputs; i++)
+                m_frame_inputs[i] = inputs[i][k];
+        };
+        
+        inline void scatter(T** outputs, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                outputs[i][k] = m_frame_outputs[i];
+        };
+        
+        inline void gatherDouble(T** inputs, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_number_of_inputs; i++)
+                m_frame_inputs_double[i] = inputs[i][k];
+        };
+        
+        inline void scatterDouble(T** outputs, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                outputs[i][k] = m_frame_outputs_double[i];
+        };
+    
+    public:
+        
+        Case()
+        {
+            m_number_of_inputs      = 0;
+            m_number_of_outputs     = 0;
+            m_frame_inputs          = NULL;
+            m_frame_outputs         = NULL;
+            m_frame_inputs_double   = NULL;
+            m_frame_outputs_double  = NULL;
+        }
+        
+        virtual ~Case()
+        {
+            delete [] m_frame_inputs;
+            delete [] m_frame_outputs;
+            delete [] m_frame_inputs_double;
+            delete [] m_frame_outputs_double;
+        }
+        
+        inline unsigned int getNumberOfInputs() const
+        {
+            return m_number_of_inputs;
+        };
+        
+        inline unsigned int getNumberOfOutputs() const
+        {
+            return m_number_of_outputs;
+        };
+        
+        //! The measured processing.
+        virtual void processBlock(T** inputs, T** outputs, const unsigned int vectorSize) = 0;
+        
+        //! The reference processing.
+        virtual void processScalar(T** inputs, T** outputs, const unsigned int vectorSize) = 0;
+    };
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Cases 2D //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    template <typename T> class Encoder2D : public Case<T>
+    {
+        Hoa2D::Encoder m_block;
+        Hoa2D::Encoder m_scalar;
+    public:
+        Encoder2D(unsigned int order, unsigned int) : m_block(order), m_scalar(order)
+        {
+            this->allocate(1, m_block.getNumberOfHarmonics());
+            m_block.setAzimuth(1.3);
+            m_scalar.setAzimuth(1.3);
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.process(inputs[0], outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                m_scalar.process(inputs[0][k], this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    template <typename T> class Map2D : public Case<T>
+    {
+        Hoa2D::Map m_block;
+        Hoa2D::Map m_scalar;
+    public:
+        Map2D(unsigned int order, unsigned int numberOfSources) : m_block(order, numberOfSources), m_scalar(order, numberOfSources)
+        {
+            this->allocate(numberOfSources, m_block.getNumberOfHarmonics());
+            for(unsigned int i = 0; i < numberOfSources; i++)
+            {
+                m_block.setAzimuth(i, HOA_2PI * i / numberOfSources);
+                m_scalar.setAzimuth(i, HOA_2PI * i / numberOfSources);
+                m_block.setRadius(i, 0.5 + (double)i / numberOfSources);
+                m_scalar.setRadius(i, 0.5 + (double)i / numberOfSources);
+            }
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.process(inputs, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gather(inputs, k);
+                m_scalar.process(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    //! The case of a class with the block methods for planar vectors and the sample methods for frames.
+    template <typename T, class Processor> class Planar : public Case<T>
+    {
+    protected:
+        Processor* m_block;
+        Processor* m_scalar;
+    public:
+        Planar(Processor* block, Processor* scalar, const unsigned int numberOfInputs, const unsigned int numberOfOutputs) : m_block(block), m_scalar(scalar)
+        {
+            this->allocate(numberOfInputs, numberOfOutputs);
+        }
+        ~Planar()
+        {
+            delete m_block;
+            delete m_scalar;
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block->process(inputs, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gather(inputs, k);
+                m_scalar->process(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    template <typename T> class DecoderRegular2D : public Planar<T, Hoa2D::DecoderRegular>
+    {
+    public:
+        DecoderRegular2D(unsigned int order, unsigned int) : Planar<T, Hoa2D::DecoderRegular>(new Hoa2D::DecoderRegular(order, 2 * order + 2), new Hoa2D::DecoderRegular(order, 2 * order + 2), 2 * order + 1, 2 * order + 2)
+        {
+            ;
+        }
+    };
+    
+    template <typename T> class DecoderIrregular2D : public Planar<T, Hoa2D::DecoderIrregular>
+    {
+    public:
+        DecoderIrregular2D(unsigned int order, unsigned int) : Planar<T, Hoa2D::DecoderIrregular>(new Hoa2D::DecoderIrregular(order, 5), new Hoa2D::DecoderIrregular(order, 5), 2 * order + 1, 5)
+        {
+            // The channels of a 5.0 setup
+            double azimuths[5] = {0., HOA_PI / 6., HOA_2PI - HOA_PI / 6., 110. / 180. * HOA_PI, HOA_2PI - 110. / 180. * HOA_PI};
+            this->m_block->setChannelsAzimuth(azimuths);
+            this->m_scalar->setChannelsAzimuth(azimuths);
+        }
+    };
+    
+    //! Synthetic impulse responses with a decay and a delay that depends on the channel.
+    inline void fillImpulses(float* impulses, float** left, float** right, const unsigned int numberOfChannels)
+    {
+        for(unsigned int i = 0; i < numberOfChannels; i++)
+        {
+            left[i]     = impulses + (2 * i) * HOA_BENCHMARK_IMPULSE_SIZE;
+            right[i]    = impulses + (2 * i + 1) * HOA_BENCHMARK_IMPULSE_SIZE;
+            for(unsigned int k = 0; k < HOA_BENCHMARK_IMPULSE_SIZE; k++)
+            {
+                const double decay = exp(-(double)k / 64.);
+                left[i][k]  = decay * sin(0.13 * (k + i));
+                right[i][k] = decay * cos(0.17 * (k + 2 * i));
+            }
+        }
+    }
+    
+    template <typename T> class DecoderBinaural2D : public Planar<T, Hoa2D::DecoderBinaural>
+    {
+    public:
+        DecoderBinaural2D(unsigned int order, unsigned int) : Planar<T, Hoa2D::DecoderBinaural>(new Hoa2D::DecoderBinaural(order), new Hoa2D::DecoderBinaural(order), 2 * order + 1, 2)
+        {
+            const unsigned int number_of_channels = this->m_block->getNumberOfVirtualChannels();
+            float* impulses = new float[2 * number_of_channels * HOA_BENCHMARK_IMPULSE_SIZE];
+            float** left    = new float*[number_of_channels];
+            float** right   = new float*[number_of_channels];
+            fillImpulses(impulses, left, right, number_of_channels);
+            this->m_block->setImpulses(left, right, HOA_BENCHMARK_IMPULSE_SIZE);
+            this->m_scalar->setImpulses(left, right, HOA_BENCHMARK_IMPULSE_SIZE);
+            delete [] impulses;
+            delete [] left;
+            delete [] right;
+        }
+    };
+    
+    template <typename T> class Rotate2D : public Planar<T, Hoa2D::Rotate>
+    {
+    public:
+        Rotate2D(unsigned int order, unsigned int) : Planar<T, Hoa2D::Rotate>(new Hoa2D::Rotate(order), new Hoa2D::Rotate(order), 2 * order + 1, 2 * order + 1)
+        {
+            this->m_block->setYaw(2.3);
+            this->m_scalar->setYaw(2.3);
+        }
+    };
+    
+    template <typename T> class Wider2D : public Planar<T, Hoa2D::Wider>
+    {
+    public:
+        Wider2D(unsigned int order, unsigned int) : Planar<T, Hoa2D::Wider>(new Hoa2D::Wider(order), new Hoa2D::Wider(order), 2 * order + 1, 2 * order + 1)
+        {
+            this->m_block->setWideningValue(0.3);
+            this->m_scalar->setWideningValue(0.3);
+        }
+    };
+    
+    template <typename T> class Optim2D : public Planar<T, Hoa2D::Optim>
+    {
+    public:
+        Optim2D(unsigned int order, unsigned int) : Planar<T, Hoa2D::Optim>(new Hoa2D::Optim(order, Hoa2D::Optim::InPhase), new Hoa2D::Optim(order, Hoa2D::Optim::InPhase), 2 * order + 1, 2 * order + 1)
+        {
+            ;
+        }
+    };
+    
+    template <typename T> class Recomposer2D : public Case<T>
+    {
+        Hoa2D::Recomposer m_block;
+        Hoa2D::Recomposer m_scalar;
+    public:
+        Recomposer2D(unsigned int order, unsigned int numberOfSources) : m_block(order, numberOfSources), m_scalar(order, numberOfSources)
+        {
+            this->allocate(numberOfSources, m_block.getNumberOfHarmonics());
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.processFixe(inputs, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gather(inputs, k);
+                m_scalar.processFixe(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    template <typename T> class RecomposerFree2D : public Case<T>
+    {
+        Hoa2D::Recomposer m_block;
+        Hoa2D::Recomposer m_scalar;
+    public:
+        RecomposerFree2D(unsigned int order, unsigned int numberOfSources) : m_block(order, numberOfSources), m_scalar(order, numberOfSources)
+        {
+            this->allocate(numberOfSources, m_block.getNumberOfHarmonics());
+            for(unsigned int i = 0; i < numberOfSources; i++)
+            {
+                m_block.setAzimuth(i, HOA_2PI * i / numberOfSources + 0.2);
+                m_scalar.setAzimuth(i, HOA_2PI * i / numberOfSources + 0.2);
+                m_block.setWideningValue(i, 0.4 + 0.5 * i / numberOfSources);
+                m_scalar.setWideningValue(i, 0.4 + 0.5 * i / numberOfSources);
+            }
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.processFree(inputs, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gather(inputs, k);
+                m_scalar.processFree(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Frame cases //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    //! The case of a class that only processes a frame of samples.
+    /** The measured processing is the frame processing with the precision of the case and the reference processing is the frame processing in double precision.
+     */
+    template <typename T, class Processor> class Frame : public Case<T>
+    {
+    protected:
+        Processor* m_block;
+        Processor* m_scalar;
+    public:
+        Frame(Processor* block, Processor* scalar, const unsigned int numberOfInputs, const unsigned int numberOfOutputs) : m_block(block), m_scalar(scalar)
+        {
+            this->allocate(numberOfInputs, numberOfOutputs);
+        }
+        ~Frame()
+        {
+            delete m_block;
+            delete m_scalar;
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gather(inputs, k);
+                m_block->process(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gatherDouble(inputs, k);
+                m_scalar->process(this->m_frame_inputs_double, this->m_frame_outputs_double);
+                this->scatterDouble(outputs, k);
+            }
+        }
+    };
+    
+    //! The case of an analyzer that only processes a frame of samples.
+    /** The analyzers have no outputs, their state is written in the first samples of the outputs after the processing.
+     */
+    template <typename T, class Processor> class Analyzer : public Case<T>
+    {
+    protected:
+        Processor* m_block;
+        Processor* m_scalar;
+        
+        virtual void state(Processor* processor, T** outputs) = 0;
+    
+    public:
+        Analyzer(Processor* block, Processor* scalar, const unsigned int numberOfInputs, const unsigned int numberOfOutputs) : m_block(block), m_scalar(scalar)
+        {
+            this->allocate(numberOfInputs, numberOfOutputs);
+        }
+        ~Analyzer()
+        {
+            delete m_block;
+            delete m_scalar;
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gather(inputs, k);
+                this->m_block->process(this->m_frame_inputs);
+            }
+            this->state(this->m_block, outputs);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gatherDouble(inputs, k);
+                this->m_scalar->process(this->m_frame_inputs_double);
+            }
+            this->state(this->m_scalar, outputs);
+        }
+    };
+    
+    template <typename T> class Meter2D : public Analyzer<T, Hoa2D::Meter>
+    {
+        void state(Hoa2D::Meter* meter, T** outputs)
+        {
+            meter->update();
+            for(unsigned int i = 0; i < this->m_number_of_outputs; i++)
+            {
+                outputs[i][0] = meter->getChannelPeak(i);
+                outputs[i][1] = meter->getChannelRms(i);
+                outputs[i][2] = meter->getChannelLevel(i);
+            }
+        }
+    public:
+        // The windows are shorter than the blocks so the snapshots are published during the processing
+        Meter2D(unsigned int order, unsigned int) : Analyzer<T, Hoa2D::Meter>(new Hoa2D::Meter(2 * order + 2), new Hoa2D::Meter(2 * order + 2), 2 * order + 2, 2 * order + 2)
+        {
+            this->m_block->setVectorSize(48);
+            this->m_scalar->setVectorSize(48);
+            this->m_block->setRelease(300.);
+            this->m_scalar->setRelease(300.);
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            this->m_block->process(inputs, vectorSize);
+            this->state(this->m_block, outputs);
+        }
+    };
+    
+    template <typename T> class Scope2D : public Analyzer<T, Hoa2D::Scope>
+    {
+        void state(Hoa2D::Scope* scope, T** outputs)
+        {
+            for(unsigned int i = 0; i < this->m_number_of_outputs; i++)
+                outputs[i][0] = scope->getValue(i);
+        }
+    public:
+        Scope2D(unsigned int order, unsigned int) : Analyzer<T, Hoa2D::Scope>(new Hoa2D::Scope(order, NUMBEROFCIRCLEPOINTS_UI), new Hoa2D::Scope(order, NUMBEROFCIRCLEPOINTS_UI), 2 * order + 1, NUMBEROFCIRCLEPOINTS_UI)
+        {
+            ;
+        }
+    };
+    
+    template <typename T> class ScopeCovariance2D : public Analyzer<T, Hoa2D::Scope>
+    {
+        void state(Hoa2D::Scope* scope, T** outputs)
+        {
+            scope->evaluate();
+            for(unsigned int i = 0; i < this->m_number_of_outputs; i++)
+                outputs[i][0] = scope->getValue(i);
+        }
+    public:
+        // The audio thread accumulates the covariance and the scope is evaluated once per block
+        ScopeCovariance2D(unsigned int order, unsigned int) : Analyzer<T, Hoa2D::Scope>(new Hoa2D::Scope(order, NUMBEROFCIRCLEPOINTS_UI), new Hoa2D::Scope(order, NUMBEROFCIRCLEPOINTS_UI), 2 * order + 1, NUMBEROFCIRCLEPOINTS_UI)
+        {
+            this->m_block->setVectorSize(48);
+            this->m_scalar->setVectorSize(48);
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            this->m_block->accumulate(inputs, vectorSize);
+            this->state(this->m_block, outputs);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gatherDouble(inputs, k);
+                this->m_scalar->accumulate(this->m_frame_inputs_double);
+            }
+            this->state(this->m_scalar, outputs);
+        }
+    };
+    
+    template <typename T> class Vector2D : public Frame<T, Hoa2D::Vector>
+    {
+    public:
+        Vector2D(unsigned int order, unsigned int) : Frame<T, Hoa2D::Vector>(new Hoa2D::Vector(2 * order + 2), new Hoa2D::Vector(2 * order + 2), 2 * order + 2, 4)
+        {
+            ;
+        }
+    };
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Cases 3D //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    //! The trajectory of the sources, a slow turn around the vertical axis with an oscillation of the elevation.
+    inline double trajectoryAzimuth(const unsigned int index, const unsigned int k)
+    {
+        return 0.3 * index + 0.0007 * k;
+    }
+    
+    inline double trajectoryElevation(const unsigned int index, const unsigned int k)
+    {
+        return 0.6 * sin(0.5 * index + 0.0011 * k);
+    }
+    
+    template <typename T> class Encoder3D : public Case<T>
+    {
+        Hoa3D::Encoder m_block;
+        Hoa3D::Encoder m_scalar;
+        T* m_azimuths;
+        T* m_elevations;
+    public:
+        Encoder3D(unsigned int order, unsigned int) : m_block(order), m_scalar(order, Hoa3D::Encoder::Recurrence)
+        {
+            this->allocate(1, m_block.getNumberOfHarmonics());
+            m_azimuths      = new T[HOA_BENCHMARK_MAX_BLOCK];
+            m_elevations    = new T[HOA_BENCHMARK_MAX_BLOCK];
+            for(unsigned int k = 0; k < HOA_BENCHMARK_MAX_BLOCK; k++)
+            {
+                m_azimuths[k]   = trajectoryAzimuth(1, k);
+                m_elevations[k] = trajectoryElevation(1, k);
+            }
+        }
+        ~Encoder3D()
+        {
+            delete [] m_azimuths;
+            delete [] m_elevations;
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.process(inputs[0], m_azimuths, m_elevations, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                m_scalar.setAzimuth(m_azimuths[k]);
+                m_scalar.setElevation(m_elevations[k]);
+                m_scalar.process(inputs[0][k], this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    template <typename T> class Map3D : public Case<T>
+    {
+        Hoa3D::Map  m_block;
+        Hoa3D::Map  m_scalar;
+        T*          m_positions;
+        T**         m_azimuths;
+        T**         m_elevations;
+    public:
+        Map3D(unsigned int order, unsigned int numberOfSources) : m_block(order, numberOfSources), m_scalar(order, numberOfSources)
+        {
+            this->allocate(numberOfSources, m_block.getNumberOfHarmonics());
+            m_positions     = new T[2 * numberOfSources * HOA_BENCHMARK_MAX_BLOCK];
+            m_azimuths      = new T*[numberOfSources];
+            m_elevations    = new T*[numberOfSources];
+            for(unsigned int i = 0; i < numberOfSources; i++)
+            {
+                m_azimuths[i]   = m_positions + (2 * i) * HOA_BENCHMARK_MAX_BLOCK;
+                m_elevations[i] = m_positions + (2 * i + 1) * HOA_BENCHMARK_MAX_BLOCK;
+                for(unsigned int k = 0; k < HOA_BENCHMARK_MAX_BLOCK; k++)
+                {
+                    m_azimuths[i][k]    = trajectoryAzimuth(i, k);
+                    m_elevations[i][k]  = trajectoryElevation(i, k);
+                }
+                m_block.setRadius(i, 0.5 + (double)i / numberOfSources);
+                m_scalar.setRadius(i, 0.5 + (double)i / numberOfSources);
+            }
+        }
+        ~Map3D()
+        {
+            delete [] m_positions;
+            delete [] m_azimuths;
+            delete [] m_elevations;
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.process(inputs, m_azimuths, m_elevations, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                for(unsigned int i = 0; i < this->m_number_of_inputs; i++)
+                {
+                    m_scalar.setAzimuth(i, m_azimuths[i][k]);
+                    m_scalar.setElevation(i, m_elevations[i][k]);
+                }
+                this->gather(inputs, k);
+                m_scalar.process(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    template <typename T> class Vbap3D : public Case<T>
+    {
+        Hoa3D::Vbap m_block;
+        Hoa3D::Vbap m_scalar;
+        T*          m_positions;
+        T**         m_azimuths;
+        T**         m_elevations;
+    public:
+        Vbap3D(unsigned int order, unsigned int numberOfSources) : m_block((order + 1) * (order + 1) + 4, numberOfSources), m_scalar((order + 1) * (order + 1) + 4, numberOfSources)
+        {
+            this->allocate(numberOfSources, m_block.getNumberOfChannels());
+            m_positions     = new T[2 * numberOfSources * HOA_BENCHMARK_MAX_BLOCK];
+            m_azimuths      = new T*[numberOfSources];
+            m_elevations    = new T*[numberOfSources];
+            for(unsigned int i = 0; i < numberOfSources; i++)
+            {
+                m_azimuths[i]   = m_positions + (2 * i) * HOA_BENCHMARK_MAX_BLOCK;
+                m_elevations[i] = m_positions + (2 * i + 1) * HOA_BENCHMARK_MAX_BLOCK;
+                for(unsigned int k = 0; k < HOA_BENCHMARK_MAX_BLOCK; k++)
+                {
+                    m_azimuths[i][k]    = trajectoryAzimuth(i, k);
+                    m_elevations[i][k]  = trajectoryElevation(i, k);
+                }
+            }
+        }
+        ~Vbap3D()
+        {
+            delete [] m_positions;
+            delete [] m_azimuths;
+            delete [] m_elevations;
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            m_block.process(inputs, m_azimuths, m_elevations, outputs, vectorSize);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                for(unsigned int i = 0; i < this->m_number_of_inputs; i++)
+                {
+                    m_scalar.setAzimuth(i, m_azimuths[i][k]);
+                    m_scalar.setElevation(i, m_elevations[i][k]);
+                }
+                this->gather(inputs, k);
+                m_scalar.process(this->m_frame_inputs, this->m_frame_outputs);
+                this->scatter(outputs, k);
+            }
+        }
+    };
+    
+    template <typename T> class DecoderRegular3D : public Planar<T, Hoa3D::DecoderRegular>
+    {
+    public:
+        DecoderRegular3D(unsigned int order, unsigned int) : Planar<T, Hoa3D::DecoderRegular>(new Hoa3D::DecoderRegular(order, (order + 1) * (order + 1) + 4), new Hoa3D::DecoderRegular(order, (order + 1) * (order + 1) + 4), (order + 1) * (order + 1), (order + 1) * (order + 1) + 4)
+        {
+            ;
+        }
+    };
+    
+    template <typename T> class DecoderBinaural3D : public Planar<T, Hoa3D::DecoderBinaural>
+    {
+    public:
+        DecoderBinaural3D(unsigned int order, unsigned int) : Planar<T, Hoa3D::DecoderBinaural>(new Hoa3D::DecoderBinaural(order), new Hoa3D::DecoderBinaural(order), (order + 1) * (order + 1), 2)
+        {
+            const unsigned int number_of_channels = this->m_block->getNumberOfVirtualChannels();
+            float* impulses = new float[2 * number_of_channels * HOA_BENCHMARK_IMPULSE_SIZE];
+            float** left    = new float*[number_of_channels];
+            float** right   = new float*[number_of_channels];
+            fillImpulses(impulses, left, right, number_of_channels);
+            this->m_block->setImpulses(left, right, HOA_BENCHMARK_IMPULSE_SIZE);
+            this->m_scalar->setImpulses(left, right, HOA_BENCHMARK_IMPULSE_SIZE);
+            delete [] impulses;
+            delete [] left;
+            delete [] right;
+        }
+    };
+    
+    template <typename T> class Rotate3D : public Planar<T, Hoa3D::Rotate>
+    {
+    public:
+        Rotate3D(unsigned int order, unsigned int) : Planar<T, Hoa3D::Rotate>(new Hoa3D::Rotate(order), new Hoa3D::Rotate(order), (order + 1) * (order + 1), (order + 1) * (order + 1))
+        {
+            this->m_block->setRotations(0.4, -0.7, 2.3);
+            this->m_scalar->setRotations(0.4, -0.7, 2.3);
+        }
+    };
+    
+    template <typename T> class Wider3D : public Planar<T, Hoa3D::Wider>
+    {
+    public:
+        Wider3D(unsigned int order, unsigned int) : Planar<T, Hoa3D::Wider>(new Hoa3D::Wider(order), new Hoa3D::Wider(order), (order + 1) * (order + 1), (order + 1) * (order + 1))
+        {
+            this->m_block->setWideningValue(0.3);
+            this->m_scalar->setWideningValue(0.3);
+        }
+    };
+    
+    template <typename T> class Optim3D : public Frame<T, Hoa3D::Optim>
+    {
+    public:
+        Optim3D(unsigned int order, unsigned int) : Frame<T, Hoa3D::Optim>(new Hoa3D::Optim(order, Hoa3D::Optim::InPhase), new Hoa3D::Optim(order, Hoa3D::Optim::InPhase), (order + 1) * (order + 1), (order + 1) * (order + 1))
+        {
+            ;
+        }
+    };
+    
+    template <typename T> class Meter3D : public Analyzer<T, Hoa3D::Meter>
+    {
+        void state(Hoa3D::Meter* meter, T** outputs)
+        {
+            meter->update();
+            for(unsigned int i = 0; i < this->m_number_of_outputs; i++)
+            {
+                outputs[i][0] = meter->getChannelPeak(i);
+                outputs[i][1] = meter->getChannelRms(i);
+                outputs[i][2] = meter->getChannelLevel(i);
+            }
+        }
+    public:
+        // The meter has at most 256 channels, the windows are shorter than the blocks
+        Meter3D(unsigned int order, unsigned int) : Analyzer<T, Hoa3D::Meter>(new Hoa3D::Meter((order + 1) * (order + 1), 10, 20), new Hoa3D::Meter((order + 1) * (order + 1), 10, 20), (order + 1) * (order + 1), (order + 1) * (order + 1))
+        {
+            this->m_block->setVectorSize(48);
+            this->m_scalar->setVectorSize(48);
+            this->m_block->setRelease(300.);
+            this->m_scalar->setRelease(300.);
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            this->m_block->process(inputs, vectorSize);
+            this->state(this->m_block, outputs);
+        }
+    };
+    
+    template <typename T> class Scope3D : public Analyzer<T, Hoa3D::Scope>
+    {
+        void state(Hoa3D::Scope* scope, T** outputs)
+        {
+            const unsigned int columns = scope->getNumberOfColumns();
+            for(unsigned int i = 0; i < this->m_number_of_outputs; i++)
+                outputs[i][0] = scope->getValue(i / columns, i % columns);
+        }
+    public:
+        Scope3D(unsigned int order, unsigned int) : Analyzer<T, Hoa3D::Scope>(new Hoa3D::Scope(order, 19, 36), new Hoa3D::Scope(order, 19, 36), (order + 1) * (order + 1), 0)
+        {
+            this->allocate(this->m_number_of_inputs, this->m_block->getNumberOfRows() * this->m_block->getNumberOfColumns());
+        }
+    };
+    
+    template <typename T> class ScopeCovariance3D : public Analyzer<T, Hoa3D::Scope>
+    {
+        void state(Hoa3D::Scope* scope, T** outputs)
+        {
+            scope->evaluate();
+            const unsigned int columns = scope->getNumberOfColumns();
+            for(unsigned int i = 0; i < this->m_number_of_outputs; i++)
+                outputs[i][0] = scope->getValue(i / columns, i % columns);
+        }
+    public:
+        // The audio thread accumulates the covariance and the scope is evaluated once per block
+        ScopeCovariance3D(unsigned int order, unsigned int) : Analyzer<T, Hoa3D::Scope>(new Hoa3D::Scope(order, 19, 36), new Hoa3D::Scope(order, 19, 36), (order + 1) * (order + 1), 0)
+        {
+            this->allocate(this->m_number_of_inputs, this->m_block->getNumberOfRows() * this->m_block->getNumberOfColumns());
+            this->m_block->setVectorSize(48);
+            this->m_scalar->setVectorSize(48);
+        }
+        void processBlock(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            this->m_block->accumulate(inputs, vectorSize);
+            this->state(this->m_block, outputs);
+        }
+        void processScalar(T** inputs, T** outputs, const unsigned int vectorSize)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                this->gatherDouble(inputs, k);
+                this->m_scalar->accumulate(this->m_frame_inputs_double);
+            }
+            this->state(this->m_scalar, outputs);
+        }
+    };
+    
+    template <typename T> class Vector3D : public Frame<T, Hoa3D::Vector>
+    {
+    public:
+        Vector3D(unsigned int order, unsigned int) : Frame<T, Hoa3D::Vector>(new Hoa3D::Vector((order + 1) * (order + 1) + 4), new Hoa3D::Vector((order + 1) * (order + 1) + 4), (order + 1) * (order + 1) + 4, 6)
+        {
+            ;
+        }
+    };
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Runner //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    //! A registered benchmark.
+    /** The tolerances are the greatest relative errors of the block processing for each precision. The memory function, if any, estimates the memory of a case so the cases that would exhaust the memory are skipped.
+     */
+    struct Benchmark
+    {
+        const char*     name;
+        bool            sources;
+        double          tolerance_float;
+        double          tolerance_double;
+        double          (*memory)(unsigned int order, unsigned int numberOfSources);
+        Case<float>*    (*createFloat)(unsigned int order, unsigned int numberOfSources);
+        Case<double>*   (*createDouble)(unsigned int order, unsigned int numberOfSources);
+    };
+    
+    //! The memory of the maps, each source has a table of NUMBEROFLINEARPOINTS widening weights by harmonic.
+    double memoryMap2D(unsigned int order, unsigned int numberOfSources)
+    {
+        return 2. * numberOfSources * (2 * order + 1) * NUMBEROFLINEARPOINTS * sizeof(double);
+    }
+    
+    double memoryMap3D(unsigned int order, unsigned int numberOfSources)
+    {
+        return 2. * numberOfSources * (order + 1) * (order + 1) * NUMBEROFLINEARPOINTS * sizeof(double);
+    }
+    
+    template <template <typename> class C, typename T> Case<T>* create(unsigned int order, unsigned int numberOfSources)
+    {
+        return new C<T>(order, numberOfSources);
+    }
+
+#define HOA_BENCHMARK(NAME, CLASS, SOURCES, FLOAT, DOUBLE, MEMORY) {NAME, SOURCES, FLOAT, DOUBLE, MEMORY, &create<CLASS, float>, &create<CLASS, double>}
+    
+    // The binaural decoders convolve in single precision, the vectors are normalized by the energy that can be small,
+    // the 3D map encodes the sample by sample with the tables and the blocks with the recurrence.
+    static const Benchmark benchmarks[] =
+    {
+        HOA_BENCHMARK("Hoa2D::Encoder",             Encoder2D,          false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Map",                 Map2D,              true,   1e-4,   1e-9,   &memoryMap2D),
+        HOA_BENCHMARK("Hoa2D::DecoderRegular",      DecoderRegular2D,   false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::DecoderIrregular",    DecoderIrregular2D, false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::DecoderBinaural",     DecoderBinaural2D,  false,  1e-4,   1e-6,   NULL),
+        HOA_BENCHMARK("Hoa2D::Rotate",              Rotate2D,           false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Wider",               Wider2D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Optim",               Optim2D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Recomposer",          Recomposer2D,       true,   1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Recomposer/free",     RecomposerFree2D,   true,   1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Meter",               Meter2D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Scope",               Scope2D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Scope/covariance",    ScopeCovariance2D,  false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa2D::Vector",              Vector2D,           false,  1e-2,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Encoder",             Encoder3D,          false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Map",                 Map3D,              true,   5e-3,   5e-3,   &memoryMap3D),
+        HOA_BENCHMARK("Hoa3D::Vbap",                Vbap3D,             true,   1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::DecoderRegular",      DecoderRegular3D,   false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::DecoderBinaural",     DecoderBinaural3D,  false,  1e-4,   1e-6,   NULL),
+        HOA_BENCHMARK("Hoa3D::Rotate",              Rotate3D,           false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Wider",               Wider3D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Optim",               Optim3D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Meter",               Meter3D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Scope",               Scope3D,            false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Scope/covariance",    ScopeCovariance3D,  false,  1e-4,   1e-9,   NULL),
+        HOA_BENCHMARK("Hoa3D::Vector",              Vector3D,           false,  1e-2,   1e-9,   NULL)
+    };
+    
+    //! The options of the command line.
+    struct Options
+    {
+        std::string                 filter;
+        unsigned int                order_min;
+        unsigned int                order_max;
+        unsigned int                block_min;
+        unsigned int                block_max;
+        std::vector<unsigned int>   sources;
+        double                      min_time;
+        bool                        check_only;
+    };
+    
+    inline double now()
+    {
+        struct timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return time.tv_sec + time.tv_nsec * 1e-9;
+    }
+    
+    //! A set of planar vectors.
+    template <typename T> class Vectors
+    {
+        T*  m_samples;
+        T** m_vectors;
+    public:
+        Vectors(const unsigned int numberOfVectors)
+        {
+            const unsigned int number = numberOfVectors ? numberOfVectors : 1;
+            m_samples = new T[number * HOA_BENCHMARK_MAX_BLOCK];
+            m_vectors = new T*[number];
+            for(unsigned int i = 0; i < number; i++)
+                m_vectors[i] = m_samples + i * HOA_BENCHMARK_MAX_BLOCK;
+            for(unsigned int i = 0; i < number * HOA_BENCHMARK_MAX_BLOCK; i++)
+                m_samples[i] = 0;
+        }
+        ~Vectors()
+        {
+            delete [] m_samples;
+            delete [] m_vectors;
+        }
+        inline T** get() const
+        {
+            return m_vectors;
+        };
+        inline T* getSamples() const
+        {
+            return m_samples;
+        };
+    };
+    
+    //! The deterministic test signal, a sine with a frequency and a phase that depend on the vector.
+    template <typename T> void fillSignals(Vectors<T>& vectors, const unsigned int numberOfVectors)
+    {
+        for(unsigned int i = 0; i < numberOfVectors; i++)
+        {
+            for(unsigned int k = 0; k < HOA_BENCHMARK_MAX_BLOCK; k++)
+                vectors.get()[i][k] = 0.5 * sin(0.01 * (i + 1) * k + i);
+        }
+    }
+    
+    //! Compare the block processing with the scalar processing of a new case.
+    /** The error is the greatest absolute difference divided by the greatest absolute value of the scalar outputs or 1 if the outputs are smaller.
+     */
+    template <typename T> double check(Case<T>* block, const unsigned int vectorSize)
+    {
+        Vectors<T> inputs(block->getNumberOfInputs());
+        Vectors<T> outputs_block(block->getNumberOfOutputs());
+        Vectors<T> outputs_scalar(block->getNumberOfOutputs());
+        fillSignals(inputs, block->getNumberOfInputs());
+        
+        // Two blocks so the state of the first block is used by the second one
+        for(unsigned int offset = 0; offset < 2; offset++)
+        {
+            block->processBlock(inputs.get(), outputs_block.get(), vectorSize);
+            block->processScalar(inputs.get(), outputs_scalar.get(), vectorSize);
+        }
+        
+        double difference = 0., peak = 1.;
+        for(unsigned int i = 0; i < block->getNumberOfOutputs(); i++)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+            {
+                const double value = outputs_scalar.get()[i][k];
+                difference  = std::max(difference, (double)fabs(outputs_block.get()[i][k] - value));
+                peak        = std::max(peak, (double)fabs(value));
+            }
+        }
+        return difference / peak;
+    }
+    
+    //! Measure the block processing.
+    /** The block processing is repeated until the minimum time is elapsed.
+     
+        @return    The time in nanoseconds per sample and per channel.
+     */
+    template <typename T> double measure(Case<T>* block, const unsigned int vectorSize, const double minTime, unsigned long& iterations)
+    {
+        Vectors<T> inputs(block->getNumberOfInputs());
+        Vectors<T> outputs(block->getNumberOfOutputs());
+        fillSignals(inputs, block->getNumberOfInputs());
+        block->processBlock(inputs.get(), outputs.get(), vectorSize);
+        
+        iterations = 0;
+        unsigned long batch = 1;
+        const double start = now();
+        double elapsed = 0.;
+        while(elapsed < minTime)
+        {
+            for(unsigned long i = 0; i < batch; i++)
+                block->processBlock(inputs.get(), outputs.get(), vectorSize);
+            iterations += batch;
+            batch *= 2;
+            elapsed = now() - start;
+        }
+        const unsigned int channels = std::max(block->getNumberOfInputs(), block->getNumberOfOutputs());
+        return elapsed * 1e9 / ((double)iterations * vectorSize * channels);
+    }
+    
+    template <typename T> bool run(const Benchmark& benchmark, Case<T>* (*create)(unsigned int, unsigned int), const char* precision, const unsigned int order, const unsigned int numberOfSources, const unsigned int vectorSize, const Options& options)
+    {
+        char name[256];
+        if(benchmark.sources)
+            sprintf(name, "%s/order:%u/sources:%u/%s/block:%u", benchmark.name, order, numberOfSources, precision, vectorSize);
+        else
+            sprintf(name, "%s/order:%u/%s/block:%u", benchmark.name, order, precision, vectorSize);
+        if(!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos)
+            return true;
+        if(benchmark.memory && benchmark.memory(order, numberOfSources) > HOA_BENCHMARK_MAX_MEMORY)
+        {
+            printf("%-64s skipped, the instances need more than %u MB\n", name, HOA_BENCHMARK_MAX_MEMORY >> 20);
+            return true;
+        }
+        
+        Case<T>* block = create(order, numberOfSources);
+        const double error = check(block, vectorSize);
+        const bool valid = error <= (sizeof(T) == sizeof(float) ? benchmark.tolerance_float : benchmark.tolerance_double);
+        if(options.check_only)
+        {
+            printf("%-64s %12.3e %s\n", name, error, valid ? "ok" : "FAILED");
+        }
+        else
+        {
+            unsigned long iterations;
+            const double time = measure(block, vectorSize, options.min_time, iterations);
+            printf("%-64s %12.4f %12lu %12.3e %s\n", name, time, iterations, error, valid ? "ok" : "FAILED");
+        }
+        delete block;
+        fflush(stdout);
+        return valid;
+    }
+    
+    bool parseRange(const char* value, unsigned int& min, unsigned int& max)
+    {
+        if(sscanf(value, "%u-%u", &min, &max) == 2)
+            return min <= max;
+        if(sscanf(value, "%u", &min) == 1)
+        {
+            max = min;
+            return true;
+        }
+        return false;
+    }
+    
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        options.order_min   = 1;
+        options.order_max   = HOA_MAX_KERNELS_ORDER;
+        options.block_min   = 32;
+        options.block_max   = HOA_BENCHMARK_MAX_BLOCK;
+        options.min_time    = 0.01;
+        options.check_only  = false;
+        
+        const char* sources = "1,16,128";
+        for(int i = 1; i < argc; i++)
+        {
+            const char* argument = argv[i];
+            if(!strncmp(argument, "--filter=", 9))
+                options.filter = argument + 9;
+            else if(!strncmp(argument, "--orders=", 9))
+            {
+                if(!parseRange(argument + 9, options.order_min, options.order_max) || !options.order_min)
+                    return false;
+            }
+            else if(!strncmp(argument, "--blocks=", 9))
+            {
+                if(!parseRange(argument + 9, options.block_min, options.block_max) || !options.block_min || options.block_max > HOA_BENCHMARK_MAX_BLOCK)
+                    return false;
+            }
+            else if(!strncmp(argument, "--sources=", 10))
+                sources = argument + 10;
+            else if(!strncmp(argument, "--min-time=", 11))
+                options.min_time = atof(argument + 11);
+            else if(!strncmp(argument, "--isa=", 6))
+            {
+                bool found = false;
+                for(int isa = IsaGeneric; isa <= IsaNeon && !found; isa++)
+                {
+                    if(!strcmp(argument + 6, getIsaName((Isa)isa)))
+                    {
+                        if(!setSimdIsa((Isa)isa))
+                        {
+                            fprintf(stderr, "The instruction set %s is not supported.\n", argument + 6);
+                            return false;
+                        }
+                        found = true;
+                    }
+                }
+                if(!found)
+                    return false;
+            }
+            else if(!strcmp(argument, "--check"))
+                options.check_only = true;
+            else
+                return false;
+        }
+        
+        for(const char* source = sources; *source; )
+        {
+            char* end;
+            const unsigned long number = strtoul(source, &end, 10);
+            if(end == source || !number)
+                return false;
+            options.sources.push_back(number);
+            source = (*end == ',') ? end + 1 : end;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Hoa::Options options;
+    if(!Hoa::parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "Usage : %s [--filter=name] [--orders=min-max] [--blocks=min-max] [--sources=n,n,...] [--min-time=seconds] [--isa=name] [--check]\n", argv[0]);
+        return 2;
+    }
+    
+    printf("Instruction set : %s\n", Hoa::getIsaName(Hoa::getSimdKernels()->isa));
+    if(options.check_only)
+        printf("%-64s %12s %s\n", "Benchmark", "Error", "Check");
+    else
+        printf("%-64s %12s %12s %12s %s\n", "Benchmark", "ns/sample/ch", "Iterations", "Error", "Check");
+    
+    bool valid = true;
+    const unsigned int number_of_benchmarks = sizeof(Hoa::benchmarks) / sizeof(Hoa::Benchmark);
+    for(unsigned int i = 0; i < number_of_benchmarks; i++)
+    {
+        const Hoa::Benchmark& benchmark = Hoa::benchmarks[i];
+        for(unsigned int order = options.order_min; order <= options.order_max; order++)
+        {
+            const unsigned int number_of_sources = benchmark.sources ? options.sources.size() : 1;
+            for(unsigned int j = 0; j < number_of_sources; j++)
+            {
+                for(unsigned int vectorSize = options.block_min; vectorSize <= options.block_max; vectorSize *= 2)
+                {
+                    valid = Hoa::run(benchmark, benchmark.createFloat, "float", order, options.sources[j], vectorSize, options) && valid;
+                    valid = Hoa::run(benchmark, benchmark.createDouble, "double", order, options.sources[j], vectorSize, options) && valid;
+                }
+            }
+        }
+    }
+    return valid ? 0 : 1;
+}
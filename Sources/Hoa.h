@@ -10,6 +10,7 @@
 namespace Hoa{};
 
 #include "HoaDefs.h"
+#include "HoaSimd.h"
 #include "HoaMath.h"
 #include "HoaUtils.h"
 
@@ -12,6 +12,8 @@ namespace Hoa2D
     {
         m_order					= order;
         m_number_of_harmonics	= m_order * 2 + 1;
+        m_kernels_float         = getKernels<float>(m_order);
+        m_kernels_double        = getKernels<double>(m_order);
         
         m_harmonics_orders   = new long[m_number_of_harmonics];
         m_harmonics_orders[0] = 0;
@@ -8,6 +8,7 @@
 #define DEF_HOA_2D_AMBISONIC
 
 #include "../Hoa.h"
+#include "Kernels.h"
 
 namespace Hoa2D
 {
@@ -21,6 +22,8 @@ namespace Hoa2D
         unsigned int	m_order;
         unsigned int	m_number_of_harmonics;
         long*           m_harmonics_orders;
+        const KernelsTable<float>*  m_kernels_float;
+        const KernelsTable<double>* m_kernels_double;
     
 public:
         //! The ambisonic constructor.
@@ -14,82 +14,170 @@ namespace Hoa2D
     DecoderRegular::DecoderRegular(unsigned int order, unsigned int numberOfChannels) : Ambisonic(order), Planewaves(numberOfChannels)
     {
         assert(numberOfChannels >= m_number_of_harmonics);
-
+        
         m_harmonics_vector          = new double[m_number_of_harmonics];
-        m_decoder_matrix_double     = new double[m_number_of_channels * m_number_of_harmonics];
-        m_decoder_matrix_float      = new float[m_number_of_channels * m_number_of_harmonics];
+        m_matrix                    = new Hoa::MatrixInterpolator(m_number_of_channels, m_number_of_harmonics);
         m_encoder                   = new Encoder(m_order);
         setChannelsOffset(0.);
     }
-
+    
     void DecoderRegular::setChannelsOffset(double offset)
 	{
+        Hoa::Coefficients* matrix = new Hoa::Coefficients(m_number_of_channels * m_number_of_harmonics);
+        double* matrix_double = matrix->getDouble();
         m_offset = wrap_twopi(offset);
         for(unsigned int i = 0; i < m_number_of_channels; i++)
         {
             m_encoder->setAzimuth(m_channels_azimuth[i] + m_offset);
             m_encoder->process(1., m_harmonics_vector);
-
-            m_decoder_matrix_float[i * m_number_of_harmonics] = m_decoder_matrix_double[i * m_number_of_harmonics] = 0.5 / (double)(m_order + 1.);
+            
+            matrix_double[i * m_number_of_harmonics] = 0.5 / (double)(m_order + 1.);
             for(unsigned int j = 1; j < m_number_of_harmonics; j++)
             {
-                m_decoder_matrix_float[i * m_number_of_harmonics + j] = m_decoder_matrix_double[i * m_number_of_harmonics + j] = m_harmonics_vector[j] / (double)(m_order + 1.);
+                matrix_double[i * m_number_of_harmonics + j] = m_harmonics_vector[j] / (double)(m_order + 1.);
             }
         }
+        matrix->update();
+        m_matrix->publish(matrix);
 	}
-
+    
     void DecoderRegular::process(const float* input, float* output)
 	{
-		cblas_sgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1.f, m_decoder_matrix_float, m_number_of_harmonics, (float *)input, 1, 0.f, output, 1);
+		m_matrix->process(input, output);
 	}
-
+	
 	void DecoderRegular::process(const double* input, double* output)
 	{
-		cblas_dgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1.f, m_decoder_matrix_double, m_number_of_harmonics, (double *)input, 1, 0.f, output, 1);
+		m_matrix->process(input, output);
 	}
-
+    
+    void DecoderRegular::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+    
+    void DecoderRegular::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+	
 	DecoderRegular::~DecoderRegular()
 	{
-		delete [] m_decoder_matrix_double;
-        delete [] m_decoder_matrix_float;
+		delete m_matrix;
         delete [] m_harmonics_vector;
         delete m_encoder;
 	}
-
+    
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Decoder Irregular //
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     DecoderIrregular::DecoderIrregular(unsigned int order, unsigned int numberOfChannels) : Ambisonic(order), Planewaves(numberOfChannels)
     {
         m_harmonics_vector          = new double[m_number_of_harmonics];
-        m_decoder_matrix            = new double[m_number_of_channels * m_number_of_harmonics];
-        m_decoder_matrix_float      = new float[m_number_of_channels * m_number_of_harmonics];
+        m_matrix                    = new Hoa::MatrixInterpolator(m_number_of_channels, m_number_of_harmonics);
         m_encoder                   = new Encoder(m_order);
-        m_nearest_channel[0]        = NULL;
-        m_nearest_channel[1]        = NULL;
+        m_matrix_double             = new double[m_number_of_channels * m_number_of_harmonics];
+        m_rows_changed              = new bool[m_number_of_channels];
+        m_virtual_channels          = NULL;
+        m_virtual_factors           = NULL;
+        m_virtual_capacity          = 0;
+        m_number_of_virtual_channels = 0;
         
         m_offset = 0;
         setChannelAzimuth(0, 0.);
     }
-
+    
     void DecoderIrregular::setChannelsOffset(double offset)
 	{
         m_offset = wrap_twopi(offset);
-        setChannelAzimuth(0, m_channels_azimuth[0]);
+        computeMatrix(false);
     }
-
+    
     void DecoderIrregular::setChannelsAzimuth(double* azimuths)
     {
         Planewaves::setChannelsAzimuth(azimuths);
-        setChannelAzimuth(0, m_channels_azimuth[0]);
+        computeMatrix(false);
     }
-
+    
     void DecoderIrregular::setChannelAzimuth(unsigned int index, double azimuth)
     {
-        double  current_distance, minimum_distance;
-
         Planewaves::setChannelAzimuth(index, azimuth);
-
+        computeMatrix(true);
+    }
+    
+    unsigned int DecoderIrregular::getCandidates(const unsigned int next, unsigned int* candidates) const
+    {
+        // The azimuths of the channels are sorted so the nearest channel of an angle between the channels next - 1 and
+        // next is in one of the two groups of channels with the same azimuth around the angle and the second nearest
+        // channel is in one of the four groups around the angle. The ties are resolved by the smallest index like a
+        // linear search, so the two first channels of each group are the candidates.
+        const long size = m_number_of_channels;
+        long groups[4];
+        groups[2] = next % size;
+        groups[3] = groups[2];
+        while(groups[3] < size - 1 && m_channels_azimuth[groups[3] + 1] == m_channels_azimuth[groups[2]])
+            groups[3]++;
+        groups[3] = (groups[3] + 1) % size;
+        for(int i = 1; i >= 0; i--)
+        {
+            groups[i] = (groups[i + 1] + size - 1) % size;
+            while(groups[i] > 0 && m_channels_azimuth[groups[i] - 1] == m_channels_azimuth[groups[i]])
+                groups[i]--;
+        }
+        
+        unsigned int number_of_candidates = 0;
+        for(int i = 0; i < 8; i++)
+        {
+            const unsigned int candidate = (groups[i / 2] + i % 2) % size;
+            if(std::find(candidates, candidates + number_of_candidates, candidate) == candidates + number_of_candidates)
+                candidates[number_of_candidates++] = candidate;
+        }
+        return number_of_candidates;
+    }
+    
+    void DecoderIrregular::getNearestChannels(const double angle, const unsigned int* candidates, const unsigned int numberOfCandidates, unsigned int& index1, unsigned int& index2, double& factor1, double& factor2) const
+    {
+        double distances[8];
+        for(unsigned int i = 0; i < numberOfCandidates; i++)
+            distances[i] = radianClosestDistance(m_channels_azimuth[candidates[i]], angle);
+        
+        double distance1 = HOA_2PI, distance2 = HOA_2PI;
+        index1 = 0;
+        index2 = 0;
+        for(unsigned int i = 0; i < numberOfCandidates; i++)
+        {
+            if(distances[i] < distance1 || (distances[i] == distance1 && candidates[i] < index1))
+            {
+                distance1 = distances[i];
+                index1 = candidates[i];
+            }
+        }
+        for(unsigned int i = 0; i < numberOfCandidates; i++)
+        {
+            if(candidates[i] != index1 && (distances[i] < distance2 || (distances[i] == distance2 && candidates[i] < index2)))
+            {
+                distance2 = distances[i];
+                index2 = candidates[i];
+            }
+        }
+        
+        if(fabs(distance1 - distance2) < HOA_PI / (double)m_number_of_virtual_channels)
+        {
+            const double distance_ratio = distance1 + distance2;
+            factor1   = cos(distance1 / (distance_ratio) * HOA_PI2);
+            factor2   = cos(distance2 / (distance_ratio) * HOA_PI2);
+        }
+        else
+        {
+            factor1   = 1;
+            factor2   = 0;
+        }
+    }
+    
+    void DecoderIrregular::computeMatrix(bool incremental)
+    {
+        double  current_distance, minimum_distance;
+        
         // Get the minimum distance between the channels
         minimum_distance    = HOA_2PI + 1;
         current_distance    = distance_radian(m_channels_azimuth[0], m_channels_azimuth[m_number_of_channels-1]);
@@ -101,166 +189,191 @@ namespace Hoa2D
             if(current_distance < minimum_distance)
                 minimum_distance = current_distance;
         }
-
+        
         // Get the optimal number of virtual channels
         // Always prefer the number of harmonics + 1
+        // A resolution finer than the circle points doesn't change the matrix but costs memory and time
+        unsigned int number_of_virtual_channels;
         if(minimum_distance > 0)
-            m_number_of_virtual_channels = (HOA_2PI / minimum_distance);
+            number_of_virtual_channels = min(HOA_2PI / minimum_distance, (double)NUMBEROFCIRCLEPOINTS);
         else
-            m_number_of_virtual_channels = m_number_of_harmonics + 1;
-        if(m_number_of_virtual_channels < m_number_of_harmonics + 1)
+            number_of_virtual_channels = m_number_of_harmonics + 1;
+        if(number_of_virtual_channels < m_number_of_harmonics + 1)
         {
-            m_number_of_virtual_channels = m_number_of_harmonics + 1;
+            number_of_virtual_channels = m_number_of_harmonics + 1;
         }
         
-        if(m_nearest_channel[0] && m_nearest_channel[1])
+        if(number_of_virtual_channels != m_number_of_virtual_channels)
         {
-            delete [] m_nearest_channel[0];
-            delete [] m_nearest_channel[1];
+            m_number_of_virtual_channels = number_of_virtual_channels;
+            incremental = false;
         }
-        m_nearest_channel[0] = new unsigned int[m_number_of_virtual_channels];
-        m_nearest_channel[1] = new unsigned int[m_number_of_virtual_channels];
-        
-        for(unsigned int i = 0; i < m_number_of_channels * m_number_of_harmonics; i++)
+        if(m_number_of_virtual_channels > m_virtual_capacity)
         {
-            m_decoder_matrix[i] = 0.;
-            m_decoder_matrix_float[i] = 0.;
+            delete [] m_virtual_channels;
+            delete [] m_virtual_factors;
+            m_virtual_capacity  = m_number_of_virtual_channels;
+            m_virtual_channels  = new unsigned int[2 * m_virtual_capacity];
+            m_virtual_factors   = new double[2 * m_virtual_capacity];
         }
-
+        
         if(m_number_of_channels == 1)
         {
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                m_matrix_double[j] = 0.;
             for(unsigned int i = 0; i < m_number_of_virtual_channels; i++)
             {
                 double angle = (double)i / (double)m_number_of_virtual_channels * HOA_2PI;
                 m_encoder->setAzimuth(angle + m_offset);
                 m_encoder->process(1., m_harmonics_vector);
-
-                m_decoder_matrix[0] += (0.5 / (double)(m_order + 1.));
+                
+                m_matrix_double[0] += (0.5 / (double)(m_order + 1.));
                 for(unsigned int j = 1; j < m_number_of_harmonics; j++)
                 {
-                    m_decoder_matrix[j] += (m_harmonics_vector[j] / (double)(m_order + 1.));
+                    m_matrix_double[j] += (m_harmonics_vector[j] / (double)(m_order + 1.));
                 }
             }
-            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            {
-                m_decoder_matrix_float[i] = m_decoder_matrix[i];
-            }
         }
         else if(m_number_of_channels == 2)
         {
+            for(unsigned int j = 0; j < 2 * m_number_of_harmonics; j++)
+                m_matrix_double[j] = 0.;
             for(unsigned int i = 0; i < m_number_of_virtual_channels; i++)
             {
                 double factor_index1 = 0, factor_index2 = 0;
                 double angle = (double)i / (double)m_number_of_virtual_channels * HOA_2PI;
                 m_encoder->setAzimuth(angle + m_offset);
                 m_encoder->process(1., m_harmonics_vector);
-
-                m_decoder_matrix[0] += (0.5 / (double)(m_order + 1.));
-                m_decoder_matrix[m_number_of_harmonics] += (0.5 / (double)(m_order + 1.));
-
+                
+                m_matrix_double[0] += (0.5 / (double)(m_order + 1.));
+                m_matrix_double[m_number_of_harmonics] += (0.5 / (double)(m_order + 1.));
+                
                 factor_index1 = fabs(cos(distance_radian(angle, m_channels_azimuth[0]) / HOA_PI * HOA_PI2));
                 factor_index2 = fabs(cos(distance_radian(angle, m_channels_azimuth[1]) / HOA_PI * HOA_PI2));
                 for(unsigned int j = 1; j < m_number_of_harmonics; j++)
                 {
-                    m_decoder_matrix[j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factor_index1;
-
-                    m_decoder_matrix[m_number_of_harmonics + j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factor_index2;
+                    m_matrix_double[j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factor_index1;
+                    
+                    m_matrix_double[m_number_of_harmonics + j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factor_index2;
                 }
             }
-
-
-            for(unsigned int i = 0; i < m_number_of_channels * m_number_of_harmonics; i++)
-            {
-                m_decoder_matrix_float[i] = m_decoder_matrix[i];
-            }
         }
         else
         {
-            // Get the nearest channels
+            // Get the nearest channels of the virtual channels and mark the channels whose virtual channels have changed
+            // The virtual channels are sorted like the channels so the candidates only change between two channels
+            unsigned int candidates[8];
+            unsigned int number_of_candidates = 0;
+            unsigned int next = 0;
+            for(unsigned int i = 0; i < m_number_of_channels; i++)
+                m_rows_changed[i] = !incremental;
             for(unsigned int i = 0; i < m_number_of_virtual_channels; i++)
             {
-                long   channel_index1 = 0, channel_index2 = 0;
-                double distance1 = HOA_2PI, distance2 = HOA_2PI;
+                unsigned int channel_index1, channel_index2;
+                double factor_index1, factor_index2;
                 double angle = (double)i / (double)m_number_of_virtual_channels * HOA_2PI;
-                double factor_index1 = 0, factor_index2 = 0;
-                
-                for(unsigned int j = 0; j < m_number_of_channels; j++)
+                if(!number_of_candidates || (next < m_number_of_channels && m_channels_azimuth[next] < angle))
                 {
-                    if(radianClosestDistance(m_channels_azimuth[j], angle) < distance1)
-                    {
-                        distance1 = radianClosestDistance(m_channels_azimuth[j], angle);
-                        channel_index1 = j;
-                    }
+                    next = std::lower_bound(m_channels_azimuth + next, m_channels_azimuth + m_number_of_channels, angle) - m_channels_azimuth;
+                    number_of_candidates = getCandidates(next, candidates);
                 }
+                getNearestChannels(angle, candidates, number_of_candidates, channel_index1, channel_index2, factor_index1, factor_index2);
                 
-                for(unsigned int j = 0; j < m_number_of_channels; j++)
+                unsigned int* channels  = m_virtual_channels + 2 * i;
+                double* factors         = m_virtual_factors + 2 * i;
+                if(!incremental || channels[0] != channel_index1 || channels[1] != channel_index2 || factors[0] != factor_index1 || factors[1] != factor_index2)
                 {
-                    if(radianClosestDistance(m_channels_azimuth[j], angle) < distance2 && j != channel_index1)
+                    if(incremental)
                     {
-                        distance2 = radianClosestDistance(m_channels_azimuth[j], angle);
-                        channel_index2 = j;
+                        m_rows_changed[channels[0]] = true;
+                        m_rows_changed[channels[1]] = true;
+                        m_rows_changed[channel_index1] = true;
+                        m_rows_changed[channel_index2] = true;
                     }
+                    channels[0] = channel_index1;
+                    channels[1] = channel_index2;
+                    factors[0]  = factor_index1;
+                    factors[1]  = factor_index2;
                 }
-                
-                if(fabs(distance1 - distance2) < HOA_PI / (double)m_number_of_virtual_channels)
-                {
-                    double angle1 = m_channels_azimuth[channel_index1], angle2 = m_channels_azimuth[channel_index2];
-                    double distance_index1 = radianClosestDistance(angle, angle1);
-                    double distance_index2 = radianClosestDistance(angle, angle2);
-                    double distance_ratio = distance_index1 + distance_index2;
-                    factor_index1   = cos(distance_index1 / (distance_ratio) * HOA_PI2);
-                    factor_index2   = cos(distance_index2 / (distance_ratio) * HOA_PI2);
-                }
-                else
+            }
+            
+            // Recompute the rows of the changed channels in the order of the virtual channels
+            for(unsigned int i = 0; i < m_number_of_channels; i++)
+            {
+                if(m_rows_changed[i])
                 {
-                    factor_index1   = 1;
-                    factor_index2   = 0;
+                    for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                        m_matrix_double[i * m_number_of_harmonics + j] = 0.;
                 }
+            }
+            for(unsigned int i = 0; i < m_number_of_virtual_channels; i++)
+            {
+                const unsigned int* channels  = m_virtual_channels + 2 * i;
+                const double* factors         = m_virtual_factors + 2 * i;
+                if(!m_rows_changed[channels[0]] && !m_rows_changed[channels[1]])
+                    continue;
                 
                 // Get the harmonics coefficients for the virtual channel
+                double angle = (double)i / (double)m_number_of_virtual_channels * HOA_2PI;
                 m_encoder->setAzimuth(angle + m_offset);
                 m_encoder->process(1., m_harmonics_vector);
                 
-                m_decoder_matrix[channel_index1 * m_number_of_harmonics] += (0.5 / (double)(m_order + 1.)) * factor_index1;
-                m_decoder_matrix[channel_index2 * m_number_of_harmonics] += (0.5 / (double)(m_order + 1.)) * factor_index2;
-                for(unsigned int j = 1; j < m_number_of_harmonics; j++)
+                for(unsigned int k = 0; k < 2; k++)
                 {
-                    m_decoder_matrix[channel_index1 * m_number_of_harmonics + j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factor_index1;
-                    m_decoder_matrix[channel_index2 * m_number_of_harmonics + j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factor_index2;
+                    if(m_rows_changed[channels[k]])
+                    {
+                        double* row = m_matrix_double + channels[k] * m_number_of_harmonics;
+                        row[0] += (0.5 / (double)(m_order + 1.)) * factors[k];
+                        for(unsigned int j = 1; j < m_number_of_harmonics; j++)
+                        {
+                            row[j] += (m_harmonics_vector[j] / (double)(m_order + 1.)) * factors[k];
+                        }
+                    }
                 }
             }
-
-            for(unsigned int i = 0; i < m_number_of_channels * m_number_of_harmonics; i++)
-            {
-                m_decoder_matrix_float[i] = m_decoder_matrix[i];
-            }
         }
+        
+        Hoa::Coefficients* matrix = new Hoa::Coefficients(m_number_of_channels * m_number_of_harmonics);
+        memcpy(matrix->getDouble(), m_matrix_double, m_number_of_channels * m_number_of_harmonics * sizeof(double));
+        matrix->update();
+        m_matrix->publish(matrix);
     }
-
+    
     void DecoderIrregular::process(const float* input, float* output)
 	{
-		cblas_sgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1.f, m_decoder_matrix_float, m_number_of_harmonics, input, 1, 0.f, output, 1);
+		m_matrix->process(input, output);
 	}
-
+	
 	void DecoderIrregular::process(const double* input, double* output)
 	{
-		cblas_dgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1.f, m_decoder_matrix, m_number_of_harmonics, input, 1, 0.f, output, 1);
+		m_matrix->process(input, output);
 	}
-
+    
+    void DecoderIrregular::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+    
+    void DecoderIrregular::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+	
 	DecoderIrregular::~DecoderIrregular()
 	{
-		delete [] m_decoder_matrix;
-        delete [] m_decoder_matrix_float;
+		delete m_matrix;
         delete [] m_harmonics_vector;
-        delete [] m_nearest_channel[0];
-        delete [] m_nearest_channel[1];
         delete m_encoder;
+        delete [] m_matrix_double;
+        delete [] m_rows_changed;
+        delete [] m_virtual_channels;
+        delete [] m_virtual_factors;
 	}
-
+    
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Decoder Binaural //
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
+    
     DecoderBinaural::DecoderBinaural(unsigned int order) : Ambisonic(order), Planewaves(2)
     {
         m_channels_azimuth[0] = HOA_PI2;
@@ -275,13 +388,106 @@ namespace Hoa2D
         m_pinna_size = Small;
         m_outputs_double    = new double[m_decoder->getNumberOfChannels()];
         m_outputs_float     = new float[m_decoder->getNumberOfChannels()];
+        m_inputs_double     = new double[m_number_of_harmonics];
+        m_inputs_float      = new float[m_number_of_harmonics];
+        m_binaural_filters  = new Hoa::Exchanger<Hoa::BinauralFilters>(new Hoa::BinauralFilters(NULL));
     }
-
+    
+    void DecoderBinaural::setImpulses(const float* const* left, const float* const* right, const unsigned int size)
+    {
+        if(!left || !right || !size)
+        {
+            m_binaural_filters->publish(new Hoa::BinauralFilters(NULL));
+            return;
+        }
+        
+        const unsigned int number_of_channels = m_decoder->getNumberOfChannels();
+        const double* matrix = m_decoder->getDecodingMatrix();
+        float* impulses = new float[2 * m_number_of_harmonics * size];
+        const float** impulses_vectors = new const float*[2 * m_number_of_harmonics];
+        for(unsigned int i = 0; i < 2 * m_number_of_harmonics * size; i++)
+            impulses[i] = 0.f;
+        
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            float* impulse_left     = impulses + i * size;
+            float* impulse_right    = impulses + (m_number_of_harmonics + i) * size;
+            for(unsigned int j = 0; j < number_of_channels; j++)
+            {
+                const float gain = matrix[j * m_number_of_harmonics + i];
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    impulse_left[k]     += gain * left[j][k];
+                    impulse_right[k]    += gain * right[j][k];
+                }
+            }
+            impulses_vectors[i]                         = impulse_left;
+            impulses_vectors[m_number_of_harmonics + i] = impulse_right;
+        }
+        
+        Hoa::Convolver* convolver = new Hoa::Convolver(m_number_of_harmonics, 2, NUMBEROFCHUNKPOINTS);
+        convolver->setImpulses(impulses_vectors, size);
+        m_binaural_filters->publish(new Hoa::BinauralFilters(convolver));
+        delete [] impulses;
+        delete [] impulses_vectors;
+    }
+    
+    bool DecoderBinaural::loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory)
+    {
+        Hoa::HrirSet set;
+        if(!set.read(path) || sampleRate <= 0.)
+            return false;
+        
+        Hoa::BinauralCache::Key key;
+        key.hash            = set.getHash();
+        key.dimension       = 2;
+        key.order           = m_order;
+        key.sampleRate      = (unsigned int)(sampleRate + 0.5);
+        key.partitionSize   = NUMBEROFCHUNKPOINTS;
+        const std::string cache_path = cacheDirectory.empty() ? "" : Hoa::BinauralCache::getPath(cacheDirectory, key);
+        if(!cache_path.empty())
+        {
+            Hoa::BinauralCache* cache = new Hoa::BinauralCache();
+            if(cache->map(cache_path, key, m_number_of_harmonics, 2))
+            {
+                Hoa::Convolver* convolver = new Hoa::Convolver(m_number_of_harmonics, 2, NUMBEROFCHUNKPOINTS);
+                convolver->setImpulses(cache->getHeads(), cache->getImpulsesReal(), cache->getImpulsesImag(), cache->getNumberOfPartitions());
+                m_binaural_filters->publish(new Hoa::BinauralFilters(convolver, cache));
+                return true;
+            }
+            delete cache;
+        }
+        
+        if(!set.decode())
+            return false;
+        const unsigned int number_of_channels = m_decoder->getNumberOfChannels();
+        const unsigned int size = set.getSize(sampleRate);
+        float* impulses = new float[number_of_channels * size * 2];
+        const float** left  = new const float*[number_of_channels];
+        const float** right = new const float*[number_of_channels];
+        for(unsigned int i = 0; i < number_of_channels; i++)
+        {
+            const unsigned int index = set.getClosestDirection(m_decoder->getChannelAzimuth(i), 0.);
+            left[i]     = impulses + i * size * 2;
+            right[i]    = impulses + i * size * 2 + size;
+            set.getImpulse(index, false, sampleRate, impulses + i * size * 2);
+            set.getImpulse(index, true, sampleRate, impulses + i * size * 2 + size);
+        }
+        setImpulses(left, right, size);
+        delete [] impulses;
+        delete [] left;
+        delete [] right;
+        
+        if(!cache_path.empty())
+            Hoa::BinauralCache::write(cache_path, key, *m_binaural_filters->getLatest()->getConvolver());
+        return true;
+    }
+    
     void DecoderBinaural::setPinnaSize(PinnaSize pinnaSize)
     {
         m_pinna_size = pinnaSize;
     }
-
+    
     void DecoderBinaural::setSampleRate(double sampleRate)
     {
         if (m_sampleRate != sampleRate)
@@ -307,9 +513,15 @@ namespace Hoa2D
         }
         */
     }
-
+    
     void DecoderBinaural::process(const float* inputs, float* outputs)
 	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs);
+            return;
+        }
         outputs[0] = 0.f;
         outputs[1] = 0.f;
         m_decoder->process(inputs, m_outputs_float);
@@ -319,9 +531,15 @@ namespace Hoa2D
             outputs[1] += m_filters_right[i].process(m_outputs_float[i]);
         }
     }
-
+    
     void DecoderBinaural::process(const double* inputs, double* outputs)
 	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs);
+            return;
+        }
         outputs[0] = 0.f;
         outputs[1] = 0.f;
         m_decoder->process(inputs, m_outputs_double);
@@ -331,89 +549,145 @@ namespace Hoa2D
             outputs[1] += m_filters_right[i].process(m_outputs_double[i]);
         }
     }
-
+    
+    void DecoderBinaural::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs, vectorSize);
+            return;
+        }
+        float frame[2];
+        for(unsigned int k = 0; k < vectorSize; k++)
+        {
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                m_inputs_float[i] = inputs[i][k];
+            process(m_inputs_float, frame);
+            outputs[0][k] = frame[0];
+            outputs[1][k] = frame[1];
+        }
+    }
+    
+    void DecoderBinaural::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs, vectorSize);
+            return;
+        }
+        double frame[2];
+        for(unsigned int k = 0; k < vectorSize; k++)
+        {
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                m_inputs_double[i] = inputs[i][k];
+            process(m_inputs_double, frame);
+            outputs[0][k] = frame[0];
+            outputs[1][k] = frame[1];
+        }
+    }
+	
 	DecoderBinaural::~DecoderBinaural()
 	{
+        delete m_binaural_filters;
         delete m_decoder;
         m_filters_left.clear();
         m_filters_right.clear();
         delete [] m_outputs_double;
         delete [] m_outputs_float;
+        delete [] m_inputs_double;
+        delete [] m_inputs_float;
 	}
-
+    
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Decoder Multi //
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
+    
     DecoderMulti::DecoderMulti(unsigned int order) : Ambisonic(order), Planewaves(order * 2 + 2)
     {
         m_mode = Regular;
-        m_decoder_regular   = new DecoderRegular(m_order, m_order * 2 + 2);
-        m_decoder_irregular = new DecoderIrregular(m_order, m_order * 2 + 2);
+        m_decoder_regular   = new Hoa::Exchanger<DecoderRegular>(new DecoderRegular(m_order, m_order * 2 + 2));
+        m_decoder_irregular = new Hoa::Exchanger<DecoderIrregular>(new DecoderIrregular(m_order, m_order * 2 + 2));
         m_decoder_binaural  = new DecoderBinaural(m_order);
+        m_ramp_length       = NUMBEROFRAMPPOINTS;
     }
-
+    
     void DecoderMulti::setDecodingMode(Mode mode)
     {
-        m_mode = mode;
+        Hoa::atomic_store(&m_mode, mode);
     }
-
+    
     void DecoderMulti::setNumberOfChannels(unsigned int numberOfChannels)
     {
         if(numberOfChannels != getNumberOfChannels())
         {
-            if(m_mode == Regular && numberOfChannels >= m_decoder_regular->getNumberOfHarmonics())
+            if(m_mode == Regular && numberOfChannels >= m_decoder_regular->getLatest()->getNumberOfHarmonics())
             {
-                delete m_decoder_regular;
-                m_decoder_regular = new DecoderRegular(m_order, numberOfChannels);
+                DecoderRegular* decoder = new DecoderRegular(m_order, numberOfChannels);
+                decoder->setRampLength(m_ramp_length);
+                m_decoder_regular->publish(decoder);
             }
             else if(m_mode == Irregular)
             {
-                delete m_decoder_irregular;
-                m_decoder_irregular = new DecoderIrregular(m_order, numberOfChannels);
+                DecoderIrregular* decoder = new DecoderIrregular(m_order, numberOfChannels);
+                decoder->setRampLength(m_ramp_length);
+                m_decoder_irregular->publish(decoder);
             }
         }
     }
-
+    
+    void DecoderMulti::setRampLength(unsigned int numberOfSamples)
+    {
+        m_ramp_length = numberOfSamples;
+        m_decoder_regular->getLatest()->setRampLength(m_ramp_length);
+        m_decoder_irregular->getLatest()->setRampLength(m_ramp_length);
+    }
+    
     void DecoderMulti::setChannelsOffset(double offset)
 	{
         if(m_mode == Regular)
         {
-            m_decoder_regular->setChannelsOffset(offset);
+            m_decoder_regular->getLatest()->setChannelsOffset(offset);
         }
         else if(m_mode == Irregular)
         {
-            m_decoder_irregular->setChannelsOffset(offset);
+            m_decoder_irregular->getLatest()->setChannelsOffset(offset);
         }
 	}
-
+    
     void DecoderMulti::setChannelAzimuth(unsigned int index, double azimuth)
     {
         if(m_mode == Irregular)
         {
-            m_decoder_irregular->setChannelAzimuth(index, azimuth);
+            m_decoder_irregular->getLatest()->setChannelAzimuth(index, azimuth);
         }
     }
-
+    
     void DecoderMulti::setChannelsAzimuth(double* azimuths)
     {
         if(m_mode == Irregular)
         {
-            m_decoder_irregular->setChannelsAzimuth(azimuths);
+            m_decoder_irregular->getLatest()->setChannelsAzimuth(azimuths);
         }
     }
-
+    
     void DecoderMulti::setPinnaSize(DecoderBinaural::PinnaSize pinnaSize)
     {
         m_decoder_binaural->setPinnaSize(pinnaSize);
     }
-
+    
+    bool DecoderMulti::loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory)
+    {
+        return m_decoder_binaural->loadImpulses(path, sampleRate, cacheDirectory);
+    }
+    
     void DecoderMulti::setSampleRate(double sampleRate)
     {
         m_decoder_binaural->setSampleRate(sampleRate);
         m_sample_rate = sampleRate;
     }
-
+	
 	DecoderMulti::~DecoderMulti()
 	{
         delete m_decoder_regular;
@@ -11,22 +11,24 @@
 #include "Planewaves.h"
 #include "Encoder.h"
 #include "Rotate.h"
+#include "../HoaCommon/HrirSet.h"
+#include "../HoaCommon/BinauralCache.h"
+#include "../HoaCommon/MatrixInterpolator.h"
 
 namespace Hoa2D
 {
     //! The ambisonic regular decoder.
-    /** The regular decoder should be used to decode an ambisonic sound field for a set a channels at equal distances on a circle depending on a decomposition order. The number of channels must be at least the number of harmonics. Note that you can only change the offset of the channels.
+    /** The regular decoder should be used to decode an ambisonic sound field for a set a channels at equal distances on a circle depending on a decomposition order. The number of channels must be at least the number of harmonics. Note that you can only change the offset of the channels. The decoding matrix is computed by the control thread in a new buffer and published to the audio thread with an atomic swap, so the offset can be changed while processing. The decoder interpolates from the previous matrix to the new one over a number of samples so the changes don't click.
      */
     class DecoderRegular : public Ambisonic, public Planewaves
     {
-        
+    
     private:
         double          m_offset;
-        double*         m_decoder_matrix_double;
-        float*          m_decoder_matrix_float;
+        Hoa::MatrixInterpolator* m_matrix;
 		double*         m_harmonics_vector;
         Encoder*        m_encoder;
-        
+    
     public:
         
         //! The regular decoder constructor.
@@ -36,7 +38,7 @@ namespace Hoa2D
             @param     numberOfChannels     The number of channels.
          */
 		DecoderRegular(unsigned int order, unsigned int numberOfChannels);
-		
+        
         //! The regular decoder destructor.
         /**	The regular decoder destructor free the memory.
          */
@@ -58,7 +60,34 @@ namespace Hoa2D
         {
             return m_offset;
         }
-				
+        
+        //! Retrieve the decoding matrix.
+        /**	Retrieve the last decoding matrix computed by the control thread, the matrix contains one row of harmonics for each channel. This method must only be called by the control thread.
+         
+            @return    The decoding matrix.
+         */
+        inline const double* getDecodingMatrix() const
+        {
+            return m_matrix->getLatest()->getDouble();
+        };
+        
+        //! Set the length of the interpolation of the decoding matrix.
+        /**	Set the number of samples of the interpolation from the previous decoding matrix to the new one when the channels change, 0 means that the new matrix is used immediately. The default length is NUMBEROFRAMPPOINTS samples.
+         
+            @param     numberOfSamples  The number of samples of the interpolation.
+         */
+        inline void setRampLength(unsigned int numberOfSamples)
+        {
+            m_matrix->setRampLength(numberOfSamples);
+        };
+        
+        /**	Retrieve the number of samples of the interpolation of the decoding matrix.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return m_matrix->getRampLength();
+        };
+        
         //! This method performs the regular decoding with single precision.
 		/**	You should use this method for in-place or not-in-place processing and performs the regular decoding sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimym size must be the number of channels.
          
@@ -66,7 +95,7 @@ namespace Hoa2D
             @param     outputs The output array that contains samples destinated to channels.
          */
 		void process(const float* input, float* output);
-		
+        
         //! This method performs the regular decoding with double precision.
 		/**	You should use this method for in-place or not-in-place processing and performs the regular decoding sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimym size must be the number of channels.
          
@@ -74,6 +103,24 @@ namespace Hoa2D
             @param     outputs The output array that contains samples destinated to channels.
          */
 		void process(const double* input, double* output);
+        
+        //! This method performs the regular decoding with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the regular decoding on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the regular decoding with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the regular decoding on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
     
     
@@ -85,16 +132,23 @@ namespace Hoa2D
      */
     class DecoderIrregular : public Ambisonic, public Planewaves
     {
-        
+    
     private:
-        double*         m_decoder_matrix;
-        float*          m_decoder_matrix_float;
+        Hoa::MatrixInterpolator* m_matrix;
 		double*         m_harmonics_vector;
         Encoder*        m_encoder;
         double          m_offset;
         unsigned int    m_number_of_virtual_channels;
-        unsigned int*   m_nearest_channel[2];
-        
+        unsigned int    m_virtual_capacity;
+        unsigned int*   m_virtual_channels;
+        double*         m_virtual_factors;
+        double*         m_matrix_double;
+        bool*           m_rows_changed;
+        
+        unsigned int getCandidates(const unsigned int next, unsigned int* candidates) const;
+        void getNearestChannels(const double angle, const unsigned int* candidates, const unsigned int numberOfCandidates, unsigned int& index1, unsigned int& index2, double& factor1, double& factor2) const;
+        void computeMatrix(bool incremental);
+    
     public:
         
         //! The irregular decoder constructor.
@@ -104,7 +158,7 @@ namespace Hoa2D
             @param     numberOfChannels     The number of channels.
          */
 		DecoderIrregular(unsigned int order, unsigned int numberOfChannels);
-		
+        
         //! The irregular decoder destructor.
         /**	The irregular decoder destructor free the memory.
          */
@@ -127,6 +181,23 @@ namespace Hoa2D
             return m_offset;
         }
         
+        //! Set the length of the interpolation of the decoding matrix.
+        /**	Set the number of samples of the interpolation from the previous decoding matrix to the new one when the channels change, 0 means that the new matrix is used immediately. The default length is NUMBEROFRAMPPOINTS samples.
+         
+            @param     numberOfSamples  The number of samples of the interpolation.
+         */
+        inline void setRampLength(unsigned int numberOfSamples)
+        {
+            m_matrix->setRampLength(numberOfSamples);
+        };
+        
+        /**	Retrieve the number of samples of the interpolation of the decoding matrix.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return m_matrix->getRampLength();
+        };
+        
         //! Get the number of virtual channels.
         /**	Retreive the number of virtual channels.
          
@@ -138,7 +209,7 @@ namespace Hoa2D
         }
         
         //! Set the azimuth of a channel.
-        /** Set the azimuth of a channel. The azimuth is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The maximum index must be the number of channel - 1.
+        /** Set the azimuth of a channel. The azimuth is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The maximum index must be the number of channel - 1. The channels are sorted by azimuth, so the index of a channel can change. While the number of virtual channels doesn't change, only the rows of the decoding matrix of the channels whose virtual channels have changed are recomputed, so a channel can be dragged without recomputing the whole matrix.
          
             @param     index		The index of the channel.
             @param     azimuth		The azimuth.
@@ -148,8 +219,8 @@ namespace Hoa2D
         void setChannelAzimuth(unsigned int index, double azimuth);
         
         //! Set the azimtuh of all the channels.
-        /** Set the azimtuh of all the channels. It is more efficient to set all the channels azimuths at the same time because even if only one channel has changed, all the decoding matrix have to be recomputed. The azimuths are in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The azimtuhs array must have a minimum size of the number of channels.
-        
+        /** Set the azimtuh of all the channels. The whole decoding matrix is recomputed. The azimuths are in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The azimtuhs array must have a minimum size of the number of channels.
+         
             @param     azimuths		The azimuths array.
          
             @see    setChannelAzimuth
@@ -163,7 +234,7 @@ namespace Hoa2D
             @param     outputs The output array that contains samples destinated to channels.
          */
 		void process(const float* input, float* output);
-		
+        
         //! This method performs the irregular decoding with double precision.
 		/**	You should use this method for in-place or not-in-place processing and performs the irregular decoding sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimum size must be the number of channels.
          
@@ -171,6 +242,24 @@ namespace Hoa2D
             @param     outputs The output array that contains samples destinated to channels.
          */
 		void process(const double* input, double* output);
+        
+        //! This method performs the irregular decoding with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the irregular decoding on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the irregular decoding with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the irregular decoding on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
     
     //! The ambisonic binaural decoder.
@@ -185,16 +274,19 @@ namespace Hoa2D
             Small       = 0,	/**< Small Pinna Size  */
             Large       = 1,	/**< Large Pinna Size */
         };
-        
+    
     private:        
         
         PinnaSize       m_pinna_size;
         double*         m_outputs_double;
         float*          m_outputs_float;
+        double*         m_inputs_double;
+        float*          m_inputs_float;
         DecoderRegular* m_decoder;
         double          m_sampleRate;
         std::vector<BinauralFilter> m_filters_left;
         std::vector<BinauralFilter> m_filters_right;
+        Hoa::Exchanger<Hoa::BinauralFilters>* m_binaural_filters;
     public:
         
         //! The binaural decoder constructor.
@@ -203,7 +295,7 @@ namespace Hoa2D
             @param     order				The order
          */
 		DecoderBinaural(unsigned int order);
-		
+        
         //! The binaural decoder destructor.
         /**	The binaural decoder destructor free the memory.
          */
@@ -236,6 +328,51 @@ namespace Hoa2D
             return m_pinna_size;
         };
         
+        //! Set the head related impulse responses.
+        /** Set the head related impulse responses of the virtual channels and use the convolution in the circular harmonics domain instead of the filters. The left and right arrays contain one impulse response for each virtual channel, at the azimuth of the virtual channel, and their minimum size must be the number of virtual channels. The impulse responses of the virtual channels are decoded once in one impulse response for each circular harmonic and each ear, then the cost of the convolution depends on the number of harmonics and not on the number of virtual channels. The impulse responses are partitioned and transformed in a new convolver that is published to the audio thread without lock, so you should not call this method in the audio thread. A NULL left or right array or a null size removes the impulse responses and restores the filters.
+         
+            @param     left     The impulse responses of the left ear.
+            @param     right    The impulse responses of the right ear.
+            @param     size     The size of the impulse responses.
+         
+            @see    getNumberOfVirtualChannels
+            @see    getVirtualChannelAzimuth
+         */
+        void setImpulses(const float* const* left, const float* const* right, const unsigned int size);
+        
+        //! Load the head related impulse responses of a file.
+        /** Load the head related impulse responses of a file and set the impulse responses of the virtual channels with the impulse responses of the closest directions of the file, resampled to the sample rate. The file must follow the binary layout of the HrirSet class. If a cache directory is given, the impulse responses of the harmonics are read from a cache file identified by the hash of the file, the order, the sample rate and the size of the partitions, and the impulse responses of the file are only converted if the cache file doesn't exist. The cache file is mapped in memory and shared with all the other decoders that use it, it is published to the audio thread with the convolver and unmapped once the audio thread released it, otherwise the impulse responses are computed and the cache file is written for the next decoders. You should not call this method in the audio thread.
+         
+            @param     path             The path of the file.
+            @param     sampleRate       The sample rate.
+            @param     cacheDirectory   The directory of the cache files or an empty string to not use the cache.
+            @return    True if the impulse responses have been loaded.
+         
+            @see    setImpulses
+         */
+        bool loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory = "");
+        
+        //! Retrieve the number of virtual channels.
+        /** Retrieve the number of virtual channels used to decode the impulse responses.
+         
+            @return    The number of virtual channels.
+         */
+        inline unsigned int getNumberOfVirtualChannels() const
+        {
+            return m_decoder->getNumberOfChannels();
+        };
+        
+        //! Retrieve the azimuth of a virtual channel.
+        /** Retrieve the azimuth in radian of a virtual channel, the impulse responses of the virtual channel must be measured at this azimuth.
+         
+            @param     index	The index of the virtual channel.
+            @return    The azimuth of the virtual channel.
+         */
+        inline double getVirtualChannelAzimuth(unsigned int index) const
+        {
+            return m_decoder->getChannelAzimuth(index);
+        };
+        
         //! Retrieve a name for a channel.
         /** Retrieve a name for a channel in a std::string format that will be "Headphone Left" or "Headphone Right".
          
@@ -253,25 +390,43 @@ namespace Hoa2D
         };
         
         //! This method performs the binaural decoding with single precision.
-		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2].
+		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2]. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
          
          @param     inputs	The input samples.
          @param     outputs  The output array that contains samples destinated to channels.
          */
 		void process(const float* inputs, float* outputs);
-		
+        
         //! This method performs the binaural decoding with double precision.
-		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2].
+		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2]. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
          
          @param     input    The input samples.
          @param     outputs  The output array that contains samples destinated to channels.
          */
 		void process(const double* inputs, double* outputs);
         
+        //! This method performs the binaural decoding with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the binaural decoding on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains the two headphones vectors. Each vector must contain at least the vector size samples. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the binaural decoding with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the binaural decoding on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains the two headphones vectors. Each vector must contain at least the vector size samples. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+    
     };
     
     //! The ambisonic multi-decoder.
-    /** The multi-decoder is a class that facilitates the use of the three decoder : regular, irregular and binaural.
+    /** The multi-decoder is a class that facilitates the use of the three decoder : regular, irregular and binaural. When the number of channels changes, the new decoder is allocated by the control thread and published to the audio thread with an atomic swap, the previous decoder is freed by the control thread once the audio thread has released it.
      */
     class DecoderMulti : public Ambisonic, public Planewaves
     {
@@ -283,14 +438,15 @@ namespace Hoa2D
             Irregular   = 1,	/**< Irregular Decoding */
             Binaural    = 2     /**< Binaural Decoding  */
         };
-        
+    
     private:
-        DecoderRegular*     m_decoder_regular;
-        DecoderIrregular*   m_decoder_irregular;
+        Hoa::Exchanger<DecoderRegular>*     m_decoder_regular;
+        Hoa::Exchanger<DecoderIrregular>*   m_decoder_irregular;
         DecoderBinaural*    m_decoder_binaural;
         Mode                m_mode;
         unsigned int        m_sample_rate;
-        
+        unsigned int        m_ramp_length;
+    
     public:
         
         //! The multi-decoder constructor.
@@ -299,7 +455,7 @@ namespace Hoa2D
             @param     order				The order
          */
 		DecoderMulti(unsigned int order);
-		
+        
         //! The multi-decoder destructor.
         /**	The multi-decoder destructor free the memory.
          */
@@ -329,6 +485,20 @@ namespace Hoa2D
          */
 		void setNumberOfChannels(unsigned int numberOfChannels);
         
+        //! Set the length of the interpolation of the decoding matrices.
+        /**	Set the number of samples of the interpolation of the decoding matrices of the regular and irregular decoding when the channels change, 0 means that the new matrices are used immediately.
+         
+            @param     numberOfSamples  The number of samples of the interpolation.
+         */
+        void setRampLength(unsigned int numberOfSamples);
+        
+        /**	Retrieve the number of samples of the interpolation of the decoding matrices.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return m_ramp_length;
+        };
+        
         //! Retrieve the number of channels.
 		/** Retrieve the number of channels of the planewave class.
          
@@ -337,9 +507,9 @@ namespace Hoa2D
 		inline unsigned int getNumberOfChannels() const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getNumberOfChannels();
+                return m_decoder_regular->getLatest()->getNumberOfChannels();
             else if(m_mode == Irregular)
-                return m_decoder_irregular->getNumberOfChannels();
+                return m_decoder_irregular->getLatest()->getNumberOfChannels();
             else
                 return m_decoder_binaural->getNumberOfChannels();
         }
@@ -352,7 +522,7 @@ namespace Hoa2D
 		unsigned int getNumberOfVirutalChannels() const
         {
             if(m_mode == Irregular)
-                return m_decoder_irregular->getNumberOfVirutalChannels();
+                return m_decoder_irregular->getLatest()->getNumberOfVirutalChannels();
             else
                 return 0;
         }
@@ -372,9 +542,9 @@ namespace Hoa2D
 		double getChannelsOffset() const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelsOffset();
+                return m_decoder_regular->getLatest()->getChannelsOffset();
             else if(m_mode == Irregular)
-                return m_decoder_irregular->getChannelsOffset();
+                return m_decoder_irregular->getLatest()->getChannelsOffset();
             else
                 return 0;
         }
@@ -416,6 +586,18 @@ namespace Hoa2D
          */
         void setPinnaSize(DecoderBinaural::PinnaSize pinnaSize);
         
+        //! Load the head related impulse responses of the binaural decoding.
+        /** Load the head related impulse responses of a file for the binaural decoding, you should not call this method in the audio thread.
+         
+            @param     path             The path of the file.
+            @param     sampleRate       The sample rate.
+            @param     cacheDirectory   The directory of the cache files or an empty string to not use the cache.
+            @return    True if the impulse responses have been loaded.
+         
+            @see    DecoderBinaural::loadImpulses
+         */
+        bool loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory = "");
+        
         //! Retrieve if the pinna size of the binaural decoder.
         /** Retrieve if the pinna size of the binaural decoder.
          
@@ -439,9 +621,9 @@ namespace Hoa2D
 		inline double getChannelAzimuth(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelAzimuth(index);
+                return m_decoder_regular->getLatest()->getChannelAzimuth(index);
             else if(m_mode == Irregular)
-                return m_decoder_irregular->getChannelAzimuth(index);
+                return m_decoder_irregular->getLatest()->getChannelAzimuth(index);
             else
                 return m_decoder_binaural->getChannelAzimuth(index);
         }
@@ -459,13 +641,13 @@ namespace Hoa2D
 		inline double getChannelAbscissa(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelAbscissa(index);
+                return m_decoder_regular->getLatest()->getChannelAbscissa(index);
             else if(m_mode == Irregular)
-                return m_decoder_irregular->getChannelAbscissa(index);
+                return m_decoder_irregular->getLatest()->getChannelAbscissa(index);
             else
                 return m_decoder_binaural->getChannelAbscissa(index);
         }
-		
+        
         //! Retrieve the ordinate of a channel.
 		/** Retrieve the ordinate of a channel. The ordinate is between -1 and 1, -1 is the back of the soundfield, 0 is the center of the soundfield and 1 is the front of the soundfield. The maximum index must be the number of channels - 1.
          
@@ -479,9 +661,9 @@ namespace Hoa2D
 		inline double getChannelOrdinate(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelOrdinate(index);
+                return m_decoder_regular->getLatest()->getChannelOrdinate(index);
             else if(m_mode == Irregular)
-                return m_decoder_irregular->getChannelOrdinate(index);
+                return m_decoder_irregular->getLatest()->getChannelOrdinate(index);
             else
                 return m_decoder_binaural->getChannelOrdinate(index);
         }
@@ -496,9 +678,9 @@ namespace Hoa2D
 		inline std::string getChannelName(unsigned int index)
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelName(index);
+                return m_decoder_regular->getLatest()->getChannelName(index);
             else if(m_mode == Irregular)
-                return m_decoder_irregular->getChannelName(index);
+                return m_decoder_irregular->getLatest()->getChannelName(index);
             else
                 return m_decoder_binaural->getChannelName(index);
         };
@@ -511,10 +693,11 @@ namespace Hoa2D
          */
 		inline void process(const float* inputs, float* outputs)
         {
-            if(m_mode == Regular)
-                return m_decoder_regular->process(inputs, outputs);
-            else if(m_mode == Irregular)
-                return m_decoder_irregular->process(inputs, outputs);
+            const Mode mode = Hoa::atomic_load(&m_mode);
+            if(mode == Regular)
+                return m_decoder_regular->acquire()->process(inputs, outputs);
+            else if(mode == Irregular)
+                return m_decoder_irregular->acquire()->process(inputs, outputs);
             else
                 return m_decoder_binaural->process(inputs, outputs);
         }
@@ -527,13 +710,52 @@ namespace Hoa2D
          */
 		inline void process(const double* inputs, double* outputs)
         {
-            if(m_mode == Regular)
-                return m_decoder_regular->process(inputs, outputs);
-            else if(m_mode == Irregular)
-                return m_decoder_irregular->process(inputs, outputs);
+            const Mode mode = Hoa::atomic_load(&m_mode);
+            if(mode == Regular)
+                return m_decoder_regular->acquire()->process(inputs, outputs);
+            else if(mode == Irregular)
+                return m_decoder_irregular->acquire()->process(inputs, outputs);
             else
                 return m_decoder_binaural->process(inputs, outputs);
         }
+        
+        
+        //! This method performs the decoding depending of the mode with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the decoding depending of the mode on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        inline void process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+        {
+            const Mode mode = Hoa::atomic_load(&m_mode);
+            if(mode == Regular)
+                return m_decoder_regular->acquire()->process(inputs, outputs, vectorSize);
+            else if(mode == Irregular)
+                return m_decoder_irregular->acquire()->process(inputs, outputs, vectorSize);
+            else
+                return m_decoder_binaural->process(inputs, outputs, vectorSize);
+        }
+        
+        
+        //! This method performs the decoding depending of the mode with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the decoding depending of the mode on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        inline void process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+        {
+            const Mode mode = Hoa::atomic_load(&m_mode);
+            if(mode == Regular)
+                return m_decoder_regular->acquire()->process(inputs, outputs, vectorSize);
+            else if(mode == Irregular)
+                return m_decoder_irregular->acquire()->process(inputs, outputs, vectorSize);
+            else
+                return m_decoder_binaural->process(inputs, outputs, vectorSize);
+        }
     };
 }
 
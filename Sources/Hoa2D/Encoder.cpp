@@ -22,34 +22,100 @@ namespace Hoa2D
     
     void Encoder::process(const float input, float* outputs)
     {
-        float cos_x = m_cosx;
-        float sin_x = m_sinx;
-        float tcos_x = cos_x;
-        outputs[0] = input;
-        for(unsigned int i = 1; i < m_number_of_harmonics; i += 2)
+        if(m_kernels_float)
+            m_kernels_float->encode(input, m_cosx, m_sinx, outputs);
+        else
+            encode_vectors<float>(m_number_of_harmonics, m_cosx, m_sinx, &input, Frame<float>(outputs), 1);
+    }
+    
+    void Encoder::process(const double input, double* outputs)
+    {
+        if(m_kernels_double)
+            m_kernels_double->encode(input, m_cosx, m_sinx, outputs);
+        else
+            encode_vectors<double>(m_number_of_harmonics, m_cosx, m_sinx, &input, Frame<double>(outputs), 1);
+    }
+    
+    void Encoder::process(const float* input, float** outputs, const unsigned int vectorSize)
+    {
+        encode_vectors<float>(m_number_of_harmonics, m_cosx, m_sinx, input, outputs, vectorSize);
+    }
+    
+    void Encoder::process(const double* input, double** outputs, const unsigned int vectorSize)
+    {
+        encode_vectors<double>(m_number_of_harmonics, m_cosx, m_sinx, input, outputs, vectorSize);
+    }
+    
+    void Encoder::process(const float* input, const float* azimuths, float** outputs, const unsigned int vectorSize)
+    {
+        float cos_b[NUMBEROFCHUNKPOINTS];
+        float sin_b[NUMBEROFCHUNKPOINTS];
+        float cos_x[NUMBEROFCHUNKPOINTS];
+        float sin_x[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
         {
-            outputs[i] = input * sin_x;
-            outputs[i+1] = input * cos_x;
-            cos_x = tcos_x * m_cosx - sin_x * m_sinx; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-            sin_x = tcos_x * m_sinx + sin_x * m_cosx; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-            tcos_x = cos_x;
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            const float* in = input + offset;
+            vector_sincos(azimuths + offset, sin_b, cos_b, size);
+            for(unsigned int j = 0; j < size; j++)
+            {
+                cos_x[j] = cos_b[j];
+                sin_x[j] = sin_b[j];
+            }
+            for(unsigned int i = 1; i < m_number_of_harmonics; i += 2)
+            {
+                float* out_sin = outputs[i] + offset;
+                float* out_cos = outputs[i+1] + offset;
+                for(unsigned int j = 0; j < size; j++)
+                {
+                    out_sin[j] = in[j] * sin_x[j];
+                    out_cos[j] = in[j] * cos_x[j];
+                    const float tcos_x = cos_x[j];
+                    cos_x[j] = tcos_x * cos_b[j] - sin_x[j] * sin_b[j]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                    sin_x[j] = tcos_x * sin_b[j] + sin_x[j] * cos_b[j]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+                }
+            }
         }
+        if(outputs[0] != input)
+            cblas_scopy(vectorSize, input, 1, outputs[0], 1);
+        if(vectorSize)
+            setAzimuth(azimuths[vectorSize - 1]);
     }
     
-    void Encoder::process(const double input, double* outputs)
+    void Encoder::process(const double* input, const double* azimuths, double** outputs, const unsigned int vectorSize)
     {
-        double cos_x = m_cosx;
-        double sin_x = m_sinx;
-        double tcos_x = cos_x;
-        outputs[0] = input;
-        for(unsigned int i = 1; i < m_number_of_harmonics; i += 2)
+        double cos_b[NUMBEROFCHUNKPOINTS];
+        double sin_b[NUMBEROFCHUNKPOINTS];
+        double cos_x[NUMBEROFCHUNKPOINTS];
+        double sin_x[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
         {
-            outputs[i] = input * sin_x;
-            outputs[i+1] = input * cos_x;
-            cos_x = tcos_x * m_cosx - sin_x * m_sinx; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-            sin_x = tcos_x * m_sinx + sin_x * m_cosx; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-            tcos_x = cos_x;
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            const double* in = input + offset;
+            vector_sincos(azimuths + offset, sin_b, cos_b, size);
+            for(unsigned int j = 0; j < size; j++)
+            {
+                cos_x[j] = cos_b[j];
+                sin_x[j] = sin_b[j];
+            }
+            for(unsigned int i = 1; i < m_number_of_harmonics; i += 2)
+            {
+                double* out_sin = outputs[i] + offset;
+                double* out_cos = outputs[i+1] + offset;
+                for(unsigned int j = 0; j < size; j++)
+                {
+                    out_sin[j] = in[j] * sin_x[j];
+                    out_cos[j] = in[j] * cos_x[j];
+                    const double tcos_x = cos_x[j];
+                    cos_x[j] = tcos_x * cos_b[j] - sin_x[j] * sin_b[j]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                    sin_x[j] = tcos_x * sin_b[j] + sin_x[j] * cos_b[j]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+                }
+            }
         }
+        if(outputs[0] != input)
+            cblas_dcopy(vectorSize, input, 1, outputs[0], 1);
+        if(vectorSize)
+            setAzimuth(azimuths[vectorSize - 1]);
     }
     
     Encoder::~Encoder()
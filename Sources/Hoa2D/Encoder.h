@@ -73,6 +73,44 @@ namespace Hoa2D
             @param     outputs The output array.
          */
         void process(const double input, double* outputs);
+        
+        //! This method performs the encoding with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the encoding on a whole vector of samples. The input array contains the samples of the signal and its minimum size must be the vector size. The outputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics and each vector must contain at least the vector size samples. Only the vector of the first harmonic can share its memory with the input.
+         
+            @param     input        The input vector.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* input, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the encoding on a whole vector of samples. The input array contains the samples of the signal and its minimum size must be the vector size. The outputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics and each vector must contain at least the vector size samples. Only the vector of the first harmonic can share its memory with the input.
+         
+            @param     input        The input vector.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* input, double** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with single precision on a block of samples with a signal of azimuth.
+        /**	You should use this method for not-in-place processing and performs the encoding on a whole vector of samples with an angle of azimuth for each sample. The input array and the azimuths array contain the samples of the signal and the angles in radian, their minimum size must be the vector size. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics and each vector must contain at least the vector size samples. The sines and cosines of the angles are computed with the vectorized approximation of vector_sincos. Only the vector of the first harmonic can share its memory with the input. At the end of the block, the azimuth of the encoder is the last angle of the azimuths array.
+         
+            @param     input        The input vector.
+            @param     azimuths     The azimuths vector.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* input, const float* azimuths, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with double precision on a block of samples with a signal of azimuth.
+        /**	You should use this method for not-in-place processing and performs the encoding on a whole vector of samples with an angle of azimuth for each sample. The input array and the azimuths array contain the samples of the signal and the angles in radian, their minimum size must be the vector size. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics and each vector must contain at least the vector size samples. The sines and cosines of the angles are computed with the vectorized approximation of vector_sincos. Only the vector of the first harmonic can share its memory with the input. At the end of the block, the azimuth of the encoder is the last angle of the azimuths array.
+         
+            @param     input        The input vector.
+            @param     azimuths     The azimuths vector.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* input, const double* azimuths, double** outputs, const unsigned int vectorSize);
     };
 }
 
@@ -0,0 +1,207 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_2D_KERNELS
+#define DEF_HOA_2D_KERNELS
+
+#include "../Hoa.h"
+
+namespace Hoa2D
+{
+    //! The harmonics of a frame.
+    /** The frame gives access to the harmonics of one sample like the vectors of a block of one sample, so the sample by sample processing and the block processing use the same kernels.
+     */
+    template <typename T> class Frame
+    {
+        T* m_samples;
+    public:
+        inline Frame(T* samples) : m_samples(samples) {}
+        inline T* operator[](const unsigned int index) const {return m_samples + index;}
+    };
+    
+    //! Encode a vector.
+    /** The harmonics are computed with the recurrence of the cosine and the sine of the multiples of the azimuth.
+     
+        @param     numberOfHarmonics    The number of harmonics.
+        @param     cosx                 The cosine of the azimuth.
+        @param     sinx                 The sine of the azimuth.
+        @param     input                The input vector.
+        @param     outputs              The harmonics vectors, the first one can be the input.
+        @param     vectorSize           The number of samples.
+     */
+    template <typename T, class Outputs> inline void encode_vectors(const unsigned int numberOfHarmonics, const double cosx, const double sinx, const T* input, Outputs outputs, const unsigned int vectorSize)
+    {
+        T cos_x = cosx;
+        T sin_x = sinx;
+        T tcos_x = cos_x;
+        for(unsigned int i = 1; i < numberOfHarmonics; i += 2)
+        {
+            T* out_sin = outputs[i];
+            T* out_cos = outputs[i+1];
+            for(unsigned int j = 0; j < vectorSize; j++)
+            {
+                out_sin[j] = input[j] * sin_x;
+                out_cos[j] = input[j] * cos_x;
+            }
+            cos_x = tcos_x * cosx - sin_x * sinx; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+            sin_x = tcos_x * sinx + sin_x * cosx; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+            tcos_x = cos_x;
+        }
+        T* out = outputs[0];
+        if(out != input)
+        {
+            for(unsigned int j = 0; j < vectorSize; j++)
+                out[j] = input[j];
+        }
+    }
+    
+    //! Rotate the harmonics vectors.
+    /** The harmonics of each degree are rotated by the multiple of the angle.
+     
+        @param     numberOfHarmonics    The number of harmonics.
+        @param     cosx                 The cosine of the angle.
+        @param     sinx                 The sine of the angle.
+        @param     inputs               The input harmonics vectors.
+        @param     outputs              The output harmonics vectors, can be the inputs.
+        @param     vectorSize           The number of samples.
+     */
+    template <typename T, class Inputs, class Outputs> inline void rotate_vectors(const unsigned int numberOfHarmonics, const double cosx, const double sinx, Inputs inputs, Outputs outputs, const unsigned int vectorSize)
+    {
+        T cos_x = cosx;
+        T sin_x = sinx;
+        T tcos_x = cos_x;
+        const T* in = inputs[0];
+        T* out = outputs[0];
+        if(out != in)
+        {
+            for(unsigned int j = 0; j < vectorSize; j++)
+                out[j] = in[j];
+        }
+        for(unsigned int i = 2; i < numberOfHarmonics; i += 2)
+        {
+            const T* in_sin = inputs[i-1];
+            const T* in_cos = inputs[i];
+            T* out_sin = outputs[i-1];
+            T* out_cos = outputs[i];
+            for(unsigned int j = 0; j < vectorSize; j++)
+            {
+                const T sig_sin = in_sin[j];
+                const T sig_cos = in_cos[j];
+                out_sin[j] = sin_x * sig_cos + cos_x * sig_sin;
+                out_cos[j] = cos_x * sig_cos - sin_x * sig_sin;
+            }
+            cos_x = tcos_x * cosx - sin_x * sinx; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+            sin_x = tcos_x * sinx + sin_x * cosx; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+            tcos_x = cos_x;
+        }
+    }
+    
+    //! Weight the harmonics vectors.
+    /** Each harmonic is multiplied by its weight rounded to the precision of the vectors.
+     
+        @param     numberOfHarmonics    The number of harmonics.
+        @param     weights              The weights of the harmonics.
+        @param     inputs               The input harmonics vectors.
+        @param     outputs              The output harmonics vectors, can be the inputs.
+        @param     vectorSize           The number of samples.
+     */
+    template <typename T, class Inputs, class Outputs> inline void weight_vectors(const unsigned int numberOfHarmonics, const double* weights, Inputs inputs, Outputs outputs, const unsigned int vectorSize)
+    {
+        for(unsigned int i = 0; i < numberOfHarmonics; i++)
+        {
+            const T weight = (T)weights[i];
+            const T* in = inputs[i];
+            T* out = outputs[i];
+            for(unsigned int j = 0; j < vectorSize; j++)
+                out[j] = in[j] * weight;
+        }
+    }
+    
+    //! The kernels of an order.
+    /** The kernels perform the sample by sample processing of the ambisonic classes with a number of harmonics known at compile time, so the compiler can unroll and vectorize the loops over the harmonics. The kernels are the vector kernels applied to a frame.
+     */
+    template <unsigned int Order> class Kernels
+    {
+    public:
+        
+        //! The number of harmonics of the order.
+        static const unsigned int number_of_harmonics = 2 * Order + 1;
+        
+        //! Encode a sample.
+        template <typename T> static void encode(const T input, const double cosx, const double sinx, T* outputs)
+        {
+            encode_vectors<T>(number_of_harmonics, cosx, sinx, &input, Frame<T>(outputs), 1);
+        }
+        
+        //! Rotate the harmonics of a sample.
+        template <typename T> static void rotate(const double cosx, const double sinx, const T* inputs, T* outputs)
+        {
+            rotate_vectors<T>(number_of_harmonics, cosx, sinx, Frame<const T>(inputs), Frame<T>(outputs), 1);
+        }
+        
+        //! Weight the harmonics of a sample.
+        template <typename T> static void weight(const double* weights, const T* inputs, T* outputs)
+        {
+            weight_vectors<T>(number_of_harmonics, weights, Frame<const T>(inputs), Frame<T>(outputs), 1);
+        }
+    };
+    
+    //! The kernels table.
+    /** The kernels table contains the kernels of an order for a precision.
+     */
+    template <typename T> struct KernelsTable
+    {
+        void (*encode)(const T input, const double cosx, const double sinx, T* outputs);
+        void (*rotate)(const double cosx, const double sinx, const T* inputs, T* outputs);
+        void (*weight)(const double* weights, const T* inputs, T* outputs);
+    };
+    
+    //! Retrieve the kernels table of an order.
+    template <unsigned int Order, typename T> inline const KernelsTable<T>* getKernelsTable()
+    {
+        static const KernelsTable<T> table =
+        {
+            &Kernels<Order>::template encode<T>,
+            &Kernels<Order>::template rotate<T>,
+            &Kernels<Order>::template weight<T>
+        };
+        return &table;
+    }
+    
+    //! The dispatch of the kernels tables.
+    /** The dispatch compares the order with the orders from Order to HOA_MAX_KERNELS_ORDER, so the kernels of all the orders of the macro are instantiated.
+     */
+    template <unsigned int Order, typename T> struct KernelsDispatch
+    {
+        static const KernelsTable<T>* get(const unsigned int order)
+        {
+            if(order == Order)
+                return getKernelsTable<Order, T>();
+            return KernelsDispatch<Order + 1, T>::get(order);
+        }
+    };
+    
+    template <typename T> struct KernelsDispatch<HOA_MAX_KERNELS_ORDER + 1, T>
+    {
+        static const KernelsTable<T>* get(const unsigned int)
+        {
+            return NULL;
+        }
+    };
+    
+    //! Retrieve the kernels of an order.
+    /** The kernels are instantiated for the orders 1 to HOA_MAX_KERNELS_ORDER, the classes should use their generic loops for the greater orders.
+     
+        @param     order    The order.
+        @return    The kernels table or NULL if the order has no kernels.
+     */
+    template <typename T> inline const KernelsTable<T>* getKernels(const unsigned int order)
+    {
+        return KernelsDispatch<1, T>::get(order);
+    }
+}
+
+#endif
@@ -225,6 +225,14 @@ namespace Hoa2D
 			return m_channels_width[index];
 		}
 		
+		//! Take the last snapshot of the meter.
+        /** The peaks and the energies of the channels are read from this snapshot until the next update.
+         */
+        inline void updateMeter()
+        {
+            m_meter->update();
+        }
+        
 		//! Retrieve the peak value of a given channel.
         /**
          * @param		index		The index of the channel.
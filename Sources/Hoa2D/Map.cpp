@@ -20,6 +20,24 @@ namespace Hoa2D
         m_cosx              = new double[m_number_of_sources];
         m_wide              = new long[m_number_of_sources];
         
+        m_active            = new unsigned int[m_number_of_sources];
+        m_matrix_float      = new float[m_number_of_harmonics * m_number_of_sources];
+        m_matrix_double     = new double[m_number_of_harmonics * m_number_of_sources];
+        m_inputs_float      = new float[m_number_of_sources];
+        m_inputs_double     = new double[m_number_of_sources];
+        m_frame_inputs_float    = new const float*[m_number_of_sources];
+        m_frame_inputs_double   = new const double*[m_number_of_sources];
+        m_frame_outputs_float   = new float*[m_number_of_harmonics];
+        m_frame_outputs_double  = new double*[m_number_of_harmonics];
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            m_frame_inputs_float[i]     = m_inputs_float + i;
+            m_frame_inputs_double[i]    = m_inputs_double + i;
+        }
+        m_number_of_active  = 0;
+        m_dirty             = true;
+        m_active_dirty      = true;
+        
         m_wide_matrix       = new double[NUMBEROFLINEARPOINTS * m_number_of_harmonics];
         
         double weight_order = log((double)(m_order + 1));
@@ -47,7 +65,6 @@ namespace Hoa2D
             }
         }
         
-		m_first_source      = 0;
         for(unsigned int i = 0; i < m_number_of_sources; i++)
         {
 			setMute(i, 0);
@@ -62,6 +79,7 @@ namespace Hoa2D
         m_azimuth[index] = wrap_twopi(azimuth);
         m_cosx[index]    = cos(m_azimuth[index]);
         m_sinx[index]    = sin(m_azimuth[index]);
+        m_dirty          = true;
     }
 	
     void Map::setRadius(const unsigned int index, const double radius)
@@ -77,118 +95,375 @@ namespace Hoa2D
             m_gains[index] = 1.;
             m_wide[index] = clip_minmax(radius, 0., 1.) * (double)(NUMBEROFLINEARPOINTS - 1);
         }
+        m_dirty = true;
     }
     
     void Map::setMute(const unsigned int index, const bool muted)
     {
         assert(index < m_number_of_sources);
         m_muted[index] = muted;
-        m_first_source = -1;
+        Hoa::atomic_store(&m_active_dirty, true);
+    }
+    
+    void Map::computeActive()
+    {
+        Hoa::atomic_store(&m_active_dirty, false);
+        m_number_of_active = 0;
         for(unsigned int i = 0; i < m_number_of_sources; i++)
         {
             if(!m_muted[i])
+                m_active[m_number_of_active++] = i;
+        }
+        m_dirty = true;
+    }
+    
+    void Map::computeMatrix()
+    {
+        double cos_b[NUMBEROFCHUNKPOINTS];
+        double sin_b[NUMBEROFCHUNKPOINTS];
+        double cos_x[NUMBEROFCHUNKPOINTS];
+        double sin_x[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < m_number_of_active; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (m_number_of_active - offset) < NUMBEROFCHUNKPOINTS ? (m_number_of_active - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int i = 0; i < size; i++)
             {
-                m_first_source = i;
-                break;
+                const unsigned int index = m_active[offset + i];
+                const double* weights = m_wide_matrix + m_wide[index] * m_number_of_harmonics;
+                const double gain = m_gains[index] * weights[0];
+                m_matrix_double[offset + i] = gain;
+                for(unsigned int j = 1; j < m_number_of_harmonics; j++)
+                    m_matrix_double[j * m_number_of_sources + offset + i] = gain * weights[j];
+                cos_b[i] = cos_x[i] = m_cosx[index];
+                sin_b[i] = sin_x[i] = m_sinx[index];
+            }
+            
+            for(unsigned int j = 1; j < m_number_of_harmonics; j += 2)
+            {
+                double* row_sin = m_matrix_double + j * m_number_of_sources + offset;
+                double* row_cos = row_sin + m_number_of_sources;
+                for(unsigned int i = 0; i < size; i++)
+                {
+                    row_sin[i] *= sin_x[i];
+                    row_cos[i] *= cos_x[i];
+                    const double tcos_x = cos_x[i];
+                    cos_x[i] = tcos_x * cos_b[i] - sin_x[i] * sin_b[i]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                    sin_x[i] = tcos_x * sin_b[i] + sin_x[i] * cos_b[i]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+                }
             }
         }
+        
+        for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+        {
+            const double* row_double = m_matrix_double + j * m_number_of_sources;
+            float* row_float = m_matrix_float + j * m_number_of_sources;
+            for(unsigned int i = 0; i < m_number_of_active; i++)
+                row_float[i] = row_double[i];
+        }
+        m_dirty = false;
     }
     
     void Map::process(const float* inputs, float* outputs)
     {
-        int first = m_first_source;
-        if(first > -1)
-        {
-            int index = m_wide[first] * m_number_of_harmonics;
-            float cos_x = m_cosx[first];
-            float sin_x = m_sinx[first];
-            float tcos_x = cos_x;
-            float sig = inputs[first] * m_gains[first] * m_wide_matrix[index];
-            outputs[0] = sig;
-            for(unsigned int i = 1; i < m_number_of_harmonics; i += 2)
+        // The frame is copied so the processing can be in place
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+            m_inputs_float[i] = inputs[i];
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            m_frame_outputs_float[i] = outputs + i;
+        process(m_frame_inputs_float, m_frame_outputs_float, 1);
+    }
+    
+    void Map::process(const double* inputs, double* outputs)
+    {
+        // The frame is copied so the processing can be in place
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+            m_inputs_double[i] = inputs[i];
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            m_frame_outputs_double[i] = outputs + i;
+        process(m_frame_inputs_double, m_frame_outputs_double, 1);
+    }
+    
+    void Map::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        if(Hoa::atomic_load(&m_active_dirty))
+            computeActive();
+        if(m_dirty)
+            computeMatrix();
+        
+        const unsigned int number_of_active = m_number_of_active;
+        const SimdKernels* simd = getSimdKernels();
+        for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+        {
+            const float* row = m_matrix_float + j * m_number_of_sources;
+            float* output = outputs[j];
+            simd->accumulate_float(inputs, m_active, row, number_of_active, output, vectorSize);
+        }
+    }
+    
+    void Map::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        if(Hoa::atomic_load(&m_active_dirty))
+            computeActive();
+        if(m_dirty)
+            computeMatrix();
+        
+        const unsigned int number_of_active = m_number_of_active;
+        const SimdKernels* simd = getSimdKernels();
+        for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+        {
+            const double* row = m_matrix_double + j * m_number_of_sources;
+            double* output = outputs[j];
+            simd->accumulate_double(inputs, m_active, row, number_of_active, output, vectorSize);
+        }
+    }
+    
+    void Map::process(const float* const* inputs, const float* const* azimuths, const float* const* radius, float** outputs, const unsigned int vectorSize)
+    {
+        if(Hoa::atomic_load(&m_active_dirty))
+            computeActive();
+        if(!m_number_of_active)
+        {
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                outputs[i] = sig * sin_x * m_wide_matrix[index + i];
-                outputs[i+1] = sig * cos_x * m_wide_matrix[index + i + 1];
-                cos_x = tcos_x * m_cosx[first] - sin_x * m_sinx[first]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-                sin_x = tcos_x * m_sinx[first] + sin_x * m_cosx[first]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-                tcos_x = cos_x;
+                for(unsigned int k = 0; k < vectorSize; k++)
+                    outputs[i][k] = 0.;
             }
-            
-            for(unsigned int i = first+1; i < m_number_of_sources; i++)
+            return;
+        }
+        
+        float sig[NUMBEROFCHUNKPOINTS];
+        float cos_b[NUMBEROFCHUNKPOINTS];
+        float sin_b[NUMBEROFCHUNKPOINTS];
+        float cos_x[NUMBEROFCHUNKPOINTS];
+        float sin_x[NUMBEROFCHUNKPOINTS];
+        const double* rows[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int a = 0; a < m_number_of_active; a++)
             {
-                if (!m_muted[i])
-                {
-                    index = m_wide[i] * m_number_of_harmonics;
-                    cos_x = m_cosx[i];
-                    sin_x = m_sinx[i];
-                    tcos_x = cos_x;
-                    sig = inputs[i] * m_gains[i] * m_wide_matrix[index];
-                    outputs[0] += sig;
-                    for(unsigned int j = 1; j < m_number_of_harmonics; j += 2)
+                const unsigned int i = m_active[a];
+                const float* input = inputs[i] + offset;
+                if(azimuths && azimuths[i])
+                {
+                    vector_sincos(azimuths[i] + offset, sin_b, cos_b, size);
+                }
+                else
+                {
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        cos_b[k] = m_cosx[i];
+                        sin_b[k] = m_sinx[i];
+                    }
+                }
+                if(radius && radius[i])
+                {
+                    const float* rad = radius[i] + offset;
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        if(rad[k] >= 1.)
+                        {
+                            rows[k] = m_wide_matrix + (NUMBEROFLINEARPOINTS - 1) * m_number_of_harmonics;
+                            sig[k]  = input[k] / (rad[k] * rad[k]) * rows[k][0];
+                        }
+                        else
+                        {
+                            rows[k] = m_wide_matrix + (long)(clip_minmax(rad[k], 0., 1.) * (double)(NUMBEROFLINEARPOINTS - 1)) * m_number_of_harmonics;
+                            sig[k]  = input[k] * rows[k][0];
+                        }
+                    }
+                }
+                else
+                {
+                    const double* row = m_wide_matrix + m_wide[i] * m_number_of_harmonics;
+                    const float gain = m_gains[i] * row[0];
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        rows[k] = row;
+                        sig[k]  = input[k] * gain;
+                    }
+                }
+                
+                float* output = outputs[0] + offset;
+                if(a == 0)
+                {
+                    for(unsigned int k = 0; k < size; k++)
+                        output[k] = sig[k];
+                }
+                else
+                {
+                    for(unsigned int k = 0; k < size; k++)
+                        output[k] += sig[k];
+                }
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    cos_x[k] = cos_b[k];
+                    sin_x[k] = sin_b[k];
+                }
+                for(unsigned int j = 1; j < m_number_of_harmonics; j += 2)
+                {
+                    float* out_sin = outputs[j] + offset;
+                    float* out_cos = outputs[j+1] + offset;
+                    if(a == 0)
+                    {
+                        for(unsigned int k = 0; k < size; k++)
+                        {
+                            out_sin[k] = sig[k] * sin_x[k] * rows[k][j];
+                            out_cos[k] = sig[k] * cos_x[k] * rows[k][j+1];
+                        }
+                    }
+                    else
+                    {
+                        for(unsigned int k = 0; k < size; k++)
+                        {
+                            out_sin[k] += sig[k] * sin_x[k] * rows[k][j];
+                            out_cos[k] += sig[k] * cos_x[k] * rows[k][j+1];
+                        }
+                    }
+                    for(unsigned int k = 0; k < size; k++)
                     {
-                        outputs[j] += sig * sin_x * m_wide_matrix[index + j];
-                        outputs[j+1] += sig * cos_x * m_wide_matrix[index + j + 1];
-                        cos_x = tcos_x * m_cosx[i] - sin_x * m_sinx[i]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-                        sin_x = tcos_x * m_sinx[i] + sin_x * m_cosx[i]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-                        tcos_x = cos_x;
+                        const float tcos_x = cos_x[k];
+                        cos_x[k] = tcos_x * cos_b[k] - sin_x[k] * sin_b[k]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                        sin_x[k] = tcos_x * sin_b[k] + sin_x[k] * cos_b[k]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
                     }
-                    
                 }
             }
         }
-        else
+        
+        if(vectorSize)
         {
-            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                outputs[i] = 0.;
+            for(unsigned int i = 0; i < m_number_of_sources; i++)
+            {
+                if(azimuths && azimuths[i])
+                    setAzimuth(i, azimuths[i][vectorSize - 1]);
+                if(radius && radius[i])
+                    setRadius(i, radius[i][vectorSize - 1]);
+            }
         }
     }
     
-    void Map::process(const double* inputs, double* outputs)
+    void Map::process(const double* const* inputs, const double* const* azimuths, const double* const* radius, double** outputs, const unsigned int vectorSize)
     {
-        int first = m_first_source;
-		if(first > -1)
-        {
-            int index = m_wide[first] * m_number_of_harmonics;
-            double cos_x = m_cosx[first];
-            double sin_x = m_sinx[first];
-            double tcos_x = cos_x;
-            double sig = inputs[first] * m_gains[first] * m_wide_matrix[index];
-            outputs[0] = sig;
-            for(unsigned int i = 1; i < m_number_of_harmonics; i += 2)
+        if(Hoa::atomic_load(&m_active_dirty))
+            computeActive();
+        if(!m_number_of_active)
+        {
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                outputs[i] = sig * sin_x * m_wide_matrix[index + i];
-                outputs[i+1] = sig * cos_x * m_wide_matrix[index + i + 1];
-                cos_x = tcos_x * m_cosx[first] - sin_x * m_sinx[first]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-                sin_x = tcos_x * m_sinx[first] + sin_x * m_cosx[first]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-                tcos_x = cos_x;
+                for(unsigned int k = 0; k < vectorSize; k++)
+                    outputs[i][k] = 0.;
             }
-
-            for(unsigned int i = first+1; i < m_number_of_sources; i++)
+            return;
+        }
+        
+        double sig[NUMBEROFCHUNKPOINTS];
+        double cos_b[NUMBEROFCHUNKPOINTS];
+        double sin_b[NUMBEROFCHUNKPOINTS];
+        double cos_x[NUMBEROFCHUNKPOINTS];
+        double sin_x[NUMBEROFCHUNKPOINTS];
+        const double* rows[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int a = 0; a < m_number_of_active; a++)
             {
-                if (!m_muted[i])
-                {
-                    index = m_wide[i] * m_number_of_harmonics;
-                    cos_x = m_cosx[i];
-                    sin_x = m_sinx[i];
-                    tcos_x = cos_x;
-                    sig = inputs[i] * m_gains[i] * m_wide_matrix[index];
-                    outputs[0] += sig;
-                    for(unsigned int j = 1; j < m_number_of_harmonics; j += 2)
+                const unsigned int i = m_active[a];
+                const double* input = inputs[i] + offset;
+                if(azimuths && azimuths[i])
+                {
+                    vector_sincos(azimuths[i] + offset, sin_b, cos_b, size);
+                }
+                else
+                {
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        cos_b[k] = m_cosx[i];
+                        sin_b[k] = m_sinx[i];
+                    }
+                }
+                if(radius && radius[i])
+                {
+                    const double* rad = radius[i] + offset;
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        if(rad[k] >= 1.)
+                        {
+                            rows[k] = m_wide_matrix + (NUMBEROFLINEARPOINTS - 1) * m_number_of_harmonics;
+                            sig[k]  = input[k] / (rad[k] * rad[k]) * rows[k][0];
+                        }
+                        else
+                        {
+                            rows[k] = m_wide_matrix + (long)(clip_minmax(rad[k], 0., 1.) * (double)(NUMBEROFLINEARPOINTS - 1)) * m_number_of_harmonics;
+                            sig[k]  = input[k] * rows[k][0];
+                        }
+                    }
+                }
+                else
+                {
+                    const double* row = m_wide_matrix + m_wide[i] * m_number_of_harmonics;
+                    const double gain = m_gains[i] * row[0];
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        rows[k] = row;
+                        sig[k]  = input[k] * gain;
+                    }
+                }
+                
+                double* output = outputs[0] + offset;
+                if(a == 0)
+                {
+                    for(unsigned int k = 0; k < size; k++)
+                        output[k] = sig[k];
+                }
+                else
+                {
+                    for(unsigned int k = 0; k < size; k++)
+                        output[k] += sig[k];
+                }
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    cos_x[k] = cos_b[k];
+                    sin_x[k] = sin_b[k];
+                }
+                for(unsigned int j = 1; j < m_number_of_harmonics; j += 2)
+                {
+                    double* out_sin = outputs[j] + offset;
+                    double* out_cos = outputs[j+1] + offset;
+                    if(a == 0)
+                    {
+                        for(unsigned int k = 0; k < size; k++)
+                        {
+                            out_sin[k] = sig[k] * sin_x[k] * rows[k][j];
+                            out_cos[k] = sig[k] * cos_x[k] * rows[k][j+1];
+                        }
+                    }
+                    else
                     {
-                        outputs[j] += sig * sin_x * m_wide_matrix[index + j];
-                        outputs[j+1] += sig * cos_x * m_wide_matrix[index + j + 1];
-                        cos_x = tcos_x * m_cosx[i] - sin_x * m_sinx[i]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-                        sin_x = tcos_x * m_sinx[i] + sin_x * m_cosx[i]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-                        tcos_x = cos_x;
+                        for(unsigned int k = 0; k < size; k++)
+                        {
+                            out_sin[k] += sig[k] * sin_x[k] * rows[k][j];
+                            out_cos[k] += sig[k] * cos_x[k] * rows[k][j+1];
+                        }
+                    }
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        const double tcos_x = cos_x[k];
+                        cos_x[k] = tcos_x * cos_b[k] - sin_x[k] * sin_b[k]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                        sin_x[k] = tcos_x * sin_b[k] + sin_x[k] * cos_b[k]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
                     }
-                    
                 }
             }
         }
-        else
+        
+        if(vectorSize)
         {
-            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                outputs[i] = 0.;
+            for(unsigned int i = 0; i < m_number_of_sources; i++)
+            {
+                if(azimuths && azimuths[i])
+                    setAzimuth(i, azimuths[i][vectorSize - 1]);
+                if(radius && radius[i])
+                    setRadius(i, radius[i][vectorSize - 1]);
+            }
         }
     }
     
@@ -201,6 +476,15 @@ namespace Hoa2D
         delete [] m_sinx;
         delete [] m_wide_matrix;
         delete [] m_wide;
+        delete [] m_active;
+        delete [] m_matrix_float;
+        delete [] m_matrix_double;
+        delete [] m_inputs_float;
+        delete [] m_inputs_double;
+        delete [] m_frame_inputs_float;
+        delete [] m_frame_inputs_double;
+        delete [] m_frame_outputs_float;
+        delete [] m_frame_outputs_double;
     }
 }
 
@@ -10,6 +10,7 @@
 #include "Ambisonic.h"
 #include "Encoder.h"
 #include "Wider.h"
+#include "../HoaCommon/Queue.h"
 
 namespace Hoa2D
 {
@@ -26,7 +27,6 @@ namespace Hoa2D
         unsigned int			m_number_of_sources;
         double*					m_gains;
 		bool*					m_muted;
-        int						m_first_source;
         
         double*                 m_azimuth;
         double*                 m_cosx;
@@ -34,6 +34,29 @@ namespace Hoa2D
         long*                   m_wide;
         double*                 m_wide_matrix;
         
+        unsigned int*           m_active;
+        unsigned int            m_number_of_active;
+        bool                    m_dirty;
+        bool                    m_active_dirty;
+        float*                  m_matrix_float;
+        double*                 m_matrix_double;
+        float*                  m_inputs_float;
+        double*                 m_inputs_double;
+        const float**           m_frame_inputs_float;
+        const double**          m_frame_inputs_double;
+        float**                 m_frame_outputs_float;
+        double**                m_frame_outputs_double;
+        
+        //! Compute the matrix of the coefficients of the active sources.
+        /**	The active sources are processed by chunks, their cosines and sines are packed in structure-of-arrays and the recurrence is computed for all the sources of a chunk together, harmonic after harmonic, in loops that the compiler can vectorize over the sources. The matrix has one row for each harmonic and one column for each active source, the columns are packed so the muted sources are not processed. The matrix is only computed by the process methods when the coordinates or the mute states of the sources changed.
+         */
+        void computeMatrix();
+        
+        //! Compute the indices of the active sources.
+        /**	The mute states are set by the control thread and the indices of the active sources are only read by the process methods, so the control thread only flags the change and the list is rebuilt by the process methods at the beginning of the next call. The matrix is then computed again for the new columns.
+         */
+        void computeActive();
+        
     public:
         
         //! The map constructor.
@@ -141,6 +164,46 @@ namespace Hoa2D
             @param     outputs The outputs array.
          */
         void process(const double* inputs, double* outputs);
+        
+        //! This method performs the encoding with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the encoding with distance compensation on a whole vector of samples. The inputs array contains one vector for each source, its minimum size must be the number of sources. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The active sources are mixed four by four with the matrix of coefficients so each output vector is read and written once for four sources.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the encoding with distance compensation on a whole vector of samples. The inputs array contains one vector for each source, its minimum size must be the number of sources. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The active sources are mixed four by four with the matrix of coefficients so each output vector is read and written once for four sources.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with distance compensation with single precision on a block of samples with signals of coordinates.
+        /**	You should use this method for not-in-place processing and performs the encoding with distance compensation on a whole vector of samples with an angle of azimuth and a radius for each sample of each source. The inputs array contains one vector for each source, its minimum size must be the number of sources. The azimuths and the radius arrays contain one vector of angles in radian and one vector of radius for each source, the arrays or their vectors can be NULL to use the current azimuth or radius of the sources. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The sines and cosines of the angles are computed with the vectorized approximation of vector_sincos. At the end of the block, the coordinates of the sources are the last values of their vectors.
+         
+            @param     inputs       The input vectors.
+            @param     azimuths     The azimuths vectors.
+            @param     radius       The radius vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, const float* const* azimuths, const float* const* radius, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with distance compensation with double precision on a block of samples with signals of coordinates.
+        /**	You should use this method for not-in-place processing and performs the encoding with distance compensation on a whole vector of samples with an angle of azimuth and a radius for each sample of each source. The inputs array contains one vector for each source, its minimum size must be the number of sources. The azimuths and the radius arrays contain one vector of angles in radian and one vector of radius for each source, the arrays or their vectors can be NULL to use the current azimuth or radius of the sources. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The sines and cosines of the angles are computed with the vectorized approximation of vector_sincos. At the end of the block, the coordinates of the sources are the last values of their vectors.
+         
+            @param     inputs       The input vectors.
+            @param     azimuths     The azimuths vectors.
+            @param     radius       The radius vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, const double* const* azimuths, const double* const* radius, double** outputs, const unsigned int vectorSize);
     };
 }
 
@@ -9,11 +9,12 @@
 
 #include "Planewaves.h"
 #include "Vector.h"
+#include "../HoaCommon/TripleBuffer.h"
 
 namespace Hoa2D
 {
     //! The planewaves peak level meter.
-    /** The meter should be used to compute and display channels peak levels.
+    /** The meter should be used to compute and display channels peak levels. The peaks and the RMS of the channels are computed over windows of vector size samples and the levels follow the peaks with the attack and release ballistics. At the end of each window the audio thread publishes a snapshot of the values with a triple buffer, so the graphical interface takes the last complete window without lock with update() and reads its values.
      */
     class Meter : public Planewaves
     {
@@ -21,11 +22,22 @@ namespace Hoa2D
         unsigned int    m_ramp;
         unsigned int    m_vector_size;
         double*         m_channels_peaks;
+        double*         m_channels_squares;
+        double*         m_channels_levels;
 		double*			m_channels_azimuth_mapped;
 		double*			m_channels_azimuth_width;
         double          m_offset;
-        
+        double          m_sample_rate;
+        double          m_attack;
+        double          m_release;
+        double          m_attack_coefficient;
+        double          m_release_coefficient;
+        Hoa::TripleBuffer<double>* m_snapshots;
+        const double*   m_snapshot;
+		
 		void computeAngles();
+        void computeBallistics();
+        void publish();
     public:
         
         //! The meter constructor.
@@ -39,7 +51,7 @@ namespace Hoa2D
         /**	The meter destructor free the memory.
          */
         ~Meter();
-
+        
         //! Set the azimuth of a given channel.
         /** Set the azimuth of a given channel. The azimuth is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field.
          *
@@ -74,7 +86,7 @@ namespace Hoa2D
         {
             return m_offset;
         }
-        
+		
 		//! Get the mapped azimuth of a given channel.
         /**
          *
@@ -102,11 +114,41 @@ namespace Hoa2D
 		}
         
         //! Set the vector size.
-        /**
+        /** Set the number of samples of the windows over which the peaks and the RMS are computed, a snapshot is published at the end of each window.
+         *
          * @param     vectorSize	The vector size.
 		 * @see getChannelAzimuth
          */
         void setVectorSize(unsigned int vectorSize);
+        
+        //! Set the sample rate.
+        /** Set the sample rate used to convert the attack and the release times, the default sample rate is 44100.
+         *
+         * @param     sampleRate	The sample rate.
+         */
+        void setSampleRate(double sampleRate);
+        
+        //! Set the attack time.
+        /** Set the time in milliseconds that the level takes to rise by 63% of the distance to a greater peak, 0 makes the level jump to the peak. The default attack time is 0.
+         *
+         * @param     attack		The attack time.
+		 * @see setRelease
+         */
+        void setAttack(double attack);
+        
+        //! Set the release time.
+        /** Set the time in milliseconds that the level takes to fall by 63% of the distance to a lower peak, 0 makes the level fall to the peak. The default release time is 0.
+         *
+         * @param     release		The release time.
+		 * @see setAttack
+         */
+        void setRelease(double release);
+        
+        //! Get the attack time.
+        double getAttack() const {return m_attack;}
+        
+        //! Get the release time.
+        double getRelease() const {return m_release;}
 		
 		//! Get the vector size.
         /**
@@ -114,27 +156,61 @@ namespace Hoa2D
 		 * @see setVectorSize
          */
         unsigned int getVectorSize(unsigned int vectorSize) const {return m_vector_size;}
-        
+		
+		//! Take the last snapshot.
+        /** Take the last snapshot published by the audio thread, the peaks, the RMS, the levels and the energies are read from this snapshot until the next update so they all belong to the same window. This method should be called once per frame before the values are read, this method and the getters of the values must only be called by one reader thread.
+         */
+        inline void update()
+        {
+            m_snapshot = m_snapshots->read();
+        }
+		
 		//! Retrieve the peak value of a given channel.
-        /**
+        /** Retrieve the greatest absolute value of a channel over the last complete window. The value is read from the snapshot taken by the last update.
+         *
          * @param		index		The index of the channel.
 		 * @see getChannelEnergy
          */
         inline double getChannelPeak(unsigned int index) const
         {
             assert(index < m_number_of_channels);
-            return m_channels_peaks[index];
+            return m_snapshot[index];
         }
-        
-		//! Retrieve the energy of a given channel.
-        /**
+		
+		//! Retrieve the RMS value of a given channel.
+        /** Retrieve the root mean square of a channel over the last complete window from the snapshot taken by the last update.
+         *
          * @param		index		The index of the channel.
 		 * @see getChannelPeak
          */
+        inline double getChannelRms(unsigned int index) const
+        {
+            assert(index < m_number_of_channels);
+            return m_snapshot[m_number_of_channels + index];
+        }
+		
+		//! Retrieve the level of a given channel.
+        /** Retrieve the peak value of a channel smoothed by the attack and release ballistics from the snapshot taken by the last update.
+         *
+         * @param		index		The index of the channel.
+		 * @see getChannelEnergy
+         */
+        inline double getChannelLevel(unsigned int index) const
+        {
+            assert(index < m_number_of_channels);
+            return m_snapshot[2 * m_number_of_channels + index];
+        }
+		
+		//! Retrieve the energy of a given channel.
+        /** Retrieve the level of a channel in decibels.
+         *
+         * @param		index		The index of the channel.
+		 * @see getChannelLevel
+         */
         inline double getChannelEnergy(unsigned int index) const
         {
             assert(index < m_number_of_channels);
-            return atodb(m_channels_peaks[index]);
+            return atodb(getChannelLevel(index));
         }
         
         //! This method performs the metering with single precision.
@@ -150,6 +226,22 @@ namespace Hoa2D
             @param     inputs   The inputs array.
          */
         void process(const double* inputs);
+        
+        //! This method performs the metering with single precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the metering on a whole vector of samples. The inputs array contains one vector for each channel and its minimum size must be the number of channels. The vectors are split at the ends of the windows and the peak and the energy of each channel are computed over contiguous samples.
+         
+            @param     inputs       The inputs array.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, const unsigned int vectorSize);
+        
+        //! This method performs the metering with double precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the metering on a whole vector of samples. The inputs array contains one vector for each channel and its minimum size must be the number of channels. The vectors are split at the ends of the windows and the peak and the energy of each channel are computed over contiguous samples.
+         
+            @param     inputs       The inputs array.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, const unsigned int vectorSize);
     };
 }
 
@@ -10,7 +10,7 @@ namespace Hoa2D
 {
     Optim::Optim(unsigned int order, Mode mode) : Ambisonic(order)
     {
-        m_harmonics = new double[m_number_of_harmonics];
+        m_harmonics = new Hoa::Exchanger<Hoa::Coefficients>(new Hoa::Coefficients(m_number_of_harmonics));
         setMode(mode);
     }
     
@@ -18,19 +18,21 @@ namespace Hoa2D
     {
         long double temp1;
         long double temp2;
+        Hoa::Coefficients* weights = new Hoa::Coefficients(m_number_of_harmonics);
+        double* harmonics = weights->getDouble();
         m_mode = mode;
         if(m_mode == Basic)
         {
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                m_harmonics[i] = 1.;
+                harmonics[i] = 1.;
             }
         }
         else if (m_mode == MaxRe)
         {
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                m_harmonics[i] = cos(fabs((double)getHarmonicDegree(i)) * HOA_PI / (double)(2. * m_order + 2));
+                harmonics[i] = cos(fabs((double)getHarmonicDegree(i)) * HOA_PI / (double)(2. * m_order + 2));
             }
         }
         else
@@ -39,26 +41,44 @@ namespace Hoa2D
             {
                 temp1 = (long double)factorial(m_order) / (long double)factorial(m_order + getHarmonicDegree(i) + 1.);
                 temp2 = (long double)factorial(m_order + 1.) / (long double)factorial(m_order - fabs((double)getHarmonicDegree(i)));
-                m_harmonics[i] = temp1 * temp2;
+                harmonics[i] = temp1 * temp2;
             }
         }
+        weights->update();
+        m_harmonics->publish(weights);
     }
     
     void Optim::process(const float* inputs, float* outputs)
     {
-        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            outputs[i] = inputs[i] * m_harmonics[i];
+        const double* harmonics = m_harmonics->acquire()->getDouble();
+        if(m_kernels_float)
+            m_kernels_float->weight(harmonics, inputs, outputs);
+        else
+            weight_vectors<float>(m_number_of_harmonics, harmonics, Frame<const float>(inputs), Frame<float>(outputs), 1);
     }
     
     void Optim::process(const double* inputs, double* outputs)
     {
-        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            outputs[i] = inputs[i] * m_harmonics[i];
+        const double* harmonics = m_harmonics->acquire()->getDouble();
+        if(m_kernels_double)
+            m_kernels_double->weight(harmonics, inputs, outputs);
+        else
+            weight_vectors<double>(m_number_of_harmonics, harmonics, Frame<const double>(inputs), Frame<double>(outputs), 1);
+    }
+    
+    void Optim::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        weight_vectors<float>(m_number_of_harmonics, m_harmonics->acquire()->getDouble(), inputs, outputs, vectorSize);
+    }
+    
+    void Optim::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        weight_vectors<double>(m_number_of_harmonics, m_harmonics->acquire()->getDouble(), inputs, outputs, vectorSize);
     }
     
     Optim::~Optim()
     {
-        delete [] m_harmonics;
+        delete m_harmonics;
     }
 }
 
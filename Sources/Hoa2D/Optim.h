@@ -8,11 +8,12 @@
 #define DEF_HOA_2D_OPTIM
 
 #include "Ambisonic.h"
+#include "../HoaCommon/Exchanger.h"
 
 namespace Hoa2D
 {
     //! The ambisonic optimization.
-    /** The optimization should be used to optimize the ambisonic sound field. There are 3 optimization modes, Basic (no optimization), MaxRe (energy vector optimization) and InPhase (energy and velocity vector optimization). Basic has no effect, it should be used with a perfect ambisonic channels, arrengement where all the channels are to equal distance on a circle, and for a listener placed at the perfect center of the circle. MaxRe should be used for auditory confined to the center of the circle. InPhase should be used when the auditory covers the entire channels area and when the channels arragement is not a perfect circle or when the channels are not to equal distance. Note that the optimizations decrease the precision of the sound field restitution thus it can be compared to particular cases of the fractional orders.
+    /** The optimization should be used to optimize the ambisonic sound field. There are 3 optimization modes, Basic (no optimization), MaxRe (energy vector optimization) and InPhase (energy and velocity vector optimization). Basic has no effect, it should be used with a perfect ambisonic channels, arrengement where all the channels are to equal distance on a circle, and for a listener placed at the perfect center of the circle. MaxRe should be used for auditory confined to the center of the circle. InPhase should be used when the auditory covers the entire channels area and when the channels arragement is not a perfect circle or when the channels are not to equal distance. The weights are computed by the control thread and published to the audio thread with an atomic swap, so the mode can be changed while processing. Note that the optimizations decrease the precision of the sound field restitution thus it can be compared to particular cases of the fractional orders.
      */    class Optim : public Ambisonic
     {
     public:
@@ -22,12 +23,12 @@ namespace Hoa2D
             MaxRe   = 1,	/**< Max Re Optimization    */
             InPhase = 2     /**< In Phase Optimization  */
         };
-        
+    
     private:
         
         Mode            m_mode;
-        double*         m_harmonics;
-        
+        Hoa::Exchanger<Hoa::Coefficients>* m_harmonics;
+    
     public:
         
         //! The optimization constructor.
@@ -74,6 +75,24 @@ namespace Hoa2D
             @param     outputs  The outputs array.
          */
         void process(const double* inputs, double* outputs);
+        
+        //! This method performs the optimization with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the optimization on a whole vector of samples. The inputs array and outputs array contains one vector for each circular harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the optimization with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the optimization on a whole vector of samples. The inputs array and outputs array contains one vector for each circular harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
 }
 
@@ -12,6 +12,10 @@ namespace Hoa2D
     {
         m_projector_matrix_double   = new double[m_number_of_channels * m_number_of_harmonics];
         m_projector_matrix_float    = new float[m_number_of_channels * m_number_of_harmonics];
+        m_inputs_chunk_float        = new float[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_inputs_chunk_double       = new double[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_float       = new float[m_number_of_channels * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_double      = new double[m_number_of_channels * NUMBEROFCHUNKPOINTS];
         
         double*         m_harmonics_vector;
         Encoder*        m_encoder;
@@ -43,10 +47,24 @@ namespace Hoa2D
 		cblas_dgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1., m_projector_matrix_double, m_number_of_harmonics, inputs, 1, 0., outputs, 1);
 	}
 	
+    void Projector::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        matrix_vectors_product(m_projector_matrix_float, m_number_of_channels, m_number_of_harmonics, inputs, outputs, vectorSize, m_inputs_chunk_float, m_outputs_chunk_float);
+	}
+
+    void Projector::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        matrix_vectors_product(m_projector_matrix_double, m_number_of_channels, m_number_of_harmonics, inputs, outputs, vectorSize, m_inputs_chunk_double, m_outputs_chunk_double);
+	}
+
 	Projector::~Projector()
 	{
 		delete [] m_projector_matrix_double;
         delete [] m_projector_matrix_float;
+        delete [] m_inputs_chunk_float;
+        delete [] m_inputs_chunk_double;
+        delete [] m_outputs_chunk_float;
+        delete [] m_outputs_chunk_double;
 	}
 }
 
@@ -22,6 +22,10 @@ namespace Hoa2D
     private:
         double*         m_projector_matrix_double;
         float*          m_projector_matrix_float;        
+        float*          m_inputs_chunk_float;
+        double*         m_inputs_chunk_double;
+        float*          m_outputs_chunk_float;
+        double*         m_outputs_chunk_double;
     public:
         
         //! The projector constructor.
@@ -52,6 +56,24 @@ namespace Hoa2D
             @param     outputs  The outputs array.
          */
 		void process(const double* inputs, double* outputs);
+        
+        //! This method performs the projection with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the projection on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is projected with a single matrix product.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the projection with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the projection on a whole vector of samples. The inputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is projected with a single matrix product.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
 }
 
@@ -14,6 +14,21 @@ namespace Hoa2D
         m_harmonics_double          = new double[m_number_of_harmonics];
         m_recomposer_matrix_float   = new float[m_number_of_harmonics * m_number_of_channels];
         m_recomposer_matrix_double  = new double[m_number_of_harmonics * m_number_of_channels];
+        m_free_matrix_float         = new float[m_number_of_harmonics * m_number_of_channels];
+        m_free_matrix_double        = new double[m_number_of_harmonics * m_number_of_channels];
+        m_fisheye_matrix_float      = new float[m_number_of_harmonics * m_number_of_channels];
+        m_fisheye_matrix_double     = new double[m_number_of_harmonics * m_number_of_channels];
+        m_ramp_matrix_float         = new float[m_number_of_harmonics * m_number_of_channels * 2];
+        m_ramp_matrix_double        = new double[m_number_of_harmonics * m_number_of_channels * 2];
+        m_inputs_chunk_float        = new float[m_number_of_channels * 2 * NUMBEROFCHUNKPOINTS];
+        m_inputs_chunk_double       = new double[m_number_of_channels * 2 * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_float       = new float[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_double      = new double[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_free_dirty                = new bool[m_number_of_channels];
+        m_fisheye_dirty             = new bool[m_number_of_channels];
+        m_changes                   = new unsigned int[m_number_of_channels];
+        m_free_processed            = false;
+        m_fisheye_processed         = false;
         m_encoders                  = new Encoder*[m_number_of_channels];
         m_widers                    = new Wider*[m_number_of_channels];
         for(unsigned int i = 0; i < m_number_of_channels; i++)
@@ -22,6 +37,8 @@ namespace Hoa2D
             m_widers[i]     = new Wider(m_order);
             m_encoders[i]->setAzimuth((double)i / (double)m_number_of_channels * HOA_2PI);
             m_widers[i]->setWideningValue(1.);
+            m_free_dirty[i]     = true;
+            m_fisheye_dirty[i]  = true;
         }
 
         for(unsigned int i = 0; i < m_number_of_channels; i++)
@@ -33,18 +50,22 @@ namespace Hoa2D
                 m_recomposer_matrix_float[j * m_number_of_channels + i] = m_recomposer_matrix_double[j * m_number_of_channels + i] = m_harmonics_double[j];
             }
         }
+        m_encoders[0]->setAzimuth(0.);
     }
 
     void Recomposer::setAzimuth(unsigned int index, const double azimuth)
     {
         assert(index < m_number_of_channels);
         m_encoders[index]->setAzimuth(azimuth);
+        m_free_dirty[index]     = true;
+        m_fisheye_dirty[index]  = true;
     }
 	
     void Recomposer::setWideningValue(unsigned int index, const double value)
     {
         assert(index < m_number_of_channels);
         m_widers[index]->setWideningValue(value);
+        m_free_dirty[index] = true;
     }
     
     void Recomposer::setFisheye(const double fisheye)
@@ -57,7 +78,112 @@ namespace Hoa2D
                 azimuth *= factor;
             else
                 azimuth = HOA_2PI - ((HOA_2PI - azimuth) * factor);
+            const double previous = m_encoders[i]->getAzimuth();
             m_encoders[i]->setAzimuth(azimuth);
+            if(m_encoders[i]->getAzimuth() != previous)
+            {
+                m_free_dirty[i]     = true;
+                m_fisheye_dirty[i]  = true;
+            }
+        }
+    }
+    
+    unsigned int Recomposer::update(double* matrixDouble, float* matrixFloat, bool* dirty, const bool widen, const bool ramp)
+    {
+        unsigned int number_of_changes = 0;
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+        {
+            if(dirty[i])
+                m_changes[number_of_changes++] = i;
+        }
+        if(!number_of_changes)
+            return 0;
+        
+        // The ramp matrix is the previous matrix extended with the differences of the changed columns
+        const unsigned int columns = m_number_of_channels + number_of_changes;
+        if(ramp)
+        {
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                memcpy(m_ramp_matrix_double + j * columns, matrixDouble + j * m_number_of_channels, m_number_of_channels * sizeof(double));
+        }
+        for(unsigned int i = 0; i < number_of_changes; i++)
+        {
+            const unsigned int index = m_changes[i];
+            m_encoders[index]->process(1., m_harmonics_double);
+            if(widen)
+                m_widers[index]->process(m_harmonics_double, m_harmonics_double);
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+            {
+                double* coefficient = matrixDouble + j * m_number_of_channels + index;
+                if(ramp)
+                    m_ramp_matrix_double[j * columns + m_number_of_channels + i] = m_harmonics_double[j] - *coefficient;
+                *coefficient = m_harmonics_double[j];
+                matrixFloat[j * m_number_of_channels + index] = m_harmonics_double[j];
+            }
+            dirty[index] = false;
+        }
+        if(!ramp)
+            return 0;
+        for(unsigned int i = 0; i < m_number_of_harmonics * columns; i++)
+            m_ramp_matrix_float[i] = m_ramp_matrix_double[i];
+        return number_of_changes;
+    }
+    
+    void Recomposer::processMatrix(const float* matrix, const unsigned int numberOfChanges, const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        if(!numberOfChanges)
+        {
+            matrix_vectors_product(matrix, m_number_of_harmonics, m_number_of_channels, inputs, outputs, vectorSize, m_inputs_chunk_float, m_outputs_chunk_float);
+            return;
+        }
+        
+        // The inputs of the changed channels weighted by the ramp are multiplied by the differences of the columns
+        const unsigned int columns = m_number_of_channels + numberOfChanges;
+        const float step = 1.f / (float)vectorSize;
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int j = 0; j < m_number_of_channels; j++)
+                memcpy(m_inputs_chunk_float + j * NUMBEROFCHUNKPOINTS, inputs[j] + offset, size * sizeof(float));
+            for(unsigned int i = 0; i < numberOfChanges; i++)
+            {
+                const float* input = inputs[m_changes[i]] + offset;
+                float* chunk = m_inputs_chunk_float + (m_number_of_channels + i) * NUMBEROFCHUNKPOINTS;
+                for(unsigned int k = 0; k < size; k++)
+                    chunk[k] = input[k] * (float)(offset + k + 1) * step;
+            }
+            matrix_chunk_product(m_ramp_matrix_float, m_number_of_harmonics, columns, m_inputs_chunk_float, m_outputs_chunk_float, size);
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_float + i * NUMBEROFCHUNKPOINTS, size * sizeof(float));
+        }
+    }
+    
+    void Recomposer::processMatrix(const double* matrix, const unsigned int numberOfChanges, const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        if(!numberOfChanges)
+        {
+            matrix_vectors_product(matrix, m_number_of_harmonics, m_number_of_channels, inputs, outputs, vectorSize, m_inputs_chunk_double, m_outputs_chunk_double);
+            return;
+        }
+        
+        // The inputs of the changed channels weighted by the ramp are multiplied by the differences of the columns
+        const unsigned int columns = m_number_of_channels + numberOfChanges;
+        const double step = 1. / (double)vectorSize;
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int j = 0; j < m_number_of_channels; j++)
+                memcpy(m_inputs_chunk_double + j * NUMBEROFCHUNKPOINTS, inputs[j] + offset, size * sizeof(double));
+            for(unsigned int i = 0; i < numberOfChanges; i++)
+            {
+                const double* input = inputs[m_changes[i]] + offset;
+                double* chunk = m_inputs_chunk_double + (m_number_of_channels + i) * NUMBEROFCHUNKPOINTS;
+                for(unsigned int k = 0; k < size; k++)
+                    chunk[k] = input[k] * (double)(offset + k + 1) * step;
+            }
+            matrix_chunk_product(m_ramp_matrix_double, m_number_of_harmonics, columns, m_inputs_chunk_double, m_outputs_chunk_double, size);
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_double + i * NUMBEROFCHUNKPOINTS, size * sizeof(double));
         }
     }
     
@@ -73,46 +199,68 @@ namespace Hoa2D
     
     void Recomposer::processFisheye(const float* inputs, float* outputs)
 	{
-		m_encoders[0]->process(inputs[0], outputs);
-        for(unsigned int i = 1; i < m_number_of_channels; i++)
-        {
-            m_encoders[i]->process(inputs[i], m_harmonics_float);
-            cblas_saxpy(m_number_of_harmonics, 1., m_harmonics_float, 1, outputs, 1);
-        }
+        update(m_fisheye_matrix_double, m_fisheye_matrix_float, m_fisheye_dirty, false, false);
+        m_fisheye_processed = true;
+		cblas_sgemv(CblasRowMajor, CblasNoTrans, m_number_of_harmonics, m_number_of_channels, 1.f, m_fisheye_matrix_float, m_number_of_channels, inputs, 1, 0.f, outputs, 1);
 	}
 	
 	void Recomposer::processFisheye(const double* inputs, double* outputs)
 	{
-		m_encoders[0]->process(inputs[0], outputs);
-        for(unsigned int i = 1; i < m_number_of_channels; i++)
-        {
-            m_encoders[i]->process(inputs[i], m_harmonics_double);
-            cblas_daxpy(m_number_of_harmonics, 1., m_harmonics_double, 1, outputs, 1);
-        }
+        update(m_fisheye_matrix_double, m_fisheye_matrix_float, m_fisheye_dirty, false, false);
+        m_fisheye_processed = true;
+		cblas_dgemv(CblasRowMajor, CblasNoTrans, m_number_of_harmonics, m_number_of_channels, 1., m_fisheye_matrix_double, m_number_of_channels, inputs, 1, 0., outputs, 1);
 	}
     
     void Recomposer::processFree(const float* inputs, float* outputs)
 	{
-		m_encoders[0]->process(inputs[0], m_harmonics_float);
-        m_widers[0]->process(m_harmonics_float, outputs);
-        for(unsigned int i = 1; i < m_number_of_channels; i++)
-        {
-            m_encoders[i]->process(inputs[i], m_harmonics_float);
-            m_widers[i]->process(m_harmonics_float, m_harmonics_float);
-            cblas_saxpy(m_number_of_harmonics, 1.f, m_harmonics_float, 1, outputs, 1);
-        }
+        update(m_free_matrix_double, m_free_matrix_float, m_free_dirty, true, false);
+        m_free_processed = true;
+		cblas_sgemv(CblasRowMajor, CblasNoTrans, m_number_of_harmonics, m_number_of_channels, 1.f, m_free_matrix_float, m_number_of_channels, inputs, 1, 0.f, outputs, 1);
 	}
 	
 	void Recomposer::processFree(const double* inputs, double* outputs)
 	{
-		m_encoders[0]->process(inputs[0], m_harmonics_double);
-        m_widers[0]->process(m_harmonics_double, outputs);
-        for(unsigned int i = 1; i < m_number_of_channels; i++)
-        {
-            m_encoders[i]->process(inputs[i], m_harmonics_double);
-            m_widers[i]->process(m_harmonics_double, m_harmonics_double);
-            cblas_daxpy(m_number_of_harmonics, 1., m_harmonics_double, 1, outputs, 1);
-        }
+        update(m_free_matrix_double, m_free_matrix_float, m_free_dirty, true, false);
+        m_free_processed = true;
+		cblas_dgemv(CblasRowMajor, CblasNoTrans, m_number_of_harmonics, m_number_of_channels, 1., m_free_matrix_double, m_number_of_channels, inputs, 1, 0., outputs, 1);
+	}
+    
+    void Recomposer::processFixe(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        processMatrix(m_recomposer_matrix_float, 0, inputs, outputs, vectorSize);
+	}
+    
+    void Recomposer::processFixe(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        processMatrix(m_recomposer_matrix_double, 0, inputs, outputs, vectorSize);
+	}
+    
+    void Recomposer::processFisheye(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        const unsigned int number_of_changes = update(m_fisheye_matrix_double, m_fisheye_matrix_float, m_fisheye_dirty, false, m_fisheye_processed);
+        m_fisheye_processed = true;
+        processMatrix(m_fisheye_matrix_float, number_of_changes, inputs, outputs, vectorSize);
+	}
+    
+    void Recomposer::processFisheye(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        const unsigned int number_of_changes = update(m_fisheye_matrix_double, m_fisheye_matrix_float, m_fisheye_dirty, false, m_fisheye_processed);
+        m_fisheye_processed = true;
+        processMatrix(m_fisheye_matrix_double, number_of_changes, inputs, outputs, vectorSize);
+	}
+    
+    void Recomposer::processFree(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        const unsigned int number_of_changes = update(m_free_matrix_double, m_free_matrix_float, m_free_dirty, true, m_free_processed);
+        m_free_processed = true;
+        processMatrix(m_free_matrix_float, number_of_changes, inputs, outputs, vectorSize);
+	}
+    
+    void Recomposer::processFree(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        const unsigned int number_of_changes = update(m_free_matrix_double, m_free_matrix_float, m_free_dirty, true, m_free_processed);
+        m_free_processed = true;
+        processMatrix(m_free_matrix_double, number_of_changes, inputs, outputs, vectorSize);
 	}
 	
 	Recomposer::~Recomposer()
@@ -121,6 +269,19 @@ namespace Hoa2D
         delete [] m_harmonics_float;
         delete [] m_recomposer_matrix_double;
         delete [] m_recomposer_matrix_float;
+        delete [] m_free_matrix_double;
+        delete [] m_free_matrix_float;
+        delete [] m_fisheye_matrix_double;
+        delete [] m_fisheye_matrix_float;
+        delete [] m_ramp_matrix_double;
+        delete [] m_ramp_matrix_float;
+        delete [] m_inputs_chunk_double;
+        delete [] m_inputs_chunk_float;
+        delete [] m_outputs_chunk_double;
+        delete [] m_outputs_chunk_float;
+        delete [] m_free_dirty;
+        delete [] m_fisheye_dirty;
+        delete [] m_changes;
         for(unsigned int i = 0; i < m_number_of_channels; i++)
         {
             delete m_encoders[i];
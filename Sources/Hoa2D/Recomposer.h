@@ -15,7 +15,7 @@
 namespace Hoa2D
 {
     //! The ambisonic recomposer.
-    /** The recomposer should be in the planewaves domain to come back the the circular harmonics domain. The recomposition is similar to the several encoding exept that we consider planewaves (or virtual microphones) instead of sources. The number of channels (or planewaves) must be a least the number of harmonics, the first angle is 0 radian and the angular distances between the channels are equals.
+    /** The recomposer should be in the planewaves domain to come back the the circular harmonics domain. The recomposition is similar to the several encoding exept that we consider planewaves (or virtual microphones) instead of sources. The number of channels (or planewaves) must be a least the number of harmonics, the first angle is 0 radian and the angular distances between the channels are equals. The fisheye and the free recompositions keep a matrix of the harmonics by the channels, only the columns of the channels whose azimuth or widening value changed are computed again before the next processing, so they cost a matrix product like the fixed recomposition. On a block of samples, the changes of the matrix are interpolated linearly over the block.
      */
     class Recomposer : public Ambisonic, public Planewaves
     {
@@ -27,7 +27,26 @@ namespace Hoa2D
         Wider**     m_widers;
         double*     m_recomposer_matrix_double;
         float*      m_recomposer_matrix_float;
+        double*     m_free_matrix_double;
+        float*      m_free_matrix_float;
+        double*     m_fisheye_matrix_double;
+        float*      m_fisheye_matrix_float;
+        double*     m_ramp_matrix_double;
+        float*      m_ramp_matrix_float;
+        bool*       m_free_dirty;
+        bool*       m_fisheye_dirty;
+        bool        m_free_processed;
+        bool        m_fisheye_processed;
+        unsigned int*   m_changes;
+        double*     m_inputs_chunk_double;
+        float*      m_inputs_chunk_float;
+        double*     m_outputs_chunk_double;
+        float*      m_outputs_chunk_float;
         
+        unsigned int update(double* matrixDouble, float* matrixFloat, bool* dirty, const bool widen, const bool ramp);
+        void processMatrix(const float* matrix, const unsigned int numberOfChanges, const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        void processMatrix(const double* matrix, const unsigned int numberOfChanges, const double* const* inputs, double** outputs, const unsigned int vectorSize);
+    
     public:
         
         //! The recomposer constructor.
@@ -106,6 +125,24 @@ namespace Hoa2D
          */
 		void processFixe(const double* inputs, double* outputs);
         
+        //! This method performs the recomposition with fixed angles with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the recomposition with fixed angles on a whole vector of samples. The inputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The outputs vectors can't share their memory with the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void processFixe(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the recomposition with fixed angles with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the recomposition with fixed angles on a whole vector of samples. The inputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The outputs vectors can't share their memory with the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void processFixe(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+        
         //! This method performs the fish-eye recomposition with single precision.
         /**	You should use this method for in-place or not-in-place processing and performs the projection sample by sample. The outputs array contains the circular harmonics samples and the minimum size must be the number of harmonics and the  inputs array contains the channels (or planewaves) samples and the minimum size must be a least the number of channels.
          
@@ -122,6 +159,24 @@ namespace Hoa2D
          */
 		void processFisheye(const double* inputs, double* outputs);
         
+        //! This method performs the recomposition with the fisheye effect with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the recomposition with the fisheye effect on a whole vector of samples. The changes of the fisheye factor since the last processing are interpolated linearly over the block. The inputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The outputs vectors can't share their memory with the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void processFisheye(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the recomposition with the fisheye effect with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the recomposition with the fisheye effect on a whole vector of samples. The changes of the fisheye factor since the last processing are interpolated linearly over the block. The inputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The outputs vectors can't share their memory with the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void processFisheye(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+        
         //! This method performs the free recomposition with single precision.
         /**	You should use this method for in-place or not-in-place processing and performs the projection sample by sample. The outputs array contains the circular harmonics samples and the minimum size must be the number of harmonics and the  inputs array contains the channels (or planewaves) samples and the minimum size must be a least the number of channels.
          
@@ -138,6 +193,24 @@ namespace Hoa2D
          */
 		void processFree(const double* inputs, double* outputs);
         
+        //! This method performs the recomposition with free angles and widening values with single precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the recomposition with free angles and widening values on a whole vector of samples. The changes of the angles or of the widening values since the last processing are interpolated linearly over the block. The inputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The outputs vectors can't share their memory with the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void processFree(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the recomposition with free angles and widening values with double precision on a block of samples.
+        /**	You should use this method for not-in-place processing and performs the recomposition with free angles and widening values on a whole vector of samples. The changes of the angles or of the widening values since the last processing are interpolated linearly over the block. The inputs array contains one vector for each channel (or planewave), its minimum size must be the number of channels. The outputs array contains one vector for each circular harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. The outputs vectors can't share their memory with the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void processFree(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+        
     };
 }
 
@@ -22,38 +22,28 @@ namespace Hoa2D
     
     void Rotate::process(const float* inputs, float* outputs)
     {
-        float cos_x = m_cosx;
-        float sin_x = m_sinx;
-        float tcos_x = cos_x;
-        float sig;
-        outputs[0] = inputs[0];
-        for(int i = 2; i < m_number_of_harmonics; i += 2)
-        {
-            sig = inputs[i-1];
-            outputs[i-1] = sin_x * inputs[i] + cos_x * sig;
-            outputs[i] = cos_x * inputs[i] - sin_x * sig;
-            cos_x = tcos_x * m_cosx - sin_x * m_sinx; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-            sin_x = tcos_x * m_sinx + sin_x * m_cosx; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-            tcos_x = cos_x;
-        }
+        if(m_kernels_float)
+            m_kernels_float->rotate(m_cosx, m_sinx, inputs, outputs);
+        else
+            rotate_vectors<float>(m_number_of_harmonics, m_cosx, m_sinx, Frame<const float>(inputs), Frame<float>(outputs), 1);
     }
     
     void Rotate::process(const double* inputs, double* outputs)
     {
-        double cos_x = m_cosx;
-        double sin_x = m_sinx;
-        double tcos_x = cos_x;
-        double sig;
-        outputs[0] = inputs[0];
-        for(int i = 2; i < m_number_of_harmonics; i += 2)
-        {
-            sig = inputs[i-1];
-            outputs[i-1] = sin_x * inputs[i] + cos_x * sig;
-            outputs[i] = cos_x * inputs[i] - sin_x * sig;
-            cos_x = tcos_x * m_cosx - sin_x * m_sinx; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-            sin_x = tcos_x * m_sinx + sin_x * m_cosx; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-            tcos_x = cos_x;
-        }
+        if(m_kernels_double)
+            m_kernels_double->rotate(m_cosx, m_sinx, inputs, outputs);
+        else
+            rotate_vectors<double>(m_number_of_harmonics, m_cosx, m_sinx, Frame<const double>(inputs), Frame<double>(outputs), 1);
+    }
+    
+    void Rotate::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        rotate_vectors<float>(m_number_of_harmonics, m_cosx, m_sinx, inputs, outputs, vectorSize);
+    }
+    
+    void Rotate::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        rotate_vectors<double>(m_number_of_harmonics, m_cosx, m_sinx, inputs, outputs, vectorSize);
     }
     
     Rotate::~Rotate()
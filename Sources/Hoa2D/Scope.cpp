@@ -11,16 +11,143 @@ namespace Hoa2D
     Scope::Scope(unsigned int order, unsigned int numberOfPoints) : Ambisonic(order)
     {
         m_number_of_points = numberOfPoints;
+        m_ramp          = 0;
+        m_vector_size   = 256;
 		m_decoder   = new DecoderRegular(order, m_number_of_points);
         m_matrix    = new double[m_number_of_points];
+        m_points    = new double[m_number_of_points];
         m_harmonics = new double[m_number_of_harmonics];
- 
+        m_covariance    = new double[m_number_of_harmonics * m_number_of_harmonics];
+        m_factor        = new double[m_number_of_harmonics * m_number_of_harmonics];
+        m_snapshots     = new Hoa::TripleBuffer<double>(m_number_of_harmonics * m_number_of_harmonics);
+        
         for(unsigned int i = 0; i < m_number_of_points; i++)
         {
             m_matrix[i] = 0.;
         }
+        for(unsigned int i = 0; i < m_number_of_harmonics * m_number_of_harmonics; i++)
+        {
+            m_covariance[i] = 0.;
+        }
     }
-	
+    
+    void Scope::setVectorSize(unsigned int vectorSize)
+    {
+        m_vector_size   = vectorSize > 0 ? vectorSize : 1;
+        m_ramp          = 0;
+        for(unsigned int i = 0; i < m_number_of_harmonics * m_number_of_harmonics; i++)
+        {
+            m_covariance[i] = 0.;
+        }
+    }
+    
+    void Scope::publish()
+    {
+        // Only the upper triangle is accumulated, the snapshot is the full mean covariance
+        double* snapshot = m_snapshots->getWrite();
+        const double scale = 1. / (double)m_vector_size;
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            for(unsigned int j = i; j < m_number_of_harmonics; j++)
+            {
+                snapshot[i * m_number_of_harmonics + j] = snapshot[j * m_number_of_harmonics + i] = m_covariance[i * m_number_of_harmonics + j] * scale;
+                m_covariance[i * m_number_of_harmonics + j] = 0.;
+            }
+        }
+        m_snapshots->publish();
+        m_ramp = 0;
+    }
+    
+    void Scope::accumulate(const float* inputs)
+    {
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            double* row = m_covariance + i * m_number_of_harmonics;
+            const double value = inputs[i];
+            for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                row[j] += value * (double)inputs[j];
+        }
+        if(++m_ramp >= m_vector_size)
+            publish();
+    }
+    
+    void Scope::accumulate(const double* inputs)
+    {
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            double* row = m_covariance + i * m_number_of_harmonics;
+            const double value = inputs[i];
+            for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                row[j] += value * inputs[j];
+        }
+        if(++m_ramp >= m_vector_size)
+            publish();
+    }
+    
+    void Scope::accumulate(const float* const* inputs, const unsigned int vectorSize)
+    {
+        const Hoa::SimdKernels* kernels = getSimdKernels();
+        for(unsigned int k = 0; k < vectorSize;)
+        {
+            const unsigned int size = std::min(vectorSize - k, m_vector_size - m_ramp);
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            {
+                double* row = m_covariance + i * m_number_of_harmonics;
+                for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                    row[j] += kernels->dot_float(inputs[i] + k, inputs[j] + k, size);
+            }
+            k       += size;
+            m_ramp  += size;
+            if(m_ramp >= m_vector_size)
+                publish();
+        }
+    }
+    
+    void Scope::accumulate(const double* const* inputs, const unsigned int vectorSize)
+    {
+        const Hoa::SimdKernels* kernels = getSimdKernels();
+        for(unsigned int k = 0; k < vectorSize;)
+        {
+            const unsigned int size = std::min(vectorSize - k, m_vector_size - m_ramp);
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            {
+                double* row = m_covariance + i * m_number_of_harmonics;
+                for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                    row[j] += kernels->dot_double(inputs[i] + k, inputs[j] + k, size);
+            }
+            k       += size;
+            m_ramp  += size;
+            if(m_ramp >= m_vector_size)
+                publish();
+        }
+    }
+    
+    void Scope::evaluate()
+    {
+        // The energy of a point is y^T * C * y = sum of (y . r_j)^2 with the rows r_j of the factor of C = R^T * R
+        const double* covariance = m_snapshots->read();
+        const unsigned int rank = matrix_cholesky(covariance, m_number_of_harmonics, m_factor);
+        for(unsigned int i = 0; i < m_number_of_points; i++)
+        {
+            m_matrix[i] = 0.;
+        }
+        for(unsigned int j = 0; j < rank; j++)
+        {
+            m_decoder->process(m_factor + j * m_number_of_harmonics, m_points);
+            for(unsigned int i = 0; i < m_number_of_points; i++)
+                m_matrix[i] += m_points[i] * m_points[i];
+        }
+        for(unsigned int i = 0; i < m_number_of_points; i++)
+        {
+            m_matrix[i] = sqrt(m_matrix[i]);
+        }
+        const double max = fabs(m_matrix[cblas_idamax(m_number_of_points, m_matrix, 1)]);
+        if(max > 1.)
+        {
+            cblas_dscal(m_number_of_points, (1. / max), m_matrix, 1.);
+        }
+    }
+    
     void Scope::process(const float* inputs)
     {
         double max = 1.;
@@ -50,8 +177,12 @@ namespace Hoa2D
     Scope::~Scope()
     {
 		delete [] m_matrix;
+        delete [] m_points;
         delete [] m_harmonics;
+        delete [] m_covariance;
+        delete [] m_factor;
         delete m_decoder;
+        delete m_snapshots;
     }
 	
 }
@@ -9,19 +9,28 @@
 
 #include "Ambisonic.h"
 #include "Decoder.h"
+#include "../HoaCommon/TripleBuffer.h"
 
 namespace Hoa2D
 {
     //! The ambisonic scope.
-    /** The scope discretize a circle by a set of point and uses a decoder to project the circular harmonics on it. This class should be used for graphical interfaces outside the digital signal processing if the number of points to discretize the circle is very large. Then you should prefer to record snapshot of the circular harmonics and to call the process method at an interval adapted to a graphical rendering.
+    /** The scope discretize a circle by a set of point and uses a decoder to project the circular harmonics on it. This class should be used for graphical interfaces outside the digital signal processing if the number of points to discretize the circle is very large. Then you should prefer to record snapshot of the circular harmonics and to call the process method at an interval adapted to a graphical rendering. The scope can also be fed by the audio thread with the accumulate methods that only compute the covariance of the circular harmonics over windows of vector size samples, then the graphical interface evaluates the energy of the last complete window at its own rate with the evaluate method, so the cost of the digital signal processing doesn't depend on the number of points.
      */
     class Scope : public Ambisonic
     {
     private:
         unsigned int    m_number_of_points;
+        unsigned int    m_ramp;
+        unsigned int    m_vector_size;
         double*         m_harmonics;
         double*         m_matrix;
+        double*         m_points;
+        double*         m_covariance;
+        double*         m_factor;
         DecoderRegular* m_decoder;
+        Hoa::TripleBuffer<double>* m_snapshots;
+        
+        void publish();
     public:
         
         //! The scope constructor.
@@ -120,6 +129,64 @@ namespace Hoa2D
             return ordinate(fabs(m_matrix[pointIndex]), getAzimuth(pointIndex));
         }
         
+        //! Set the vector size.
+        /** Set the number of samples of the windows over which the covariance of the circular harmonics is accumulated, a snapshot is published at the end of each window. The default vector size is 256.
+         
+            @param     vectorSize	The vector size.
+         */
+        void setVectorSize(unsigned int vectorSize);
+        
+        //! Get the vector size.
+        /** Retrieve the number of samples of the windows over which the covariance of the circular harmonics is accumulated.
+         
+            @return    The vector size.
+         */
+        inline unsigned int getVectorSize() const
+        {
+            return m_vector_size;
+        }
+        
+        //! This method accumulates the covariance of the circular harmonics with single precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a sample of the circular harmonics, the projection is computed later by the evaluate method. The inputs array contains the circular harmonics samples and the minimum size must be the number of harmonics.
+         
+            @param     inputs   The inputs array.
+            @see       evaluate
+         */
+        void accumulate(const float* inputs);
+        
+        //! This method accumulates the covariance of the circular harmonics with double precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a sample of the circular harmonics, the projection is computed later by the evaluate method. The inputs array contains the circular harmonics samples and the minimum size must be the number of harmonics.
+         
+            @param     inputs   The inputs array.
+            @see       evaluate
+         */
+        void accumulate(const double* inputs);
+        
+        //! This method accumulates the covariance of a block of circular harmonics with single precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a block of the circular harmonics, the projection is computed later by the evaluate method. The inputs array contains the circular harmonics vectors, the minimum size must be the number of harmonics and the vectors must have vector size samples.
+         
+            @param     inputs       The inputs array.
+            @param     vectorSize   The number of samples of the vectors.
+            @see       evaluate
+         */
+        void accumulate(const float* const* inputs, const unsigned int vectorSize);
+        
+        //! This method accumulates the covariance of a block of circular harmonics with double precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a block of the circular harmonics, the projection is computed later by the evaluate method. The inputs array contains the circular harmonics vectors, the minimum size must be the number of harmonics and the vectors must have vector size samples.
+         
+            @param     inputs       The inputs array.
+            @param     vectorSize   The number of samples of the vectors.
+            @see       evaluate
+         */
+        void accumulate(const double* const* inputs, const unsigned int vectorSize);
+        
+        //! This method evaluates the energy of the circular harmonics over the circle.
+        /**	You should use this method in the graphical thread to compute the projection of the covariance of the last complete window on the circle. The radius of a point is the root mean square of the circular harmonics projected on this point, so the values are positive. The covariance is factorized so the cost is at most the number of harmonics times the projection of the process method and it doesn't depend on the audio rate.
+         
+            @see       accumulate
+         */
+        void evaluate();
+        
         //! This method performs the circular harmonics projection with single precision.
         /**	You should use this method to compute the projection of the circular harmonics over an ambisonics circle. The inputs array contains the circular harmonics samples and the minimum size must be the number of harmonics.
          
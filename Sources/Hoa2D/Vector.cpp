@@ -59,8 +59,8 @@ namespace Hoa2D
         for(int i = 0; i < m_number_of_channels; i++)
             veclocitySum += inputs[i];
 		
-        velocityAbscissa = cblas_sdot(m_number_of_channels, inputs, 1, m_channels_abscissa_float, 1);
-        velocityOrdinate = cblas_sdot(m_number_of_channels, inputs, 1, m_channels_ordinate_float, 1);
+        velocityAbscissa = getSimdKernels()->dot_float(inputs, m_channels_abscissa_float, m_number_of_channels);
+        velocityOrdinate = getSimdKernels()->dot_float(inputs, m_channels_ordinate_float, m_number_of_channels);
         if(veclocitySum)
         {
             outputs[0] = velocityAbscissa / veclocitySum;
@@ -80,8 +80,8 @@ namespace Hoa2D
         for(int i = 0; i < m_number_of_channels; i++)
             veclocitySum += inputs[i];
 		
-        velocityAbscissa = cblas_ddot(m_number_of_channels, inputs, 1, m_channels_abscissa_double, 1);
-        velocityOrdinate = cblas_ddot(m_number_of_channels, inputs, 1, m_channels_ordinate_double, 1);
+        velocityAbscissa = getSimdKernels()->dot_double(inputs, m_channels_abscissa_double, m_number_of_channels);
+        velocityOrdinate = getSimdKernels()->dot_double(inputs, m_channels_ordinate_double, m_number_of_channels);
 
         if(veclocitySum)
         {
@@ -104,8 +104,8 @@ namespace Hoa2D
             m_channels_float[i] *= m_channels_float[i];
 
         energySum = cblas_sasum(m_number_of_channels, m_channels_float, 1);
-        energyAbscissa = cblas_sdot(m_number_of_channels, m_channels_float, 1, m_channels_abscissa_float, 1);
-        energyOrdinate = cblas_sdot(m_number_of_channels, m_channels_float, 1, m_channels_ordinate_float, 1);
+        energyAbscissa = getSimdKernels()->dot_float(m_channels_float, m_channels_abscissa_float, m_number_of_channels);
+        energyOrdinate = getSimdKernels()->dot_float(m_channels_float, m_channels_ordinate_float, m_number_of_channels);
 
         if(energySum)
         {
@@ -129,8 +129,8 @@ namespace Hoa2D
             m_channels_double[i] *= m_channels_double[i];
 
         energySum = cblas_dasum(m_number_of_channels, m_channels_double, 1);
-        energyAbscissa = cblas_ddot(m_number_of_channels, m_channels_double, 1, m_channels_abscissa_double, 1);
-        energyOrdinate = cblas_ddot(m_number_of_channels, m_channels_double, 1, m_channels_ordinate_double, 1);
+        energyAbscissa = getSimdKernels()->dot_double(m_channels_double, m_channels_abscissa_double, m_number_of_channels);
+        energyOrdinate = getSimdKernels()->dot_double(m_channels_double, m_channels_ordinate_double, m_number_of_channels);
 
         if(energySum)
         {
@@ -46,14 +46,28 @@ namespace Hoa2D
     
     void Wider::process(const float* inputs, float* outputs)
     {
-        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            outputs[i] = inputs[i] * m_wide_matrix[m_wide * m_number_of_harmonics+ i];
+        if(m_kernels_float)
+            m_kernels_float->weight(m_wide_matrix + m_wide * m_number_of_harmonics, inputs, outputs);
+        else
+            weight_vectors<float>(m_number_of_harmonics, m_wide_matrix + m_wide * m_number_of_harmonics, Frame<const float>(inputs), Frame<float>(outputs), 1);
     }
     
     void Wider::process(const double* inputs, double* outputs)
     {
-        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            outputs[i] = inputs[i] * m_wide_matrix[m_wide * m_number_of_harmonics + i];
+        if(m_kernels_double)
+            m_kernels_double->weight(m_wide_matrix + m_wide * m_number_of_harmonics, inputs, outputs);
+        else
+            weight_vectors<double>(m_number_of_harmonics, m_wide_matrix + m_wide * m_number_of_harmonics, Frame<const double>(inputs), Frame<double>(outputs), 1);
+    }
+    
+    void Wider::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        weight_vectors<float>(m_number_of_harmonics, m_wide_matrix + m_wide * m_number_of_harmonics, inputs, outputs, vectorSize);
+    }
+    
+    void Wider::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        weight_vectors<double>(m_number_of_harmonics, m_wide_matrix + m_wide * m_number_of_harmonics, inputs, outputs, vectorSize);
     }
     
     Wider::~Wider()
@@ -12,6 +12,8 @@ namespace Hoa3D
     {
         m_order					= order;
         m_number_of_harmonics	= (m_order + 1) * (m_order + 1);
+        m_kernels_float         = getKernels<float>(m_order);
+        m_kernels_double        = getKernels<double>(m_order);
         
         m_harmonics_orders   = new int[m_number_of_harmonics];
         m_harmonics_degrees      = new unsigned int[m_number_of_harmonics];
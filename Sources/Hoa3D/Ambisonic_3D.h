@@ -8,6 +8,8 @@
 #define __DEF_HOA_3D_AMBISONIC__
 
 #include "../Hoa.h"
+#include "Kernels_3D.h"
+
 //! The 3D ambisonic classes.
 /**
  All the 3D ambisonic and planewaves classes will be part of this namespace
@@ -24,6 +26,8 @@ namespace Hoa3D
         unsigned int	m_number_of_harmonics;
         unsigned int*   m_harmonics_degrees;
         int*            m_harmonics_orders;
+        const KernelsTable<float>*  m_kernels_float;
+        const KernelsTable<double>* m_kernels_double;
         
     public:
         
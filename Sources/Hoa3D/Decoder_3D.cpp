@@ -11,30 +11,41 @@ namespace Hoa3D
 	DecoderRegular::DecoderRegular(unsigned int order, unsigned int numberOfChannels) : Ambisonic(order), Planewaves(numberOfChannels)
 	{
         m_harmonics_vector          = new double[m_number_of_harmonics];
-        m_decoder_matrix            = new double[m_number_of_channels * m_number_of_harmonics];
-        m_decoder_matrix_float      = new float[m_number_of_channels * m_number_of_harmonics];
+        m_matrix                    = new Hoa::MatrixInterpolator(m_number_of_channels, m_number_of_harmonics);
         m_encoder                   = new Encoder(m_order);
         setChannelsPosition(m_channels_azimuth, m_channels_elevation);
 	}
 	
-	void DecoderRegular::setChannelPosition(unsigned int index, double azimuth, double elevation)
+	void DecoderRegular::computeMatrix()
 	{
-        Planewaves::setChannelPosition(index, azimuth, elevation);
-        
-        m_encoder->setAzimuth(m_channels_rotated_azimuth[index]);
-        m_encoder->setElevation(m_channels_rotated_elevation[index]);
-        m_encoder->process(12.5 / (double)((m_order+1.)*(m_order+1.)), m_harmonics_vector);
-        
-        for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+        Hoa::Coefficients* matrix = new Hoa::Coefficients(m_number_of_channels * m_number_of_harmonics);
+        double* matrix_double = matrix->getDouble();
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
         {
-            m_decoder_matrix_float[index * m_number_of_harmonics + j] = m_decoder_matrix[index * m_number_of_harmonics + j] = m_harmonics_vector[j] * m_encoder->getNormalization(j) * m_encoder->getNormalization(j);
+            m_encoder->setAzimuth(m_channels_rotated_azimuth[i]);
+            m_encoder->setElevation(m_channels_rotated_elevation[i]);
+            m_encoder->process(12.5 / (double)((m_order+1.)*(m_order+1.)), m_harmonics_vector);
+            
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+            {
+                matrix_double[i * m_number_of_harmonics + j] = m_harmonics_vector[j] * m_encoder->getNormalization(j) * m_encoder->getNormalization(j);
+            }
         }
+        matrix->update();
+        m_matrix->publish(matrix);
+	}
+	
+	void DecoderRegular::setChannelPosition(unsigned int index, double azimuth, double elevation)
+	{
+        Planewaves::setChannelPosition(index, azimuth, elevation);
+        computeMatrix();
 	}
     
     void DecoderRegular::setChannelsPosition(double* azimuths, double* elevations)
 	{
         for(unsigned int i = 0; i < m_number_of_channels; i++)
-            setChannelPosition(i, azimuths[i], elevations[i]);
+            Planewaves::setChannelPosition(i, azimuths[i], elevations[i]);
+        computeMatrix();
 	}
     
     void DecoderRegular::setChannelsRotation(double axis_x, double axis_y, double axis_z)
@@ -45,26 +56,266 @@ namespace Hoa3D
 	
 	void DecoderRegular::process(const float* input, float* output)
 	{
-		cblas_sgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1.f, m_decoder_matrix_float, m_number_of_harmonics, input, 1, 0.f, output, 1);
+		m_matrix->process(input, output);
 	}
 	
 	void DecoderRegular::process(const double* input, double* output)
 	{
-		cblas_dgemv(CblasRowMajor, CblasNoTrans, m_number_of_channels, m_number_of_harmonics, 1., m_decoder_matrix, m_number_of_harmonics, input, 1, 0., output, 1);
+		m_matrix->process(input, output);
+	}
+    
+    void DecoderRegular::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+    
+    void DecoderRegular::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
 	}
 	
 	DecoderRegular::~DecoderRegular()
 	{
-		delete [] m_decoder_matrix;
-        delete [] m_decoder_matrix_float;
+		delete m_matrix;
         delete [] m_harmonics_vector;
         delete m_encoder;
 	}
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Decoder Irregular //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    DecoderIrregular::DecoderIrregular(unsigned int order, unsigned int numberOfChannels, Mode mode) : Ambisonic(order), Planewaves(numberOfChannels)
+	{
+        m_mode                      = mode;
+        m_matrix                    = new Hoa::MatrixInterpolator(m_number_of_channels, m_number_of_harmonics);
+        m_encoder                   = new Encoder(m_order, Encoder::Recurrence);
+        m_vbap                      = new Vbap(m_number_of_channels);
+        computeMatrix();
+	}
+    
+    void DecoderIrregular::computeMatrix()
+	{
+        Hoa::Coefficients* matrix = new Hoa::Coefficients(m_number_of_channels * m_number_of_harmonics);
+        Hoa::MatrixCache::Key key;
+        key.hash                = Hoa::MatrixCache::getHash(m_channels_rotated_azimuth, m_number_of_channels);
+        key.hash                = Hoa::MatrixCache::getHash(m_channels_rotated_elevation, m_number_of_channels, key.hash);
+        key.dimension           = 3;
+        key.order               = m_order;
+        key.numberOfChannels    = m_number_of_channels;
+        key.mode                = m_mode;
+        const std::string path = m_cache_directory.empty() ? "" : Hoa::MatrixCache::getPath(m_cache_directory, key);
+        if(path.empty() || !Hoa::MatrixCache::read(path, key, matrix->getDouble(), m_number_of_channels * m_number_of_harmonics))
+        {
+            designMatrix(matrix->getDouble());
+            if(!path.empty())
+                Hoa::MatrixCache::write(path, key, matrix->getDouble(), m_number_of_channels * m_number_of_harmonics);
+        }
+        matrix->update();
+        m_matrix->publish(matrix);
+	}
+    
+    void DecoderIrregular::designMatrix(double* matrix)
+    {
+        // The sphere is sampled with a Gauss-Legendre product grid, it integrates exactly the products of harmonics of
+        // order 2 * rows - 1 and it is at least as dense as the 240 directions of a 21-design for the virtual channels.
+        const unsigned int rows         = std::max(2 * m_order + 2, (unsigned int)11);
+        const unsigned int columns      = 2 * rows;
+        const unsigned int size         = rows * columns;
+        const unsigned int channels     = m_number_of_channels;
+        const unsigned int harmonics    = m_number_of_harmonics;
+        double* nodes       = new double[rows];
+        double* weights     = new double[rows];
+        double* grid        = new double[harmonics * size];
+        double* azimuths    = new double[std::max(size, channels)];
+        double* elevations  = new double[std::max(size, channels)];
+        double* gridWeights = new double[size];
+        double* scales      = new double[harmonics];
+        double* speakers    = new double[channels * harmonics];
+        double* gains       = new double[channels];
+        gauss_legendre(rows, nodes, weights);
+        for(unsigned int i = 0; i < rows; i++)
+        {
+            for(unsigned int j = 0; j < columns; j++)
+            {
+                azimuths[i * columns + j]       = (double)j * HOA_2PI / (double)columns;
+                elevations[i * columns + j]     = asin(nodes[i]) + HOA_PI2;
+                gridWeights[i * columns + j]    = weights[i] * 0.5 / (double)columns;
+            }
+        }
+        
+        // The grid stores a row of directions for each harmonic, the harmonics of the encoder are the orthonormal
+        // harmonics divided by their normalization and their elevation is measured from the equator instead of the pole.
+        spherical_harmonics_batch(m_order, size, azimuths, elevations, grid);
+        for(unsigned int i = 0; i < harmonics; i++)
+        {
+            const double factor = 1. / m_encoder->getNormalization(i);
+            for(unsigned int k = 0; k < size; k++)
+                grid[i * size + k] *= factor;
+        }
+        
+        // The harmonics of the encoder are scaled so their mean square over the sphere is 1 and the target energy is the
+        // mean energy of the regular decoder, the sum over the channels of its squared kernel. The grid integrates the
+        // products of the harmonics exactly so their Gram matrix is diagonal, the mean square of the orthonormal
+        // harmonics is 1 / 4pi.
+        double target = 0.;
+        for(unsigned int i = 0; i < harmonics; i++)
+        {
+            const double gram   = 1. / (4. * HOA_PI * m_encoder->getNormalization(i) * m_encoder->getNormalization(i));
+            const double factor = 12.5 / (double)((m_order+1.)*(m_order+1.)) * m_encoder->getNormalization(i) * m_encoder->getNormalization(i);
+            target += factor * factor * gram * gram;
+            scales[i] = 1. / sqrt(gram);
+        }
+        target *= channels;
+        
+        for(unsigned int i = 0; i < channels * harmonics; i++)
+            matrix[i] = 0.;
+        if(m_mode == AllRad)
+        {
+            m_vbap->setChannelsPosition(m_channels_rotated_azimuth, m_channels_rotated_elevation);
+            for(unsigned int i = 0; i < rows; i++)
+            {
+                for(unsigned int j = 0; j < columns; j++)
+                {
+                    const unsigned int k = i * columns + j;
+                    m_vbap->getGains((double)j * HOA_2PI / (double)columns, asin(nodes[i]), gains);
+                    for(unsigned int c = 0; c < channels; c++)
+                    {
+                        if(gains[c] == 0.)
+                            continue;
+                        for(unsigned int l = 0; l < harmonics; l++)
+                            matrix[c * harmonics + l] += gains[c] * gridWeights[k] * grid[l * size + k] * scales[l];
+                    }
+                }
+            }
+        }
+        else
+        {
+            // The encoding of the channels is inverted with its singular value decomposition, the mode matching keeps
+            // the well conditioned singular values and the energy preserving decoding replaces them with 1. The null
+            // singular values of the layouts that don't span all the harmonics have arbitrary vectors so both drop them.
+            const unsigned int rank = std::min(channels, harmonics);
+            double* left    = new double[channels * rank];
+            double* values  = new double[rank];
+            double* right   = new double[harmonics * rank];
+            double* encoding = new double[harmonics * channels];
+            for(unsigned int c = 0; c < channels; c++)
+                elevations[c] = m_channels_rotated_elevation[c] + HOA_PI2;
+            spherical_harmonics_batch(m_order, channels, m_channels_rotated_azimuth, elevations, encoding);
+            for(unsigned int c = 0; c < channels; c++)
+            {
+                for(unsigned int l = 0; l < harmonics; l++)
+                    speakers[c * harmonics + l] = encoding[l * channels + c] / m_encoder->getNormalization(l) * scales[l];
+            }
+            delete [] encoding;
+            matrix_svd(speakers, channels, harmonics, left, values, right);
+            for(unsigned int r = 0; r < rank; r++)
+            {
+                double factor = (values[r] > values[0] * 1e-9) ? 1. : 0.;
+                if(m_mode == ModeMatching)
+                    factor = (values[r] > values[0] * 1e-2) ? 1. / values[r] : 0.;
+                for(unsigned int c = 0; c < channels; c++)
+                {
+                    for(unsigned int l = 0; l < harmonics; l++)
+                        matrix[c * harmonics + l] += left[c * rank + r] * factor * right[l * rank + r];
+                }
+            }
+            delete [] left;
+            delete [] values;
+            delete [] right;
+        }
+        
+        // The matrix is converted to the harmonics of the encoder and normalized to the target energy
+        for(unsigned int c = 0; c < channels; c++)
+        {
+            for(unsigned int l = 0; l < harmonics; l++)
+                matrix[c * harmonics + l] *= scales[l];
+        }
+        double energy = 0.;
+        for(unsigned int k = 0; k < size; k++)
+        {
+            for(unsigned int c = 0; c < channels; c++)
+            {
+                const double output = cblas_ddot(harmonics, matrix + c * harmonics, 1, grid + k, size);
+                energy += gridWeights[k] * output * output;
+            }
+        }
+        const double scale = energy > 0. ? sqrt(target / energy) : 0.;
+        for(unsigned int i = 0; i < channels * harmonics; i++)
+            matrix[i] *= scale;
+        
+        delete [] nodes;
+        delete [] weights;
+        delete [] grid;
+        delete [] azimuths;
+        delete [] elevations;
+        delete [] gridWeights;
+        delete [] scales;
+        delete [] speakers;
+        delete [] gains;
+    }
+    
+    void DecoderIrregular::setDecodingMode(Mode mode)
+    {
+        m_mode = mode;
+        computeMatrix();
+    }
+    
+    void DecoderIrregular::setCacheDirectory(const std::string& directory)
+    {
+        m_cache_directory = directory;
+    }
 	
+	void DecoderIrregular::setChannelPosition(unsigned int index, double azimuth, double elevation)
+	{
+        Planewaves::setChannelPosition(index, azimuth, elevation);
+        computeMatrix();
+	}
+    
+    void DecoderIrregular::setChannelsPosition(double* azimuths, double* elevations)
+	{
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+            Planewaves::setChannelPosition(i, azimuths[i], elevations[i]);
+        computeMatrix();
+	}
+    
+    void DecoderIrregular::setChannelsRotation(double axis_x, double axis_y, double axis_z)
+    {
+        Planewaves::setChannelsRotation(axis_x, axis_y, axis_z);
+        computeMatrix();
+    }
+	
+	void DecoderIrregular::process(const float* input, float* output)
+	{
+		m_matrix->process(input, output);
+	}
+	
+	void DecoderIrregular::process(const double* input, double* output)
+	{
+		m_matrix->process(input, output);
+	}
+    
+    void DecoderIrregular::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+    
+    void DecoderIrregular::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        m_matrix->process(inputs, outputs, vectorSize);
+	}
+	
+	DecoderIrregular::~DecoderIrregular()
+	{
+		delete m_matrix;
+        delete m_encoder;
+        delete m_vbap;
+	}
+    
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Decoder Binaural //
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
+    
     DecoderBinaural::DecoderBinaural(unsigned int order) : Ambisonic(order), Planewaves(2)
     {
         m_channels_azimuth[0] = HOA_PI2;
@@ -87,6 +338,108 @@ namespace Hoa3D
         m_pinna_size = Small;
         m_outputs_double    = new double[m_decoder->getNumberOfChannels()];
         m_outputs_float     = new float[m_decoder->getNumberOfChannels()];
+        m_inputs_vectors_float  = new const float*[m_number_of_harmonics];
+        m_inputs_vectors_double = new const double*[m_number_of_harmonics];
+        m_chunk_float           = new float[m_decoder->getNumberOfChannels() * NUMBEROFCHUNKPOINTS];
+        m_chunk_double          = new double[m_decoder->getNumberOfChannels() * NUMBEROFCHUNKPOINTS];
+        m_chunk_vectors_float   = new float*[m_decoder->getNumberOfChannels()];
+        m_chunk_vectors_double  = new double*[m_decoder->getNumberOfChannels()];
+        for(unsigned int i = 0; i < m_decoder->getNumberOfChannels(); i++)
+        {
+            m_chunk_vectors_float[i]    = m_chunk_float + i * NUMBEROFCHUNKPOINTS;
+            m_chunk_vectors_double[i]   = m_chunk_double + i * NUMBEROFCHUNKPOINTS;
+        }
+        m_binaural_filters = new Hoa::Exchanger<Hoa::BinauralFilters>(new Hoa::BinauralFilters(NULL));
+    }
+    
+    void DecoderBinaural::setImpulses(const float* const* left, const float* const* right, const unsigned int size)
+    {
+        if(!left || !right || !size)
+        {
+            m_binaural_filters->publish(new Hoa::BinauralFilters(NULL));
+            return;
+        }
+        
+        const unsigned int number_of_channels = m_decoder->getNumberOfChannels();
+        const double* matrix = m_decoder->getDecodingMatrix();
+        float* impulses = new float[2 * m_number_of_harmonics * size];
+        const float** impulses_vectors = new const float*[2 * m_number_of_harmonics];
+        for(unsigned int i = 0; i < 2 * m_number_of_harmonics * size; i++)
+            impulses[i] = 0.f;
+        
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            float* impulse_left     = impulses + i * size;
+            float* impulse_right    = impulses + (m_number_of_harmonics + i) * size;
+            for(unsigned int j = 0; j < number_of_channels; j++)
+            {
+                const float gain = matrix[j * m_number_of_harmonics + i];
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    impulse_left[k]     += gain * left[j][k];
+                    impulse_right[k]    += gain * right[j][k];
+                }
+            }
+            impulses_vectors[i]                         = impulse_left;
+            impulses_vectors[m_number_of_harmonics + i] = impulse_right;
+        }
+        
+        Hoa::Convolver* convolver = new Hoa::Convolver(m_number_of_harmonics, 2, NUMBEROFCHUNKPOINTS);
+        convolver->setImpulses(impulses_vectors, size);
+        m_binaural_filters->publish(new Hoa::BinauralFilters(convolver));
+        delete [] impulses;
+        delete [] impulses_vectors;
+    }
+    
+    bool DecoderBinaural::loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory)
+    {
+        Hoa::HrirSet set;
+        if(!set.read(path) || sampleRate <= 0.)
+            return false;
+        
+        Hoa::BinauralCache::Key key;
+        key.hash            = set.getHash();
+        key.dimension       = 3;
+        key.order           = m_order;
+        key.sampleRate      = (unsigned int)(sampleRate + 0.5);
+        key.partitionSize   = NUMBEROFCHUNKPOINTS;
+        const std::string cache_path = cacheDirectory.empty() ? "" : Hoa::BinauralCache::getPath(cacheDirectory, key);
+        if(!cache_path.empty())
+        {
+            Hoa::BinauralCache* cache = new Hoa::BinauralCache();
+            if(cache->map(cache_path, key, m_number_of_harmonics, 2))
+            {
+                Hoa::Convolver* convolver = new Hoa::Convolver(m_number_of_harmonics, 2, NUMBEROFCHUNKPOINTS);
+                convolver->setImpulses(cache->getHeads(), cache->getImpulsesReal(), cache->getImpulsesImag(), cache->getNumberOfPartitions());
+                m_binaural_filters->publish(new Hoa::BinauralFilters(convolver, cache));
+                return true;
+            }
+            delete cache;
+        }
+        
+        if(!set.decode())
+            return false;
+        const unsigned int number_of_channels = m_decoder->getNumberOfChannels();
+        const unsigned int size = set.getSize(sampleRate);
+        float* impulses = new float[number_of_channels * size * 2];
+        const float** left  = new const float*[number_of_channels];
+        const float** right = new const float*[number_of_channels];
+        for(unsigned int i = 0; i < number_of_channels; i++)
+        {
+            const unsigned int index = set.getClosestDirection(m_decoder->getChannelAzimuth(i), m_decoder->getChannelElevation(i));
+            left[i]     = impulses + i * size * 2;
+            right[i]    = impulses + i * size * 2 + size;
+            set.getImpulse(index, false, sampleRate, impulses + i * size * 2);
+            set.getImpulse(index, true, sampleRate, impulses + i * size * 2 + size);
+        }
+        setImpulses(left, right, size);
+        delete [] impulses;
+        delete [] left;
+        delete [] right;
+        
+        if(!cache_path.empty())
+            Hoa::BinauralCache::write(cache_path, key, *m_binaural_filters->getLatest()->getConvolver());
+        return true;
     }
     
     void DecoderBinaural::setChannelsRotation(double axis_x, double axis_y, double axis_z)
@@ -118,6 +471,12 @@ namespace Hoa3D
     
     void DecoderBinaural::process(const float* inputs, float* outputs)
 	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs);
+            return;
+        }
         outputs[0] = 0.f;
         outputs[1] = 0.f;
         m_decoder->process(inputs, m_outputs_float);
@@ -130,6 +489,12 @@ namespace Hoa3D
     
     void DecoderBinaural::process(const double* inputs, double* outputs)
 	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs);
+            return;
+        }
         outputs[0] = 0.f;
         outputs[1] = 0.f;
         m_decoder->process(inputs, m_outputs_double);
@@ -140,13 +505,78 @@ namespace Hoa3D
         }
     }
     
+    void DecoderBinaural::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs, vectorSize);
+            return;
+        }
+        const unsigned int number_of_channels = m_decoder->getNumberOfChannels();
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                m_inputs_vectors_float[i] = inputs[i] + offset;
+            m_decoder->process(m_inputs_vectors_float, m_chunk_vectors_float, size);
+            for(unsigned int k = 0; k < size; k++)
+            {
+                float left = 0.f, right = 0.f;
+                for(unsigned int i = 0; i < number_of_channels; i++)
+                {
+                    left    += m_filters_left[i].process(m_chunk_vectors_float[i][k]);
+                    right   += m_filters_right[i].process(m_chunk_vectors_float[i][k]);
+                }
+                outputs[0][offset + k] = left;
+                outputs[1][offset + k] = right;
+            }
+        }
+    }
+    
+    void DecoderBinaural::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+	{
+        Hoa::Convolver* convolver = m_binaural_filters->acquire()->getConvolver();
+        if(convolver && convolver->getState())
+        {
+            convolver->process(inputs, outputs, vectorSize);
+            return;
+        }
+        const unsigned int number_of_channels = m_decoder->getNumberOfChannels();
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                m_inputs_vectors_double[i] = inputs[i] + offset;
+            m_decoder->process(m_inputs_vectors_double, m_chunk_vectors_double, size);
+            for(unsigned int k = 0; k < size; k++)
+            {
+                double left = 0., right = 0.;
+                for(unsigned int i = 0; i < number_of_channels; i++)
+                {
+                    left    += m_filters_left[i].process(m_chunk_vectors_double[i][k]);
+                    right   += m_filters_right[i].process(m_chunk_vectors_double[i][k]);
+                }
+                outputs[0][offset + k] = left;
+                outputs[1][offset + k] = right;
+            }
+        }
+    }
+	
 	DecoderBinaural::~DecoderBinaural()
 	{
+        delete m_binaural_filters;
         delete m_decoder;
         m_filters_left.clear();
         m_filters_right.clear();
         delete [] m_outputs_double;
         delete [] m_outputs_float;
+        delete [] m_inputs_vectors_float;
+        delete [] m_inputs_vectors_double;
+        delete [] m_chunk_float;
+        delete [] m_chunk_double;
+        delete [] m_chunk_vectors_float;
+        delete [] m_chunk_vectors_double;
 	}
     
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -156,20 +586,22 @@ namespace Hoa3D
     DecoderMulti::DecoderMulti(unsigned int order) : Ambisonic(order)
     {
         m_mode = Regular;
-        m_decoder_regular   = new DecoderRegular(m_order, (m_order + 1) * (m_order + 1));
+        m_decoder_regular   = new Hoa::Exchanger<DecoderRegular>(new DecoderRegular(m_order, (m_order + 1) * (m_order + 1)));
         m_decoder_binaural  = new DecoderBinaural(m_order);
+        m_ramp_length       = NUMBEROFRAMPPOINTS;
     }
 	
 	DecoderMulti::DecoderMulti(unsigned int order, unsigned int numberOfChannels) : Ambisonic(order)
     {
         m_mode = Regular;
-        m_decoder_regular   = new DecoderRegular(m_order, numberOfChannels);
+        m_decoder_regular   = new Hoa::Exchanger<DecoderRegular>(new DecoderRegular(m_order, numberOfChannels));
         m_decoder_binaural  = new DecoderBinaural(m_order);
+        m_ramp_length       = NUMBEROFRAMPPOINTS;
     }
     
     void DecoderMulti::setDecodingMode(Mode mode)
     {
-        m_mode = mode;
+        Hoa::atomic_store(&m_mode, mode);
     }
     
     void DecoderMulti::setNumberOfChannels(unsigned int numberOfChannels)
@@ -178,17 +610,24 @@ namespace Hoa3D
         {
             if(m_mode == Regular)
             {
-                delete m_decoder_regular;
-                m_decoder_regular = new DecoderRegular(m_order, numberOfChannels);
+                DecoderRegular* decoder = new DecoderRegular(m_order, numberOfChannels);
+                decoder->setRampLength(m_ramp_length);
+                m_decoder_regular->publish(decoder);
             }
         }
     }
     
+    void DecoderMulti::setRampLength(unsigned int numberOfSamples)
+    {
+        m_ramp_length = numberOfSamples;
+        m_decoder_regular->getLatest()->setRampLength(m_ramp_length);
+    }
+    
     void DecoderMulti::setChannelPosition(unsigned int index, double azimuth, double elevation)
     {
         if(m_mode == Regular)
         {
-            m_decoder_regular->setChannelPosition(index, azimuth, elevation);
+            m_decoder_regular->getLatest()->setChannelPosition(index, azimuth, elevation);
         }
     }
     
@@ -196,13 +635,13 @@ namespace Hoa3D
     {
         if(m_mode == Regular)
         {
-            m_decoder_regular->setChannelsPosition(azimuths, elevations);
+            m_decoder_regular->getLatest()->setChannelsPosition(azimuths, elevations);
         }
     }
     
     void DecoderMulti::setChannelsRotation(double axis_x, double axis_y, double axis_z)
     {
-        m_decoder_regular->setChannelsRotation(axis_x, axis_y, axis_z);
+        m_decoder_regular->getLatest()->setChannelsRotation(axis_x, axis_y, axis_z);
         m_decoder_binaural->setChannelsRotation(axis_x, axis_y, axis_z);
     }
     
@@ -211,12 +650,17 @@ namespace Hoa3D
         m_decoder_binaural->setPinnaSize(pinnaSize);
     }
     
+    bool DecoderMulti::loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory)
+    {
+        return m_decoder_binaural->loadImpulses(path, sampleRate, cacheDirectory);
+    }
+    
     void DecoderMulti::setSampleRate(double sampleRate)
     {
         m_decoder_binaural->setSampleRate(sampleRate);
         m_sample_rate = sampleRate;
     }
-    
+	
 	DecoderMulti::~DecoderMulti()
 	{
         delete m_decoder_regular;
@@ -10,33 +10,41 @@
 #include "Ambisonic_3D.h"
 #include "Planewaves_3D.h"
 #include "Encoder_3D.h"
+#include "Vbap_3D.h"
+#include "../HoaCommon/HrirSet.h"
+#include "../HoaCommon/BinauralCache.h"
+#include "../HoaCommon/MatrixCache.h"
+#include "../HoaCommon/MatrixInterpolator.h"
 
 namespace Hoa3D
 {
 	//! The ambisonic decoder.
-    /** The decoder should be used to decode a signal encoded in the spherical harmonics domain depending on a decomposition order and a number of channels.
+    /** The decoder should be used to decode a signal encoded in the spherical harmonics domain depending on a decomposition order and a number of channels. The decoding matrix is computed by the control thread in a new buffer and published to the audio thread with an atomic swap, so the position and the rotation of the channels can be changed while processing. The decoder interpolates from the previous matrix to the new one over a number of samples so the changes don't click.
      */
 	class DecoderRegular : public Ambisonic, public Planewaves
 	{
-		
+	
 	private:
-		double*         m_decoder_matrix;
-        float*          m_decoder_matrix_float;
+        Hoa::MatrixInterpolator* m_matrix;
 		double*         m_harmonics_vector;
-        Encoder*        m_encoder;        
-	public:
+        Encoder*        m_encoder;
         
+        /**	Compute the decoding matrix for the current position of the channels and publish it to the audio thread.
+         */
+        void computeMatrix();
+	public:
+		
 		/**	The decoder constructor.
          @param     order					The order, must be at least 1.
 		 @param     numberOfChannels	The number of channels, must be at least (order + 1)^2.
 		 @param     shape					Is a sphere or a half sphere.
          */
 		DecoderRegular(unsigned int order, unsigned int numberOfChannels);
-		
+        
         /**	The decoder destructor.
          */
 		~DecoderRegular();
-        
+		
 		/**	Set channel position.
 		 @param     index		The index of the channel.
 		 @param     azimuth		An azimuth value. In radian, between 0 and 2π.
@@ -60,7 +68,181 @@ namespace Hoa3D
          @param     axis_z	The angle of rotation around the z axe.
          */
 		void setChannelsRotation(double axis_x, double axis_y, double axis_z);
+        
+        //! Retrieve the decoding matrix.
+        /**	Retrieve the last decoding matrix computed by the control thread, the matrix contains one row of harmonics for each channel. This method must only be called by the control thread.
+         
+            @return    The decoding matrix.
+         */
+        inline const double* getDecodingMatrix() const
+        {
+            return m_matrix->getLatest()->getDouble();
+        };
+        
+        //! Set the length of the interpolation of the decoding matrix.
+        /**	Set the number of samples of the interpolation from the previous decoding matrix to the new one when the channels change, 0 means that the new matrix is used immediately. The default length is NUMBEROFRAMPPOINTS samples.
+         
+            @param     numberOfSamples  The number of samples of the interpolation.
+         */
+        inline void setRampLength(unsigned int numberOfSamples)
+        {
+            m_matrix->setRampLength(numberOfSamples);
+        };
+        
+        /**	Retrieve the number of samples of the interpolation of the decoding matrix.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return m_matrix->getRampLength();
+        };
+        
+        /**	This method performs the decoding with single precision.
+         @param     input	The inputs array.
+         @param     outputs The output array that contains samples destinated to channels.
+         */
+		void process(const float* input, float* output);
+		
+		/**	This method performs the decoding with double precision.
+         @param     input	The inputs array.
+         @param     outputs The output array that contains samples destinated to channels.
+         */
+		void process(const double* input, double* output);
+        
+        /**	This method performs the decoding with single precision on a block of samples. The inputs array contains one vector for each spherical harmonic and the outputs array contains one vector for each channel. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product, so the processing can be in-place.
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        /**	This method performs the decoding with double precision on a block of samples. The inputs array contains one vector for each spherical harmonic and the outputs array contains one vector for each channel. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product, so the processing can be in-place.
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+	};
+    
+    //! The ambisonic irregular decoder.
+    /** The irregular decoder should be used to decode a signal encoded in the spherical harmonics domain for a set of channels that doesn't cover the sphere regularly, like a dome. The decoding matrix is designed by the control thread with one of the three methods : the all-round ambisonic decoding that decodes on a dense virtual layout and pans the virtual channels on the channels with the vector base amplitude panning, the mode matching that inverts the encoding of the channels with the pseudo-inverse of its singular value decomposition, or the energy preserving decoding that only keeps the singular vectors of this decomposition. The matrix is normalized so its mean energy is the one of the regular decoder with the same number of channels. The design is expensive so the matrix can be cached on the disk with the layout, then the decoding has the same cost as the regular decoder. For futher information : Franz Zotter and Matthias Frank, All-Round Ambisonic Panning and Decoding. Journal of the Audio Engineering Society, 60(10), 2012.
+     */
+	class DecoderIrregular : public Ambisonic, public Planewaves
+	{
+    public:
+        
+        enum Mode
+        {
+            AllRad              = 0,	/**< All-round ambisonic decoding */
+            ModeMatching        = 1,	/**< Mode matching decoding */
+            EnergyPreserving    = 2     /**< Energy preserving decoding */
+        };
+	
+	private:
+        Mode                        m_mode;
+        std::string                 m_cache_directory;
+        Hoa::MatrixInterpolator*    m_matrix;
+        Encoder*                    m_encoder;
+        Vbap*                       m_vbap;
+        
+        /**	Read the decoding matrix of the current position of the channels in the cache or design it, and publish it to the audio thread.
+         */
+        void computeMatrix();
+        
+        /**	Design the decoding matrix of the current position of the channels with the current mode.
+         */
+        void designMatrix(double* matrix);
+	public:
+		
+		/**	The irregular decoder constructor.
+         @param     order				The order, must be at least 1.
+		 @param     numberOfChannels	The number of channels, must be at least 1.
+		 @param     mode				The design of the decoding matrix.
+         */
+		DecoderIrregular(unsigned int order, unsigned int numberOfChannels, Mode mode = AllRad);
+        
+        /**	The irregular decoder destructor.
+         */
+		~DecoderIrregular();
+        
+        //! Set the design of the decoding matrix.
+        /**	Set the method used to design the decoding matrix and compute the matrix.
+         
+            @param     mode		The design of the decoding matrix.
+         */
+        void setDecodingMode(Mode mode);
+        
+        /**	Retrieve the design of the decoding matrix.
+         */
+        inline Mode getDecodingMode() const
+        {
+            return m_mode;
+        };
+        
+        //! Set the directory of the cache.
+        /**	Set the directory where the decoding matrices are cached, an empty string means that the matrices are not cached. The matrices are identified by the rotated positions of the channels, the order and the mode, they are read from the cache when the channels change instead of being designed again.
+         
+            @param     directory    The directory of the cache files.
+         */
+        void setCacheDirectory(const std::string& directory);
+        
+        /**	Retrieve the directory of the cache.
+         */
+        inline const std::string& getCacheDirectory() const
+        {
+            return m_cache_directory;
+        };
 		
+		/**	Set channel position.
+		 @param     index		The index of the channel.
+		 @param     azimuth		An azimuth value. In radian, between 0 and 2π.
+		 @param     elevation	An elevation value. In radian, between 0 and 2π.
+         */
+		void	setChannelPosition(unsigned int index, double azimuth, double elevation);
+        
+        //! Set the position of the channels.
+        /** Set the position of the channels with polar coordinates. The azimtuh is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The elevation is in radian between -1/2 Pi and 1/2 Pi, -1/2 Pi the the bottom of the sound field, 0 is the center of the sound field and 1/2 Pi is the top of the sound field. The maximum index must be the number of channels - 1.
+         
+         @param     azimuths		The azimuths.
+         @param     elevations	The elevations.
+         */
+		void setChannelsPosition(double* azimuths, double* elevations);
+        
+        //! Set the rotation of the channels.
+		/**	Set the angles in radian of the rotation of the channels around the axes x, y and z.
+         
+         @param     axis_x	The angle of rotation around the x axe.
+         @param     axis_y	The angle of rotation around the y axe.
+         @param     axis_z	The angle of rotation around the z axe.
+         */
+		void setChannelsRotation(double axis_x, double axis_y, double axis_z);
+        
+        //! Retrieve the decoding matrix.
+        /**	Retrieve the last decoding matrix computed by the control thread, the matrix contains one row of harmonics for each channel. This method must only be called by the control thread.
+         
+            @return    The decoding matrix.
+         */
+        inline const double* getDecodingMatrix() const
+        {
+            return m_matrix->getLatest()->getDouble();
+        };
+        
+        //! Set the length of the interpolation of the decoding matrix.
+        /**	Set the number of samples of the interpolation from the previous decoding matrix to the new one when the channels change, 0 means that the new matrix is used immediately. The default length is NUMBEROFRAMPPOINTS samples.
+         
+            @param     numberOfSamples  The number of samples of the interpolation.
+         */
+        inline void setRampLength(unsigned int numberOfSamples)
+        {
+            m_matrix->setRampLength(numberOfSamples);
+        };
+        
+        /**	Retrieve the number of samples of the interpolation of the decoding matrix.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return m_matrix->getRampLength();
+        };
+        
         /**	This method performs the decoding with single precision.
          @param     input	The inputs array.
          @param     outputs The output array that contains samples destinated to channels.
@@ -72,6 +254,20 @@ namespace Hoa3D
          @param     outputs The output array that contains samples destinated to channels.
          */
 		void process(const double* input, double* output);
+        
+        /**	This method performs the decoding with single precision on a block of samples. The inputs array contains one vector for each spherical harmonic and the outputs array contains one vector for each channel. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product, so the processing can be in-place.
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        /**	This method performs the decoding with double precision on a block of samples. The inputs array contains one vector for each spherical harmonic and the outputs array contains one vector for each channel. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples and each chunk is decoded with a single matrix product, so the processing can be in-place.
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
 	};
     
     const float* get_mit_hrtf_3D(long samplerate, double azimuth, long elevation, bool large);
@@ -88,15 +284,22 @@ namespace Hoa3D
             Small       = 0,	/**< Small Pinna Size  */
             Large       = 1,	/**< Large Pinna Size */
         };
-        
+    
     private:
         PinnaSize       m_pinna_size;
         double*         m_outputs_double;
         float*          m_outputs_float;
+        const float**   m_inputs_vectors_float;
+        const double**  m_inputs_vectors_double;
+        float*          m_chunk_float;
+        double*         m_chunk_double;
+        float**         m_chunk_vectors_float;
+        double**        m_chunk_vectors_double;
         DecoderRegular* m_decoder;
         double          m_sampleRate;
         std::vector<BinauralFilter> m_filters_left;
         std::vector<BinauralFilter> m_filters_right;
+        Hoa::Exchanger<Hoa::BinauralFilters>* m_binaural_filters;
     public:
         
         //! The binaural decoder constructor.
@@ -105,7 +308,7 @@ namespace Hoa3D
          @param     order				The order
          */
 		DecoderBinaural(unsigned int order);
-		
+        
         //! The binaural decoder destructor.
         /**	The binaural decoder destructor free the memory.
          */
@@ -147,6 +350,63 @@ namespace Hoa3D
             return m_pinna_size;
         };
         
+        //! Set the head related impulse responses.
+        /** Set the head related impulse responses of the virtual channels and use the convolution in the spherical harmonics domain instead of the filters. The left and right arrays contain one impulse response for each virtual channel, at the azimuth and the elevation of the virtual channel, and their minimum size must be the number of virtual channels. The impulse responses of the virtual channels are decoded once in one impulse response for each spherical harmonic and each ear, then the cost of the convolution depends on the number of harmonics and not on the number of virtual channels. The impulse responses are partitioned and transformed in a new convolver that is published to the audio thread without lock, so you should not call this method in the audio thread. A NULL left or right array or a null size removes the impulse responses and restores the filters.
+         
+            @param     left     The impulse responses of the left ear.
+            @param     right    The impulse responses of the right ear.
+            @param     size     The size of the impulse responses.
+         
+            @see    getNumberOfVirtualChannels
+            @see    getVirtualChannelAzimuth
+            @see    getVirtualChannelElevation
+         */
+        void setImpulses(const float* const* left, const float* const* right, const unsigned int size);
+        
+        //! Load the head related impulse responses of a file.
+        /** Load the head related impulse responses of a file and set the impulse responses of the virtual channels with the impulse responses of the closest directions of the file, resampled to the sample rate. The file must follow the binary layout of the HrirSet class. If a cache directory is given, the impulse responses of the harmonics are read from a cache file identified by the hash of the file, the order, the sample rate and the size of the partitions, and the impulse responses of the file are only converted if the cache file doesn't exist. The cache file is mapped in memory and shared with all the other decoders that use it, it is published to the audio thread with the convolver and unmapped once the audio thread released it, otherwise the impulse responses are computed and the cache file is written for the next decoders. You should not call this method in the audio thread.
+         
+            @param     path             The path of the file.
+            @param     sampleRate       The sample rate.
+            @param     cacheDirectory   The directory of the cache files or an empty string to not use the cache.
+            @return    True if the impulse responses have been loaded.
+         
+            @see    setImpulses
+         */
+        bool loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory = "");
+        
+        //! Retrieve the number of virtual channels.
+        /** Retrieve the number of virtual channels used to decode the impulse responses.
+         
+            @return    The number of virtual channels.
+         */
+        inline unsigned int getNumberOfVirtualChannels() const
+        {
+            return m_decoder->getNumberOfChannels();
+        };
+        
+        //! Retrieve the azimuth of a virtual channel.
+        /** Retrieve the azimuth in radian of a virtual channel, the impulse responses of the virtual channel must be measured at this azimuth and this elevation.
+         
+            @param     index	The index of the virtual channel.
+            @return    The azimuth of the virtual channel.
+         */
+        inline double getVirtualChannelAzimuth(unsigned int index) const
+        {
+            return m_decoder->getChannelAzimuth(index);
+        };
+        
+        //! Retrieve the elevation of a virtual channel.
+        /** Retrieve the elevation in radian of a virtual channel, the impulse responses of the virtual channel must be measured at this elevation.
+         
+            @param     index	The index of the virtual channel.
+            @return    The elevation of the virtual channel.
+         */
+        inline double getVirtualChannelElevation(unsigned int index) const
+        {
+            return m_decoder->getChannelElevation(index);
+        };
+        
         //! Retrieve a name for a channel.
         /** Retrieve a name for a channel in a std::string format that will be "Headphone Left" or "Headphone Right".
          
@@ -164,24 +424,42 @@ namespace Hoa3D
         };
         
         //! This method performs the binaural decoding with single precision.
-		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2].
+		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2]. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
          
          @param     inputs	The input samples.
          @param     outputs  The output array that contains samples destinated to channels.
          */
 		void process(const float* inputs, float* outputs);
-		
+        
         //! This method performs the binaural decoding with double precision.
-		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2].
+		/**	You should use this method for not-in-place processing and performs the binaural decoding sample by sample. The inputs array contains the spherical harmonics samples : inputs[number of harmonics] and the outputs array contains the headphones samples : outputs[2]. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
          
          @param     input    The input samples.
          @param     outputs  The output array that contains samples destinated to channels.
          */
 		void process(const double* inputs, double* outputs);
+        
+        //! This method performs the binaural decoding with single precision on a block of samples.
+		/**	You should use this method for in-place or not-in-place processing and performs the binaural decoding on a whole vector of samples. The inputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics. The outputs array contains the two vectors of the headphones. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples, each chunk is decoded on the virtual channels with a single matrix product and then filtered. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
+         
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+		void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the binaural decoding with double precision on a block of samples.
+		/**	You should use this method for in-place or not-in-place processing and performs the binaural decoding on a whole vector of samples. The inputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics. The outputs array contains the two vectors of the headphones. Each vector must contain at least the vector size samples. The vectors are processed by chunks of NUMBEROFCHUNKPOINTS samples, each chunk is decoded on the virtual channels with a single matrix product and then filtered. When the head related impulse responses are set, the harmonics are directly convolved with the impulse responses of the harmonics.
+         
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+		void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
     
     //! The ambisonic multi-decoder.
-    /** The multi-decoder is a class that facilitates the use of the three decoder : regular, irregular and binaural.
+    /** The multi-decoder is a class that facilitates the use of the three decoder : regular, irregular and binaural. When the number of channels changes, the new decoder is allocated by the control thread and published to the audio thread with an atomic swap, the previous decoder is freed by the control thread once the audio thread has released it.
      */
     class DecoderMulti : public Ambisonic
     {
@@ -192,13 +470,14 @@ namespace Hoa3D
             Regular     = 0,	/**< Regular Decoding   */
             Binaural    = 1     /**< Binaural Decoding  */
         };
-        
+    
     private:
-        DecoderRegular*     m_decoder_regular;
+        Hoa::Exchanger<DecoderRegular>*     m_decoder_regular;
         DecoderBinaural*    m_decoder_binaural;
         Mode                m_mode;
         double              m_sample_rate;
-        
+        unsigned int        m_ramp_length;
+    
     public:
         
         //! The multi-decoder constructor.
@@ -245,6 +524,20 @@ namespace Hoa3D
          */
         void setNumberOfChannels(unsigned int numberOfChannels);
         
+        //! Set the length of the interpolation of the decoding matrices.
+        /**	Set the number of samples of the interpolation of the decoding matrices of the regular and irregular decoding when the channels change, 0 means that the new matrices are used immediately.
+         
+            @param     numberOfSamples  The number of samples of the interpolation.
+         */
+        void setRampLength(unsigned int numberOfSamples);
+        
+        /**	Retrieve the number of samples of the interpolation of the decoding matrices.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return m_ramp_length;
+        };
+        
         //! Retrieve the number of channels.
         /** Retrieve the number of channels of the planewave class.
          
@@ -253,7 +546,7 @@ namespace Hoa3D
         inline unsigned int getNumberOfChannels() const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getNumberOfChannels();
+                return m_decoder_regular->getLatest()->getNumberOfChannels();
             else
                 return m_decoder_binaural->getNumberOfChannels();
         }
@@ -290,7 +583,7 @@ namespace Hoa3D
 		double getChannelsRotationX() const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelsRotationX();
+                return m_decoder_regular->getLatest()->getChannelsRotationX();
             else
                 return 0;
         }
@@ -303,7 +596,7 @@ namespace Hoa3D
 		double getChannelsRotationY() const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelsRotationY();
+                return m_decoder_regular->getLatest()->getChannelsRotationY();
             else
                 return 0;
         }
@@ -316,7 +609,7 @@ namespace Hoa3D
 		double getChannelsRotationZ() const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelsRotationZ();
+                return m_decoder_regular->getLatest()->getChannelsRotationZ();
             else
                 return 0;
         }
@@ -337,7 +630,19 @@ namespace Hoa3D
          
          */
         void setPinnaSize(DecoderBinaural::PinnaSize pinnaSize);
-
+        
+        //! Load the head related impulse responses of the binaural decoding.
+        /** Load the head related impulse responses of a file for the binaural decoding, you should not call this method in the audio thread.
+         
+            @param     path             The path of the file.
+            @param     sampleRate       The sample rate.
+            @param     cacheDirectory   The directory of the cache files or an empty string to not use the cache.
+            @return    True if the impulse responses have been loaded.
+         
+            @see    DecoderBinaural::loadImpulses
+         */
+        bool loadImpulses(const std::string& path, const double sampleRate, const std::string& cacheDirectory = "");
+        
         
         //! Retrieve if the pinna size of the binaural decoder.
         /** Retrieve if the pinna size of the binaural decoder.
@@ -362,7 +667,7 @@ namespace Hoa3D
         inline double getChannelAzimuth(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelAzimuth(index);
+                return m_decoder_regular->getLatest()->getChannelAzimuth(index);
             else
                 return m_decoder_binaural->getChannelAzimuth(index);
         }
@@ -377,7 +682,7 @@ namespace Hoa3D
         inline double getChannelElevation(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelElevation(index);
+                return m_decoder_regular->getLatest()->getChannelElevation(index);
             else
                 return m_decoder_binaural->getChannelElevation(index);
         }
@@ -395,7 +700,7 @@ namespace Hoa3D
         inline double getChannelAbscissa(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelAbscissa(index);
+                return m_decoder_regular->getLatest()->getChannelAbscissa(index);
             else
                 return m_decoder_binaural->getChannelAbscissa(index);
         }
@@ -413,7 +718,7 @@ namespace Hoa3D
         inline double getChannelOrdinate(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelOrdinate(index);
+                return m_decoder_regular->getLatest()->getChannelOrdinate(index);
             else
                 return m_decoder_binaural->getChannelOrdinate(index);
         }
@@ -429,7 +734,7 @@ namespace Hoa3D
         inline double getChannelHeight(unsigned int index) const
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelHeight(index);
+                return m_decoder_regular->getLatest()->getChannelHeight(index);
             else
                 return m_decoder_binaural->getChannelHeight(index);
         }
@@ -445,7 +750,7 @@ namespace Hoa3D
         inline std::string getChannelName(unsigned int index)
         {
             if(m_mode == Regular)
-                return m_decoder_regular->getChannelName(index);
+                return m_decoder_regular->getLatest()->getChannelName(index);
             else
                 return m_decoder_binaural->getChannelName(index);
         };
@@ -458,8 +763,8 @@ namespace Hoa3D
          */
         inline void process(const float* inputs, float* outputs)
         {
-            if(m_mode == Regular)
-                m_decoder_regular->process(inputs, outputs);
+            if(Hoa::atomic_load(&m_mode) == Regular)
+                m_decoder_regular->acquire()->process(inputs, outputs);
             else
                 m_decoder_binaural->process(inputs, outputs);
         }
@@ -472,11 +777,41 @@ namespace Hoa3D
          */
         inline void process(const double* inputs, double* outputs)
         {
-            if(m_mode == Regular)
-                m_decoder_regular->process(inputs, outputs);
+            if(Hoa::atomic_load(&m_mode) == Regular)
+                m_decoder_regular->acquire()->process(inputs, outputs);
             else
                 m_decoder_binaural->process(inputs, outputs);
         }
+        
+        //! This method performs the decoding depending of the mode with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the decoding on a whole vector of samples. The inputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples.
+         
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+        inline void process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+        {
+            if(Hoa::atomic_load(&m_mode) == Regular)
+                m_decoder_regular->acquire()->process(inputs, outputs, vectorSize);
+            else
+                m_decoder_binaural->process(inputs, outputs, vectorSize);
+        }
+        
+        //! This method performs the decoding depending of the mode with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the decoding on a whole vector of samples. The inputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples.
+         
+         @param     inputs       The input vectors.
+         @param     outputs      The output vectors.
+         @param     vectorSize   The number of samples to process.
+         */
+        inline void process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+        {
+            if(Hoa::atomic_load(&m_mode) == Regular)
+                m_decoder_regular->acquire()->process(inputs, outputs, vectorSize);
+            else
+                m_decoder_binaural->process(inputs, outputs, vectorSize);
+        }
     };
 
 } // end of namespace Hoa3D
@@ -5,120 +5,635 @@
 */
 
 #include "Encoder_3D.h"
+#include "../HoaCommon/Queue.h"
 
 namespace Hoa3D
 {
-    Encoder::Encoder(unsigned int order) : Ambisonic(order)
+    class Encoder::Tables
     {
-        m_elevation         = 0;
-        m_azimuth           = 0;
-        m_azimuth_matrix    = new double*[NUMBEROFCIRCLEPOINTS];
-        m_elevation_matrix  = new double*[NUMBEROFCIRCLEPOINTS];
-        m_normalization     = new double[m_number_of_harmonics];
-        
-        for(int j = 0; j < NUMBEROFCIRCLEPOINTS; j++)
+    public:
+        unsigned int    order;
+        unsigned int    number_of_harmonics;
+        unsigned int    references;
+        unsigned int    matrices_references;
+        double*         normalization;
+        double*         factors;
+        double*         recurrence;
+        double*         azimuth_matrix;
+        double*         elevation_matrix;
+    };
+    
+    //! The lock of the cache of the tables.
+    /** The lock is a spinlock on an atomic exchange, it is only taken by the constructors and the destructors of the encoders.
+     */
+    class TablesLock
+    {
+    private:
+        static unsigned int m_locked;
+    public:
+        TablesLock()
         {
-            m_azimuth_matrix[j]    = new double[m_number_of_harmonics];
-            m_elevation_matrix[j]  = new double[m_number_of_harmonics];
+            while(Hoa::atomic_exchange(&m_locked, 1u))
+                ;
         }
         
-        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        ~TablesLock()
+        {
+            Hoa::atomic_store(&m_locked, 0u);
+        }
+    };
+    
+    unsigned int TablesLock::m_locked = 0;
+    
+    std::map<unsigned int, Encoder::Tables*>& Encoder::getTablesCache()
+    {
+        static std::map<unsigned int, Tables*> cache;
+        return cache;
+    }
+    
+    void Encoder::computeLegendre(const unsigned int order, const double cos_theta, const double sin_theta, double* values)
+    {
+        double pmm = 1.;
+        for(unsigned int m = 0; m <= order; m++)
         {
-            double max;
-            double theta;
-            double phi;
-            int degree = getHarmonicDegree(i);
-            int order = getHarmonicOrder(i);
+            // P(m, m) = (-1)^m * (2m - 1)!! * sin(theta)^m
+            if(m > 0)
+                pmm *= -(double)(2 * m - 1) * sin_theta;
             
-            max = 0.;
-            for(int j = 0; j < NUMBEROFCIRCLEPOINTS; j++)
+            double p0 = pmm;
+            values[m * m + m + m] = values[m * m] = p0;
+            if(m < order)
             {
-				phi = (double)j / (double)NUMBEROFCIRCLEPOINTS * HOA_2PI;
-                phi = wrap_twopi(phi);
-                
-                m_azimuth_matrix[j][i] = spherical_harmonics_azimuth(degree, order, phi);
-                
-                theta = (double)j / (double)NUMBEROFCIRCLEPOINTS * HOA_2PI + HOA_PI2;
-                theta = wrap_twopi(theta);
-                if(theta >= HOA_PI)
-                    theta = HOA_2PI - theta;
-                
-                double value = spherical_harmonics_elevation(degree, order, theta);
-                m_elevation_matrix[j][i] = value;
-                if(max < fabs(value))
+                // P(m + 1, m) = cos(theta) * (2m + 1) * P(m, m)
+                double p1 = cos_theta * (double)(2 * m + 1) * pmm;
+                unsigned int l = m + 1;
+                values[l * l + l + m] = values[l * l + l - m] = p1;
+                for(l = m + 2; l <= order; l++)
                 {
-                    max = fabs(value);
+                    // P(l, m) = ((2l - 1) * cos(theta) * P(l - 1, m) - (l + m - 1) * P(l - 2, m)) / (l - m)
+                    double p2 = ((double)(2 * l - 1) * cos_theta * p1 - (double)(l + m - 1) * p0) / (double)(l - m);
+                    values[l * l + l + m] = values[l * l + l - m] = p2;
+                    p0 = p1;
+                    p1 = p2;
                 }
             }
-            m_normalization[i] = max;
-            for(int j = 0; j < NUMBEROFCIRCLEPOINTS; j++)
+        }
+    }
+    
+    Encoder::Tables* Encoder::acquireTables(const Encoder* encoder)
+    {
+        TablesLock lock;
+        std::map<unsigned int, Tables*>& cache = getTablesCache();
+        std::map<unsigned int, Tables*>::iterator it = cache.find(encoder->getDecompositionOrder());
+        if(it != cache.end())
+        {
+            Tables* tables = it->second;
+            tables->references++;
+            return tables;
+        }
+        
+        const unsigned int number_of_harmonics = encoder->getNumberOfHarmonics();
+        Tables* tables                  = new Tables();
+        tables->order                   = encoder->getDecompositionOrder();
+        tables->number_of_harmonics     = number_of_harmonics;
+        tables->references              = 1;
+        tables->matrices_references     = 0;
+        tables->normalization           = new double[number_of_harmonics];
+        tables->factors                 = new double[number_of_harmonics];
+        tables->recurrence              = new double[number_of_harmonics * 2];
+        tables->azimuth_matrix          = NULL;
+        tables->elevation_matrix        = NULL;
+        
+        // The elevation coefficients are normalized by their maximum over the discretized circle.
+        double* legendre = new double[number_of_harmonics];
+        for(unsigned int i = 0; i < number_of_harmonics; i++)
+        {
+            tables->factors[i]          = legendre_normalization(encoder->getHarmonicDegree(i), encoder->getHarmonicOrder(i));
+            tables->normalization[i]    = 0.;
+        }
+        for(int j = 0; j < NUMBEROFCIRCLEPOINTS; j++)
+        {
+            double theta = (double)j / (double)NUMBEROFCIRCLEPOINTS * HOA_2PI + HOA_PI2;
+            computeLegendre(tables->order, cos(theta), fabs(sin(theta)), legendre);
+            for(unsigned int i = 0; i < number_of_harmonics; i++)
             {
-                m_elevation_matrix[j][i] /= max;
+                double value = fabs(legendre[i] * tables->factors[i]);
+                if(tables->normalization[i] < value)
+                    tables->normalization[i] = value;
             }
         }
+        for(unsigned int i = 0; i < number_of_harmonics; i++)
+        {
+            const unsigned int l = encoder->getHarmonicDegree(i);
+            const unsigned int m = abs(encoder->getHarmonicOrder(i));
+            tables->factors[i] /= tables->normalization[i];
+            
+            // The factors of the recurrence over the degrees : (2l - 1) / (l - m) and (l + m - 1) / (l - m)
+            tables->recurrence[i * 2]       = l > m ? (double)(2 * l - 1) / (double)(l - m) : 0.;
+            tables->recurrence[i * 2 + 1]   = l > m ? (double)(l + m - 1) / (double)(l - m) : 0.;
+        }
+        delete [] legendre;
+        
+        cache[tables->order] = tables;
+        return tables;
+    }
+    
+    void Encoder::releaseTables(Tables* tables)
+    {
+        TablesLock lock;
+        if(--tables->references == 0)
+        {
+            getTablesCache().erase(tables->order);
+            delete [] tables->normalization;
+            delete [] tables->factors;
+            delete [] tables->recurrence;
+            delete [] tables->azimuth_matrix;
+            delete [] tables->elevation_matrix;
+            delete tables;
+        }
+    }
+    
+    void Encoder::acquireMatrices(Tables* tables)
+    {
+        TablesLock lock;
+        if(tables->matrices_references++ > 0)
+            return;
+        
+        const unsigned int number_of_harmonics = tables->number_of_harmonics;
+        tables->azimuth_matrix      = new double[NUMBEROFCIRCLEPOINTS * number_of_harmonics];
+        tables->elevation_matrix    = new double[NUMBEROFCIRCLEPOINTS * number_of_harmonics];
+        
+        for(int j = 0; j < NUMBEROFCIRCLEPOINTS; j++)
+        {
+            double* azimuth_row     = tables->azimuth_matrix + j * number_of_harmonics;
+            double* elevation_row   = tables->elevation_matrix + j * number_of_harmonics;
+            
+            double phi = (double)j / (double)NUMBEROFCIRCLEPOINTS * HOA_2PI;
+            phi = wrap_twopi(phi);
+            for(unsigned int l = 0; l <= tables->order; l++)
+            {
+                for(int m = -(int)l; m <= (int)l; m++)
+                    azimuth_row[l * l + l + m] = spherical_harmonics_azimuth(l, m, phi);
+            }
+            
+            double theta = (double)j / (double)NUMBEROFCIRCLEPOINTS * HOA_2PI + HOA_PI2;
+            computeLegendre(tables->order, cos(theta), fabs(sin(theta)), elevation_row);
+            for(unsigned int i = 0; i < number_of_harmonics; i++)
+                elevation_row[i] *= tables->factors[i];
+        }
+    }
+    
+    void Encoder::releaseMatrices(Tables* tables)
+    {
+        TablesLock lock;
+        if(--tables->matrices_references == 0)
+        {
+            delete [] tables->azimuth_matrix;
+            delete [] tables->elevation_matrix;
+            tables->azimuth_matrix      = NULL;
+            tables->elevation_matrix    = NULL;
+        }
+    }
+    
+    Encoder::Encoder(unsigned int order, Mode mode) : Ambisonic(order)
+    {
+        m_mode              = mode;
+        m_elevation         = 0;
+        m_azimuth           = 0;
+        m_elevation_angle   = 0.;
+        m_azimuth_angle     = 0.;
+        m_harmonics         = new double[m_number_of_harmonics];
+        m_dirty             = true;
+        m_tables            = acquireTables(this);
+        m_normalization     = m_tables->normalization;
+        m_factors           = m_tables->factors;
+        m_recurrence        = m_tables->recurrence;
+        m_azimuth_matrix    = NULL;
+        m_elevation_matrix  = NULL;
+        if(m_mode == Tabulated)
+        {
+            acquireMatrices(m_tables);
+            m_azimuth_matrix    = m_tables->azimuth_matrix;
+            m_elevation_matrix  = m_tables->elevation_matrix;
+        }
+    }
+    
+    void Encoder::setMode(const Mode mode)
+    {
+        if(mode == m_mode)
+            return;
+        
+        if(mode == Tabulated)
+        {
+            acquireMatrices(m_tables);
+            m_azimuth_matrix    = m_tables->azimuth_matrix;
+            m_elevation_matrix  = m_tables->elevation_matrix;
+            m_mode              = mode;
+        }
+        else
+        {
+            m_dirty             = true;
+            m_mode              = mode;
+            m_azimuth_matrix    = NULL;
+            m_elevation_matrix  = NULL;
+            releaseMatrices(m_tables);
+        }
+    }
+    
+    void Encoder::computeHarmonics()
+    {
+        // The azimuth is reversed when the source goes over the poles.
+        double phi = m_azimuth_angle;
+        if(m_elevation_angle >= HOA_PI2 && m_elevation_angle <= HOA_PI + HOA_PI2)
+            phi += HOA_PI;
+        
+        const double cos_theta  = -sin(m_elevation_angle);
+        const double sin_theta  = fabs(cos(m_elevation_angle));
+        const double cos_phi    = cos(phi);
+        const double sin_phi    = sin(phi);
+        double cos_x    = 1.;
+        double sin_x    = 0.;
+        double tcos_x   = cos_x;
+        double pmm      = 1.;
+        for(unsigned int m = 0; m <= m_order; m++)
+        {
+            if(m > 0)
+            {
+                pmm *= -(double)(2 * m - 1) * sin_theta;
+                cos_x = tcos_x * cos_phi - sin_x * sin_phi; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                sin_x = tcos_x * sin_phi + sin_x * cos_phi; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+                tcos_x = cos_x;
+            }
+            
+            const unsigned int index = m * m + m;
+            m_harmonics[index + m] = pmm * m_factors[index + m] * cos_x;
+            if(m > 0)
+                m_harmonics[index - m] = pmm * m_factors[index - m] * sin_x;
+            
+            double p0 = 0.;
+            double p1 = pmm;
+            for(unsigned int l = m + 1; l <= m_order; l++)
+            {
+                // P(l, m) = ((2l - 1) * cos(theta) * P(l - 1, m) - (l + m - 1) * P(l - 2, m)) / (l - m)
+                const unsigned int index = l * l + l;
+                const double legendre = m_recurrence[(index + m) * 2] * cos_theta * p1 - m_recurrence[(index + m) * 2 + 1] * p0;
+                m_harmonics[index + m] = legendre * m_factors[index + m] * cos_x;
+                if(m > 0)
+                    m_harmonics[index - m] = legendre * m_factors[index - m] * sin_x;
+                p0 = p1;
+                p1 = legendre;
+            }
+        }
+        m_dirty = false;
     }
     
     void Encoder::setAzimuth(const double azimuth)
     {
-        m_azimuth = wrap_twopi(azimuth) / HOA_2PI * (double)(NUMBEROFCIRCLEPOINTS - 1);
+        m_azimuth_angle = wrap_twopi(azimuth);
+        m_azimuth = m_azimuth_angle / HOA_2PI * (double)(NUMBEROFCIRCLEPOINTS - 1);
+        m_dirty = true;
     }
     
     void Encoder::setElevation(const double elevation)
     {
-        m_elevation = wrap_twopi(elevation)  / HOA_2PI * (double)(NUMBEROFCIRCLEPOINTS - 1);
+        m_elevation_angle = wrap_twopi(elevation);
+        m_elevation = m_elevation_angle / HOA_2PI * (double)(NUMBEROFCIRCLEPOINTS - 1);
+        m_dirty = true;
     }
     
     void Encoder::process(const float input, float* outputs)
     {
-        if(m_elevation >= 9000 && m_elevation <= 27000)
+        if(m_mode == Recurrence)
+        {
+            if(m_dirty)
+                computeHarmonics();
+            if(m_kernels_float)
+                m_kernels_float->scale(input, m_harmonics, outputs);
+            else
+            {
+                for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                    outputs[i] = input * m_harmonics[i];
+            }
+        }
+        else if(m_kernels_float)
+        {
+            // Beyond the poles, the azimuth is turned by π
+            const long azimuth = (m_elevation >= 9000 && m_elevation <= 27000) ? ((m_azimuth >= 18000) ? m_azimuth - 18000 : m_azimuth + 18000) : m_azimuth;
+            m_kernels_float->encode(input, m_azimuth_matrix + azimuth * m_number_of_harmonics, m_elevation_matrix + m_elevation * m_number_of_harmonics, outputs);
+        }
+        else if(m_elevation >= 9000 && m_elevation <= 27000)
         {
             if(m_azimuth >= 18000)
             {
                 for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                    outputs[i] = input * m_azimuth_matrix[m_azimuth-18000][i] * m_elevation_matrix[m_elevation][i];
+                    outputs[i] = input * m_azimuth_matrix[(m_azimuth-18000) * m_number_of_harmonics + i] * m_elevation_matrix[m_elevation * m_number_of_harmonics + i];
             }
             else
             {
                 for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                    outputs[i] = input * m_azimuth_matrix[m_azimuth+18000][i] * m_elevation_matrix[m_elevation][i];
+                    outputs[i] = input * m_azimuth_matrix[(m_azimuth+18000) * m_number_of_harmonics + i] * m_elevation_matrix[m_elevation * m_number_of_harmonics + i];
             }
         }
         else
         {
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                outputs[i] = input * m_azimuth_matrix[m_azimuth][i] * m_elevation_matrix[m_elevation][i];
+                outputs[i] = input * m_azimuth_matrix[m_azimuth * m_number_of_harmonics + i] * m_elevation_matrix[m_elevation * m_number_of_harmonics + i];
         }
     }
     
     void Encoder::process(const double input, double* outputs)
     {
-        if(m_elevation >= 9000 && m_elevation <= 27000)
+        if(m_mode == Recurrence)
+        {
+            if(m_dirty)
+                computeHarmonics();
+            if(m_kernels_double)
+                m_kernels_double->scale(input, m_harmonics, outputs);
+            else
+            {
+                for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+                    outputs[i] = input * m_harmonics[i];
+            }
+        }
+        else if(m_kernels_double)
+        {
+            // Beyond the poles, the azimuth is turned by π
+            const long azimuth = (m_elevation >= 9000 && m_elevation <= 27000) ? ((m_azimuth >= 18000) ? m_azimuth - 18000 : m_azimuth + 18000) : m_azimuth;
+            m_kernels_double->encode(input, m_azimuth_matrix + azimuth * m_number_of_harmonics, m_elevation_matrix + m_elevation * m_number_of_harmonics, outputs);
+        }
+        else if(m_elevation >= 9000 && m_elevation <= 27000)
         {
             if(m_azimuth >= 18000)
             {
                 for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                    outputs[i] = input * m_azimuth_matrix[m_azimuth-18000][i] * m_elevation_matrix[m_elevation][i];
+                    outputs[i] = input * m_azimuth_matrix[(m_azimuth-18000) * m_number_of_harmonics + i] * m_elevation_matrix[m_elevation * m_number_of_harmonics + i];
             }
             else
             {
                 for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-                    outputs[i] = input * m_azimuth_matrix[m_azimuth+18000][i] * m_elevation_matrix[m_elevation][i];
+                    outputs[i] = input * m_azimuth_matrix[(m_azimuth+18000) * m_number_of_harmonics + i] * m_elevation_matrix[m_elevation * m_number_of_harmonics + i];
             }
         }
         else
         {
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                outputs[i] = input * m_azimuth_matrix[m_azimuth][i] * m_elevation_matrix[m_elevation][i];
+                outputs[i] = input * m_azimuth_matrix[m_azimuth * m_number_of_harmonics + i] * m_elevation_matrix[m_elevation * m_number_of_harmonics + i];
             }
         }
     }
     
+    void Encoder::process(const float* input, const float* azimuths, const float* elevations, float** outputs, const unsigned int vectorSize)
+    {
+        float cos_phi[NUMBEROFCHUNKPOINTS];
+        float sin_phi[NUMBEROFCHUNKPOINTS];
+        float cos_theta[NUMBEROFCHUNKPOINTS];
+        float sin_theta[NUMBEROFCHUNKPOINTS];
+        float cos_x[NUMBEROFCHUNKPOINTS];
+        float sin_x[NUMBEROFCHUNKPOINTS];
+        float pmm[NUMBEROFCHUNKPOINTS];
+        float p0[NUMBEROFCHUNKPOINTS];
+        float p1[NUMBEROFCHUNKPOINTS];
+        const float cos_azimuth   = cos(m_azimuth_angle);
+        const float sin_azimuth   = sin(m_azimuth_angle);
+        const float cos_elevation = cos(m_elevation_angle);
+        const float sin_elevation = sin(m_elevation_angle);
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            const float* in = input + offset;
+            if(azimuths)
+            {
+                vector_sincos(azimuths + offset, sin_phi, cos_phi, size);
+            }
+            else
+            {
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    cos_phi[k] = cos_azimuth;
+                    sin_phi[k] = sin_azimuth;
+                }
+            }
+            if(elevations)
+            {
+                vector_sincos(elevations + offset, sin_x, cos_x, size);
+            }
+            else
+            {
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    cos_x[k] = cos_elevation;
+                    sin_x[k] = sin_elevation;
+                }
+            }
+            for(unsigned int k = 0; k < size; k++)
+            {
+                // The azimuth is reversed when the source goes over the poles.
+                const float reverse = cos_x[k] <= 0. ? -1. : 1.;
+                cos_phi[k]  *= reverse;
+                sin_phi[k]  *= reverse;
+                cos_theta[k] = -sin_x[k];
+                sin_theta[k] = fabs(cos_x[k]);
+                cos_x[k]    = 1.;
+                sin_x[k]    = 0.;
+                pmm[k]      = in[k];
+            }
+            
+            for(unsigned int m = 0; m <= m_order; m++)
+            {
+                if(m > 0)
+                {
+                    const float factor = -(double)(2 * m - 1);
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        pmm[k] *= factor * sin_theta[k];
+                        const float tcos_x = cos_x[k];
+                        cos_x[k] = tcos_x * cos_phi[k] - sin_x[k] * sin_phi[k]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                        sin_x[k] = tcos_x * sin_phi[k] + sin_x[k] * cos_phi[k]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+                    }
+                }
+                
+                unsigned int index = m * m + m;
+                float factor = m_factors[index + m];
+                float* out_cos = outputs[index + m] + offset;
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    out_cos[k] = pmm[k] * factor * cos_x[k];
+                    p0[k] = 0.;
+                    p1[k] = pmm[k];
+                }
+                if(m > 0)
+                {
+                    factor = m_factors[index - m];
+                    float* out_sin = outputs[index - m] + offset;
+                    for(unsigned int k = 0; k < size; k++)
+                        out_sin[k] = pmm[k] * factor * sin_x[k];
+                }
+                
+                for(unsigned int l = m + 1; l <= m_order; l++)
+                {
+                    // P(l, m) = ((2l - 1) * cos(theta) * P(l - 1, m) - (l + m - 1) * P(l - 2, m)) / (l - m)
+                    index = l * l + l;
+                    const float alpha = m_recurrence[(index + m) * 2];
+                    const float beta  = m_recurrence[(index + m) * 2 + 1];
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        const float legendre = alpha * cos_theta[k] * p1[k] - beta * p0[k];
+                        p0[k] = p1[k];
+                        p1[k] = legendre;
+                    }
+                    factor = m_factors[index + m];
+                    out_cos = outputs[index + m] + offset;
+                    for(unsigned int k = 0; k < size; k++)
+                        out_cos[k] = p1[k] * factor * cos_x[k];
+                    if(m > 0)
+                    {
+                        factor = m_factors[index - m];
+                        float* out_sin = outputs[index - m] + offset;
+                        for(unsigned int k = 0; k < size; k++)
+                            out_sin[k] = p1[k] * factor * sin_x[k];
+                    }
+                }
+            }
+        }
+        
+        if(vectorSize)
+        {
+            if(azimuths)
+                setAzimuth(azimuths[vectorSize - 1]);
+            if(elevations)
+                setElevation(elevations[vectorSize - 1]);
+        }
+    }
+    
+    void Encoder::process(const double* input, const double* azimuths, const double* elevations, double** outputs, const unsigned int vectorSize)
+    {
+        double cos_phi[NUMBEROFCHUNKPOINTS];
+        double sin_phi[NUMBEROFCHUNKPOINTS];
+        double cos_theta[NUMBEROFCHUNKPOINTS];
+        double sin_theta[NUMBEROFCHUNKPOINTS];
+        double cos_x[NUMBEROFCHUNKPOINTS];
+        double sin_x[NUMBEROFCHUNKPOINTS];
+        double pmm[NUMBEROFCHUNKPOINTS];
+        double p0[NUMBEROFCHUNKPOINTS];
+        double p1[NUMBEROFCHUNKPOINTS];
+        const double cos_azimuth   = cos(m_azimuth_angle);
+        const double sin_azimuth   = sin(m_azimuth_angle);
+        const double cos_elevation = cos(m_elevation_angle);
+        const double sin_elevation = sin(m_elevation_angle);
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            const double* in = input + offset;
+            if(azimuths)
+            {
+                vector_sincos(azimuths + offset, sin_phi, cos_phi, size);
+            }
+            else
+            {
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    cos_phi[k] = cos_azimuth;
+                    sin_phi[k] = sin_azimuth;
+                }
+            }
+            if(elevations)
+            {
+                vector_sincos(elevations + offset, sin_x, cos_x, size);
+            }
+            else
+            {
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    cos_x[k] = cos_elevation;
+                    sin_x[k] = sin_elevation;
+                }
+            }
+            for(unsigned int k = 0; k < size; k++)
+            {
+                // The azimuth is reversed when the source goes over the poles.
+                const double reverse = cos_x[k] <= 0. ? -1. : 1.;
+                cos_phi[k]  *= reverse;
+                sin_phi[k]  *= reverse;
+                cos_theta[k] = -sin_x[k];
+                sin_theta[k] = fabs(cos_x[k]);
+                cos_x[k]    = 1.;
+                sin_x[k]    = 0.;
+                pmm[k]      = in[k];
+            }
+            
+            for(unsigned int m = 0; m <= m_order; m++)
+            {
+                if(m > 0)
+                {
+                    const double factor = -(double)(2 * m - 1);
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        pmm[k] *= factor * sin_theta[k];
+                        const double tcos_x = cos_x[k];
+                        cos_x[k] = tcos_x * cos_phi[k] - sin_x[k] * sin_phi[k]; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
+                        sin_x[k] = tcos_x * sin_phi[k] + sin_x[k] * cos_phi[k]; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
+                    }
+                }
+                
+                unsigned int index = m * m + m;
+                double factor = m_factors[index + m];
+                double* out_cos = outputs[index + m] + offset;
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    out_cos[k] = pmm[k] * factor * cos_x[k];
+                    p0[k] = 0.;
+                    p1[k] = pmm[k];
+                }
+                if(m > 0)
+                {
+                    factor = m_factors[index - m];
+                    double* out_sin = outputs[index - m] + offset;
+                    for(unsigned int k = 0; k < size; k++)
+                        out_sin[k] = pmm[k] * factor * sin_x[k];
+                }
+                
+                for(unsigned int l = m + 1; l <= m_order; l++)
+                {
+                    // P(l, m) = ((2l - 1) * cos(theta) * P(l - 1, m) - (l + m - 1) * P(l - 2, m)) / (l - m)
+                    index = l * l + l;
+                    const double alpha = m_recurrence[(index + m) * 2];
+                    const double beta  = m_recurrence[(index + m) * 2 + 1];
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        const double legendre = alpha * cos_theta[k] * p1[k] - beta * p0[k];
+                        p0[k] = p1[k];
+                        p1[k] = legendre;
+                    }
+                    factor = m_factors[index + m];
+                    out_cos = outputs[index + m] + offset;
+                    for(unsigned int k = 0; k < size; k++)
+                        out_cos[k] = p1[k] * factor * cos_x[k];
+                    if(m > 0)
+                    {
+                        factor = m_factors[index - m];
+                        double* out_sin = outputs[index - m] + offset;
+                        for(unsigned int k = 0; k < size; k++)
+                            out_sin[k] = p1[k] * factor * sin_x[k];
+                    }
+                }
+            }
+        }
+        
+        if(vectorSize)
+        {
+            if(azimuths)
+                setAzimuth(azimuths[vectorSize - 1]);
+            if(elevations)
+                setElevation(elevations[vectorSize - 1]);
+        }
+    }
+    
     Encoder::~Encoder()
     {
-        delete [] m_azimuth_matrix;
-        delete [] m_elevation_matrix;
-        delete [] m_normalization;
+        if(m_mode == Tabulated)
+            releaseMatrices(m_tables);
+        releaseTables(m_tables);
+        delete [] m_harmonics;
     }
 }
-
@@ -18,28 +18,110 @@ namespace Hoa3D
      */
     class Encoder : public Ambisonic
     {
+    public:
         
+        enum Mode
+        {
+            Tabulated   = 0,	/**< Tabulated mode : the coefficients are read in tables quantized to the hundredth of degree */
+            Recurrence  = 1     /**< Recurrence mode : the coefficients are computed exactly with recurrences and without table */
+        };
+    
     private:
+        class Tables;
+        
+        Mode            m_mode;
         long            m_elevation;
         long            m_azimuth;
-        double**        m_azimuth_matrix;
-        double**        m_elevation_matrix;
-        double*         m_normalization;
+        double          m_elevation_angle;
+        double          m_azimuth_angle;
+        double*         m_harmonics;
+        bool            m_dirty;
+        Tables*         m_tables;
+        const double*   m_azimuth_matrix;
+        const double*   m_elevation_matrix;
+        const double*   m_normalization;
+        const double*   m_factors;
+        const double*   m_recurrence;
+        
+        //! Retrieve the shared tables of an order.
+        /**	The normalizations of the harmonics only depend on the order of decomposition, so they are computed once and shared read-only by all the encoders of the same order. The tables are reference counted and allocated the first time an encoder of this order is created.
+         
+            @param     encoder	The encoder that requests the tables.
+            @return    The tables of the order of the encoder.
+         */
+        static Tables* acquireTables(const Encoder* encoder);
+        
+        //! Release the shared tables of an order.
+        /**	Decrement the reference counter of the tables and free the memory when the last encoder of this order is deleted.
+         
+            @param     tables	The tables to release.
+         */
+        static void releaseTables(Tables* tables);
         
+        //! Retrieve the shared azimuth and elevation matrices of an order.
+        /**	The azimuth and elevation matrices are only needed by the encoders in tabulated mode, they are reference counted separately and allocated the first time an encoder of this order uses the tabulated mode.
+         
+            @param     tables	The tables of the order.
+         */
+        static void acquireMatrices(Tables* tables);
+        
+        //! Release the shared azimuth and elevation matrices of an order.
+        /**	Decrement the reference counter of the matrices and free the memory when the last encoder of this order stops using the tabulated mode.
+         
+            @param     tables	The tables of the order.
+         */
+        static void releaseMatrices(Tables* tables);
+        
+        //! Retrieve the cache of the shared tables indexed by order.
+        static std::map<unsigned int, Tables*>& getTablesCache();
+        
+        //! Compute the associated Legendre polynomials of all the harmonics.
+        /**	The polynomials are computed with the stable recurrence over the degrees for each argument, the cosine and the sine of the angle must be given.
+         
+            @param     order        The order of decomposition.
+            @param     cos_theta    The cosine of the angle.
+            @param     sin_theta    The absolute sine of the angle.
+            @param     values       The array of the polynomials, its minimum size must be the number of harmonics.
+         */
+        static void computeLegendre(const unsigned int order, const double cos_theta, const double sin_theta, double* values);
+        
+        //! Compute the normalized spherical harmonics coefficients for the current angles.
+        /**	The associated Legendre polynomials are computed with the stable recurrence over the degrees and the azimuth coefficients with the Chebyshev recurrence over the arguments, in a single pass. The coefficients are only computed by the process methods when the angles changed since the last evaluation.
+         */
+        void computeHarmonics();
+        
+        Encoder(const Encoder& other);
+        Encoder& operator=(const Encoder& other);
+    
     public:
         
         //! The encoder constructor.
-        /**	The encoder constructor allocates and initialize the member values to computes spherical harmonics coefficients depending of a decomposition order. The order must be at least 1.
+        /**	The encoder constructor allocates and initialize the member values to computes spherical harmonics coefficients depending of a decomposition order. The order must be at least 1. In tabulated mode, the coefficients are read in tables shared between all the encoders with the same order, so only the first encoder of an order computes them. In recurrence mode, the coefficients are computed exactly once after the angles change and the encoder doesn't use any table.
          
             @param     order	The order.
+            @param     mode     The mode of evaluation of the coefficients.
          */
-        Encoder(unsigned int order);
+        Encoder(unsigned int order, Mode mode = Tabulated);
         
         //! The encoder destructor.
-        /**	The encoder destructor free the memory.
+        /**	The encoder destructor free the memory. The tables of coefficients are freed with the last encoder of the same order.
          */
         ~Encoder();
         
+        //! This method set the mode of evaluation of the coefficients.
+        /**	The tabulated mode reads the coefficients in tables quantized to the hundredth of degree while the recurrence mode computes them exactly without table. Switching to the tabulated mode can allocate the tables, so you should not call this method in the audio thread.
+         
+            @param     mode	The mode.
+         */
+        void setMode(const Mode mode);
+        
+        /**	Retreive the mode of evaluation of the coefficients.
+         */
+        inline Mode getMode() const
+        {
+            return m_mode;
+        };
+        
         //! This method set the angle of azimuth.
         /**	The angle of azimuth in radian and you should prefer to use it between 0 and 2 Pi to avoid recursive wrapping of the value. The direction of rotation is counterclockwise. The 0 radian is Pi/2 phase shifted relative to a mathematical representation of a circle, then the 0 radian is at the "front" of the soundfield.
          
@@ -70,6 +152,8 @@ namespace Hoa3D
          */
         double getAzimuth() const
         {
+            if(m_mode == Recurrence)
+                return m_azimuth_angle;
             return (double)m_azimuth * HOA_2PI / (double)(NUMBEROFCIRCLEPOINTS - 1);
         };
         
@@ -77,6 +161,8 @@ namespace Hoa3D
          */
         double getElevation() const
         {
+            if(m_mode == Recurrence)
+                return m_elevation_angle;
             return (double)m_elevation * HOA_2PI / (double)(NUMBEROFCIRCLEPOINTS - 1);
         };
         
@@ -95,6 +181,28 @@ namespace Hoa3D
             @param     outputs  The outputs array.
          */
         void process(const double input, double* outputs);
+        
+        //! This method performs the encoding with single precision on a block of samples with signals of angles.
+        /**	You should use this method for not-in-place processing and performs the encoding on a whole vector of samples with an angle of azimuth and an angle of elevation for each sample. The input array contains the samples of the signal and the azimuths and the elevations arrays contain the angles in radian, their minimum size must be the vector size. The azimuths or the elevations can be NULL to use the current angle of the encoder. The outputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics and each vector must contain at least the vector size samples. The sines and cosines of the angles are computed with the vectorized approximation of vector_sincos and the spherical harmonics are evaluated with the recurrences whatever the mode of the encoder. At the end of the block, the angles of the encoder are the last values of the vectors.
+         
+            @param     input        The input vector.
+            @param     azimuths     The azimuths vector or NULL.
+            @param     elevations   The elevations vector or NULL.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* input, const float* azimuths, const float* elevations, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with double precision on a block of samples with signals of angles.
+        /**	You should use this method for not-in-place processing and performs the encoding on a whole vector of samples with an angle of azimuth and an angle of elevation for each sample. The input array contains the samples of the signal and the azimuths and the elevations arrays contain the angles in radian, their minimum size must be the vector size. The azimuths or the elevations can be NULL to use the current angle of the encoder. The outputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics and each vector must contain at least the vector size samples. The sines and cosines of the angles are computed with the vectorized approximation of vector_sincos and the spherical harmonics are evaluated with the recurrences whatever the mode of the encoder. At the end of the block, the angles of the encoder are the last values of the vectors.
+         
+            @param     input        The input vector.
+            @param     azimuths     The azimuths vector or NULL.
+            @param     elevations   The elevations vector or NULL.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* input, const double* azimuths, const double* elevations, double** outputs, const unsigned int vectorSize);
     };
 }
 
@@ -0,0 +1,307 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "HeadTracker_3D.h"
+
+namespace Hoa3D
+{
+    HeadTracker::HeadTracker(unsigned int order, unsigned int capacity) : Ambisonic(order)
+    {
+        m_rotate                = new Rotate(m_order);
+        m_orientations          = new Hoa::Queue<Orientation>(capacity);
+        m_matrix_size           = m_rotate->getMatrixSize();
+        m_buffer                = new double[m_rotate->getBufferSize()];
+        m_matrix_from           = new double[m_matrix_size];
+        m_matrix_to             = new double[m_matrix_size];
+        m_matrix_float          = new float[m_matrix_size];
+        m_ramp_matrix_float     = new float[m_matrix_size * 2];
+        m_ramp_matrix_double    = new double[m_matrix_size * 2];
+        m_inputs_chunk_float    = new float[m_number_of_harmonics * 2 * NUMBEROFCHUNKPOINTS];
+        m_inputs_chunk_double   = new double[m_number_of_harmonics * 2 * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_float   = new float[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_double  = new double[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        
+        m_current.time  = 0.;
+        m_current.w     = 1.;
+        m_current.x     = 0.;
+        m_current.y     = 0.;
+        m_current.z     = 0.;
+        m_has_next      = false;
+        m_quaternion[0] = 1.;
+        m_quaternion[1] = m_quaternion[2] = m_quaternion[3] = 0.;
+        m_time          = 0;
+        m_delay         = 0;
+        m_sub_block_size= 32;
+        
+        const double identity[9] = {1., 0., 0., 0., 1., 0., 0., 0., 1.};
+        m_rotate->computeMatrix(identity, m_matrix_from, m_buffer);
+        for(unsigned int i = 0; i < m_matrix_size; i++)
+            m_matrix_float[i] = m_matrix_from[i];
+    }
+    
+    bool HeadTracker::push(const double time, const double w, const double x, const double y, const double z)
+    {
+        const double norm = sqrt(w * w + x * x + y * y + z * z);
+        if(norm == 0.)
+            return false;
+        Orientation orientation;
+        orientation.time    = time;
+        orientation.w       = w / norm;
+        orientation.x       = x / norm;
+        orientation.y       = y / norm;
+        orientation.z       = z / norm;
+        return m_orientations->push(orientation);
+    }
+    
+    void HeadTracker::setDelay(const unsigned int numberOfSamples)
+    {
+        Hoa::atomic_store(&m_delay, numberOfSamples);
+    }
+    
+    void HeadTracker::setSubBlockSize(const unsigned int numberOfSamples)
+    {
+        Hoa::atomic_store(&m_sub_block_size, (unsigned int)clip_minmax(numberOfSamples, 1, NUMBEROFCHUNKPOINTS));
+    }
+    
+    //! The spherical linear interpolation between two unit quaternions.
+    static inline void quaternion_slerp(const double* from, const double* to, const double ratio, double* result)
+    {
+        double sign = 1.;
+        double cosine = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+        
+        // The quaternions q and -q are the same orientation, the shortest path is used
+        if(cosine < 0.)
+        {
+            sign    = -1.;
+            cosine  = -cosine;
+        }
+        
+        double scale_from, scale_to;
+        if(cosine > 0.9995)
+        {
+            scale_from  = 1. - ratio;
+            scale_to    = ratio;
+        }
+        else
+        {
+            const double angle  = acos(cosine);
+            const double sine   = sin(angle);
+            scale_from  = sin((1. - ratio) * angle) / sine;
+            scale_to    = sin(ratio * angle) / sine;
+        }
+        
+        double norm = 0.;
+        for(int i = 0; i < 4; i++)
+        {
+            result[i] = scale_from * from[i] + sign * scale_to * to[i];
+            norm += result[i] * result[i];
+        }
+        norm = 1. / sqrt(norm);
+        for(int i = 0; i < 4; i++)
+            result[i] *= norm;
+    }
+    
+    bool HeadTracker::update(const double time)
+    {
+        // The orientations that precede the time are consumed, the last one is the start of the interpolation
+        while(true)
+        {
+            if(!m_has_next)
+                m_has_next = m_orientations->pop(m_next);
+            if(m_has_next && m_next.time <= time)
+            {
+                m_current   = m_next;
+                m_has_next  = false;
+            }
+            else
+                break;
+        }
+        
+        double quaternion[4] = {m_current.w, m_current.x, m_current.y, m_current.z};
+        if(m_has_next && m_next.time > m_current.time)
+        {
+            const double from[4]    = {m_current.w, m_current.x, m_current.y, m_current.z};
+            const double to[4]      = {m_next.w, m_next.x, m_next.y, m_next.z};
+            const double ratio      = clip_minmax((time - m_current.time) / (m_next.time - m_current.time), 0., 1.);
+            quaternion_slerp(from, to, ratio, quaternion);
+        }
+        
+        if(quaternion[0] == m_quaternion[0] && quaternion[1] == m_quaternion[1] && quaternion[2] == m_quaternion[2] && quaternion[3] == m_quaternion[3])
+            return false;
+        for(int i = 0; i < 4; i++)
+            m_quaternion[i] = quaternion[i];
+        
+        // The sound field is rotated by the inverse of the orientation of the head, the transpose of its rotation matrix
+        const double w = quaternion[0], x = quaternion[1], y = quaternion[2], z = quaternion[3];
+        const double rotation[9] =
+        {
+            1. - 2. * (y * y + z * z),  2. * (x * y + w * z),       2. * (x * z - w * y),
+            2. * (x * y - w * z),       1. - 2. * (x * x + z * z),  2. * (y * z + w * x),
+            2. * (x * z + w * y),       2. * (y * z - w * x),       1. - 2. * (x * x + y * y)
+        };
+        m_rotate->computeMatrix(rotation, m_matrix_to, m_buffer);
+        return true;
+    }
+    
+    void HeadTracker::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        const unsigned int sub_block_size = Hoa::atomic_load(&m_sub_block_size);
+        const double delay = (double)Hoa::atomic_load(&m_delay);
+        if(outputs[0] != inputs[0])
+            cblas_scopy(vectorSize, inputs[0], 1, outputs[0], 1);
+        
+        float gains[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += sub_block_size)
+        {
+            const unsigned int size = (vectorSize - offset) < sub_block_size ? (vectorSize - offset) : sub_block_size;
+            const bool changed = update((double)(m_time + offset + size) - delay);
+            
+            // The harmonics of a degree are followed by the harmonics weighted by the ramp
+            for(unsigned int l = 1; l <= m_order; l++)
+            {
+                for(unsigned int m = 0; m < 2 * l + 1; m++)
+                    memcpy(m_inputs_chunk_float + (2 * l * l + m) * NUMBEROFCHUNKPOINTS, inputs[l * l + m] + offset, size * sizeof(float));
+            }
+            
+            if(changed)
+            {
+                for(unsigned int k = 0; k < size; k++)
+                    gains[k] = (float)(k + 1) / (float)size;
+                const double* from  = m_matrix_from + 1;
+                const double* to    = m_matrix_to + 1;
+                float* block        = m_ramp_matrix_float + 2;
+                for(unsigned int l = 1; l <= m_order; l++)
+                {
+                    const unsigned int degree_size = 2 * l + 1;
+                    for(unsigned int m = 0; m < degree_size; m++)
+                    {
+                        const float* input = m_inputs_chunk_float + (2 * l * l + m) * NUMBEROFCHUNKPOINTS;
+                        float* weighted = m_inputs_chunk_float + (2 * l * l + degree_size + m) * NUMBEROFCHUNKPOINTS;
+                        for(unsigned int k = 0; k < size; k++)
+                            weighted[k] = input[k] * gains[k];
+                        for(unsigned int n = 0; n < degree_size; n++)
+                        {
+                            block[m * degree_size * 2 + n]                 = from[m * degree_size + n];
+                            block[m * degree_size * 2 + degree_size + n]   = to[m * degree_size + n] - from[m * degree_size + n];
+                        }
+                    }
+                    matrix_chunk_product(block, degree_size, degree_size * 2, m_inputs_chunk_float + 2 * l * l * NUMBEROFCHUNKPOINTS, m_outputs_chunk_float + l * l * NUMBEROFCHUNKPOINTS, size);
+                    from    += degree_size * degree_size;
+                    to      += degree_size * degree_size;
+                    block   += degree_size * degree_size * 2;
+                }
+                
+                double* matrix  = m_matrix_from;
+                m_matrix_from   = m_matrix_to;
+                m_matrix_to     = matrix;
+                for(unsigned int i = 0; i < m_matrix_size; i++)
+                    m_matrix_float[i] = m_matrix_from[i];
+            }
+            else
+            {
+                const float* block = m_matrix_float + 1;
+                for(unsigned int l = 1; l <= m_order; l++)
+                {
+                    const unsigned int degree_size = 2 * l + 1;
+                    matrix_chunk_product(block, degree_size, degree_size, m_inputs_chunk_float + 2 * l * l * NUMBEROFCHUNKPOINTS, m_outputs_chunk_float + l * l * NUMBEROFCHUNKPOINTS, size);
+                    block += degree_size * degree_size;
+                }
+            }
+            
+            for(unsigned int i = 1; i < m_number_of_harmonics; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_float + i * NUMBEROFCHUNKPOINTS, size * sizeof(float));
+        }
+        Hoa::atomic_store(&m_time, m_time + vectorSize);
+    }
+    
+    void HeadTracker::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        const unsigned int sub_block_size = Hoa::atomic_load(&m_sub_block_size);
+        const double delay = (double)Hoa::atomic_load(&m_delay);
+        if(outputs[0] != inputs[0])
+            cblas_dcopy(vectorSize, inputs[0], 1, outputs[0], 1);
+        
+        double gains[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += sub_block_size)
+        {
+            const unsigned int size = (vectorSize - offset) < sub_block_size ? (vectorSize - offset) : sub_block_size;
+            const bool changed = update((double)(m_time + offset + size) - delay);
+            
+            // The harmonics of a degree are followed by the harmonics weighted by the ramp
+            for(unsigned int l = 1; l <= m_order; l++)
+            {
+                for(unsigned int m = 0; m < 2 * l + 1; m++)
+                    memcpy(m_inputs_chunk_double + (2 * l * l + m) * NUMBEROFCHUNKPOINTS, inputs[l * l + m] + offset, size * sizeof(double));
+            }
+            
+            if(changed)
+            {
+                for(unsigned int k = 0; k < size; k++)
+                    gains[k] = (double)(k + 1) / (double)size;
+                const double* from  = m_matrix_from + 1;
+                const double* to    = m_matrix_to + 1;
+                double* block       = m_ramp_matrix_double + 2;
+                for(unsigned int l = 1; l <= m_order; l++)
+                {
+                    const unsigned int degree_size = 2 * l + 1;
+                    for(unsigned int m = 0; m < degree_size; m++)
+                    {
+                        const double* input = m_inputs_chunk_double + (2 * l * l + m) * NUMBEROFCHUNKPOINTS;
+                        double* weighted = m_inputs_chunk_double + (2 * l * l + degree_size + m) * NUMBEROFCHUNKPOINTS;
+                        for(unsigned int k = 0; k < size; k++)
+                            weighted[k] = input[k] * gains[k];
+                        for(unsigned int n = 0; n < degree_size; n++)
+                        {
+                            block[m * degree_size * 2 + n]                 = from[m * degree_size + n];
+                            block[m * degree_size * 2 + degree_size + n]   = to[m * degree_size + n] - from[m * degree_size + n];
+                        }
+                    }
+                    matrix_chunk_product(block, degree_size, degree_size * 2, m_inputs_chunk_double + 2 * l * l * NUMBEROFCHUNKPOINTS, m_outputs_chunk_double + l * l * NUMBEROFCHUNKPOINTS, size);
+                    from    += degree_size * degree_size;
+                    to      += degree_size * degree_size;
+                    block   += degree_size * degree_size * 2;
+                }
+                
+                double* matrix  = m_matrix_from;
+                m_matrix_from   = m_matrix_to;
+                m_matrix_to     = matrix;
+                for(unsigned int i = 0; i < m_matrix_size; i++)
+                    m_matrix_float[i] = m_matrix_from[i];
+            }
+            else
+            {
+                const double* block = m_matrix_from + 1;
+                for(unsigned int l = 1; l <= m_order; l++)
+                {
+                    const unsigned int degree_size = 2 * l + 1;
+                    matrix_chunk_product(block, degree_size, degree_size, m_inputs_chunk_double + 2 * l * l * NUMBEROFCHUNKPOINTS, m_outputs_chunk_double + l * l * NUMBEROFCHUNKPOINTS, size);
+                    block += degree_size * degree_size;
+                }
+            }
+            
+            for(unsigned int i = 1; i < m_number_of_harmonics; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_double + i * NUMBEROFCHUNKPOINTS, size * sizeof(double));
+        }
+        Hoa::atomic_store(&m_time, m_time + vectorSize);
+    }
+    
+    HeadTracker::~HeadTracker()
+    {
+        delete m_rotate;
+        delete m_orientations;
+        delete [] m_buffer;
+        delete [] m_matrix_from;
+        delete [] m_matrix_to;
+        delete [] m_matrix_float;
+        delete [] m_ramp_matrix_float;
+        delete [] m_ramp_matrix_double;
+        delete [] m_inputs_chunk_float;
+        delete [] m_inputs_chunk_double;
+        delete [] m_outputs_chunk_float;
+        delete [] m_outputs_chunk_double;
+    }
+}
+
@@ -0,0 +1,147 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_3D_HEAD_TRACKER__
+#define __DEF_HOA_3D_HEAD_TRACKER__
+
+#include "Rotate_3D.h"
+#include "../HoaCommon/Queue.h"
+
+namespace Hoa3D
+{
+    //! The ambisonic head tracker.
+    /** The head tracker rotates the sound field by the inverse of the orientation of the head so the sound sources stay in place when the listener moves the head. The orientations are unit quaternions timestamped in samples that the tracker thread pushes in a lock-free queue. The audio thread splits the blocks in sub-blocks, evaluates the orientation at the end of each sub-block with a spherical linear interpolation between the two surrounding orientations, rebuilds the block-diagonal matrix of the rotation with the recursion of the Rotate class only if the orientation has changed and interpolates linearly from the previous matrix to the new one over the sub-block, so the output doesn't click and the cost of a block is bounded. The orientations are rendered with a delay so the interpolation never has to extrapolate.
+     */
+    class HeadTracker : public Ambisonic
+    {
+    public:
+        
+        //! The timestamped orientation of the head.
+        struct Orientation
+        {
+            double  time;
+            double  w;
+            double  x;
+            double  y;
+            double  z;
+        };
+    
+    private:
+        
+        Rotate*                     m_rotate;
+        Hoa::Queue<Orientation>*    m_orientations;
+        Orientation                 m_current;
+        Orientation                 m_next;
+        bool                        m_has_next;
+        double                      m_quaternion[4];
+        size_t                      m_time;
+        unsigned int                m_delay;
+        unsigned int                m_sub_block_size;
+        unsigned int                m_matrix_size;
+        double*                     m_buffer;
+        double*                     m_matrix_from;
+        double*                     m_matrix_to;
+        float*                      m_matrix_float;
+        float*                      m_ramp_matrix_float;
+        double*                     m_ramp_matrix_double;
+        float*                      m_inputs_chunk_float;
+        double*                     m_inputs_chunk_double;
+        float*                      m_outputs_chunk_float;
+        double*                     m_outputs_chunk_double;
+        
+        //! Evaluate the orientation at a time and compute the matrix of the end of the sub-block if the orientation has changed.
+        bool update(const double time);
+        
+        HeadTracker(const HeadTracker& other);
+        HeadTracker& operator=(const HeadTracker& other);
+    
+    public:
+        
+        //! The head tracker constructor.
+        /**	The head tracker constructor allocates and initialize the member values to rotate the spherical harmonics depending on a decomposition order. The order must be at least 1, the head is initially facing the front and the queue can contain a number of orientations.
+         
+            @param     order        The order.
+            @param     capacity     The minimum number of orientations of the queue.
+         */
+        HeadTracker(unsigned int order, unsigned int capacity = 256);
+        
+        //! The head tracker destructor.
+        /**	The head tracker destructor free the memory.
+         */
+        ~HeadTracker();
+        
+        //! Push an orientation of the head.
+        /**	Push a timestamped orientation of the head, the quaternion is normalized and the timestamps should increase. The time is in samples on the clock of the processing, the current time can be retrieved with getTime(). This method must only be called by the tracker thread.
+         
+            @param     time     The time of the orientation in samples.
+            @param     w        The real part of the quaternion.
+            @param     x        The component of the quaternion on the x-axis.
+            @param     y        The component of the quaternion on the y-axis.
+            @param     z        The component of the quaternion on the z-axis.
+            @return    False if the queue is full or if the quaternion is null.
+         */
+        bool push(const double time, const double w, const double x, const double y, const double z);
+        
+        /**	Retrieve the number of samples processed since the creation of the head tracker, this is the clock of the timestamps. The clock is written by the audio thread and read by the tracker thread, it is a word of the target so its loads and stores are atomic, on 32-bit targets it wraps after 2^32 samples.
+         */
+        inline double getTime() const
+        {
+            return (double)Hoa::atomic_load(&m_time);
+        };
+        
+        //! Set the delay of the rendering.
+        /**	Set the number of samples between the timestamp of an orientation and its rendering. A delay greater than the period of the tracker ensures that the orientations are always interpolated and never held.
+         
+            @param     numberOfSamples  The delay in samples.
+         */
+        void setDelay(const unsigned int numberOfSamples);
+        
+        /**	Retrieve the delay of the rendering in samples.
+         */
+        inline unsigned int getDelay() const
+        {
+            return Hoa::atomic_load(&m_delay);
+        };
+        
+        //! Set the size of the sub-blocks.
+        /**	Set the number of samples between two updates of the rotation matrix, between 1 and NUMBEROFCHUNKPOINTS. A size between 16 and 64 samples is a good tradeoff between the cost of the matrices and the smoothness of the rotation.
+         
+            @param     numberOfSamples  The size of the sub-blocks.
+         */
+        void setSubBlockSize(const unsigned int numberOfSamples);
+        
+        /**	Retrieve the number of samples between two updates of the rotation matrix.
+         */
+        inline unsigned int getSubBlockSize() const
+        {
+            return Hoa::atomic_load(&m_sub_block_size);
+        };
+        
+        //! This method performs the rotation with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the rotation on a whole vector of samples. The inputs array and outputs array contains one vector for each spherical harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the rotation with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the rotation on a whole vector of samples. The inputs array and outputs array contains one vector for each spherical harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+    };
+
+} // end of namespace Hoa3D
+
+#endif
+
+
+
@@ -21,10 +21,12 @@ namespace Hoa3D{};
 #include "Wider_3D.h"
 #include "Optim_3D.h"
 #include "Rotate_3D.h"
+#include "HeadTracker_3D.h"
 #include "Meter_3D.h"
 #include "Map_3D.h"
 #include "Scope_3D.h"
 #include "Vector_3D.h"
+#include "Vbap_3D.h"
 
 #endif
 
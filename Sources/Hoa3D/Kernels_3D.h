@@ -0,0 +1,149 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_3D_KERNELS__
+#define __DEF_HOA_3D_KERNELS__
+
+#include "../Hoa.h"
+
+namespace Hoa3D
+{
+    //! The kernels of an order.
+    /** The kernels perform the sample by sample processing of the ambisonic classes with a number of harmonics and a size of the blocks of the rotation known at compile time, so the compiler can unroll and vectorize the loops over the harmonics. The kernels perform exactly the same operations as the generic loops of the classes.
+     */
+    template <unsigned int Order> class Kernels
+    {
+    public:
+        
+        //! The number of harmonics of the order.
+        static const unsigned int number_of_harmonics = (Order + 1) * (Order + 1);
+        
+        //! Encode a sample with the tables.
+        /** The harmonics are the products of the harmonics of the azimuth and the harmonics of the elevation.
+         
+            @param     input        The input sample.
+            @param     azimuths     The harmonics of the azimuth.
+            @param     elevations   The harmonics of the elevation.
+            @param     outputs      The harmonics.
+         */
+        template <typename T> static void encode(const T input, const double* azimuths, const double* elevations, T* outputs)
+        {
+            for(unsigned int i = 0; i < number_of_harmonics; i++)
+                outputs[i] = input * azimuths[i] * elevations[i];
+        }
+        
+        //! Encode a sample with computed harmonics.
+        /** The harmonics are the product of the input and the harmonics.
+         
+            @param     input        The input sample.
+            @param     harmonics    The harmonics.
+            @param     outputs      The harmonics of the sample.
+         */
+        template <typename T> static void scale(const T input, const double* harmonics, T* outputs)
+        {
+            for(unsigned int i = 0; i < number_of_harmonics; i++)
+                outputs[i] = input * harmonics[i];
+        }
+        
+        //! Rotate the harmonics of a sample.
+        /** The harmonics of each degree are multiplied by the square block of the degree of the block-diagonal rotation matrix.
+         
+            @param     matrix   The rotation matrix of the harmonics.
+            @param     inputs   The input harmonics.
+            @param     outputs  The output harmonics, can't be the inputs.
+         */
+        template <typename T> static void rotate(const T* matrix, const T* inputs, T* outputs)
+        {
+            const T* block = matrix;
+            outputs[0] = inputs[0] * block[0];
+            block++;
+            for(unsigned int l = 1, index = 1; l <= Order; l++)
+            {
+                const unsigned int size = 2 * l + 1;
+                for(unsigned int m = 0; m < size; m++)
+                {
+                    T value = 0;
+                    for(unsigned int n = 0; n < size; n++)
+                        value += block[m * size + n] * inputs[index + n];
+                    outputs[index + m] = value;
+                }
+                block += size * size;
+                index += size;
+            }
+        }
+        
+        //! Weight the harmonics of a sample.
+        /** Each harmonic is multiplied by its weight.
+         
+            @param     weights  The weights of the harmonics.
+            @param     inputs   The input harmonics.
+            @param     outputs  The output harmonics, can be the inputs.
+         */
+        template <typename T> static void weight(const double* weights, const T* inputs, T* outputs)
+        {
+            for(unsigned int i = 0; i < number_of_harmonics; i++)
+                outputs[i] = inputs[i] * weights[i];
+        }
+    };
+    
+    //! The kernels table.
+    /** The kernels table contains the kernels of an order for a precision.
+     */
+    template <typename T> struct KernelsTable
+    {
+        void (*encode)(const T input, const double* azimuths, const double* elevations, T* outputs);
+        void (*scale)(const T input, const double* harmonics, T* outputs);
+        void (*rotate)(const T* matrix, const T* inputs, T* outputs);
+        void (*weight)(const double* weights, const T* inputs, T* outputs);
+    };
+    
+    //! Retrieve the kernels table of an order.
+    template <unsigned int Order, typename T> inline const KernelsTable<T>* getKernelsTable()
+    {
+        static const KernelsTable<T> table =
+        {
+            &Kernels<Order>::template encode<T>,
+            &Kernels<Order>::template scale<T>,
+            &Kernels<Order>::template rotate<T>,
+            &Kernels<Order>::template weight<T>
+        };
+        return &table;
+    }
+    
+    //! The dispatch of the kernels tables.
+    /** The dispatch compares the order with the orders from Order to HOA_MAX_KERNELS_ORDER, so the kernels of all the orders of the macro are instantiated.
+     */
+    template <unsigned int Order, typename T> struct KernelsDispatch
+    {
+        static const KernelsTable<T>* get(const unsigned int order)
+        {
+            if(order == Order)
+                return getKernelsTable<Order, T>();
+            return KernelsDispatch<Order + 1, T>::get(order);
+        }
+    };
+    
+    template <typename T> struct KernelsDispatch<HOA_MAX_KERNELS_ORDER + 1, T>
+    {
+        static const KernelsTable<T>* get(const unsigned int)
+        {
+            return NULL;
+        }
+    };
+    
+    //! Retrieve the kernels of an order.
+    /** The kernels are instantiated for the orders 1 to HOA_MAX_KERNELS_ORDER, the classes should use their generic loops for the greater orders.
+     
+        @param     order    The order.
+        @return    The kernels table or NULL if the order has no kernels.
+     */
+    template <typename T> inline const KernelsTable<T>* getKernels(const unsigned int order)
+    {
+        return KernelsDispatch<1, T>::get(order);
+    }
+}
+
+#endif
@@ -15,7 +15,18 @@ namespace Hoa3D
         m_number_of_sources = numberOfSources;
         m_harmonics_float   = new float[m_number_of_harmonics];
         m_harmonics_double  = new double[m_number_of_harmonics];
-        m_gains             = new double[m_number_of_harmonics];
+        m_gains             = new double[m_number_of_sources];
+        m_chunk_float       = new float[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_chunk_double      = new double[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_chunk_vectors_float   = new float*[m_number_of_harmonics];
+        m_chunk_vectors_double  = new double*[m_number_of_harmonics];
+        m_outputs_vectors_float = new float*[m_number_of_harmonics];
+        m_outputs_vectors_double= new double*[m_number_of_harmonics];
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            m_chunk_vectors_float[i]    = m_chunk_float + i * NUMBEROFCHUNKPOINTS;
+            m_chunk_vectors_double[i]   = m_chunk_double + i * NUMBEROFCHUNKPOINTS;
+        }
         m_muted				= new bool[m_number_of_sources];
         for(unsigned int i = 0; i < m_number_of_sources; i++)
         {
@@ -122,12 +133,147 @@ namespace Hoa3D
         }
     }
     
+    void Map::process(const float* const* inputs, const float* const* azimuths, const float* const* elevations, float** outputs, const unsigned int vectorSize)
+    {
+        int first = m_first_source;
+        if(first < 0)
+        {
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            {
+                for(unsigned int k = 0; k < vectorSize; k++)
+                    outputs[i][k] = 0.;
+            }
+            return;
+        }
+        
+        float sig[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                m_outputs_vectors_float[j] = outputs[j] + offset;
+            
+            for(unsigned int i = first; i < m_number_of_sources; i++)
+            {
+                if(m_muted[i])
+                    continue;
+                
+                // The first source is encoded in the outputs, the others are encoded in the chunk and accumulated.
+                float** harmonics = (i == (unsigned int)first) ? m_outputs_vectors_float : m_chunk_vectors_float;
+                const float* input = inputs[i] + offset;
+                const float gain = m_gains[i];
+                for(unsigned int k = 0; k < size; k++)
+                    sig[k] = input[k] * gain;
+                
+                m_encoders[i]->process(sig, (azimuths && azimuths[i]) ? azimuths[i] + offset : NULL, (elevations && elevations[i]) ? elevations[i] + offset : NULL, harmonics, size);
+                m_widers[i]->process(harmonics, harmonics, size);
+                if(i != (unsigned int)first)
+                {
+                    for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                    {
+                        const float* chunk = m_chunk_vectors_float[j];
+                        float* output = m_outputs_vectors_float[j];
+                        for(unsigned int k = 0; k < size; k++)
+                            output[k] += chunk[k];
+                    }
+                }
+            }
+        }
+        
+        if(vectorSize)
+        {
+            for(unsigned int i = 0; i < m_number_of_sources; i++)
+            {
+                if(m_muted[i] || i < (unsigned int)first)
+                {
+                    if(azimuths && azimuths[i])
+                        setAzimuth(i, azimuths[i][vectorSize - 1]);
+                    if(elevations && elevations[i])
+                        setElevation(i, elevations[i][vectorSize - 1]);
+                }
+            }
+        }
+    }
+    
+    void Map::process(const double* const* inputs, const double* const* azimuths, const double* const* elevations, double** outputs, const unsigned int vectorSize)
+    {
+        int first = m_first_source;
+        if(first < 0)
+        {
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            {
+                for(unsigned int k = 0; k < vectorSize; k++)
+                    outputs[i][k] = 0.;
+            }
+            return;
+        }
+        
+        double sig[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                m_outputs_vectors_double[j] = outputs[j] + offset;
+            
+            for(unsigned int i = first; i < m_number_of_sources; i++)
+            {
+                if(m_muted[i])
+                    continue;
+                
+                // The first source is encoded in the outputs, the others are encoded in the chunk and accumulated.
+                double** harmonics = (i == (unsigned int)first) ? m_outputs_vectors_double : m_chunk_vectors_double;
+                const double* input = inputs[i] + offset;
+                const double gain = m_gains[i];
+                for(unsigned int k = 0; k < size; k++)
+                    sig[k] = input[k] * gain;
+                
+                m_encoders[i]->process(sig, (azimuths && azimuths[i]) ? azimuths[i] + offset : NULL, (elevations && elevations[i]) ? elevations[i] + offset : NULL, harmonics, size);
+                m_widers[i]->process(harmonics, harmonics, size);
+                if(i != (unsigned int)first)
+                {
+                    for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                    {
+                        const double* chunk = m_chunk_vectors_double[j];
+                        double* output = m_outputs_vectors_double[j];
+                        for(unsigned int k = 0; k < size; k++)
+                            output[k] += chunk[k];
+                    }
+                }
+            }
+        }
+        
+        if(vectorSize)
+        {
+            for(unsigned int i = 0; i < m_number_of_sources; i++)
+            {
+                if(m_muted[i] || i < (unsigned int)first)
+                {
+                    if(azimuths && azimuths[i])
+                        setAzimuth(i, azimuths[i][vectorSize - 1]);
+                    if(elevations && elevations[i])
+                        setElevation(i, elevations[i][vectorSize - 1]);
+                }
+            }
+        }
+    }
+    
     Map::~Map()
     {
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            delete m_encoders[i];
+            delete m_widers[i];
+        }
         m_encoders.clear();
         m_widers.clear();
         delete [] m_harmonics_double;
         delete [] m_harmonics_float;
+        delete [] m_chunk_float;
+        delete [] m_chunk_double;
+        delete [] m_chunk_vectors_float;
+        delete [] m_chunk_vectors_double;
+        delete [] m_outputs_vectors_float;
+        delete [] m_outputs_vectors_double;
         delete [] m_gains;
         delete [] m_muted;
     }
@@ -26,6 +26,12 @@ namespace Hoa3D
         unsigned int            m_number_of_sources;
         float*                  m_harmonics_float;
         double*                 m_harmonics_double;
+        float*                  m_chunk_float;
+        double*                 m_chunk_double;
+        float**                 m_chunk_vectors_float;
+        double**                m_chunk_vectors_double;
+        float**                 m_outputs_vectors_float;
+        double**                m_outputs_vectors_double;
         double*                 m_gains;
         std::vector<Encoder*>   m_encoders;
         std::vector<Wider*>     m_widers;
@@ -159,6 +165,28 @@ namespace Hoa3D
             @param     outputs The outputs array.
          */
         void process(const double* inputs, double* outputs);
+        
+        //! This method performs the encoding with radius compensation with single precision on a block of samples with signals of angles.
+        /**	You should use this method for not-in-place processing and performs the encoding with radius compensation on a whole vector of samples with an angle of azimuth and an angle of elevation for each sample of each source. The inputs array contains one vector for each source, its minimum size must be the number of sources. The azimuths and the elevations arrays contain one vector of angles in radian for each source, the arrays or their vectors can be NULL to use the current angles of the sources. The outputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. At the end of the block, the angles of the sources are the last values of their vectors.
+         
+            @param     inputs       The input vectors.
+            @param     azimuths     The azimuths vectors.
+            @param     elevations   The elevations vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, const float* const* azimuths, const float* const* elevations, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the encoding with radius compensation with double precision on a block of samples with signals of angles.
+        /**	You should use this method for not-in-place processing and performs the encoding with radius compensation on a whole vector of samples with an angle of azimuth and an angle of elevation for each sample of each source. The inputs array contains one vector for each source, its minimum size must be the number of sources. The azimuths and the elevations arrays contain one vector of angles in radian for each source, the arrays or their vectors can be NULL to use the current angles of the sources. The outputs array contains one vector for each spherical harmonic, its minimum size must be the number of harmonics. Each vector must contain at least the vector size samples. At the end of the block, the angles of the sources are the last values of their vectors.
+         
+            @param     inputs       The input vectors.
+            @param     azimuths     The azimuths vectors.
+            @param     elevations   The elevations vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, const double* const* azimuths, const double* const* elevations, double** outputs, const unsigned int vectorSize);
     };
 }
 
@@ -13,6 +13,13 @@ namespace Hoa3D
         m_ramp                  = 0;
         m_vector_size           = 256;
         m_channels_peaks		= new double[m_number_of_channels];
+        m_channels_squares      = new double[m_number_of_channels];
+        m_channels_levels       = new double[m_number_of_channels];
+        m_snapshots             = new Hoa::TripleBuffer<double>(3 * m_number_of_channels);
+        m_snapshot              = m_snapshots->read();
+        m_sample_rate           = 44100.;
+        m_attack                = 0.;
+        m_release               = 0.;
         m_number_of_rows        = numberOfRows;
         m_number_of_columns     = numberOfColumns;
         if(m_number_of_rows % 2 != 1)
@@ -21,17 +28,55 @@ namespace Hoa3D
             m_number_of_columns++;
         
         for(unsigned int i = 0; i < numberOfChannels; i++)
-            m_channels_peaks[i] = 0.;
-        
+        {
+            m_channels_peaks[i]     = 0.;
+            m_channels_squares[i]   = 0.;
+            m_channels_levels[i]    = 0.;
+        }
+        computeBallistics();
+		
 		setChannelPosition(0, m_channels_azimuth[0], m_channels_elevation[0]);
     }
     
     void Meter::setVectorSize(unsigned int vectorSize)
     {
-        m_vector_size   = vectorSize;
+        m_vector_size   = vectorSize > 0 ? vectorSize : 1;
         m_ramp          = 0;
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+        {
+            m_channels_peaks[i]     = 0.;
+            m_channels_squares[i]   = 0.;
+        }
+        computeBallistics();
+    }
+    
+    void Meter::setSampleRate(double sampleRate)
+    {
+        m_sample_rate = clip_min(sampleRate, 1.);
+        computeBallistics();
+    }
+    
+    void Meter::setAttack(double attack)
+    {
+        m_attack = clip_min(attack, 0.);
+        computeBallistics();
     }
     
+    void Meter::setRelease(double release)
+    {
+        m_release = clip_min(release, 0.);
+        computeBallistics();
+    }
+    
+    void Meter::computeBallistics()
+    {
+        // The level is updated once by window, the coefficients are the decays of the exponentials over a window
+        const double attack     = m_attack * m_sample_rate / 1000.;
+        const double release    = m_release * m_sample_rate / 1000.;
+        m_attack_coefficient    = attack > 0. ? exp(-(double)m_vector_size / attack) : 0.;
+        m_release_coefficient   = release > 0. ? exp(-(double)m_vector_size / release) : 0.;
+    }
+	
 	void Meter::setChannelsPosition(double* azimuths, double* elevations)
 	{
 		Planewaves::setChannelsPosition(azimuths, elevations);
@@ -49,7 +94,7 @@ namespace Hoa3D
         Planewaves::setChannelsRotation(axis_x, axis_y, axis_z);
         setChannelPosition(0, m_channels_azimuth[0], m_channels_elevation[0]);
     }
-    
+	
 	void Meter::find_channels_boundaries()
 	{
 		int indices[8];
@@ -58,7 +103,7 @@ namespace Hoa3D
 		unsigned int numberOfColumns = m_number_of_columns;
         unsigned int numberOfChannels = m_number_of_channels;
 		int* sphere = new int[numberOfRows * numberOfColumns];
-
+		
 		double* azimuths = m_channels_rotated_azimuth;
 		double* elevations = m_channels_rotated_elevation;
         
@@ -156,7 +201,7 @@ namespace Hoa3D
                                 }
                             }
                         }
-                        
+                    
                     }
                 }
             }
@@ -176,7 +221,7 @@ namespace Hoa3D
                             break;
                         }
                     }
-
+                
                 }
             }
             test = 1;
@@ -208,52 +253,78 @@ namespace Hoa3D
             std::sort(m_points_top[l].begin(), m_points_top[l].end(), MeterPoint::compareRelativeAzimuth);
             std::sort(m_points_bottom[l].begin(), m_points_bottom[l].end(), MeterPoint::compareRelativeAzimuth);
         }
-        
+		
 		delete [] sphere;
 	}
     
-    void Meter::process(const float* inputs)
+    void Meter::publish()
     {
-        if(m_ramp++ == m_vector_size)
+        double* snapshot = m_snapshots->getWrite();
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
         {
-            m_ramp = 0;
-            for(unsigned int i = 0; i < m_number_of_channels; i++)
-            {
-                m_channels_peaks[i] = fabs(inputs[i]);
-            }
-        }
-        else
-        {
-            for(unsigned int i = 0; i < m_number_of_channels; i++)
-            {
-                if(fabs(inputs[i]) > m_channels_peaks[i])
-                    m_channels_peaks[i] = fabs(inputs[i]);
-            }
+            const double peak       = m_channels_peaks[i];
+            const double coefficient = (peak > m_channels_levels[i]) ? m_attack_coefficient : m_release_coefficient;
+            m_channels_levels[i]    = peak + (m_channels_levels[i] - peak) * coefficient;
+            snapshot[i]                             = peak;
+            snapshot[m_number_of_channels + i]      = sqrt(m_channels_squares[i] / (double)m_vector_size);
+            snapshot[2 * m_number_of_channels + i]  = m_channels_levels[i];
+            m_channels_peaks[i]     = 0.;
+            m_channels_squares[i]   = 0.;
         }
+        m_snapshots->publish();
+        m_ramp = 0;
+    }
+    
+    void Meter::process(const float* inputs)
+    {
+        getSimdKernels()->peak_float(inputs, m_channels_peaks, m_channels_squares, m_number_of_channels);
+        if(++m_ramp >= m_vector_size)
+            publish();
     }
     
     void Meter::process(const double* inputs)
     {
-        if(m_ramp++ == m_vector_size)
+        getSimdKernels()->peak_double(inputs, m_channels_peaks, m_channels_squares, m_number_of_channels);
+        if(++m_ramp >= m_vector_size)
+            publish();
+    }
+    
+    void Meter::process(const float* const* inputs, const unsigned int vectorSize)
+    {
+        const Hoa::SimdKernels* kernels = getSimdKernels();
+        for(unsigned int k = 0; k < vectorSize;)
         {
-            m_ramp = 0;
+            const unsigned int size = std::min(vectorSize - k, m_vector_size - m_ramp);
             for(unsigned int i = 0; i < m_number_of_channels; i++)
-            {
-                m_channels_peaks[i] = fabs(inputs[i]);
-            }
+                kernels->meter_float(inputs[i] + k, m_channels_peaks + i, m_channels_squares + i, size);
+            k       += size;
+            m_ramp  += size;
+            if(m_ramp >= m_vector_size)
+                publish();
         }
-        else
+    }
+    
+    void Meter::process(const double* const* inputs, const unsigned int vectorSize)
+    {
+        const Hoa::SimdKernels* kernels = getSimdKernels();
+        for(unsigned int k = 0; k < vectorSize;)
         {
+            const unsigned int size = std::min(vectorSize - k, m_vector_size - m_ramp);
             for(unsigned int i = 0; i < m_number_of_channels; i++)
-            {
-                if(fabs(inputs[i]) > m_channels_peaks[i])
-                    m_channels_peaks[i] = fabs(inputs[i]);
-            }
+                kernels->meter_double(inputs[i] + k, m_channels_peaks + i, m_channels_squares + i, size);
+            k       += size;
+            m_ramp  += size;
+            if(m_ramp >= m_vector_size)
+                publish();
         }
     }
     
     Meter::~Meter()
     {
+        delete [] m_channels_peaks;
+        delete [] m_channels_squares;
+        delete [] m_channels_levels;
+        delete m_snapshots;
 		for(unsigned int i = 0; i < m_number_of_channels; i++)
         {
             //m_points[i].clear();
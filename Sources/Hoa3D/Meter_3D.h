@@ -8,6 +8,7 @@
 #define __DEF_HOA_3D_METER__
 
 #include "Planewaves_3D.h"
+#include "../HoaCommon/TripleBuffer.h"
 
 namespace Hoa3D
 {
@@ -102,7 +103,7 @@ namespace Hoa3D
     };
     
     //! The planewaves peak level meter.
-    /** The meter should be used to widen the sound propagation.
+    /** The meter computes the peak, the RMS and the level of the channels over windows of vector size samples. The level follows the peaks with the attack and release ballistics. At the end of each window the audio thread publishes a snapshot of the values with a triple buffer, so the graphical interface takes the last complete window without lock with update() while the audio thread processes the next one.
      */
     class Meter : public Planewaves
     {
@@ -112,11 +113,28 @@ namespace Hoa3D
         unsigned int    m_number_of_rows;
         unsigned int    m_number_of_columns;
         double*         m_channels_peaks;
+        double*         m_channels_squares;
+        double*         m_channels_levels;
+        double          m_sample_rate;
+        double          m_attack;
+        double          m_release;
+        double          m_attack_coefficient;
+        double          m_release_coefficient;
+        Hoa::TripleBuffer<double>* m_snapshots;
+        const double*   m_snapshot;
         
         std::vector<MeterPoint> m_points_top[256];
         std::vector<MeterPoint> m_points_bottom[256];
-
+		
 		void find_channels_boundaries();
+        
+        /**	Compute the coefficients of the ballistics for a window.
+         */
+        void computeBallistics();
+        
+        /**	Compute the RMS and the levels of the window, publish the snapshot and start the next window.
+         */
+        void publish();
     public:
         
         //! The meter constructor.
@@ -131,8 +149,56 @@ namespace Hoa3D
          */
         ~Meter();
         
+        //! Set the vector size.
+        /**	Set the number of samples of the windows over which the peaks and the RMS are computed, a snapshot is published at the end of each window.
+         
+            @param     vectorSize	The vector size.
+         */
         void setVectorSize(unsigned int vectorSize);
         
+        //! Get the vector size.
+        /**	Retrieve the number of samples of the windows.
+         
+            @return    The vector size.
+         */
+        inline unsigned int getVectorSize() const
+        {
+            return m_vector_size;
+        };
+        
+        //! Set the sample rate.
+        /**	Set the sample rate used to convert the attack and the release times, the default sample rate is 44100.
+         
+            @param     sampleRate	The sample rate.
+         */
+        void setSampleRate(double sampleRate);
+        
+        //! Set the attack time.
+        /**	Set the time in milliseconds that the level takes to rise by 63% of the distance to a greater peak, 0 makes the level jump to the peak. The default attack time is 0.
+         
+            @param     attack	The attack time.
+         */
+        void setAttack(double attack);
+        
+        //! Set the release time.
+        /**	Set the time in milliseconds that the level takes to fall by 63% of the distance to a lower peak, 0 makes the level fall to the peak. The default release time is 0.
+         
+            @param     release	The release time.
+         */
+        void setRelease(double release);
+        
+        //! Get the attack time.
+        inline double getAttack() const
+        {
+            return m_attack;
+        };
+        
+        //! Get the release time.
+        inline double getRelease() const
+        {
+            return m_release;
+        };
+        
         //! Set the position of a channel.
         /** Set the position of a channel with polar coordinates. The azimtuh is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The elevation is in radian between -1/2 Pi and 1/2 Pi, -1/2 Pi the the bottom of the sound field, 0 is the center of the sound field and 1/2 Pi is the top of the sound field. The maximum index must be the number of channels - 1.
          
@@ -141,7 +207,7 @@ namespace Hoa3D
          @param     elevation	The elevation.
          */
 		void setChannelPosition(unsigned int index, double azimuth, double elevation);
-        
+		
 		//! Set the position of the channels.
         /** Set the position of the channels with polar coordinates. The azimtuh is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The elevation is in radian between -1/2 Pi and 1/2 Pi, -1/2 Pi the the bottom of the sound field, 0 is the center of the sound field and 1/2 Pi is the top of the sound field. The maximum index must be the number of channels - 1.
          
@@ -149,7 +215,7 @@ namespace Hoa3D
             @param     elevations	The elevations.
          */
 		void setChannelsPosition(double* azimuths, double* elevations);
-
+        
         //! Set the rotation of the channels.
 		/**	Set the angles in radian of the rotation of the channels around the axes x, y and z.
          
@@ -158,7 +224,7 @@ namespace Hoa3D
          @param     axis_z	The angle of rotation around the z axe.
          */
 		void setChannelsRotation(double axis_x, double axis_y, double axis_z);
-        
+		
 		inline unsigned int getChannelNumberOfPoints(unsigned int index, bool top = 1) const
         {
             assert(index < m_number_of_channels);
@@ -167,7 +233,7 @@ namespace Hoa3D
 			else
 				return m_points_bottom[index].size();
         }
-
+		
 		inline double getChannelPointAzimuth(unsigned int index, unsigned int pointindex, bool top = 1) const
         {
             assert(index < m_number_of_channels);
@@ -175,9 +241,9 @@ namespace Hoa3D
 				return m_points_top[index][pointindex].azimuth();
 			else
 				return m_points_bottom[index][pointindex].azimuth();
-            
+        
         }
-
+		
 		inline double getChannelPointElevation(unsigned int index, unsigned int pointindex, bool top = 1) const
         {
             assert(index < m_number_of_channels);
@@ -186,35 +252,96 @@ namespace Hoa3D
 			else
 				return m_points_bottom[index][pointindex].elevation();
         }
-
+        
+        //! Take the last snapshot.
+        /**	Take the last snapshot published by the audio thread, the peaks, the RMS, the levels and the energies of the channels are read from this snapshot until the next update so they all belong to the same window. This method should be called once per frame before the values are read, this method and the getters of the values must only be called by one reader thread.
+         */
+        inline void update()
+        {
+            m_snapshot = m_snapshots->read();
+        }
+        
+        //! Retrieve the peak value of a channel.
+        /**	Retrieve the greatest absolute value of a channel over the last complete window from the snapshot taken by the last update.
+         
+            @param     index	The index of the channel.
+            @return    The peak value.
+         */
         inline double getChannelPeak(unsigned int index) const
         {
             assert(index < m_number_of_channels);
-            return m_channels_peaks[index];
+            return m_snapshot[index];
+        }
+        
+        //! Retrieve the RMS value of a channel.
+        /**	Retrieve the root mean square of a channel over the last complete window from the snapshot taken by the last update.
+         
+            @param     index	The index of the channel.
+            @return    The RMS value.
+         */
+        inline double getChannelRms(unsigned int index) const
+        {
+            assert(index < m_number_of_channels);
+            return m_snapshot[m_number_of_channels + index];
         }
         
+        //! Retrieve the level of a channel.
+        /**	Retrieve the peak value of a channel smoothed by the attack and release ballistics from the snapshot taken by the last update.
+         
+            @param     index	The index of the channel.
+            @return    The level.
+         */
+        inline double getChannelLevel(unsigned int index) const
+        {
+            assert(index < m_number_of_channels);
+            return m_snapshot[2 * m_number_of_channels + index];
+        }
+        
+        //! Retrieve the energy of a channel.
+        /**	Retrieve the level of a channel in decibels, clipped to -90 dB or -91 dB for silence.
+         
+            @param     index	The index of the channel.
+            @return    The energy.
+         */
         inline double getChannelEnergy(unsigned int index) const
         {
             assert(index < m_number_of_channels);
-            if(m_channels_peaks[index] == 0.)
+            const double level = getChannelLevel(index);
+            if(level == 0.)
                 return -91;
             else
-                return clip_min(20. * log10(m_channels_peaks[index]), -90.);
+                return clip_min(20. * log10(level), -90.);
         }
-       
-        //! This method performs the widening with single precision.
-        /**	You should use this method for in-place or not-in-place processing and performs the widening sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+        
+        //! This method performs the metering with single precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the metering sample by sample. The inputs array contains the samples of the channels and its minimum size must be the number of channels.
          
             @param     inputs   The inputs array.
          */
         void process(const float* inputs);
         
-        //! This method performs the widening with double precision.
-        /**	You should use this method for in-place or not-in-place processing and performs the widening sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+        //! This method performs the metering with double precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the metering sample by sample. The inputs array contains the samples of the channels and its minimum size must be the number of channels.
          
             @param     inputs   The inputs array.
          */
         void process(const double* inputs);
+        
+        //! This method performs the metering with single precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the metering on a whole vector of samples. The inputs array contains one vector for each channel, its minimum size must be the number of channels. The vectors are split at the ends of the windows and the peak and the energy of each channel are computed over contiguous samples. Each vector must contain at least the vector size samples.
+         
+            @param     inputs       The inputs array.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, const unsigned int vectorSize);
+        
+        //! This method performs the metering with double precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the metering on a whole vector of samples. The inputs array contains one vector for each channel, its minimum size must be the number of channels. The vectors are split at the ends of the windows and the peak and the energy of each channel are computed over contiguous samples. Each vector must contain at least the vector size samples.
+         
+            @param     inputs       The inputs array.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, const unsigned int vectorSize);
     };
 }
 
@@ -10,25 +10,27 @@ namespace Hoa3D
 {
     Optim::Optim(unsigned int order, Mode mode) : Ambisonic(order)
     {
-        m_harmonics = new double[m_number_of_harmonics];
+        m_harmonics = new Hoa::Exchanger<Hoa::Coefficients>(new Hoa::Coefficients(m_number_of_harmonics));
         setMode(mode);
     }
     
     void Optim::setMode(Mode mode)
     {
+        Hoa::Coefficients* weights = new Hoa::Coefficients(m_number_of_harmonics);
+        double* harmonics = weights->getDouble();
         m_mode = mode;
         if(m_mode == Basic)
         {
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                m_harmonics[i] = 1.;
+                harmonics[i] = 1.;
             }
         }
         else if (m_mode == MaxRe)
         {
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                m_harmonics[i] = cos(fabs((double)getHarmonicDegree(i)) * HOA_PI / (2 * m_order + 2));;
+                harmonics[i] = cos(fabs((double)getHarmonicDegree(i)) * HOA_PI / (2 * m_order + 2));;
             }
         }
         else
@@ -36,26 +38,40 @@ namespace Hoa3D
             long double gain = ((m_order + 1) * (m_order + 1)) / (2 * m_order + 1);
             for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             {
-                m_harmonics[i] = (long double)((long double)factorial(m_order) * (long double)factorial(m_order + 1.)) / (long double)((long double)factorial(m_order + getHarmonicDegree(i) + 1.) * (long double)factorial(m_order - fabs((double)getHarmonicDegree(i)))) * gain;
+                harmonics[i] = (long double)((long double)factorial(m_order) * (long double)factorial(m_order + 1.)) / (long double)((long double)factorial(m_order + getHarmonicDegree(i) + 1.) * (long double)factorial(m_order - fabs((double)getHarmonicDegree(i)))) * gain;
             }
         }
+        weights->update();
+        m_harmonics->publish(weights);
     }
     
     void Optim::process(const float* inputs, float* outputs)
     {
+        const double* harmonics = m_harmonics->acquire()->getDouble();
+        if(m_kernels_float)
+        {
+            m_kernels_float->weight(harmonics, inputs, outputs);
+            return;
+        }
         for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            outputs[i] = inputs[i] * m_harmonics[i];
+            outputs[i] = inputs[i] * harmonics[i];
     }
     
     void Optim::process(const double* inputs, double* outputs)
     {
+        const double* harmonics = m_harmonics->acquire()->getDouble();
+        if(m_kernels_double)
+        {
+            m_kernels_double->weight(harmonics, inputs, outputs);
+            return;
+        }
         for(unsigned int i = 0; i < m_number_of_harmonics; i++)
-            outputs[i] = inputs[i] * m_harmonics[i];
+            outputs[i] = inputs[i] * harmonics[i];
     }
     
     Optim::~Optim()
     {
-        delete [] m_harmonics;
+        delete m_harmonics;
     }
 }
 
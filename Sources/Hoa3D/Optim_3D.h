@@ -8,11 +8,12 @@
 #define __DEF_HOA_3D_OPTIM__
 
 #include "Ambisonic_3D.h"
+#include "../HoaCommon/Exchanger.h"
 
 namespace Hoa3D
 {
     //! The ambisonic optimization.
-    /** The optimization should be used to optimize the ambisonic sound field. There are 3 optimization modes, Basic (no optimizations), MaxRe (energy vector optimization) and InPhase (energy and velocity vector optimization). Basic has no effect, it should be used with a perfect ambisonic loudspeakers (arrengement where all the loudspeakers are to equal distance on a sphere) and for a listener placed at the perfect center of the sphere. MaxRe should be used for auditory confined to the center of the sphere. InPhase should be used when the auditory covers the entire loudspeaker area and when the loudspeakers arragement is not a perfect sphere or when the loudspeakers are not to equal distance. Note that the optimizations decrease the precision sound field restitution thus it can be compared to particular cases of the fractional orders.
+    /** The optimization should be used to optimize the ambisonic sound field. There are 3 optimization modes, Basic (no optimizations), MaxRe (energy vector optimization) and InPhase (energy and velocity vector optimization). Basic has no effect, it should be used with a perfect ambisonic loudspeakers (arrengement where all the loudspeakers are to equal distance on a sphere) and for a listener placed at the perfect center of the sphere. MaxRe should be used for auditory confined to the center of the sphere. InPhase should be used when the auditory covers the entire loudspeaker area and when the loudspeakers arragement is not a perfect sphere or when the loudspeakers are not to equal distance. The weights are computed by the control thread and published to the audio thread with an atomic swap, so the mode can be changed while processing. Note that the optimizations decrease the precision sound field restitution thus it can be compared to particular cases of the fractional orders.
      */
     class Optim : public Ambisonic
     {
@@ -23,12 +24,12 @@ namespace Hoa3D
             MaxRe   = 1,	/**< max-re Optimization    */
             InPhase = 2     /**< in-phase Optimization  */
         };
-        
+    
     private:
         
         Mode            m_mode;
-        double*         m_harmonics;
-        
+        Hoa::Exchanger<Hoa::Coefficients>* m_harmonics;
+    
     public:
         
         //! The optimization constructor.
@@ -10,95 +10,269 @@ namespace Hoa3D
 {
     Rotate::Rotate(unsigned int order) : Ambisonic(order)
     {
-        m_encoder           = new Encoder(order);
-        m_harmonics_matrix  = new double[m_number_of_harmonics * m_number_of_harmonics];
-		m_roll = m_pitch = m_yaw = 0.0f;
-        setRotations(0, 0, 0.);
+        m_matrix_size           = (m_order + 1) * (2 * m_order + 1) * (2 * m_order + 3) / 3;
+        m_scales                = new double[m_number_of_harmonics];
+        m_buffer                = new double[getBufferSize()];
+        m_matrix                = new Hoa::Exchanger<Hoa::Coefficients>(new Hoa::Coefficients(m_matrix_size));
+        m_inputs_chunk_float    = new float[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_inputs_chunk_double   = new double[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_float   = new float[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_double  = new double[m_number_of_harmonics * NUMBEROFCHUNKPOINTS];
+        
+        // The harmonics of the encoder are the orthonormal real harmonics without the Condon-Shortley phase
+        // weighted by (-1)^m and divided by the normalization of the encoder.
+        Encoder* encoder = new Encoder(m_order);
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            m_scales[i] = ((abs(getHarmonicOrder(i)) % 2) ? -1. : 1.) / encoder->getNormalization(i);
+        delete encoder;
+		
+		m_roll = m_pitch = m_yaw = 0.;
+        computeMatrix();
     }
 	
 	void Rotate::setRotations(const double roll, const double pitch, const double yaw)
     {
-		setRoll(roll);
-		setPitch(pitch);
-		setYaw(yaw);
+        const double new_roll   = wrap_twopi(roll);
+        const double new_pitch  = wrap_twopi(pitch);
+        const double new_yaw    = wrap_twopi(yaw);
+        if(new_roll != m_roll || new_pitch != m_pitch || new_yaw != m_yaw)
+        {
+            m_roll  = new_roll;
+            m_pitch = new_pitch;
+            m_yaw   = new_yaw;
+            computeMatrix();
+        }
     }
 	
 	void Rotate::setRoll(const double value)
     {
-		m_roll  = wrap_twopi(value);
-        m_cos_roll = cos(m_roll);
-        m_sin_roll = sin(m_roll);
-        m_encoder->setAzimuth(m_roll);
+		setRotations(value, m_pitch, m_yaw);
     }
-
+	
 	void Rotate::setPitch(const double value)
     {
-		m_pitch = wrap_twopi(value);
-        m_encoder->setElevation(m_pitch);
+		setRotations(m_roll, value, m_yaw);
     }
 	
 	void Rotate::setYaw(const double value)
     {
-		m_yaw = wrap_twopi(value);
-		m_cos_yaw = cos(m_yaw);
-        m_sin_yaw = sin(m_yaw);
+		setRotations(m_roll, m_pitch, value);
     }
     
-	// not implemented
-    void Rotate::process(const float* inputs, float* outputs)
+    //! The coefficient P of the recursion of Ivanic and Ruedenberg.
+    static inline double rotation_coefficient(const double* first, const double* previous, const int i, const int l, const int a, const int b)
     {
-		float cos_x, sin_x, tcos_x, sig;
-		
-        // Copy Harmonics Args(0)
-        for(unsigned int i = 0, j = 0; i < m_number_of_harmonics; i += i * 2 + 1, j++)
+        const int size = 2 * l - 1;
+        const double ri1    = first[(i + 1) * 3 + 2];
+        const double rim1   = first[(i + 1) * 3];
+        const double ri0    = first[(i + 1) * 3 + 1];
+        if(b == l)
+            return ri1 * previous[(a + l - 1) * size + 2 * l - 2] - rim1 * previous[(a + l - 1) * size];
+        else if(b == -l)
+            return ri1 * previous[(a + l - 1) * size] + rim1 * previous[(a + l - 1) * size + 2 * l - 2];
+        else
+            return ri0 * previous[(a + l - 1) * size + b + l - 1];
+    }
+    
+    void Rotate::computeMatrix()
+    {
+        const double cos_roll   = cos(m_roll);
+        const double sin_roll   = sin(m_roll);
+        const double cos_pitch  = cos(m_pitch);
+        const double sin_pitch  = sin(m_pitch);
+        const double cos_yaw    = cos(m_yaw);
+        const double sin_yaw    = sin(m_yaw);
+        
+        // The rotation Rz(yaw) * Ry(pitch) * Rx(roll) with x the abscissa, y the ordinate and z the height
+        const double rotation[9] =
         {
-            outputs[i] = inputs[i];
+            cos_yaw * cos_pitch,    cos_yaw * sin_pitch * sin_roll - sin_yaw * cos_roll,    cos_yaw * sin_pitch * cos_roll + sin_yaw * sin_roll,
+            sin_yaw * cos_pitch,    sin_yaw * sin_pitch * sin_roll + cos_yaw * cos_roll,    sin_yaw * sin_pitch * cos_roll - cos_yaw * sin_roll,
+            -sin_pitch,             cos_pitch * sin_roll,                                   cos_pitch * cos_roll
+        };
+        
+        Hoa::Coefficients* matrix = new Hoa::Coefficients(m_matrix_size);
+        computeMatrix(rotation, matrix->getDouble(), m_buffer);
+        matrix->update();
+        m_matrix->publish(matrix);
+    }
+    
+    void Rotate::computeMatrix(const double* rotation, double* matrix, double* buffer) const
+    {
+        double* previous    = buffer;
+        double* current     = buffer + (2 * m_order + 1) * (2 * m_order + 1);
+        
+        // The harmonics of the first degree without the Condon-Shortley phase are proportional to (-x, -z, y) for the orders -1, 0 and 1
+        const int axes[3]       = {0, 2, 1};
+        const double signs[3]   = {-1., -1., 1.};
+        double first[9];
+        for(int i = 0; i < 3; i++)
+        {
+            for(int j = 0; j < 3; j++)
+                first[i * 3 + j] = signs[i] * signs[j] * rotation[axes[i] * 3 + axes[j]];
         }
         
-        tcos_x = cos_x = m_cos_yaw;
-        sin_x = m_sin_yaw;
-        // Perform Yaw Rotation
-        for(unsigned int i = 1; i <= m_order; i++)
-		{
-            for(unsigned int j = (i + 1) * (i + 1) - 1, k = i; j < m_number_of_harmonics; k++, j += k * 2 + 1)
+        double* block = matrix;
+        block[0] = 1.;
+        for(int i = 0; i < 9; i++)
+            previous[i] = first[i];
+        
+        unsigned int offset = 1;
+        for(int l = 1; l <= (int)m_order; l++)
+        {
+            const int size = 2 * l + 1;
+            if(l > 1)
+            {
+                for(int m = -l; m <= l; m++)
+                {
+                    for(int n = -l; n <= l; n++)
+                    {
+                        const double d      = (m == 0) ? 1. : 0.;
+                        const double denom  = (abs(n) == l) ? (double)(2 * l * (2 * l - 1)) : (double)((l + n) * (l - n));
+                        const double u      = sqrt((double)((l + m) * (l - m)) / denom);
+                        const double v      = 0.5 * sqrt((1. + d) * (double)((l + abs(m) - 1) * (l + abs(m))) / denom) * (1. - 2. * d);
+                        const double w      = -0.5 * sqrt((double)((l - abs(m) - 1) * (l - abs(m))) / denom) * (1. - d);
+                        
+                        double value = 0.;
+                        if(u != 0.)
+                            value += u * rotation_coefficient(first, previous, 0, l, m, n);
+                        if(v != 0.)
+                        {
+                            if(m == 0)
+                                value += v * (rotation_coefficient(first, previous, 1, l, 1, n) + rotation_coefficient(first, previous, -1, l, -1, n));
+                            else if(m > 0)
+                                value += v * (rotation_coefficient(first, previous, 1, l, m - 1, n) * (m == 1 ? sqrt(2.) : 1.) - (m == 1 ? 0. : rotation_coefficient(first, previous, -1, l, -m + 1, n)));
+                            else
+                                value += v * ((m == -1 ? 0. : rotation_coefficient(first, previous, 1, l, m + 1, n)) + rotation_coefficient(first, previous, -1, l, -m - 1, n) * (m == -1 ? sqrt(2.) : 1.));
+                        }
+                        if(w != 0.)
+                        {
+                            if(m > 0)
+                                value += w * (rotation_coefficient(first, previous, 1, l, m + 1, n) + rotation_coefficient(first, previous, -1, l, -m - 1, n));
+                            else
+                                value += w * (rotation_coefficient(first, previous, 1, l, m - 1, n) - rotation_coefficient(first, previous, -1, l, -m + 1, n));
+                        }
+                        current[(m + l) * size + n + l] = value;
+                    }
+                }
+                for(int i = 0; i < size * size; i++)
+                    previous[i] = current[i];
+            }
+            
+            // The block is converted to the normalization of the encoder
+            const unsigned int index = l * l;
+            for(int m = 0; m < size; m++)
+            {
+                for(int n = 0; n < size; n++)
+                    block[offset + m * size + n] = previous[m * size + n] * m_scales[index + m] / m_scales[index + n];
+            }
+            offset += size * size;
+        }
+    }
+    
+    void Rotate::process(const float* inputs, float* outputs)
+    {
+        const float* block = m_matrix->acquire()->getFloat();
+        if(m_kernels_float)
+        {
+            m_kernels_float->rotate(block, inputs, outputs);
+            return;
+        }
+        outputs[0] = inputs[0] * block[0];
+        block++;
+        for(unsigned int l = 1, index = 1; l <= m_order; l++)
+        {
+            const unsigned int size = 2 * l + 1;
+            for(unsigned int m = 0; m < size; m++)
             {
-                sig = inputs[j-1];
-                outputs[j-1] = sin_x * inputs[j] + cos_x * sig;
-                outputs[j] = cos_x * inputs[j] - sin_x * sig;
+                float value = 0.f;
+                for(unsigned int n = 0; n < size; n++)
+                    value += block[m * size + n] * inputs[index + n];
+                outputs[index + m] = value;
             }
-            cos_x = tcos_x * m_cos_yaw - sin_x * m_sin_yaw; // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
-            sin_x = tcos_x * m_sin_yaw + sin_x * m_cos_yaw; // sin(x + b) = cos(x) * sin(b) + sin(x) * cos(b)
-            tcos_x = cos_x;
+            block += size * size;
+            index += size;
         }
     }
     
     void Rotate::process(const double* inputs, double* outputs)
     {
-        int numberOfHarmonics;
-        
-        outputs[0] = inputs[0];
-        for(unsigned int i = 1, j = 1; i < m_order; i++)
+        const double* block = m_matrix->acquire()->getDouble();
+        if(m_kernels_double)
         {
-            numberOfHarmonics = i * 2 + 1;
-            
-            for(unsigned int k = j; k < j + numberOfHarmonics; k++)
+            m_kernels_double->rotate(block, inputs, outputs);
+            return;
+        }
+        outputs[0] = inputs[0] * block[0];
+        block++;
+        for(unsigned int l = 1, index = 1; l <= m_order; l++)
+        {
+            const unsigned int size = 2 * l + 1;
+            for(unsigned int m = 0; m < size; m++)
             {
-                m_encoder->process(1., m_harmonics_matrix);
-                outputs[k] = m_harmonics_matrix[k] * inputs[j];
-                for(unsigned int l = j + 1; l < j + numberOfHarmonics; l++)
-                {
-                    outputs[k] += m_harmonics_matrix[k] * inputs[l];
-                }
+                double value = 0.;
+                for(unsigned int n = 0; n < size; n++)
+                    value += block[m * size + n] * inputs[index + n];
+                outputs[index + m] = value;
             }
-            j += numberOfHarmonics;
+            block += size * size;
+            index += size;
+        }
+    }
+    
+    void Rotate::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        const float* matrix = m_matrix->acquire()->getFloat();
+        if(outputs[0] != inputs[0])
+            cblas_scopy(vectorSize, inputs[0], 1, outputs[0], 1);
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int i = 1; i < m_number_of_harmonics; i++)
+                memcpy(m_inputs_chunk_float + i * NUMBEROFCHUNKPOINTS, inputs[i] + offset, size * sizeof(float));
+            const float* block = matrix + 1;
+            for(unsigned int l = 1; l <= m_order; l++)
+            {
+                const unsigned int degree_size = 2 * l + 1;
+                matrix_chunk_product(block, degree_size, degree_size, m_inputs_chunk_float + l * l * NUMBEROFCHUNKPOINTS, m_outputs_chunk_float + l * l * NUMBEROFCHUNKPOINTS, size);
+                block += degree_size * degree_size;
+            }
+            for(unsigned int i = 1; i < m_number_of_harmonics; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_float + i * NUMBEROFCHUNKPOINTS, size * sizeof(float));
+        }
+    }
+    
+    void Rotate::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        const double* matrix = m_matrix->acquire()->getDouble();
+        if(outputs[0] != inputs[0])
+            cblas_dcopy(vectorSize, inputs[0], 1, outputs[0], 1);
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int i = 1; i < m_number_of_harmonics; i++)
+                memcpy(m_inputs_chunk_double + i * NUMBEROFCHUNKPOINTS, inputs[i] + offset, size * sizeof(double));
+            const double* block = matrix + 1;
+            for(unsigned int l = 1; l <= m_order; l++)
+            {
+                const unsigned int degree_size = 2 * l + 1;
+                matrix_chunk_product(block, degree_size, degree_size, m_inputs_chunk_double + l * l * NUMBEROFCHUNKPOINTS, m_outputs_chunk_double + l * l * NUMBEROFCHUNKPOINTS, size);
+                block += degree_size * degree_size;
+            }
+            for(unsigned int i = 1; i < m_number_of_harmonics; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_double + i * NUMBEROFCHUNKPOINTS, size * sizeof(double));
         }
     }
     
     Rotate::~Rotate()
     {
-		delete m_encoder;
-        delete [] m_harmonics_matrix;
+        delete m_matrix;
+        delete [] m_scales;
+        delete [] m_buffer;
+        delete [] m_inputs_chunk_float;
+        delete [] m_inputs_chunk_double;
+        delete [] m_outputs_chunk_float;
+        delete [] m_outputs_chunk_double;
     }
-	
-}
 
+}
@@ -9,26 +9,32 @@
 
 #include "Ambisonic_3D.h"
 #include "Encoder_3D.h"
+#include "../HoaCommon/Exchanger.h"
 
 namespace Hoa3D
 {
     //! The ambisonic rotate.
-    /** The rotation.
+    /** The rotation should be used to rotate the sound field around the three axes. The roll is a rotation around the x-axis (from the left to the right), the pitch around the y-axis (from the back to the front) and the yaw around the z-axis (from the bottom to the top), the rotations are applied in this order. The rotation of the harmonics is block-diagonal : the harmonics of a degree are only combined together, so the matrix is stored as one square block of 2 * degree + 1 coefficients for each degree. The blocks are computed with the recursion of Ivanic and Ruedenberg from the rotation matrix of the first degree when the angles change and published to the audio thread with an atomic swap. The setters of the angles allocate the new matrix, so they must only be called by the control thread, and setting the current angles again doesn't compute the matrix.
      */
     class Rotate : public Ambisonic
     {
     private:
 		
-		double		m_roll;
-        double      m_cos_roll;
-        double      m_sin_roll;
-        double      m_pitch;
-        double      m_yaw;
-        double      m_cos_yaw;
-        double      m_sin_yaw;
-        Encoder*    m_encoder;
-        double*     m_harmonics_matrix;
+		double          m_roll;
+        double          m_pitch;
+        double          m_yaw;
+        double*         m_scales;
+        double*         m_buffer;
+        unsigned int    m_matrix_size;
+        Hoa::Exchanger<Hoa::Coefficients>* m_matrix;
+        float*          m_inputs_chunk_float;
+        double*         m_inputs_chunk_double;
+        float*          m_outputs_chunk_float;
+        double*         m_outputs_chunk_double;
         
+        //! Compute the rotation matrix of the harmonics for the current angles and publish it to the audio thread.
+        void computeMatrix();
+    
     public:
         
         //! The Rotate constructor.
@@ -44,8 +50,8 @@ namespace Hoa3D
         ~Rotate();
 		
 		//! This method sets the three rotation values at the same time (xyz axis).
-        /** This method sets the three rotation values at the same time (xyz axis).
-		 
+        /** This method sets the three rotation values at the same time (xyz axis). The matrix is computed and published only if one of the angles changed. This method allocates memory, so you should not call it in the audio thread.
+         
             @param     roll	The roll value is equivalent to a rotation on the x-axis (also named tilt), between 0 and 2π.
             @param     pitch	The pitch value is equivalent to a rotation on the y-axis (also named tumble), between 0 and 2π.
             @param     yaw		The yaw value is equivalent to a rotation on the z-axis (also named rotation), between 0 and 2π.
@@ -54,8 +60,8 @@ namespace Hoa3D
         void setRotations(const double roll, const double pitch, const double yaw);
         
         //! This method sets the roll value (rotation on the x-axis).
-        /** The roll is equivalent to a rotation on the x-axis (also named tilt).
-		 
+        /** The roll is equivalent to a rotation on the x-axis (also named tilt). This method allocates memory if the roll changes, so you should not call it in the audio thread.
+         
             @param  value       The roll value between 0 and 2π.
             @see    setPitch
             @see    setYaw
@@ -63,8 +69,8 @@ namespace Hoa3D
         void setRoll(const double value);
 		
 		//! This method sets the pitch value (rotation on the y-axis).
-        /** The pitch is equivalent to a rotation on the y-axis (also named tumble).
-		 
+        /** The pitch is equivalent to a rotation on the y-axis (also named tumble). This method allocates memory if the pitch changes, so you should not call it in the audio thread.
+         
             @param  value       The pitch value between 0 and 2π.
             @see    setRoll
             @see    setYaw
@@ -72,8 +78,8 @@ namespace Hoa3D
         void setPitch(const double value);
 		
 		//! This method sets the yaw value (rotation on the z-axis).
-        /** The yaw is equivalent to a rotation on the z-axis (also named rotation).
-		 
+        /** The yaw is equivalent to a rotation on the z-axis (also named rotation). This method allocates memory if the yaw changes, so you should not call it in the audio thread.
+         
             @param  value       The yaw value between 0 and 2π.
             @see    setRoll
             @see    setPitch
@@ -82,25 +88,49 @@ namespace Hoa3D
 		
 		//! Get the roll value (rotation on the x-axis).
         /** The roll is equivalent to a rotation on the x-axis (also named tilt).
-		 
+         
 		 @return     value The roll value between 0 and 2π.
          */
         inline double getRoll() const {return m_roll;};
 		
 		//! Get the pitch value (rotation on the y-axis).
         /** The pitch is equivalent to a rotation on the y-axis (also named tumble).
-		 
+         
 		 @return     value The pitch value between 0 and 2π.
          */
         inline double getPitch() const {return m_pitch;};
 		
 		//! Get the yaw value (rotation on the z-axis).
         /** The yaw is equivalent to a rotation on the z-axis (also named rotation).
-		 
+         
 		 @return     value The yaw value between 0 and 2π.
          */
         inline double getYaw() const {return m_yaw;};
         
+        //! Retrieve the size of the rotation matrix of the harmonics.
+        /** The rotation matrix of the harmonics contains one square block of 2 * degree + 1 coefficients for each degree, from the degree 0 to the order of decomposition.
+         
+		 @return     The number of coefficients of the matrix.
+         */
+        inline unsigned int getMatrixSize() const {return m_matrix_size;};
+        
+        //! Retrieve the size of the buffer of the computation of the rotation matrix.
+        /** The buffer contains the blocks of two successive degrees.
+         
+		 @return     The number of values of the buffer.
+         */
+        inline unsigned int getBufferSize() const {return 2 * (2 * m_order + 1) * (2 * m_order + 1);};
+        
+        //! Compute the rotation matrix of the harmonics for a rotation of the space.
+        /** Compute the block-diagonal rotation matrix of the harmonics for a rotation matrix of the space with x the abscissa, y the ordinate and z the height. This method doesn't allocate memory and doesn't change the rotation of the object, so it can be called by the audio thread with its own buffer.
+         
+            @param     rotation The row-major rotation matrix of the space, 3 by 3 coefficients.
+            @param     matrix   The rotation matrix of the harmonics, its minimum size must be the matrix size.
+            @param     buffer   A buffer for the recursion, its minimum size must be the buffer size.
+            @see getMatrixSize, getBufferSize
+         */
+        void computeMatrix(const double* rotation, double* matrix, double* buffer) const;
+        
         //! This method performs the rotation with single precision.
         /**	You should use this method for not-in-place processing and performs the rotation sample by sample.
 			(warning : doesn't work with in-place vectors);
@@ -120,8 +150,26 @@ namespace Hoa3D
             @param     outputs  The outputs array.
          */
         void process(const double* inputs, double* outputs);
+        
+        //! This method performs the rotation with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the rotation on a whole vector of samples. The inputs array and outputs array contains one vector for each spherical harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the rotation with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the rotation on a whole vector of samples. The inputs array and outputs array contains one vector for each spherical harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
-	
+
 } // end of namespace Hoa3D
 
 #endif
@@ -12,22 +12,179 @@ namespace Hoa3D
     {
         m_number_of_rows = numberOfRows;
         m_number_of_columns = numberOfColumns;
-		m_decoder   = new DecoderRegular(order, m_number_of_rows * m_number_of_columns);
+        m_ramp          = 0;
+        m_vector_size   = 256;
         m_matrix    = new double[m_number_of_rows * m_number_of_columns];
+        m_points    = new double[m_number_of_rows * m_number_of_columns];
         m_harmonics = new double[m_number_of_harmonics];
- 
+        m_elevations    = new double[m_number_of_rows * m_number_of_harmonics];
+        m_azimuths      = new double[(2 * m_order + 1) * m_number_of_columns];
+        m_fourier       = new double[2 * m_order + 1];
+        m_covariance    = new double[m_number_of_harmonics * m_number_of_harmonics];
+        m_factor        = new double[m_number_of_harmonics * m_number_of_harmonics];
+        m_snapshots     = new Hoa::TripleBuffer<double>(m_number_of_harmonics * m_number_of_harmonics);
+        for(unsigned int i = 0; i < m_number_of_harmonics * m_number_of_harmonics; i++)
+        {
+            m_covariance[i] = 0.;
+        }
+        for(unsigned int i = 0; i < m_number_of_rows * m_number_of_columns; i++)
+        {
+            m_matrix[i] = 0.;
+        }
+        
+        // The coefficients of a row are the ones of a regular decoder at the azimuth 0, where the harmonics of negative
+        // arguments are null, so the harmonics of an argument and of its opposite share the coefficient
+        Encoder encoder(m_order, Encoder::Recurrence);
+        encoder.setAzimuth(0.);
         for(unsigned int i = 0; i < m_number_of_rows; i++)
+        {
+            encoder.setElevation(getElevation(i));
+            encoder.process(12.5 / (double)((m_order + 1.) * (m_order + 1.)), m_harmonics);
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+            {
+                const unsigned int index = getHarmonicDegree(j) * (getHarmonicDegree(j) + 1) + abs(getHarmonicOrder(j));
+                m_elevations[i * m_number_of_harmonics + j] = m_harmonics[index] * encoder.getNormalization(index) * encoder.getNormalization(index);
+            }
+        }
+        for(int m = -(int)m_order; m <= (int)m_order; m++)
         {
             for(unsigned int j = 0; j < m_number_of_columns; j++)
+                m_azimuths[(m + m_order) * m_number_of_columns + j] = spherical_harmonics_azimuth(m_order, m, getAzimuth(j));
+        }
+    }
+    
+    void Scope::project(const double* harmonics, double* values)
+    {
+        // Each row sums the harmonics of each argument weighted by the elevation coefficients, then the Fourier series of
+        // the arguments is evaluated over the columns
+        for(unsigned int i = 0; i < m_number_of_rows; i++)
+        {
+            const double* elevations = m_elevations + i * m_number_of_harmonics;
+            for(unsigned int j = 0; j < 2 * m_order + 1; j++)
+                m_fourier[j] = 0.;
+            for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                m_fourier[getHarmonicOrder(j) + m_order] += elevations[j] * harmonics[j];
+            cblas_dgemv(CblasRowMajor, CblasTrans, 2 * m_order + 1, m_number_of_columns, 1., m_azimuths, m_number_of_columns, m_fourier, 1, 0., values + i * m_number_of_columns, 1);
+        }
+    }
+    
+    void Scope::setVectorSize(unsigned int vectorSize)
+    {
+        m_vector_size   = vectorSize > 0 ? vectorSize : 1;
+        m_ramp          = 0;
+        for(unsigned int i = 0; i < m_number_of_harmonics * m_number_of_harmonics; i++)
+        {
+            m_covariance[i] = 0.;
+        }
+    }
+    
+    void Scope::publish()
+    {
+        // Only the upper triangle is accumulated, the snapshot is the full mean covariance
+        double* snapshot = m_snapshots->getWrite();
+        const double scale = 1. / (double)m_vector_size;
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            for(unsigned int j = i; j < m_number_of_harmonics; j++)
             {
-				m_decoder->setChannelPosition(i * m_number_of_columns + j,
-											  (double)j * HOA_2PI / (double)m_number_of_columns,
-											  (double)i * HOA_PI / (double)(m_number_of_rows - 1) - HOA_PI2);
-				m_matrix[i * m_number_of_columns + j] = 0.;
+                snapshot[i * m_number_of_harmonics + j] = snapshot[j * m_number_of_harmonics + i] = m_covariance[i * m_number_of_harmonics + j] * scale;
+                m_covariance[i * m_number_of_harmonics + j] = 0.;
             }
         }
+        m_snapshots->publish();
+        m_ramp = 0;
     }
-	
+    
+    void Scope::accumulate(const float* inputs)
+    {
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            double* row = m_covariance + i * m_number_of_harmonics;
+            const double value = inputs[i];
+            for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                row[j] += value * (double)inputs[j];
+        }
+        if(++m_ramp >= m_vector_size)
+            publish();
+    }
+    
+    void Scope::accumulate(const double* inputs)
+    {
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+        {
+            double* row = m_covariance + i * m_number_of_harmonics;
+            const double value = inputs[i];
+            for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                row[j] += value * inputs[j];
+        }
+        if(++m_ramp >= m_vector_size)
+            publish();
+    }
+    
+    void Scope::accumulate(const float* const* inputs, const unsigned int vectorSize)
+    {
+        const Hoa::SimdKernels* kernels = getSimdKernels();
+        for(unsigned int k = 0; k < vectorSize;)
+        {
+            const unsigned int size = std::min(vectorSize - k, m_vector_size - m_ramp);
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            {
+                double* row = m_covariance + i * m_number_of_harmonics;
+                for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                    row[j] += kernels->dot_float(inputs[i] + k, inputs[j] + k, size);
+            }
+            k       += size;
+            m_ramp  += size;
+            if(m_ramp >= m_vector_size)
+                publish();
+        }
+    }
+    
+    void Scope::accumulate(const double* const* inputs, const unsigned int vectorSize)
+    {
+        const Hoa::SimdKernels* kernels = getSimdKernels();
+        for(unsigned int k = 0; k < vectorSize;)
+        {
+            const unsigned int size = std::min(vectorSize - k, m_vector_size - m_ramp);
+            for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            {
+                double* row = m_covariance + i * m_number_of_harmonics;
+                for(unsigned int j = i; j < m_number_of_harmonics; j++)
+                    row[j] += kernels->dot_double(inputs[i] + k, inputs[j] + k, size);
+            }
+            k       += size;
+            m_ramp  += size;
+            if(m_ramp >= m_vector_size)
+                publish();
+        }
+    }
+    
+    void Scope::evaluate()
+    {
+        // The energy of a point is y^T * C * y = sum of (y . r_j)^2 with the rows r_j of the factor of C = R^T * R
+        const double* covariance = m_snapshots->read();
+        const unsigned int rank = matrix_cholesky(covariance, m_number_of_harmonics, m_factor);
+        for(unsigned int i = 0; i < m_number_of_rows * m_number_of_columns; i++)
+        {
+            m_matrix[i] = 0.;
+        }
+        for(unsigned int j = 0; j < rank; j++)
+        {
+            project(m_factor + j * m_number_of_harmonics, m_points);
+            for(unsigned int i = 0; i < m_number_of_rows * m_number_of_columns; i++)
+                m_matrix[i] += m_points[i] * m_points[i];
+        }
+        for(unsigned int i = 0; i < m_number_of_rows * m_number_of_columns; i++)
+        {
+            m_matrix[i] = sqrt(m_matrix[i]);
+        }
+        const double max = fabs(m_matrix[cblas_idamax(m_number_of_rows * m_number_of_columns, m_matrix, 1)]);
+        if(max > 1.)
+        {
+            cblas_dscal(m_number_of_rows * m_number_of_columns, (1. / max), m_matrix, 1.);
+        }
+    }
+    
     void Scope::process(const float* inputs)
     {
         double max = 1.;
@@ -35,7 +192,7 @@ namespace Hoa3D
         {
             m_harmonics[i] = inputs[i];
         }
-		m_decoder->process(m_harmonics, m_matrix);
+		project(m_harmonics, m_matrix);
         max = fabs(m_matrix[cblas_idamax(m_number_of_rows * m_number_of_columns, m_matrix, 1)]);
         if(max > 1.)
         {
@@ -46,7 +203,7 @@ namespace Hoa3D
     void Scope::process(const double* inputs)
     {
         double max = 1.;
-        m_decoder->process(inputs, m_matrix);
+        project(inputs, m_matrix);
         max = fabs(m_matrix[cblas_idamax(m_number_of_rows * m_number_of_columns, m_matrix, 1)]);
         if(max > 1.)
         {
@@ -57,8 +214,14 @@ namespace Hoa3D
     Scope::~Scope()
     {
 		delete [] m_matrix;
+        delete [] m_points;
         delete [] m_harmonics;
-        delete m_decoder;
+        delete [] m_covariance;
+        delete [] m_factor;
+        delete [] m_elevations;
+        delete [] m_azimuths;
+        delete [] m_fourier;
+        delete m_snapshots;
     }
 	
 }
@@ -8,21 +8,33 @@
 #define __DEF_HOA_3D_SCOPE__
 
 #include "Ambisonic_3D.h"
-#include "Decoder_3D.h"
+#include "Encoder_3D.h"
+#include "../HoaCommon/TripleBuffer.h"
 
 namespace Hoa3D
 {
     //! The ambisonic scope.
-    /** The scope discretize a sphere by a set of point and uses a decoder to project the spherical harmonics on it. This class should be used for graphical interfaces outside the digital signal processing if the number of points to discretize the sphere is very large. Then you should prefer to record snapshot of the spherical harmonics and to call the process method at an interval adapted to a graphical rendering.
+    /** The scope discretize a sphere by a set of point and projects the spherical harmonics on it like a regular decoder. The projection is separable : each row sums the harmonics of each argument weighted by the elevation coefficients of the row, then evaluates the Fourier series of the arguments over the columns, so a projection costs rows * (harmonics + columns * (2 * order + 1)) operations instead of rows * columns * harmonics and the memory doesn't grow with the product of the number of points by the number of harmonics. This class should be used for graphical interfaces outside the digital signal processing if the number of points to discretize the sphere is very large. Then you should prefer to record snapshot of the spherical harmonics and to call the process method at an interval adapted to a graphical rendering. The scope can also be fed by the audio thread with the accumulate methods that only compute the covariance of the spherical harmonics over windows of vector size samples, then the graphical interface evaluates the energy of the last complete window at its own rate with the evaluate method, so the cost of the digital signal processing doesn't depend on the number of rows and columns.
      */
     class Scope : public Ambisonic
     {
     private:
         unsigned int m_number_of_rows;
         unsigned int m_number_of_columns;
+        unsigned int m_ramp;
+        unsigned int m_vector_size;
         double*     m_harmonics;
         double*     m_matrix;
-        DecoderRegular*    m_decoder;
+        double*     m_points;
+        double*     m_covariance;
+        double*     m_factor;
+        double*     m_elevations;
+        double*     m_azimuths;
+        double*     m_fourier;
+        Hoa::TripleBuffer<double>* m_snapshots;
+        
+        void project(const double* harmonics, double* values);
+        void publish();
     public:
         
         //! The Scope constructor.
@@ -125,6 +137,64 @@ namespace Hoa3D
             return (double)rowIndex * HOA_PI / (double)(m_number_of_rows - 1) - HOA_PI2;
         }
         
+        //! Set the vector size.
+        /** Set the number of samples of the windows over which the covariance of the spherical harmonics is accumulated, a snapshot is published at the end of each window. The default vector size is 256.
+         
+         @param     vectorSize	The vector size.
+         */
+        void setVectorSize(unsigned int vectorSize);
+        
+        //! Get the vector size.
+        /** Retrieve the number of samples of the windows over which the covariance of the spherical harmonics is accumulated.
+         
+         @return    The vector size.
+         */
+        inline unsigned int getVectorSize() const
+        {
+            return m_vector_size;
+        }
+        
+        //! This method accumulates the covariance of the spherical harmonics with single precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a sample of the spherical harmonics, the projection is computed later by the evaluate method. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+         
+         @param     inputs   The inputs array.
+         @see       evaluate
+         */
+        void accumulate(const float* inputs);
+        
+        //! This method accumulates the covariance of the spherical harmonics with double precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a sample of the spherical harmonics, the projection is computed later by the evaluate method. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+         
+         @param     inputs   The inputs array.
+         @see       evaluate
+         */
+        void accumulate(const double* inputs);
+        
+        //! This method accumulates the covariance of a block of spherical harmonics with single precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a block of the spherical harmonics, the projection is computed later by the evaluate method. The inputs array contains the spherical harmonics vectors, the minimum size must be the number of harmonics and the vectors must have vector size samples.
+         
+         @param     inputs       The inputs array.
+         @param     vectorSize   The number of samples of the vectors.
+         @see       evaluate
+         */
+        void accumulate(const float* const* inputs, const unsigned int vectorSize);
+        
+        //! This method accumulates the covariance of a block of spherical harmonics with double precision.
+        /**	You should use this method in the audio thread to accumulate the covariance of a block of the spherical harmonics, the projection is computed later by the evaluate method. The inputs array contains the spherical harmonics vectors, the minimum size must be the number of harmonics and the vectors must have vector size samples.
+         
+         @param     inputs       The inputs array.
+         @param     vectorSize   The number of samples of the vectors.
+         @see       evaluate
+         */
+        void accumulate(const double* const* inputs, const unsigned int vectorSize);
+        
+        //! This method evaluates the energy of the spherical harmonics over the sphere.
+        /**	You should use this method in the graphical thread to compute the projection of the covariance of the last complete window on the sphere. The radius of a point is the root mean square of the spherical harmonics projected on this point, so the values are positive. The covariance is factorized so the cost is at most the number of harmonics times the projection of the process method and it doesn't depend on the audio rate.
+         
+         @see       accumulate
+         */
+        void evaluate();
+        
         //! This method performs the spherical harmonics projection with single precision.
         /**	You should use this method to compute the projection of the spherical harmonics over an ambisonics sphere. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          
@@ -0,0 +1,695 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "Vbap_3D.h"
+#include <set>
+
+// The minimum distance between the center and the plane of a triangle, a triangle with a smaller distance spans more
+// than 80 degrees from its center and an imaginary channel is added in its direction.
+#define HOA_VBAP_MINIMUM_DISTANCE 0.17
+
+namespace Hoa3D
+{
+    static inline void vbap_cross(const double* a, const double* b, double* result)
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    }
+    
+    static inline double vbap_dot(const double* a, const double* b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+    
+    static inline void vbap_normal(const double* points, const unsigned int* face, double* normal)
+    {
+        const double* a = points + face[0] * 3;
+        const double* b = points + face[1] * 3;
+        const double* c = points + face[2] * 3;
+        const double u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const double v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        vbap_cross(u, v, normal);
+    }
+    
+    static inline double vbap_side(const double* points, const unsigned int* face, const double* normal, const unsigned int index)
+    {
+        const double* a = points + face[0] * 3;
+        const double* p = points + index * 3;
+        const double d[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+        return vbap_dot(normal, d);
+    }
+    
+    // The incremental convex hull of points on the sphere, the faces are oriented outward. The function returns false if
+    // the points are coplanar. The points are never inside the hull except the duplicates that are ignored.
+    static bool vbap_hull(const double* points, const unsigned int size, std::vector<unsigned int>& faces)
+    {
+        faces.clear();
+        if(size < 4)
+            return false;
+        
+        unsigned int first[4] = {0, 0, 0, 0};
+        double best = 0.;
+        for(unsigned int i = 1; i < size; i++)
+        {
+            const double* p = points + i * 3;
+            const double d[3] = {p[0] - points[0], p[1] - points[1], p[2] - points[2]};
+            if(vbap_dot(d, d) > best)
+            {
+                best = vbap_dot(d, d);
+                first[1] = i;
+            }
+        }
+        best = 0.;
+        for(unsigned int i = 1; i < size; i++)
+        {
+            const unsigned int face[3] = {first[0], first[1], i};
+            double normal[3];
+            vbap_normal(points, face, normal);
+            if(vbap_dot(normal, normal) > best)
+            {
+                best = vbap_dot(normal, normal);
+                first[2] = i;
+            }
+        }
+        if(best < 1e-12)
+            return false;
+        double normal[3];
+        vbap_normal(points, first, normal);
+        best = 0.;
+        for(unsigned int i = 1; i < size; i++)
+        {
+            if(fabs(vbap_side(points, first, normal, i)) > best)
+            {
+                best = fabs(vbap_side(points, first, normal, i));
+                first[3] = i;
+            }
+        }
+        if(best < 1e-12)
+            return false;
+        
+        for(unsigned int i = 0; i < 4; i++)
+        {
+            unsigned int face[3] = {first[i], first[(i + 1) % 4], first[(i + 2) % 4]};
+            vbap_normal(points, face, normal);
+            if(vbap_side(points, face, normal, first[(i + 3) % 4]) > 0.)
+                std::swap(face[1], face[2]);
+            faces.insert(faces.end(), face, face + 3);
+        }
+        
+        std::vector<bool> visibles;
+        std::set< std::pair<unsigned int, unsigned int> > edges;
+        for(unsigned int i = 0; i < size; i++)
+        {
+            if(i == first[0] || i == first[1] || i == first[2] || i == first[3])
+                continue;
+            
+            const unsigned int number_of_faces = (unsigned int)faces.size() / 3;
+            visibles.assign(number_of_faces, false);
+            edges.clear();
+            bool visible = false;
+            for(unsigned int j = 0; j < number_of_faces; j++)
+            {
+                vbap_normal(points, &faces[j * 3], normal);
+                if(vbap_side(points, &faces[j * 3], normal, i) > 1e-14)
+                {
+                    visibles[j] = visible = true;
+                    for(unsigned int k = 0; k < 3; k++)
+                        edges.insert(std::make_pair(faces[j * 3 + k], faces[j * 3 + (k + 1) % 3]));
+                }
+            }
+            if(!visible)
+                continue;
+            
+            // The edges of the visible faces that aren't shared with another visible face are the horizon
+            std::vector<unsigned int> hull;
+            for(unsigned int j = 0; j < number_of_faces; j++)
+            {
+                if(!visibles[j])
+                {
+                    hull.insert(hull.end(), &faces[j * 3], &faces[j * 3] + 3);
+                    continue;
+                }
+                for(unsigned int k = 0; k < 3; k++)
+                {
+                    const unsigned int a = faces[j * 3 + k], b = faces[j * 3 + (k + 1) % 3];
+                    if(edges.find(std::make_pair(b, a)) == edges.end())
+                    {
+                        hull.push_back(a);
+                        hull.push_back(b);
+                        hull.push_back(i);
+                    }
+                }
+            }
+            faces.swap(hull);
+        }
+        return true;
+    }
+    
+    // A normal of the plane of coplanar points, or of the great circle of one or two points.
+    static void vbap_plane(const double* points, const unsigned int size, double* normal)
+    {
+        unsigned int second = 0, third = 0;
+        double best = 0.;
+        for(unsigned int i = 1; i < size; i++)
+        {
+            const double* p = points + i * 3;
+            const double d[3] = {p[0] - points[0], p[1] - points[1], p[2] - points[2]};
+            if(vbap_dot(d, d) > best)
+            {
+                best = vbap_dot(d, d);
+                second = i;
+            }
+        }
+        best = 0.;
+        for(unsigned int i = 1; i < size && second; i++)
+        {
+            const unsigned int face[3] = {0, second, i};
+            double candidate[3];
+            vbap_normal(points, face, candidate);
+            if(vbap_dot(candidate, candidate) > best)
+            {
+                best = vbap_dot(candidate, candidate);
+                third = i;
+            }
+        }
+        if(best > 1e-12)
+        {
+            const unsigned int face[3] = {0, second, third};
+            vbap_normal(points, face, normal);
+        }
+        else if(second)
+        {
+            vbap_cross(points, points + second * 3, normal);
+        }
+        else
+        {
+            normal[0] = normal[1] = normal[2] = 0.;
+        }
+        if(vbap_dot(normal, normal) < 1e-12)
+        {
+            const double axis[3] = {fabs(points[0]) < 0.5 ? 1. : 0., fabs(points[0]) < 0.5 ? 0. : 1., 0.};
+            vbap_cross(points, axis, normal);
+        }
+        const double norm = sqrt(vbap_dot(normal, normal));
+        for(unsigned int k = 0; k < 3; k++)
+            normal[k] /= norm;
+    }
+    
+    Vbap::Vbap(unsigned int numberOfChannels, unsigned int numberOfSources) : Planewaves(numberOfChannels)
+    {
+        assert(numberOfSources > 0);
+        const unsigned int capacity = m_number_of_channels + HOA_VBAP_MAXIMUM_IMAGINARY;
+        m_number_of_points      = 0;
+        m_points                = new double[capacity * 3];
+        m_number_of_triangles   = 0;
+        m_triangles             = new unsigned int[capacity * 2 * 3];
+        m_inverses              = new double[capacity * 2 * 9];
+        m_grid_offsets          = new unsigned int[HOA_VBAP_GRID_ROWS * HOA_VBAP_GRID_COLUMNS + 1];
+        m_number_of_sources     = numberOfSources;
+        m_sources_azimuth       = new double[m_number_of_sources];
+        m_sources_elevation     = new double[m_number_of_sources];
+        m_sources_triangle      = new unsigned int[m_number_of_sources];
+        m_sources_channels      = new unsigned int[m_number_of_sources * 3];
+        m_sources_gains         = new double[m_number_of_sources * 3];
+        m_chunk_float           = new float[NUMBEROFCHUNKPOINTS * 4];
+        m_chunk_double          = new double[NUMBEROFCHUNKPOINTS * 4];
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            m_sources_azimuth[i]    = 0.;
+            m_sources_elevation[i]  = 0.;
+            m_sources_triangle[i]   = 0;
+        }
+        computeTriangulation();
+    }
+    
+    void Vbap::setChannelPosition(unsigned int index, double azimuth, double elevation)
+    {
+        Planewaves::setChannelPosition(index, azimuth, elevation);
+        computeTriangulation();
+    }
+    
+    void Vbap::setChannelsPosition(double* azimuths, double* elevations)
+    {
+        Planewaves::setChannelsPosition(azimuths, elevations);
+        computeTriangulation();
+    }
+    
+    void Vbap::setChannelsRotation(double axis_x, double axis_y, double axis_z)
+    {
+        Planewaves::setChannelsRotation(axis_x, axis_y, axis_z);
+        computeTriangulation();
+    }
+    
+    void Vbap::computeTriangulation()
+    {
+        m_number_of_points = m_number_of_channels;
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+        {
+            m_points[i * 3]     = abscissa(1., m_channels_rotated_azimuth[i], m_channels_rotated_elevation[i]);
+            m_points[i * 3 + 1] = ordinate(1., m_channels_rotated_azimuth[i], m_channels_rotated_elevation[i]);
+            m_points[i * 3 + 2] = height(1., m_channels_rotated_azimuth[i], m_channels_rotated_elevation[i]);
+        }
+        
+        // The points are slightly moved on the sphere so four channels are never on the same circle and the hull
+        // always contains all the channels, the triangles are then computed with the exact positions.
+        std::vector<double> points;
+        std::vector<unsigned int> faces;
+        bool valid = false;
+        for(;;)
+        {
+            points.assign(m_points, m_points + m_number_of_points * 3);
+            for(unsigned int i = 0; i < m_number_of_points; i++)
+            {
+                double* p = &points[i * 3];
+                for(unsigned int k = 0; k < 3; k++)
+                {
+                    double jitter = sin((i + 1.) * (k + 1.) * 12.9898 + k * 78.233) * 43758.5453;
+                    p[k] += (jitter - floor(jitter) - 0.5) * 1e-7;
+                }
+                const double norm = sqrt(vbap_dot(p, p));
+                for(unsigned int k = 0; k < 3; k++)
+                    p[k] /= norm;
+            }
+            
+            const unsigned int number_of_imaginaries = m_number_of_points - m_number_of_channels;
+            valid = vbap_hull(&points[0], m_number_of_points, faces);
+            if(!valid)
+            {
+                // The channels are coplanar, the imaginary channels are added at the poles of their plane
+                if(number_of_imaginaries + 2 > HOA_VBAP_MAXIMUM_IMAGINARY)
+                    break;
+                double normal[3];
+                vbap_plane(m_points, m_number_of_points, normal);
+                for(int side = 1; side >= -1; side -= 2)
+                {
+                    bool duplicate = false;
+                    for(unsigned int i = 0; i < m_number_of_points; i++)
+                    {
+                        const double* p = m_points + i * 3;
+                        const double d[3] = {p[0] - side * normal[0], p[1] - side * normal[1], p[2] - side * normal[2]};
+                        duplicate = duplicate || vbap_dot(d, d) < 1e-12;
+                    }
+                    if(!duplicate)
+                    {
+                        for(unsigned int k = 0; k < 3; k++)
+                            m_points[m_number_of_points * 3 + k] = side * normal[k];
+                        m_number_of_points++;
+                    }
+                }
+                continue;
+            }
+            
+            // The widest triangle gets an imaginary channel if it leaves a gap in the sphere
+            double closest = HOA_VBAP_MINIMUM_DISTANCE;
+            double direction[3];
+            for(unsigned int j = 0; j < faces.size() / 3; j++)
+            {
+                double normal[3];
+                vbap_normal(&points[0], &faces[j * 3], normal);
+                const double norm = sqrt(vbap_dot(normal, normal));
+                if(norm < 1e-14)
+                    continue;
+                for(unsigned int k = 0; k < 3; k++)
+                    normal[k] /= norm;
+                const double distance = vbap_dot(normal, &points[faces[j * 3] * 3]);
+                if(distance < closest)
+                {
+                    closest = distance;
+                    direction[0] = normal[0];
+                    direction[1] = normal[1];
+                    direction[2] = normal[2];
+                }
+            }
+            if(closest >= HOA_VBAP_MINIMUM_DISTANCE || number_of_imaginaries == HOA_VBAP_MAXIMUM_IMAGINARY)
+                break;
+            for(unsigned int k = 0; k < 3; k++)
+                m_points[m_number_of_points * 3 + k] = direction[k];
+            m_number_of_points++;
+        }
+        
+        m_number_of_triangles = 0;
+        for(unsigned int j = 0; valid && j < faces.size() / 3; j++)
+        {
+            const double* a = m_points + faces[j * 3] * 3;
+            const double* b = m_points + faces[j * 3 + 1] * 3;
+            const double* c = m_points + faces[j * 3 + 2] * 3;
+            double* inverse = m_inverses + m_number_of_triangles * 9;
+            vbap_cross(b, c, inverse);
+            vbap_cross(c, a, inverse + 3);
+            vbap_cross(a, b, inverse + 6);
+            const double determinant = vbap_dot(a, inverse);
+            if(fabs(determinant) < 1e-9)
+                continue;
+            for(unsigned int k = 0; k < 9; k++)
+                inverse[k] /= determinant;
+            for(unsigned int k = 0; k < 3; k++)
+                m_triangles[m_number_of_triangles * 3 + k] = faces[j * 3 + k];
+            m_number_of_triangles++;
+        }
+        if(!m_number_of_triangles)
+        {
+            for(unsigned int k = 0; k < 3; k++)
+                m_triangles[k] = 0;
+            for(unsigned int k = 0; k < 9; k++)
+                m_inverses[k] = 0.;
+        }
+        
+        computeGrid();
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+            computeSource(i);
+    }
+    
+    void Vbap::computeGrid()
+    {
+        // A triangle is inside the cap of its circumscribed circle, the cap of a cell is centered on the middle of the
+        // cell and reaches its farthest corner. A cell stores the triangles whose cap overlaps its cap.
+        const unsigned int rows = HOA_VBAP_GRID_ROWS, columns = HOA_VBAP_GRID_COLUMNS;
+        std::vector<double> caps(m_number_of_triangles * 4), thresholds(m_number_of_triangles);
+        for(unsigned int i = 0; i < m_number_of_triangles; i++)
+        {
+            double* cap = &caps[i * 4];
+            vbap_normal(m_points, m_triangles + i * 3, cap);
+            const double norm = sqrt(vbap_dot(cap, cap));
+            for(unsigned int k = 0; k < 3; k++)
+                cap[k] /= norm;
+            cap[3] = acos(std::min(std::max(vbap_dot(cap, m_points + m_triangles[i * 3] * 3), -1.), 1.));
+        }
+        
+        m_grid_triangles.clear();
+        for(unsigned int i = 0; i < rows; i++)
+        {
+            const double z = ((double)i + 0.5) * 2. / (double)rows - 1.;
+            const double r = sqrt(1. - z * z);
+            double aperture = 0.;
+            for(unsigned int k = 0; k < 2; k++)
+            {
+                const double corner_z = (double)(i + k) * 2. / (double)rows - 1.;
+                const double corner_r = sqrt(std::max(1. - corner_z * corner_z, 0.));
+                const double cosine = z * corner_z + r * corner_r * cos(HOA_PI / (double)columns);
+                aperture = std::max(aperture, acos(std::min(std::max(cosine, -1.), 1.)));
+            }
+            aperture += 1e-6;
+            for(unsigned int t = 0; t < m_number_of_triangles; t++)
+                thresholds[t] = (caps[t * 4 + 3] + aperture >= HOA_PI) ? -2. : cos(caps[t * 4 + 3] + aperture);
+            for(unsigned int j = 0; j < columns; j++)
+            {
+                const double angle = ((double)j + 0.5) * HOA_2PI / (double)columns;
+                const double center[3] = {-sin(angle) * r, cos(angle) * r, z};
+                m_grid_offsets[i * columns + j] = (unsigned int)m_grid_triangles.size();
+                for(unsigned int t = 0; t < m_number_of_triangles; t++)
+                {
+                    if(vbap_dot(&caps[t * 4], center) >= thresholds[t])
+                        m_grid_triangles.push_back(t);
+                }
+                if(m_grid_triangles.size() == m_grid_offsets[i * columns + j])
+                    m_grid_triangles.push_back(0);
+            }
+        }
+        m_grid_offsets[rows * columns] = (unsigned int)m_grid_triangles.size();
+    }
+    
+    void Vbap::computeSource(const unsigned int index)
+    {
+        const double azimuth = m_sources_azimuth[index], elevation = m_sources_elevation[index];
+        const double direction[3] = {abscissa(1., azimuth, elevation), ordinate(1., azimuth, elevation), height(1., azimuth, elevation)};
+        m_sources_triangle[index] = lookup(direction[0], direction[1], direction[2], azimuth, cos(elevation) < 0., m_sources_triangle[index], m_sources_gains + index * 3);
+        for(unsigned int k = 0; k < 3; k++)
+        {
+            const unsigned int channel = m_triangles[m_sources_triangle[index] * 3 + k];
+            m_sources_channels[index * 3 + k] = channel < m_number_of_channels ? channel : 0;
+        }
+    }
+    
+    void Vbap::setAzimuth(const unsigned int index, const double azimuth)
+    {
+        assert(index < m_number_of_sources);
+        m_sources_azimuth[index] = azimuth;
+        computeSource(index);
+    }
+    
+    void Vbap::setElevation(const unsigned int index, const double elevation)
+    {
+        assert(index < m_number_of_sources);
+        m_sources_elevation[index] = elevation;
+        computeSource(index);
+    }
+    
+    unsigned int Vbap::getTriangle(const double x, const double y, const double z) const
+    {
+        const double direction[3] = {x, y, z};
+        const double norm = sqrt(vbap_dot(direction, direction));
+        const double tolerance = -1e-9 * norm;
+        unsigned int index = m_number_of_triangles;
+        double best = -HUGE_VAL;
+        for(unsigned int i = 0; i < m_number_of_triangles; i++)
+        {
+            const double* inverse = m_inverses + i * 9;
+            const double minimum = std::min(vbap_dot(inverse, direction), std::min(vbap_dot(inverse + 3, direction), vbap_dot(inverse + 6, direction)));
+            if(minimum >= 0.)
+                return i;
+            if(minimum > best)
+            {
+                best = minimum;
+                index = i;
+            }
+        }
+        return best >= tolerance ? index : m_number_of_triangles;
+    }
+    
+    void Vbap::getGains(const double azimuth, const double elevation, double* gains) const
+    {
+        const double direction[3] = {abscissa(1., azimuth, elevation), ordinate(1., azimuth, elevation), height(1., azimuth, elevation)};
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+            gains[i] = 0.;
+        
+        const unsigned int index = getTriangle(direction[0], direction[1], direction[2]);
+        if(index == m_number_of_triangles)
+        {
+            unsigned int closest = 0;
+            for(unsigned int i = 1; i < m_number_of_channels; i++)
+            {
+                if(vbap_dot(m_points + i * 3, direction) > vbap_dot(m_points + closest * 3, direction))
+                    closest = i;
+            }
+            gains[closest] = 1.;
+            return;
+        }
+        
+        double values[3];
+        const unsigned int* channels = m_triangles + lookup(direction[0], direction[1], direction[2], azimuth, cos(elevation) < 0., 0, values) * 3;
+        for(unsigned int k = 0; k < 3; k++)
+        {
+            if(channels[k] < m_number_of_channels)
+                gains[channels[k]] = values[k];
+        }
+    }
+    
+    void Vbap::process(const float* inputs, float* outputs)
+    {
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+            outputs[i] = 0.f;
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            for(unsigned int k = 0; k < 3; k++)
+                outputs[m_sources_channels[i * 3 + k]] += (float)m_sources_gains[i * 3 + k] * inputs[i];
+        }
+    }
+    
+    void Vbap::process(const double* inputs, double* outputs)
+    {
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+            outputs[i] = 0.;
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            for(unsigned int k = 0; k < 3; k++)
+                outputs[m_sources_channels[i * 3 + k]] += m_sources_gains[i * 3 + k] * inputs[i];
+        }
+    }
+    
+    void Vbap::process(const float* const* inputs, const float* const* azimuths, const float* const* elevations, float** outputs, const unsigned int vectorSize)
+    {
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+                outputs[i][k] = 0.f;
+        }
+        
+        float* azimuth_sines        = m_chunk_float;
+        float* azimuth_cosines      = m_chunk_float + NUMBEROFCHUNKPOINTS;
+        float* elevation_sines      = m_chunk_float + NUMBEROFCHUNKPOINTS * 2;
+        float* elevation_cosines    = m_chunk_float + NUMBEROFCHUNKPOINTS * 3;
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            const float* azimuth    = (azimuths && azimuths[i]) ? azimuths[i] : NULL;
+            const float* elevation  = (elevations && elevations[i]) ? elevations[i] : NULL;
+            const float* input      = inputs[i];
+            if(!azimuth && !elevation)
+            {
+                for(unsigned int k = 0; k < 3; k++)
+                {
+                    const float gain = (float)m_sources_gains[i * 3 + k];
+                    float* output = outputs[m_sources_channels[i * 3 + k]];
+                    if(gain != 0.f)
+                    {
+                        for(unsigned int l = 0; l < vectorSize; l++)
+                            output[l] += gain * input[l];
+                    }
+                }
+                continue;
+            }
+            
+            // The gains are computed for each sample, the sines and the cosines of the angles are computed by chunks
+            const float azimuth_constant = (float)m_sources_azimuth[i], elevation_constant = (float)m_sources_elevation[i];
+            unsigned int triangle = m_sources_triangle[i];
+            for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+            {
+                const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+                if(azimuth)
+                    vector_sincos(azimuth + offset, azimuth_sines, azimuth_cosines, size);
+                else
+                {
+                    for(unsigned int l = 0; l < size; l++)
+                    {
+                        azimuth_sines[l]    = sinf(azimuth_constant);
+                        azimuth_cosines[l]  = cosf(azimuth_constant);
+                    }
+                }
+                if(elevation)
+                    vector_sincos(elevation + offset, elevation_sines, elevation_cosines, size);
+                else
+                {
+                    for(unsigned int l = 0; l < size; l++)
+                    {
+                        elevation_sines[l]      = sinf(elevation_constant);
+                        elevation_cosines[l]    = cosf(elevation_constant);
+                    }
+                }
+                for(unsigned int l = 0; l < size; l++)
+                {
+                    double gains[3];
+                    triangle = lookup(-azimuth_sines[l] * elevation_cosines[l], azimuth_cosines[l] * elevation_cosines[l], elevation_sines[l], azimuth ? azimuth[offset + l] : azimuth_constant, elevation_cosines[l] < 0.f, triangle, gains);
+                    const unsigned int* channels = m_triangles + triangle * 3;
+                    const float sample = input[offset + l];
+                    for(unsigned int k = 0; k < 3; k++)
+                    {
+                        if(gains[k] != 0.)
+                            outputs[channels[k]][offset + l] += (float)gains[k] * sample;
+                    }
+                }
+            }
+            if(vectorSize)
+            {
+                if(azimuth)
+                    m_sources_azimuth[i] = azimuth[vectorSize - 1];
+                if(elevation)
+                    m_sources_elevation[i] = elevation[vectorSize - 1];
+                m_sources_triangle[i] = triangle;
+                computeSource(i);
+            }
+        }
+    }
+    
+    void Vbap::process(const double* const* inputs, const double* const* azimuths, const double* const* elevations, double** outputs, const unsigned int vectorSize)
+    {
+        for(unsigned int i = 0; i < m_number_of_channels; i++)
+        {
+            for(unsigned int k = 0; k < vectorSize; k++)
+                outputs[i][k] = 0.;
+        }
+        
+        double* azimuth_sines       = m_chunk_double;
+        double* azimuth_cosines     = m_chunk_double + NUMBEROFCHUNKPOINTS;
+        double* elevation_sines     = m_chunk_double + NUMBEROFCHUNKPOINTS * 2;
+        double* elevation_cosines   = m_chunk_double + NUMBEROFCHUNKPOINTS * 3;
+        for(unsigned int i = 0; i < m_number_of_sources; i++)
+        {
+            const double* azimuth   = (azimuths && azimuths[i]) ? azimuths[i] : NULL;
+            const double* elevation = (elevations && elevations[i]) ? elevations[i] : NULL;
+            const double* input     = inputs[i];
+            if(!azimuth && !elevation)
+            {
+                for(unsigned int k = 0; k < 3; k++)
+                {
+                    const double gain = m_sources_gains[i * 3 + k];
+                    double* output = outputs[m_sources_channels[i * 3 + k]];
+                    if(gain != 0.)
+                    {
+                        for(unsigned int l = 0; l < vectorSize; l++)
+                            output[l] += gain * input[l];
+                    }
+                }
+                continue;
+            }
+            
+            // The gains are computed for each sample, the sines and the cosines of the angles are computed by chunks
+            const double azimuth_constant = m_sources_azimuth[i], elevation_constant = m_sources_elevation[i];
+            unsigned int triangle = m_sources_triangle[i];
+            for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+            {
+                const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+                if(azimuth)
+                    vector_sincos(azimuth + offset, azimuth_sines, azimuth_cosines, size);
+                else
+                {
+                    for(unsigned int l = 0; l < size; l++)
+                    {
+                        azimuth_sines[l]    = sin(azimuth_constant);
+                        azimuth_cosines[l]  = cos(azimuth_constant);
+                    }
+                }
+                if(elevation)
+                    vector_sincos(elevation + offset, elevation_sines, elevation_cosines, size);
+                else
+                {
+                    for(unsigned int l = 0; l < size; l++)
+                    {
+                        elevation_sines[l]      = sin(elevation_constant);
+                        elevation_cosines[l]    = cos(elevation_constant);
+                    }
+                }
+                for(unsigned int l = 0; l < size; l++)
+                {
+                    double gains[3];
+                    triangle = lookup(-azimuth_sines[l] * elevation_cosines[l], azimuth_cosines[l] * elevation_cosines[l], elevation_sines[l], azimuth ? azimuth[offset + l] : azimuth_constant, elevation_cosines[l] < 0., triangle, gains);
+                    const unsigned int* channels = m_triangles + triangle * 3;
+                    const double sample = input[offset + l];
+                    for(unsigned int k = 0; k < 3; k++)
+                    {
+                        if(gains[k] != 0.)
+                            outputs[channels[k]][offset + l] += gains[k] * sample;
+                    }
+                }
+            }
+            if(vectorSize)
+            {
+                if(azimuth)
+                    m_sources_azimuth[i] = azimuth[vectorSize - 1];
+                if(elevation)
+                    m_sources_elevation[i] = elevation[vectorSize - 1];
+                m_sources_triangle[i] = triangle;
+                computeSource(i);
+            }
+        }
+    }
+    
+    Vbap::~Vbap()
+    {
+        delete [] m_points;
+        delete [] m_triangles;
+        delete [] m_inverses;
+        delete [] m_grid_offsets;
+        delete [] m_sources_azimuth;
+        delete [] m_sources_elevation;
+        delete [] m_sources_triangle;
+        delete [] m_sources_channels;
+        delete [] m_sources_gains;
+        delete [] m_chunk_float;
+        delete [] m_chunk_double;
+    }
+}
+
+
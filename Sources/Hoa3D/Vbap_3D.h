@@ -0,0 +1,306 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_3D_VBAP__
+#define __DEF_HOA_3D_VBAP__
+
+#include "Planewaves_3D.h"
+
+//! The maximum number of imaginary channels added to the triangulation.
+#define HOA_VBAP_MAXIMUM_IMAGINARY 6
+//! The number of rows of the lookup grid, the rows have the same area.
+#define HOA_VBAP_GRID_ROWS 64
+//! The number of columns of the lookup grid.
+#define HOA_VBAP_GRID_COLUMNS 128
+
+namespace Hoa3D
+{
+    //! The vector base amplitude panning.
+    /** The vbap class computes the gains of a set of channels for a direction with the vector base amplitude panning. The convex hull of the rotated positions of the channels is triangulated and the gains of a direction are the coordinates of the direction in the base of the three channels of the triangle that contains it, normalized so the energy is constant. When the channels don't surround the listener, for example with a dome or a horizontal ring, imaginary channels are added in the gaps of the triangulation and their gains are discarded. Once the channels are set, the sphere is divided in a grid of cells of the same area and each cell stores the few triangles that overlap it, so the triangle of a direction is found without searching all the triangles and the class can pan many sources with signals of angles. The cells of the grid store all the triangles whose circumscribed cap overlaps them. For futher information : Ville Pulkki, Virtual Sound Source Positioning Using Vector Base Amplitude Panning. Journal of the Audio Engineering Society, 45(6), 1997.
+     */
+    class Vbap : public Planewaves
+    {
+    
+    private:
+        unsigned int    m_number_of_points;
+        double*         m_points;
+        unsigned int    m_number_of_triangles;
+        unsigned int*   m_triangles;
+        double*         m_inverses;
+        unsigned int*   m_grid_offsets;
+        std::vector<unsigned int> m_grid_triangles;
+        unsigned int    m_number_of_sources;
+        double*         m_sources_azimuth;
+        double*         m_sources_elevation;
+        unsigned int*   m_sources_triangle;
+        unsigned int*   m_sources_channels;
+        double*         m_sources_gains;
+        float*          m_chunk_float;
+        double*         m_chunk_double;
+        
+        /**	Compute the triangulation of the channels, the inverses of the bases of the triangles and the lookup grid.
+         */
+        void computeTriangulation();
+        
+        /**	Compute the triangles of the cells of the lookup grid.
+         */
+        void computeGrid();
+        
+        /**	Compute the channels and the gains of a source.
+         */
+        void computeSource(const unsigned int index);
+        
+        /**	Find the triangle of a direction and compute the gains of its three channels, the gains are normalized and the gains of the imaginary channels are null. The hint triangle is tested first, then the triangles of the cell of the lookup grid. The direction is given by its cartesian coordinates, the azimuth and the sign of the cosine of the elevation select the column of the cell.
+         */
+        inline unsigned int lookup(const double x, const double y, const double z, const double azimuth, const bool back, const unsigned int hint, double* gains) const
+        {
+            unsigned int triangle = hint < m_number_of_triangles ? hint : 0;
+            const double* inverse = m_inverses + triangle * 9;
+            gains[0] = inverse[0] * x + inverse[1] * y + inverse[2] * z;
+            gains[1] = inverse[3] * x + inverse[4] * y + inverse[5] * z;
+            gains[2] = inverse[6] * x + inverse[7] * y + inverse[8] * z;
+            double best = std::min(gains[0], std::min(gains[1], gains[2]));
+            if(best < 0.)
+            {
+                // The first triangle of the cell that contains the direction is used, otherwise the closest one
+                const double position = azimuth * (HOA_VBAP_GRID_COLUMNS / HOA_2PI);
+                int column = (int)position;
+                column -= (position < (double)column) ? 1 : 0;
+                column += back ? HOA_VBAP_GRID_COLUMNS / 2 : 0;
+                const int row = (int)((z + 1.) * (0.5 * HOA_VBAP_GRID_ROWS));
+                const unsigned int index = (unsigned int)(row < 0 ? 0 : (row >= HOA_VBAP_GRID_ROWS ? HOA_VBAP_GRID_ROWS - 1 : row)) * HOA_VBAP_GRID_COLUMNS + (unsigned int)(column & (HOA_VBAP_GRID_COLUMNS - 1));
+                for(unsigned int i = m_grid_offsets[index]; i < m_grid_offsets[index + 1] && best < 0.; i++)
+                {
+                    inverse = m_inverses + m_grid_triangles[i] * 9;
+                    const double values[3] = {inverse[0] * x + inverse[1] * y + inverse[2] * z, inverse[3] * x + inverse[4] * y + inverse[5] * z, inverse[6] * x + inverse[7] * y + inverse[8] * z};
+                    const double minimum = std::min(values[0], std::min(values[1], values[2]));
+                    if(minimum > best)
+                    {
+                        best        = minimum;
+                        triangle    = m_grid_triangles[i];
+                        gains[0]    = values[0];
+                        gains[1]    = values[1];
+                        gains[2]    = values[2];
+                    }
+                }
+            }
+            
+            double energy = 0.;
+            for(unsigned int k = 0; k < 3; k++)
+            {
+                gains[k] = std::max(gains[k], 0.);
+                energy += gains[k] * gains[k];
+            }
+            const double scale = energy > 0. ? 1. / sqrt(energy) : 0.;
+            const unsigned int* channels = m_triangles + triangle * 3;
+            for(unsigned int k = 0; k < 3; k++)
+                gains[k] = (channels[k] < m_number_of_channels) ? gains[k] * scale : 0.;
+            return triangle;
+        };
+    public:
+        
+        //! The vbap constructor.
+        /**	The vbap constructor allocates and initializes the member values and computes the triangulation of the default positions of the channels. The number of channels and the number of sources must be at least 1, the sources are at the front of the soundfield.
+         
+            @param     numberOfChannels	The number of channels.
+            @param     numberOfSources	The number of sources.
+         */
+        Vbap(unsigned int numberOfChannels, unsigned int numberOfSources = 1);
+        
+        //! The vbap destructor.
+        /**	The vbap destructor free the memory.
+         */
+        ~Vbap();
+        
+        //! Set the position of a channel.
+        /** Set the position of a channel with polar coordinates and compute the triangulation. The azimtuh is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The elevation is in radian between -1/2 Pi and 1/2 Pi, -1/2 Pi the the bottom of the sound field, 0 is the center of the sound field and 1/2 Pi is the top of the sound field. The maximum index must be the number of channels - 1.
+         
+         @param     index		The index of the channel.
+         @param     azimuth		The azimuth.
+         @param     elevation	The elevation.
+         */
+		void setChannelPosition(unsigned int index, double azimuth, double elevation);
+        
+        //! Set the position of the channels.
+        /** Set the position of the channels with polar coordinates and compute the triangulation. The azimtuh is in radian between 0 and 2 Pi, O is the front of the soundfield and Pi is the back of the sound field. The elevation is in radian between -1/2 Pi and 1/2 Pi, -1/2 Pi the the bottom of the sound field, 0 is the center of the sound field and 1/2 Pi is the top of the sound field.
+         
+         @param     azimuths		The azimuths.
+         @param     elevations	The elevations.
+         */
+		void setChannelsPosition(double* azimuths, double* elevations);
+        
+        //! Set the rotation of the channels.
+		/**	Set the angles in radian of the rotation of the channels around the axes x, y and z and compute the triangulation.
+         
+         @param     axis_x	The angle of rotation around the x axe.
+         @param     axis_y	The angle of rotation around the y axe.
+         @param     axis_z	The angle of rotation around the z axe.
+         */
+		void setChannelsRotation(double axis_x, double axis_y, double axis_z);
+        
+        //! Retrieve the number of triangles.
+        /** Retrieve the number of triangles of the triangulation.
+         
+            @return    The number of triangles.
+         */
+        inline unsigned int getNumberOfTriangles() const
+        {
+            return m_number_of_triangles;
+        };
+        
+        //! Retrieve a channel of a triangle.
+        /** Retrieve the index of one of the three channels of a triangle. An index greater or equal to the number of channels is an imaginary channel.
+         
+            @param     index    The index of the triangle.
+            @param     vertex   The index of the vertex of the triangle, between 0 and 2.
+            @return    The index of the channel.
+         */
+        inline unsigned int getTriangleChannel(unsigned int index, unsigned int vertex) const
+        {
+            assert(index < m_number_of_triangles && vertex < 3);
+            return m_triangles[index * 3 + vertex];
+        };
+        
+        //! Retrieve the number of imaginary channels.
+        /** Retrieve the number of imaginary channels added to the triangulation.
+         
+            @return    The number of imaginary channels.
+         */
+        inline unsigned int getNumberOfImaginaryChannels() const
+        {
+            return m_number_of_points - m_number_of_channels;
+        };
+        
+        //! Retrieve the azimuth of an imaginary channel.
+        /** Retrieve the azimuth in radian of an imaginary channel.
+         
+            @param     index    The index of the imaginary channel.
+            @return    The azimuth of the imaginary channel.
+         */
+        inline double getImaginaryChannelAzimuth(unsigned int index) const
+        {
+            assert(index < getNumberOfImaginaryChannels());
+            const double* point = m_points + (m_number_of_channels + index) * 3;
+            return wrap_twopi(azimuth(point[0], point[1], point[2]));
+        };
+        
+        //! Retrieve the elevation of an imaginary channel.
+        /** Retrieve the elevation in radian of an imaginary channel.
+         
+            @param     index    The index of the imaginary channel.
+            @return    The elevation of the imaginary channel.
+         */
+        inline double getImaginaryChannelElevation(unsigned int index) const
+        {
+            assert(index < getNumberOfImaginaryChannels());
+            const double* point = m_points + (m_number_of_channels + index) * 3;
+            return elevation(point[0], point[1], point[2]);
+        };
+        
+        //! Retrieve the number of sources.
+        /** Retrieve the number of sources panned by the process methods.
+         
+            @return    The number of sources.
+         */
+        inline unsigned int getNumberOfSources() const
+        {
+            return m_number_of_sources;
+        };
+        
+        //! Set the azimuth of a source.
+        /** Set the azimuth of a source in radian, 0 is the front of the soundfield and Pi is the back of the sound field.
+         
+            @param     index    The index of the source.
+            @param     azimuth  The azimuth.
+         */
+        void setAzimuth(const unsigned int index, const double azimuth);
+        
+        //! Set the elevation of a source.
+        /** Set the elevation of a source in radian, -1/2 Pi the the bottom of the sound field, 0 is the center of the sound field and 1/2 Pi is the top of the sound field.
+         
+            @param     index        The index of the source.
+            @param     elevation    The elevation.
+         */
+        void setElevation(const unsigned int index, const double elevation);
+        
+        /**	Retrieve the azimuth of a source.
+         */
+        inline double getAzimuth(const unsigned int index) const
+        {
+            assert(index < m_number_of_sources);
+            return m_sources_azimuth[index];
+        };
+        
+        /**	Retrieve the elevation of a source.
+         */
+        inline double getElevation(const unsigned int index) const
+        {
+            assert(index < m_number_of_sources);
+            return m_sources_elevation[index];
+        };
+        
+        //! Retrieve the triangle of a direction.
+        /** Retrieve the index of the triangle that contains a direction given in cartesian coordinates, the direction doesn't need to be normalized. All the triangles are tested and if no triangle contains the direction, the function returns the number of triangles. You should use the getGains method that only tests the triangles of the lookup grid to pan a source.
+         
+            @param     x        The abscissa of the direction.
+            @param     y        The ordinate of the direction.
+            @param     z        The height of the direction.
+            @return    The index of the triangle.
+         */
+        unsigned int getTriangle(const double x, const double y, const double z) const;
+        
+        //! Compute the gains of a direction.
+        /** Compute the gains of the channels for a direction with polar coordinates. The gains of the three channels of the triangle that contains the direction are normalized so the sum of the squares of the gains of the triangle is 1 and the other gains are null, the gains of the imaginary channels are discarded. The triangle is found with the lookup grid, if the triangulation failed the closest channel gets all the gain. The minimum size of the gains array must be the number of channels.
+         
+            @param     azimuth		The azimuth.
+            @param     elevation	The elevation.
+            @param     gains        The gains of the channels.
+         */
+        void getGains(const double azimuth, const double elevation, double* gains) const;
+        
+        //! This method performs the panning of the sources with single precision.
+        /**	You should use this method for not-in-place processing and performs the panning sample by sample with the current angles of the sources. The inputs array contains the samples of the sources and its minimum size must be the number of sources. The outputs array contains the samples of the channels and its minimum size must be the number of channels.
+         
+            @param     inputs  The inputs array.
+            @param     outputs The outputs array.
+         */
+        void process(const float* inputs, float* outputs);
+        
+        //! This method performs the panning of the sources with double precision.
+        /**	You should use this method for not-in-place processing and performs the panning sample by sample with the current angles of the sources. The inputs array contains the samples of the sources and its minimum size must be the number of sources. The outputs array contains the samples of the channels and its minimum size must be the number of channels.
+         
+            @param     inputs  The inputs array.
+            @param     outputs The outputs array.
+         */
+        void process(const double* inputs, double* outputs);
+        
+        //! This method performs the panning of the sources with single precision on a block of samples with signals of angles.
+        /**	You should use this method for not-in-place processing and performs the panning on a whole vector of samples with an angle of azimuth and an angle of elevation for each sample of each source. The inputs array contains one vector for each source, its minimum size must be the number of sources. The azimuths and the elevations arrays contain one vector of angles in radian for each source, the arrays or their vectors can be NULL to use the current angles of the sources. The gains of the sources with constant angles are computed once and each of these sources is added to three channels, the gains of the others are computed for each sample with the lookup grid. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples. At the end of the block, the angles of the sources are the last values of their vectors.
+         
+            @param     inputs       The input vectors.
+            @param     azimuths     The azimuths vectors.
+            @param     elevations   The elevations vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, const float* const* azimuths, const float* const* elevations, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the panning of the sources with double precision on a block of samples with signals of angles.
+        /**	You should use this method for not-in-place processing and performs the panning on a whole vector of samples with an angle of azimuth and an angle of elevation for each sample of each source. The inputs array contains one vector for each source, its minimum size must be the number of sources. The azimuths and the elevations arrays contain one vector of angles in radian for each source, the arrays or their vectors can be NULL to use the current angles of the sources. The gains of the sources with constant angles are computed once and each of these sources is added to three channels, the gains of the others are computed for each sample with the lookup grid. The outputs array contains one vector for each channel, its minimum size must be the number of channels. Each vector must contain at least the vector size samples. At the end of the block, the angles of the sources are the last values of their vectors.
+         
+            @param     inputs       The input vectors.
+            @param     azimuths     The azimuths vectors.
+            @param     elevations   The elevations vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, const double* const* azimuths, const double* const* elevations, double** outputs, const unsigned int vectorSize);
+    };
+}
+
+#endif
+
+
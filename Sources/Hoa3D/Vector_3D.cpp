@@ -49,9 +49,9 @@ namespace Hoa3D
         float veclocitySum = 0.f, velocityAbscissa = 0.f, velocityOrdinate = 0.f, velocityElevation = 0.f;
 
         veclocitySum = cblas_sasum(m_number_of_channels, inputs, 1);
-        velocityAbscissa = cblas_sdot(m_number_of_channels, inputs, 1, m_channels_abscissa_float, 1);
-        velocityOrdinate = cblas_sdot(m_number_of_channels, inputs, 1, m_channels_ordinate_float, 1);
-        velocityElevation= cblas_sdot(m_number_of_channels, inputs, 1, m_channels_height_float, 1);
+        velocityAbscissa = getSimdKernels()->dot_float(inputs, m_channels_abscissa_float, m_number_of_channels);
+        velocityOrdinate = getSimdKernels()->dot_float(inputs, m_channels_ordinate_float, m_number_of_channels);
+        velocityElevation= getSimdKernels()->dot_float(inputs, m_channels_height_float, m_number_of_channels);
         if(veclocitySum)
         {
             outputs[0] = velocityAbscissa / veclocitySum;
@@ -71,9 +71,9 @@ namespace Hoa3D
     {
         double veclocitySum = 0., velocityAbscissa = 0., velocityOrdinate = 0., velocityElevation = 0.;
         veclocitySum = cblas_dasum(m_number_of_channels, inputs, 1);
-        velocityAbscissa = cblas_ddot(m_number_of_channels, inputs, 1, m_channels_abscissa_double, 1);
-        velocityOrdinate = cblas_ddot(m_number_of_channels, inputs, 1, m_channels_ordinate_double, 1);
-        velocityElevation= cblas_ddot(m_number_of_channels, inputs, 1, m_channels_height_double, 1);
+        velocityAbscissa = getSimdKernels()->dot_double(inputs, m_channels_abscissa_double, m_number_of_channels);
+        velocityOrdinate = getSimdKernels()->dot_double(inputs, m_channels_ordinate_double, m_number_of_channels);
+        velocityElevation= getSimdKernels()->dot_double(inputs, m_channels_height_double, m_number_of_channels);
 
         if(veclocitySum)
         {
@@ -97,9 +97,9 @@ namespace Hoa3D
             m_channels_float[i] *= m_channels_float[i];
 
         energySum = cblas_sasum(m_number_of_channels, m_channels_float, 1);
-        energyAbscissa = cblas_sdot(m_number_of_channels, m_channels_float, 1, m_channels_abscissa_float, 1);
-        energyOrdinate = cblas_sdot(m_number_of_channels, m_channels_float, 1, m_channels_ordinate_float, 1);
-        energyElevation = cblas_sdot(m_number_of_channels, m_channels_float, 1, m_channels_height_float, 1);
+        energyAbscissa = getSimdKernels()->dot_float(m_channels_float, m_channels_abscissa_float, m_number_of_channels);
+        energyOrdinate = getSimdKernels()->dot_float(m_channels_float, m_channels_ordinate_float, m_number_of_channels);
+        energyElevation = getSimdKernels()->dot_float(m_channels_float, m_channels_height_float, m_number_of_channels);
 
         if(energySum)
         {
@@ -124,9 +124,9 @@ namespace Hoa3D
             m_channels_double[i] *= m_channels_double[i];
 
         energySum = cblas_dasum(m_number_of_channels, m_channels_double, 1);
-        energyAbscissa = cblas_ddot(m_number_of_channels, m_channels_double, 1, m_channels_abscissa_double, 1);
-        energyOrdinate = cblas_ddot(m_number_of_channels, m_channels_double, 1, m_channels_ordinate_double, 1);
-        energyElevation = cblas_ddot(m_number_of_channels, m_channels_double, 1, m_channels_height_double, 1);
+        energyAbscissa = getSimdKernels()->dot_double(m_channels_double, m_channels_abscissa_double, m_number_of_channels);
+        energyOrdinate = getSimdKernels()->dot_double(m_channels_double, m_channels_ordinate_double, m_number_of_channels);
+        energyElevation = getSimdKernels()->dot_double(m_channels_double, m_channels_height_double, m_number_of_channels);
 
         if(energySum)
         {
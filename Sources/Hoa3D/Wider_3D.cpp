@@ -51,18 +51,48 @@ namespace Hoa3D
     
     void Wider::process(const float* inputs, float* outputs)
     {
+        if(m_kernels_float)
+        {
+            m_kernels_float->weight(m_wide_matrix[m_wide], inputs, outputs);
+            return;
+        }
         for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             outputs[i] = inputs[i] * m_wide_matrix[m_wide][i];
     }
     
     void Wider::process(const double* inputs, double* outputs)
     {
+        if(m_kernels_double)
+        {
+            m_kernels_double->weight(m_wide_matrix[m_wide], inputs, outputs);
+            return;
+        }
         for(unsigned int i = 0; i < m_number_of_harmonics; i++)
             outputs[i] = inputs[i] * m_wide_matrix[m_wide][i];
     }
     
+    void Wider::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        const double* weights = m_wide_matrix[m_wide];
+        const SimdKernels* simd = getSimdKernels();
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            simd->weight_float(inputs[i], weights[i], outputs[i], vectorSize);
+    }
+    
+    void Wider::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        const double* weights = m_wide_matrix[m_wide];
+        const SimdKernels* simd = getSimdKernels();
+        for(unsigned int i = 0; i < m_number_of_harmonics; i++)
+            simd->weight_double(inputs[i], weights[i], outputs[i], vectorSize);
+    }
+    
     Wider::~Wider()
     {
+        for(int j = 0; j < NUMBEROFLINEARPOINTS; j++)
+        {
+            delete [] m_wide_matrix[j];
+        }
         delete [] m_wide_matrix;
     }
 }
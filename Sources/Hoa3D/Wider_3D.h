@@ -67,6 +67,24 @@ namespace Hoa3D
             @param     outputs  The outputs array.
          */
         void process(const double* inputs, double* outputs);
+        
+        //! This method performs the widening with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the widening on a whole vector of samples. The inputs array and outputs array contains one vector for each spherical harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the widening with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the widening on a whole vector of samples. The inputs array and outputs array contains one vector for each spherical harmonic, their minimum size must be the number of harmonics and each vector must contain at least the vector size samples.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
     };
 }
 
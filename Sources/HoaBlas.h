@@ -0,0 +1,218 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_BLAS__
+#define __DEF_HOA_BLAS__
+
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+// The built-in BLAS is the subset of the CBLAS interface used by the library. It is selected with the HOA_BUILTIN_BLAS
+// flag in place of the BLAS of the platform, so the library has no dependency and no thread pool of a BLAS library runs
+// in the audio thread. The vectors and the matrices of the library are small, the functions are inlined and their loops
+// have independent partial sums so the compiler vectorizes them with the instruction set of the compilation.
+// The header must not be included with another CBLAS header.
+
+typedef enum CBLAS_ORDER     {CblasRowMajor=101, CblasColMajor=102} CBLAS_ORDER;
+typedef enum CBLAS_TRANSPOSE {CblasNoTrans=111, CblasTrans=112, CblasConjTrans=113} CBLAS_TRANSPOSE;
+
+namespace Hoa
+{
+    //! The dot product of two contiguous vectors.
+    template <typename T> inline T blas_dot(const T* x, const T* y, const int n)
+    {
+        T sums[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        int i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            for(int k = 0; k < 8; k++)
+                sums[k] += x[i + k] * y[i + k];
+        }
+        for(; i < n; i++)
+            sums[0] += x[i] * y[i];
+        return ((sums[0] + sums[4]) + (sums[1] + sums[5])) + ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+    }
+    
+    //! The dot product of two strided vectors.
+    template <typename T> inline T blas_dot(const int n, const T* x, const int incx, const T* y, const int incy)
+    {
+        if(incx == 1 && incy == 1)
+            return blas_dot(x, y, n);
+        T sum = 0;
+        for(int i = 0; i < n; i++)
+            sum += x[i * incx] * y[i * incy];
+        return sum;
+    }
+    
+    //! The sum of the absolute values of a vector.
+    template <typename T> inline T blas_asum(const int n, const T* x, const int incx)
+    {
+        if(incx == 1)
+        {
+            T sums[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            int i = 0;
+            for(; i + 8 <= n; i += 8)
+            {
+                for(int k = 0; k < 8; k++)
+                    sums[k] += fabs(x[i + k]);
+            }
+            for(; i < n; i++)
+                sums[0] += fabs(x[i]);
+            return ((sums[0] + sums[4]) + (sums[1] + sums[5])) + ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+        }
+        T sum = 0;
+        for(int i = 0; i < n; i++)
+            sum += fabs(x[i * incx]);
+        return sum;
+    }
+    
+    //! The addition of a scaled vector, y = alpha * x + y.
+    template <typename T> inline void blas_axpy(const int n, const T alpha, const T* x, const int incx, T* y, const int incy)
+    {
+        if(incx == 1 && incy == 1)
+        {
+            for(int i = 0; i < n; i++)
+                y[i] += alpha * x[i];
+        }
+        else
+        {
+            for(int i = 0; i < n; i++)
+                y[i * incy] += alpha * x[i * incx];
+        }
+    }
+    
+    //! The copy of a vector, y = x.
+    template <typename T> inline void blas_copy(const int n, const T* x, const int incx, T* y, const int incy)
+    {
+        if(incx == 1 && incy == 1)
+        {
+            if(n > 0)
+                memmove(y, x, n * sizeof(T));
+        }
+        else
+        {
+            for(int i = 0; i < n; i++)
+                y[i * incy] = x[i * incx];
+        }
+    }
+    
+    //! The scaling of a vector, x = alpha * x.
+    template <typename T> inline void blas_scal(const int n, const T alpha, T* x, const int incx)
+    {
+        for(int i = 0; i < n; i++)
+            x[i * incx] *= alpha;
+    }
+    
+    //! The index of the first maximum absolute value of a vector.
+    template <typename T> inline size_t blas_iamax(const int n, const T* x, const int incx)
+    {
+        size_t index = 0;
+        T max = (n > 0) ? fabs(x[0]) : 0;
+        for(int i = 1; i < n; i++)
+        {
+            const T value = fabs(x[i * incx]);
+            if(value > max)
+            {
+                max = value;
+                index = i;
+            }
+        }
+        return index;
+    }
+    
+    //! The product of a matrix by a vector, y = alpha * A * x + beta * y.
+    /** The rows of a row-major matrix, or the columns of a column-major transposed matrix, are contiguous and each output is a dot product of the row and the input vector. Otherwise the contiguous rows are accumulated in the output vector.
+     */
+    template <typename T> inline void blas_gemv(const CBLAS_ORDER order, const CBLAS_TRANSPOSE trans, const int m, const int n, const T alpha, const T* a, const int lda, const T* x, const int incx, const T beta, T* y, const int incy)
+    {
+        const bool rows = (order == CblasRowMajor) == (trans == CblasNoTrans);
+        const int size_y = (trans == CblasNoTrans) ? m : n;
+        const int size_x = (trans == CblasNoTrans) ? n : m;
+        if(beta == 0)
+        {
+            for(int i = 0; i < size_y; i++)
+                y[i * incy] = 0;
+        }
+        else if(beta != 1)
+        {
+            blas_scal(size_y, beta, y, incy);
+        }
+        
+        if(rows)
+        {
+            for(int i = 0; i < size_y; i++)
+                y[i * incy] += alpha * blas_dot(size_x, a + i * lda, 1, x, incx);
+        }
+        else
+        {
+            for(int j = 0; j < size_x; j++)
+                blas_axpy(size_y, alpha * x[j * incx], a + j * lda, 1, y, incy);
+        }
+    }
+}
+
+inline float cblas_sdot(const int n, const float* x, const int incx, const float* y, const int incy)
+{
+    return Hoa::blas_dot(n, x, incx, y, incy);
+}
+
+inline double cblas_ddot(const int n, const double* x, const int incx, const double* y, const int incy)
+{
+    return Hoa::blas_dot(n, x, incx, y, incy);
+}
+
+inline float cblas_sasum(const int n, const float* x, const int incx)
+{
+    return Hoa::blas_asum(n, x, incx);
+}
+
+inline double cblas_dasum(const int n, const double* x, const int incx)
+{
+    return Hoa::blas_asum(n, x, incx);
+}
+
+inline void cblas_saxpy(const int n, const float alpha, const float* x, const int incx, float* y, const int incy)
+{
+    Hoa::blas_axpy(n, alpha, x, incx, y, incy);
+}
+
+inline void cblas_daxpy(const int n, const double alpha, const double* x, const int incx, double* y, const int incy)
+{
+    Hoa::blas_axpy(n, alpha, x, incx, y, incy);
+}
+
+inline void cblas_scopy(const int n, const float* x, const int incx, float* y, const int incy)
+{
+    Hoa::blas_copy(n, x, incx, y, incy);
+}
+
+inline void cblas_dcopy(const int n, const double* x, const int incx, double* y, const int incy)
+{
+    Hoa::blas_copy(n, x, incx, y, incy);
+}
+
+inline void cblas_dscal(const int n, const double alpha, double* x, const int incx)
+{
+    Hoa::blas_scal(n, alpha, x, incx);
+}
+
+inline size_t cblas_idamax(const int n, const double* x, const int incx)
+{
+    return Hoa::blas_iamax(n, x, incx);
+}
+
+inline void cblas_sgemv(const CBLAS_ORDER order, const CBLAS_TRANSPOSE trans, const int m, const int n, const float alpha, const float* a, const int lda, const float* x, const int incx, const float beta, float* y, const int incy)
+{
+    Hoa::blas_gemv(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+inline void cblas_dgemv(const CBLAS_ORDER order, const CBLAS_TRANSPOSE trans, const int m, const int n, const double alpha, const double* a, const int lda, const double* x, const int incx, const double beta, double* y, const int incy)
+{
+    Hoa::blas_gemv(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+#endif
@@ -0,0 +1,197 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "BinauralCache.h"
+#include <string.h>
+
+#ifdef _WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define HOA_BINAURAL_CACHE_VERSION 1
+
+namespace Hoa
+{
+    //! The header of a cache file.
+    struct BinauralCacheHeader
+    {
+        char            magic[8];
+        uint64_t        hash;
+        uint32_t        version;
+        uint32_t        dimension;
+        uint32_t        order;
+        uint32_t        sampleRate;
+        uint32_t        partitionSize;
+        uint32_t        numberOfInputs;
+        uint32_t        numberOfOutputs;
+        uint32_t        numberOfPartitions;
+    };
+    
+    BinauralCache::BinauralCache()
+    {
+        m_data                  = NULL;
+        m_size                  = 0;
+        m_handle                = NULL;
+        m_number_of_partitions  = 0;
+        m_heads                 = NULL;
+        m_impulses_real         = NULL;
+        m_impulses_imag         = NULL;
+    }
+    
+    std::string BinauralCache::getPath(const std::string& directory, const Key& key)
+    {
+        char name[128];
+        sprintf(name, "hoa-%016llx-%ud-%u-%u-%u.cache", (unsigned long long)key.hash, key.dimension, key.order, key.sampleRate, key.partitionSize);
+        if(directory.empty())
+            return name;
+        const char last = directory[directory.size() - 1];
+        if(last == '/' || last == '\\')
+            return directory + name;
+        return directory + "/" + name;
+    }
+    
+    bool BinauralCache::write(const std::string& path, const Key& key, const Convolver& convolver)
+    {
+        if(!convolver.getState())
+            return false;
+        
+        BinauralCacheHeader header;
+        memset(&header, 0, sizeof(BinauralCacheHeader));
+        memcpy(header.magic, "HOACACHE", 8);
+        header.hash                 = key.hash;
+        header.version              = HOA_BINAURAL_CACHE_VERSION;
+        header.dimension            = key.dimension;
+        header.order                = key.order;
+        header.sampleRate           = key.sampleRate;
+        header.partitionSize        = convolver.getPartitionSize();
+        header.numberOfInputs       = convolver.getNumberOfInputs();
+        header.numberOfOutputs      = convolver.getNumberOfOutputs();
+        header.numberOfPartitions   = convolver.getNumberOfPartitions();
+        
+        const size_t number_of_filters  = (size_t)header.numberOfInputs * header.numberOfOutputs;
+        const size_t heads_size         = number_of_filters * header.partitionSize;
+        const size_t spectra_size       = number_of_filters * header.numberOfPartitions * convolver.getComplexSize();
+        
+        const std::string temporary = path + ".tmp";
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if(!file)
+            return false;
+        bool valid = fwrite(&header, sizeof(BinauralCacheHeader), 1, file) == 1;
+        valid = valid && fwrite(convolver.getHeads(), sizeof(float), heads_size, file) == heads_size;
+        valid = valid && fwrite(convolver.getImpulsesReal(), sizeof(float), spectra_size, file) == spectra_size;
+        valid = valid && fwrite(convolver.getImpulsesImag(), sizeof(float), spectra_size, file) == spectra_size;
+        valid = (fclose(file) == 0) && valid;
+        if(valid)
+        {
+#ifdef _WINDOWS
+            remove(path.c_str());
+#endif
+            valid = rename(temporary.c_str(), path.c_str()) == 0;
+        }
+        if(!valid)
+            remove(temporary.c_str());
+        return valid;
+    }
+    
+    bool BinauralCache::map(const std::string& path, const Key& key, const unsigned int numberOfInputs, const unsigned int numberOfOutputs)
+    {
+        unmap();
+#ifdef _WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(BinauralCacheHeader))
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if(!mapping)
+            return false;
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(!data)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+        m_data      = data;
+        m_size      = (size_t)size.QuadPart;
+        m_handle    = mapping;
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if(file < 0)
+            return false;
+        struct stat status;
+        if(fstat(file, &status) != 0 || status.st_size < (off_t)sizeof(BinauralCacheHeader))
+        {
+            close(file);
+            return false;
+        }
+        void* data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+        close(file);
+        if(data == MAP_FAILED)
+            return false;
+        m_data  = data;
+        m_size  = (size_t)status.st_size;
+#endif
+        
+        const BinauralCacheHeader* header = (const BinauralCacheHeader *)m_data;
+        if(memcmp(header->magic, "HOACACHE", 8) != 0 || header->version != HOA_BINAURAL_CACHE_VERSION || header->hash != key.hash || header->dimension != key.dimension || header->order != key.order || header->sampleRate != key.sampleRate || header->partitionSize != key.partitionSize || header->numberOfInputs != numberOfInputs || header->numberOfOutputs != numberOfOutputs || !header->numberOfPartitions)
+        {
+            unmap();
+            return false;
+        }
+        
+        const size_t number_of_filters  = (size_t)numberOfInputs * numberOfOutputs;
+        const size_t heads_size         = number_of_filters * header->partitionSize;
+        const size_t spectra_size       = number_of_filters * header->numberOfPartitions * (header->partitionSize + 1);
+        if(m_size != sizeof(BinauralCacheHeader) + (heads_size + spectra_size * 2) * sizeof(float))
+        {
+            unmap();
+            return false;
+        }
+        
+        m_number_of_partitions  = header->numberOfPartitions;
+        m_heads                 = (const float *)((const char *)m_data + sizeof(BinauralCacheHeader));
+        m_impulses_real         = m_heads + heads_size;
+        m_impulses_imag         = m_impulses_real + spectra_size;
+        return true;
+    }
+    
+    void BinauralCache::unmap()
+    {
+        if(m_data)
+        {
+#ifdef _WINDOWS
+            UnmapViewOfFile(m_data);
+            CloseHandle((HANDLE)m_handle);
+#else
+            munmap(m_data, m_size);
+#endif
+        }
+        m_data                  = NULL;
+        m_size                  = 0;
+        m_handle                = NULL;
+        m_number_of_partitions  = 0;
+        m_heads                 = NULL;
+        m_impulses_real         = NULL;
+        m_impulses_imag         = NULL;
+    }
+    
+    BinauralCache::~BinauralCache()
+    {
+        unmap();
+    }
+}
+
+
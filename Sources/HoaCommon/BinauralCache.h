@@ -0,0 +1,174 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_BINAURAL_CACHE__
+#define __DEF_HOA_BINAURAL_CACHE__
+
+#include "Convolver.h"
+
+namespace Hoa
+{
+    //! The cache of the binaural filters.
+    /** The cache stores on the disk the impulse responses of the harmonics of a binaural decoder once they are partitioned and transformed by the convolver, and maps them in memory instead of computing them again. A cache file is identified by the hash of the file of the head related impulse responses, the dimension, the order of decomposition, the sample rate and the size of the partitions. The mapped memory is read-only and shared by all the decoders that use the same file.
+     */
+    class BinauralCache
+    {
+    public:
+        
+        //! The key of a cache file.
+        struct Key
+        {
+            uint64_t        hash;               /**< The hash of the file of the head related impulse responses */
+            unsigned int    dimension;          /**< The dimension, 2 or 3 */
+            unsigned int    order;              /**< The order of decomposition */
+            unsigned int    sampleRate;         /**< The sample rate */
+            unsigned int    partitionSize;      /**< The size of the partitions */
+        };
+    
+    private:
+        
+        void*               m_data;
+        size_t              m_size;
+        void*               m_handle;
+        unsigned int        m_number_of_partitions;
+        const float*        m_heads;
+        const float*        m_impulses_real;
+        const float*        m_impulses_imag;
+        
+        //! Unmap the cache file.
+        void unmap();
+        
+        BinauralCache(const BinauralCache& other);
+        BinauralCache& operator=(const BinauralCache& other);
+    
+    public:
+        
+        //! The cache constructor.
+        /**	The cache constructor initializes an empty cache.
+         */
+        BinauralCache();
+        
+        //! The cache destructor.
+        /**	The cache destructor unmaps the cache file.
+         */
+        ~BinauralCache();
+        
+        //! Retrieve the path of a cache file.
+        /**	Retrieve the path of the cache file of a key in a directory.
+         
+            @param     directory    The directory of the cache files.
+            @param     key          The key of the cache file.
+            @return    The path of the cache file.
+         */
+        static std::string getPath(const std::string& directory, const Key& key);
+        
+        //! Write a cache file.
+        /**	Write the impulse responses of a convolver in a cache file. The file is written in a temporary file and then renamed, so a decoder never maps a partial file. The values are written with the byte order of the machine.
+         
+            @param     path         The path of the cache file.
+            @param     key          The key of the cache file.
+            @param     convolver    The convolver.
+            @return    True if the file has been written.
+         */
+        static bool write(const std::string& path, const Key& key, const Convolver& convolver);
+        
+        //! Map a cache file.
+        /**	Map a cache file in memory if it exists and matches the key and the number of inputs and outputs of the convolver.
+         
+            @param     path                 The path of the cache file.
+            @param     key                  The key of the cache file.
+            @param     numberOfInputs       The number of inputs of the convolver.
+            @param     numberOfOutputs      The number of outputs of the convolver.
+            @return    True if the file has been mapped.
+         */
+        bool map(const std::string& path, const Key& key, const unsigned int numberOfInputs, const unsigned int numberOfOutputs);
+        
+        /**	Retrieve if a cache file is mapped.
+         */
+        inline bool getState() const
+        {
+            return m_data != NULL;
+        };
+        
+        /**	Retrieve the number of partitions of the impulse responses.
+         */
+        inline unsigned int getNumberOfPartitions() const
+        {
+            return m_number_of_partitions;
+        };
+        
+        /**	Retrieve the reversed first partitions of the impulse responses.
+         */
+        inline const float* getHeads() const
+        {
+            return m_heads;
+        };
+        
+        /**	Retrieve the real parts of the spectra of the partitions.
+         */
+        inline const float* getImpulsesReal() const
+        {
+            return m_impulses_real;
+        };
+        
+        /**	Retrieve the imaginary parts of the spectra of the partitions.
+         */
+        inline const float* getImpulsesImag() const
+        {
+            return m_impulses_imag;
+        };
+    };
+    
+    //! The binaural filters.
+    /** The binaural filters own a convolver and the cache its impulse responses are mapped from, if any, so they are published to the audio thread and deleted together. The mapped memory is only unmapped once the audio thread doesn't use the convolver anymore.
+     */
+    class BinauralFilters
+    {
+    private:
+        
+        Convolver*          m_convolver;
+        BinauralCache*      m_cache;
+        
+        BinauralFilters(const BinauralFilters& other);
+        BinauralFilters& operator=(const BinauralFilters& other);
+    
+    public:
+        
+        //! The binaural filters constructor.
+        /**	The binaural filters constructor takes the ownership of the convolver and of the cache.
+         
+            @param     convolver    The convolver or NULL to use no convolver.
+            @param     cache        The cache of the impulse responses of the convolver or NULL.
+         */
+        BinauralFilters(Convolver* convolver, BinauralCache* cache = NULL)
+        {
+            m_convolver = convolver;
+            m_cache     = cache;
+        };
+        
+        //! The binaural filters destructor.
+        /**	The binaural filters destructor deletes the convolver and then the cache.
+         */
+        ~BinauralFilters()
+        {
+            if(m_convolver)
+                delete m_convolver;
+            if(m_cache)
+                delete m_cache;
+        };
+        
+        /**	Retrieve the convolver.
+         */
+        inline Convolver* getConvolver() const
+        {
+            return m_convolver;
+        };
+    };
+}
+
+#endif
+
+
@@ -0,0 +1,447 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "Convolver.h"
+
+namespace Hoa
+{
+    Convolver::Convolver(unsigned int numberOfInputs, unsigned int numberOfOutputs, unsigned int partitionSize)
+    {
+        assert(numberOfInputs > 0);
+        assert(numberOfOutputs > 0);
+        assert(partitionSize > 0 && (partitionSize & (partitionSize - 1)) == 0);
+        
+        m_number_of_inputs      = numberOfInputs;
+        m_number_of_outputs     = numberOfOutputs;
+        m_partition_size        = partitionSize;
+        m_complex_size          = audiofft::AudioFFT::ComplexSize(m_partition_size * 2);
+        m_number_of_partitions  = 0;
+        m_position              = 0;
+        m_current               = 0;
+        m_fft.init(m_partition_size * 2);
+        
+        m_owner                 = true;
+        m_heads                 = NULL;
+        m_impulses_real         = NULL;
+        m_impulses_imag         = NULL;
+        m_spectra_real          = NULL;
+        m_spectra_imag          = NULL;
+        m_histories             = new float[m_number_of_inputs * m_partition_size * 2];
+        m_tails                 = new float[m_number_of_outputs * m_partition_size];
+        m_overlaps              = new float[m_number_of_outputs * m_partition_size];
+        m_fft_buffer            = new float[m_partition_size * 2];
+        m_accumulator_real      = new float[m_complex_size];
+        m_accumulator_imag      = new float[m_complex_size];
+        m_inputs_vectors        = new const float*[m_number_of_inputs];
+        m_inputs_vectors_double = new const double*[m_number_of_inputs];
+        clear();
+    }
+    
+    void Convolver::freeImpulses()
+    {
+        if(m_owner)
+        {
+            if(m_heads)
+                delete [] m_heads;
+            if(m_impulses_real)
+                delete [] m_impulses_real;
+            if(m_impulses_imag)
+                delete [] m_impulses_imag;
+        }
+        if(m_spectra_real)
+            delete [] m_spectra_real;
+        if(m_spectra_imag)
+            delete [] m_spectra_imag;
+        m_heads                 = NULL;
+        m_impulses_real         = NULL;
+        m_impulses_imag         = NULL;
+        m_spectra_real          = NULL;
+        m_spectra_imag          = NULL;
+        m_number_of_partitions  = 0;
+        m_owner                 = true;
+    }
+    
+    void Convolver::setImpulses(const float* const* impulses, const unsigned int size)
+    {
+        freeImpulses();
+        if(!size)
+        {
+            clear();
+            return;
+        }
+        
+        const unsigned int number_of_filters = m_number_of_inputs * m_number_of_outputs;
+        m_number_of_partitions  = (size + m_partition_size - 1) / m_partition_size;
+        float* heads            = new float[number_of_filters * m_partition_size];
+        float* impulses_real    = new float[number_of_filters * m_number_of_partitions * m_complex_size];
+        float* impulses_imag    = new float[number_of_filters * m_number_of_partitions * m_complex_size];
+        m_spectra_real          = new float[m_number_of_inputs * m_number_of_partitions * m_complex_size];
+        m_spectra_imag          = new float[m_number_of_inputs * m_number_of_partitions * m_complex_size];
+        
+        for(unsigned int i = 0; i < number_of_filters; i++)
+        {
+            const float* impulse = impulses[i];
+            float* head = heads + i * m_partition_size;
+            for(unsigned int j = 0; j < m_partition_size; j++)
+            {
+                const unsigned int index = m_partition_size - 1 - j;
+                head[j] = (impulse && index < size) ? impulse[index] : 0.f;
+            }
+            for(unsigned int j = 0; j < m_number_of_partitions; j++)
+            {
+                for(unsigned int k = 0; k < m_partition_size; k++)
+                {
+                    const unsigned int index = j * m_partition_size + k;
+                    m_fft_buffer[k] = (impulse && index < size) ? impulse[index] : 0.f;
+                    m_fft_buffer[k + m_partition_size] = 0.f;
+                }
+                const unsigned int offset = (i * m_number_of_partitions + j) * m_complex_size;
+                m_fft.fft(m_fft_buffer, impulses_real + offset, impulses_imag + offset);
+            }
+        }
+        m_heads         = heads;
+        m_impulses_real = impulses_real;
+        m_impulses_imag = impulses_imag;
+        clear();
+    }
+    
+    void Convolver::setImpulses(const float* heads, const float* real, const float* imag, const unsigned int numberOfPartitions)
+    {
+        freeImpulses();
+        if(!heads || !real || !imag || !numberOfPartitions)
+        {
+            clear();
+            return;
+        }
+        
+        m_owner                 = false;
+        m_number_of_partitions  = numberOfPartitions;
+        m_heads                 = heads;
+        m_impulses_real         = real;
+        m_impulses_imag         = imag;
+        m_spectra_real          = new float[m_number_of_inputs * m_number_of_partitions * m_complex_size];
+        m_spectra_imag          = new float[m_number_of_inputs * m_number_of_partitions * m_complex_size];
+        clear();
+    }
+    
+    void Convolver::clear()
+    {
+        m_position  = 0;
+        m_current   = 0;
+        for(unsigned int i = 0; i < m_number_of_inputs * m_partition_size * 2; i++)
+            m_histories[i] = 0.f;
+        for(unsigned int i = 0; i < m_number_of_outputs * m_partition_size; i++)
+            m_tails[i] = m_overlaps[i] = 0.f;
+        for(unsigned int i = 0; i < m_number_of_inputs * m_number_of_partitions * m_complex_size; i++)
+            m_spectra_real[i] = m_spectra_imag[i] = 0.f;
+    }
+    
+    void Convolver::transformInputs(const float* const* inputs)
+    {
+        const unsigned int size = m_partition_size;
+        for(unsigned int i = 0; i < m_number_of_inputs; i++)
+        {
+            for(unsigned int k = 0; k < size; k++)
+            {
+                m_fft_buffer[k] = inputs[i][k];
+                m_fft_buffer[k + size] = 0.f;
+            }
+            const unsigned int offset = (i * m_number_of_partitions + m_current) * m_complex_size;
+            m_fft.fft(m_fft_buffer, m_spectra_real + offset, m_spectra_imag + offset);
+        }
+    }
+    
+    void Convolver::transformInputs(const double* const* inputs)
+    {
+        const unsigned int size = m_partition_size;
+        for(unsigned int i = 0; i < m_number_of_inputs; i++)
+        {
+            for(unsigned int k = 0; k < size; k++)
+            {
+                m_fft_buffer[k] = inputs[i][k];
+                m_fft_buffer[k + size] = 0.f;
+            }
+            const unsigned int offset = (i * m_number_of_partitions + m_current) * m_complex_size;
+            m_fft.fft(m_fft_buffer, m_spectra_real + offset, m_spectra_imag + offset);
+        }
+    }
+    
+    void Convolver::accumulate(const unsigned int output, const unsigned int first, const unsigned int last)
+    {
+        for(unsigned int k = 0; k < m_complex_size; k++)
+            m_accumulator_real[k] = m_accumulator_imag[k] = 0.f;
+        for(unsigned int j = 0; j < m_number_of_inputs; j++)
+        {
+            for(unsigned int p = first; p < last; p++)
+            {
+                const unsigned int index = (m_current + p - first) % m_number_of_partitions;
+                const float* spectrum_real  = m_spectra_real + (j * m_number_of_partitions + index) * m_complex_size;
+                const float* spectrum_imag  = m_spectra_imag + (j * m_number_of_partitions + index) * m_complex_size;
+                const float* impulse_real   = m_impulses_real + ((output * m_number_of_inputs + j) * m_number_of_partitions + p) * m_complex_size;
+                const float* impulse_imag   = m_impulses_imag + ((output * m_number_of_inputs + j) * m_number_of_partitions + p) * m_complex_size;
+                for(unsigned int k = 0; k < m_complex_size; k++)
+                {
+                    m_accumulator_real[k] += spectrum_real[k] * impulse_real[k] - spectrum_imag[k] * impulse_imag[k];
+                    m_accumulator_imag[k] += spectrum_real[k] * impulse_imag[k] + spectrum_imag[k] * impulse_real[k];
+                }
+            }
+        }
+        m_fft.ifft(m_fft_buffer, m_accumulator_real, m_accumulator_imag);
+    }
+    
+    void Convolver::processPartition(const bool transformed)
+    {
+        const unsigned int size = m_partition_size;
+        m_position = 0;
+        if(!transformed)
+        {
+            for(unsigned int i = 0; i < m_number_of_inputs; i++)
+                m_inputs_vectors[i] = m_histories + i * size * 2 + size;
+            transformInputs(m_inputs_vectors);
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+            {
+                accumulate(i, 0, 1);
+                float* tail = m_tails + i * size;
+                for(unsigned int k = 0; k < size; k++)
+                    tail[k] = m_fft_buffer[k + size];
+            }
+        }
+        
+        if(m_number_of_partitions > 1)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+            {
+                accumulate(i, 1, m_number_of_partitions);
+                float* tail     = m_tails + i * size;
+                float* overlap  = m_overlaps + i * size;
+                for(unsigned int k = 0; k < size; k++)
+                {
+                    tail[k]    += m_fft_buffer[k] + overlap[k];
+                    overlap[k]  = m_fft_buffer[k + size];
+                }
+            }
+        }
+        m_current = m_current ? (m_current - 1) : (m_number_of_partitions - 1);
+    }
+    
+    void Convolver::process(const float* inputs, float* outputs)
+    {
+        const unsigned int size = m_partition_size;
+        if(!m_heads)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                outputs[i] = 0.f;
+            return;
+        }
+        
+        for(unsigned int i = 0; i < m_number_of_inputs; i++)
+            m_histories[i * size * 2 + size + m_position] = inputs[i];
+        
+        for(unsigned int i = 0; i < m_number_of_outputs; i++)
+        {
+            float sum = m_tails[i * size + m_position];
+            for(unsigned int j = 0; j < m_number_of_inputs; j++)
+            {
+                const float* head       = m_heads + (i * m_number_of_inputs + j) * size;
+                const float* history    = m_histories + j * size * 2 + m_position + 1;
+                for(unsigned int k = size - 1 - m_position; k < size; k++)
+                    sum += head[k] * history[k];
+            }
+            outputs[i] = sum;
+        }
+        
+        if(++m_position == size)
+            processPartition(false);
+    }
+    
+    void Convolver::process(const double* inputs, double* outputs)
+    {
+        const unsigned int size = m_partition_size;
+        if(!m_heads)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                outputs[i] = 0.;
+            return;
+        }
+        
+        for(unsigned int i = 0; i < m_number_of_inputs; i++)
+            m_histories[i * size * 2 + size + m_position] = inputs[i];
+        
+        for(unsigned int i = 0; i < m_number_of_outputs; i++)
+        {
+            double sum = m_tails[i * size + m_position];
+            for(unsigned int j = 0; j < m_number_of_inputs; j++)
+            {
+                const float* head       = m_heads + (i * m_number_of_inputs + j) * size;
+                const float* history    = m_histories + j * size * 2 + m_position + 1;
+                for(unsigned int k = size - 1 - m_position; k < size; k++)
+                    sum += head[k] * history[k];
+            }
+            outputs[i] = sum;
+        }
+        
+        if(++m_position == size)
+            processPartition(false);
+    }
+    
+    void Convolver::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        const unsigned int size = m_partition_size;
+        if(!m_heads)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+            {
+                for(unsigned int k = 0; k < vectorSize; k++)
+                    outputs[i][k] = 0.f;
+            }
+            return;
+        }
+        
+        for(unsigned int offset = 0; offset < vectorSize;)
+        {
+            const unsigned int count = (vectorSize - offset) < (size - m_position) ? (vectorSize - offset) : (size - m_position);
+            if(count == size)
+            {
+                for(unsigned int i = 0; i < m_number_of_inputs; i++)
+                    m_inputs_vectors[i] = inputs[i] + offset;
+                transformInputs(m_inputs_vectors);
+                for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                {
+                    accumulate(i, 0, 1);
+                    float* output   = outputs[i] + offset;
+                    float* tail     = m_tails + i * size;
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        output[k]   = tail[k] + m_fft_buffer[k];
+                        tail[k]     = m_fft_buffer[k + size];
+                    }
+                }
+                offset += count;
+                processPartition(true);
+                continue;
+            }
+            
+            for(unsigned int i = 0; i < m_number_of_inputs; i++)
+            {
+                const float* input  = inputs[i] + offset;
+                float* history      = m_histories + i * size * 2 + size + m_position;
+                for(unsigned int k = 0; k < count; k++)
+                    history[k] = input[k];
+            }
+            
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+            {
+                float* output       = outputs[i] + offset;
+                const float* tail   = m_tails + i * size + m_position;
+                for(unsigned int k = 0; k < count; k++)
+                    output[k] = tail[k];
+                for(unsigned int j = 0; j < m_number_of_inputs; j++)
+                {
+                    const float* head       = m_heads + (i * m_number_of_inputs + j) * size;
+                    const float* history    = m_histories + j * size * 2 + m_position + 1;
+                    for(unsigned int t = size - m_position - count; t < size; t++)
+                    {
+                        const float coef = head[t];
+                        const unsigned int first = (t + m_position + 1 < size) ? (size - t - m_position - 1) : 0;
+                        for(unsigned int k = first; k < count; k++)
+                            output[k] += coef * history[k + t];
+                    }
+                }
+            }
+            
+            offset      += count;
+            m_position  += count;
+            if(m_position == size)
+                processPartition(false);
+        }
+    }
+    
+    void Convolver::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        const unsigned int size = m_partition_size;
+        if(!m_heads)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+            {
+                for(unsigned int k = 0; k < vectorSize; k++)
+                    outputs[i][k] = 0.;
+            }
+            return;
+        }
+        
+        for(unsigned int offset = 0; offset < vectorSize;)
+        {
+            const unsigned int count = (vectorSize - offset) < (size - m_position) ? (vectorSize - offset) : (size - m_position);
+            if(count == size)
+            {
+                for(unsigned int i = 0; i < m_number_of_inputs; i++)
+                    m_inputs_vectors_double[i] = inputs[i] + offset;
+                transformInputs(m_inputs_vectors_double);
+                for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                {
+                    accumulate(i, 0, 1);
+                    double* output  = outputs[i] + offset;
+                    float* tail     = m_tails + i * size;
+                    for(unsigned int k = 0; k < size; k++)
+                    {
+                        output[k]   = tail[k] + m_fft_buffer[k];
+                        tail[k]     = m_fft_buffer[k + size];
+                    }
+                }
+                offset += count;
+                processPartition(true);
+                continue;
+            }
+            
+            for(unsigned int i = 0; i < m_number_of_inputs; i++)
+            {
+                const double* input = inputs[i] + offset;
+                float* history      = m_histories + i * size * 2 + size + m_position;
+                for(unsigned int k = 0; k < count; k++)
+                    history[k] = input[k];
+            }
+            
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+            {
+                double* output      = outputs[i] + offset;
+                const float* tail   = m_tails + i * size + m_position;
+                for(unsigned int k = 0; k < count; k++)
+                    output[k] = tail[k];
+                for(unsigned int j = 0; j < m_number_of_inputs; j++)
+                {
+                    const float* head       = m_heads + (i * m_number_of_inputs + j) * size;
+                    const float* history    = m_histories + j * size * 2 + m_position + 1;
+                    for(unsigned int t = size - m_position - count; t < size; t++)
+                    {
+                        const double coef = head[t];
+                        const unsigned int first = (t + m_position + 1 < size) ? (size - t - m_position - 1) : 0;
+                        for(unsigned int k = first; k < count; k++)
+                            output[k] += coef * history[k + t];
+                    }
+                }
+            }
+            
+            offset      += count;
+            m_position  += count;
+            if(m_position == size)
+                processPartition(false);
+        }
+    }
+    
+    Convolver::~Convolver()
+    {
+        freeImpulses();
+        delete [] m_histories;
+        delete [] m_tails;
+        delete [] m_overlaps;
+        delete [] m_fft_buffer;
+        delete [] m_accumulator_real;
+        delete [] m_accumulator_imag;
+        delete [] m_inputs_vectors;
+        delete [] m_inputs_vectors_double;
+    }
+}
+
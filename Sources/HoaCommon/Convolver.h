@@ -0,0 +1,225 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_CONVOLVER__
+#define __DEF_HOA_CONVOLVER__
+
+#include "../Hoa.h"
+#include "../../ThirdParty/AudioFFT/AudioFFT.h"
+
+namespace Hoa
+{
+    //! The multichannel convolver.
+    /** The convolver filters several inputs with a matrix of impulse responses and sums the results on several outputs, each output is the sum of all the inputs convolved with their own impulse responses. The impulse responses are uniformly partitioned and convolved in the frequency domain : each input is transformed only once whatever the number of outputs and each output is transformed back only once whatever the number of inputs. When a whole partition of the inputs is available, the block is entirely convolved in the frequency domain, otherwise the part of the first partition of the impulse responses that falls in the current partition is convolved directly in the time domain so the convolution never adds any latency and can be performed sample by sample.
+     */
+    class Convolver
+    {
+    private:
+        
+        unsigned int        m_number_of_inputs;
+        unsigned int        m_number_of_outputs;
+        unsigned int        m_partition_size;
+        unsigned int        m_number_of_partitions;
+        unsigned int        m_complex_size;
+        unsigned int        m_position;
+        unsigned int        m_current;
+        audiofft::AudioFFT  m_fft;
+        bool                m_owner;
+        const float*        m_heads;
+        const float*        m_impulses_real;
+        const float*        m_impulses_imag;
+        float*              m_spectra_real;
+        float*              m_spectra_imag;
+        float*              m_histories;
+        float*              m_tails;
+        float*              m_overlaps;
+        float*              m_fft_buffer;
+        float*              m_accumulator_real;
+        float*              m_accumulator_imag;
+        const float**       m_inputs_vectors;
+        const double**      m_inputs_vectors_double;
+        
+        //! Free the impulses and the states.
+        void freeImpulses();
+        
+        //! Transform a partition of the inputs.
+        /**	Transform a whole partition of each input in the current slot of the spectra of the inputs.
+         
+            @param     inputs	The input vectors, each vector must contain at least the size of the partitions samples.
+         */
+        void transformInputs(const float* const* inputs);
+        
+        //! Transform a partition of the inputs.
+        /**	Transform a whole partition of each input in the current slot of the spectra of the inputs.
+         
+            @param     inputs	The input vectors, each vector must contain at least the size of the partitions samples.
+         */
+        void transformInputs(const double* const* inputs);
+        
+        //! Accumulate the spectra of an output and transform it back.
+        /**	Accumulate the products of the spectra of the inputs with the spectra of a range of partitions of the impulse responses of an output, the most recent input spectrum is multiplied by the first partition of the range. The result is transformed back in the FFT buffer.
+         
+            @param     output	The index of the output.
+            @param     first	The first partition of the range.
+            @param     last     The partition after the last partition of the range.
+         */
+        void accumulate(const unsigned int output, const unsigned int first, const unsigned int last);
+        
+        //! Compute the FFT convolution at the end of a partition.
+        /**	Transform the last partition of the inputs if it isn't already transformed, prepare the tails of the outputs for the next partition and move the slot of the spectra of the inputs.
+         
+            @param     transformed	If the partition of the inputs and the end of the first partition of the impulse responses are already computed.
+         */
+        void processPartition(const bool transformed);
+        
+        Convolver(const Convolver& other);
+        Convolver& operator=(const Convolver& other);
+    
+    public:
+        
+        //! The convolver constructor.
+        /**	The convolver constructor allocates and initialize the FFT depending of the number of inputs, the number of outputs and the size of the partitions. The size of the partitions must be a power of 2, the vectors whose size is a multiple of the size of the partitions are convolved in the frequency domain only.
+         
+            @param     numberOfInputs       The number of inputs.
+            @param     numberOfOutputs      The number of outputs.
+            @param     partitionSize        The size of the partitions.
+         */
+        Convolver(unsigned int numberOfInputs, unsigned int numberOfOutputs, unsigned int partitionSize);
+        
+        //! The convolver destructor.
+        /**	The convolver destructor free the memory.
+         */
+        ~Convolver();
+        
+        //! Set the impulse responses.
+        /**	Set the impulse responses and clear the states of the convolver. The impulses array contains one impulse response for each output and each input, the impulse response of an input for an output is at the index output * number of inputs + input and can be NULL. The impulse responses are partitioned and transformed, so you should not call this method in the audio thread.
+         
+            @param     impulses     The impulse responses.
+            @param     size         The size of the impulse responses.
+         */
+        void setImpulses(const float* const* impulses, const unsigned int size);
+        
+        //! Set the transformed impulse responses.
+        /**	Set the impulse responses already partitioned and transformed by another convolver with the same number of inputs, the same number of outputs and the same size of partitions, and clear the states of the convolver. The convolver doesn't copy the impulse responses, so the arrays must remain valid until other impulse responses are set or the convolver is deleted. It allows to share read-only impulse responses, like a mapped file, between several convolvers.
+         
+            @param     heads                The reversed first partitions of the impulse responses.
+            @param     real                 The real parts of the spectra of the partitions.
+            @param     imag                 The imaginary parts of the spectra of the partitions.
+            @param     numberOfPartitions   The number of partitions.
+         
+            @see    getHeads
+            @see    getImpulsesReal
+            @see    getImpulsesImag
+         */
+        void setImpulses(const float* heads, const float* real, const float* imag, const unsigned int numberOfPartitions);
+        
+        //! Clear the states of the convolver.
+        /**	Clear the histories of the inputs and the tails of the outputs.
+         */
+        void clear();
+        
+        /**	Retrieve the number of inputs.
+         */
+        inline unsigned int getNumberOfInputs() const
+        {
+            return m_number_of_inputs;
+        };
+        
+        /**	Retrieve the number of outputs.
+         */
+        inline unsigned int getNumberOfOutputs() const
+        {
+            return m_number_of_outputs;
+        };
+        
+        /**	Retrieve the size of the partitions.
+         */
+        inline unsigned int getPartitionSize() const
+        {
+            return m_partition_size;
+        };
+        
+        /**	Retrieve the number of partitions of the impulse responses.
+         */
+        inline unsigned int getNumberOfPartitions() const
+        {
+            return m_number_of_partitions;
+        };
+        
+        /**	Retrieve the size of the spectra of the partitions.
+         */
+        inline unsigned int getComplexSize() const
+        {
+            return m_complex_size;
+        };
+        
+        /**	Retrieve the reversed first partitions of the impulse responses, the array contains the size of the partitions samples for each output and each input.
+         */
+        inline const float* getHeads() const
+        {
+            return m_heads;
+        };
+        
+        /**	Retrieve the real parts of the spectra of the partitions, the array contains the number of partitions spectra for each output and each input.
+         */
+        inline const float* getImpulsesReal() const
+        {
+            return m_impulses_real;
+        };
+        
+        /**	Retrieve the imaginary parts of the spectra of the partitions, the array contains the number of partitions spectra for each output and each input.
+         */
+        inline const float* getImpulsesImag() const
+        {
+            return m_impulses_imag;
+        };
+        
+        /**	Retrieve if the impulse responses are set.
+         */
+        inline bool getState() const
+        {
+            return m_heads != NULL;
+        };
+        
+        //! This method performs the convolution with single precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the convolution sample by sample. The inputs array contains the samples of the inputs and the outputs array contains the samples of the outputs.
+         
+            @param     inputs   The inputs array.
+            @param     outputs  The outputs array.
+         */
+        void process(const float* inputs, float* outputs);
+        
+        //! This method performs the convolution with double precision.
+        /**	You should use this method for in-place or not-in-place processing and performs the convolution sample by sample. The inputs array contains the samples of the inputs and the outputs array contains the samples of the outputs.
+         
+            @param     inputs   The inputs array.
+            @param     outputs  The outputs array.
+         */
+        void process(const double* inputs, double* outputs);
+        
+        //! This method performs the convolution with single precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the convolution on a whole vector of samples. The inputs array contains one vector for each input and the outputs array contains one vector for each output. Each vector must contain at least the vector size samples, the size of the vector doesn't need to be related to the size of the partitions.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        //! This method performs the convolution with double precision on a block of samples.
+        /**	You should use this method for in-place or not-in-place processing and performs the convolution on a whole vector of samples. The inputs array contains one vector for each input and the outputs array contains one vector for each output. Each vector must contain at least the vector size samples, the size of the vector doesn't need to be related to the size of the partitions.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+    };
+}
+
+#endif
+
+
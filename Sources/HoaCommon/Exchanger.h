@@ -0,0 +1,194 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_EXCHANGER__
+#define __DEF_HOA_EXCHANGER__
+
+#include "Queue.h"
+
+namespace Hoa
+{
+    //! The coefficients.
+    /** The coefficients store an array of coefficients with double and single precision, like a decoding matrix or the weights of an optimization, so they can be computed once and published together.
+     */
+    class Coefficients
+    {
+    private:
+        
+        unsigned int    m_size;
+        double*         m_values_double;
+        float*          m_values_float;
+        
+        Coefficients(const Coefficients& other);
+        Coefficients& operator=(const Coefficients& other);
+    
+    public:
+        
+        //! The coefficients constructor.
+        /**	The coefficients constructor allocates the coefficients and initializes them to zero.
+         
+            @param     size	The number of coefficients.
+         */
+        Coefficients(unsigned int size)
+        {
+            m_size          = size;
+            m_values_double = new double[m_size];
+            m_values_float  = new float[m_size];
+            for(unsigned int i = 0; i < m_size; i++)
+            {
+                m_values_double[i]  = 0.;
+                m_values_float[i]   = 0.f;
+            }
+        };
+        
+        //! The coefficients destructor.
+        /**	The coefficients destructor free the memory.
+         */
+        ~Coefficients()
+        {
+            delete [] m_values_double;
+            delete [] m_values_float;
+        };
+        
+        /**	Retrieve the number of coefficients.
+         */
+        inline unsigned int getSize() const
+        {
+            return m_size;
+        };
+        
+        /**	Retrieve the coefficients with double precision.
+         */
+        inline double* getDouble() const
+        {
+            return m_values_double;
+        };
+        
+        /**	Retrieve the coefficients with single precision.
+         */
+        inline float* getFloat() const
+        {
+            return m_values_float;
+        };
+        
+        //! Copy the double precision coefficients in the single precision coefficients.
+        inline void update()
+        {
+            for(unsigned int i = 0; i < m_size; i++)
+                m_values_float[i] = m_values_double[i];
+        };
+    };
+    
+    //! The exchanger.
+    /** The exchanger publishes the objects built by the control thread to the audio thread without lock. The control thread builds a new object off the audio thread and publishes it with an atomic pointer swap, the audio thread acquires the last published object at the beginning of its process and gives back the replaced object with a single producer single consumer queue, so the audio thread never allocates or frees memory. The replaced objects are deleted by the control thread the next time it publishes or collects. Only one thread can publish and collect and only one other thread can acquire.
+     */
+    template <typename T> class Exchanger
+    {
+    private:
+        
+        T*          m_current;
+        T*          m_pending;
+        T*          m_latest;
+        Queue<T*>   m_garbage;
+        
+        Exchanger(const Exchanger& other);
+        Exchanger& operator=(const Exchanger& other);
+    
+    public:
+        
+        //! The exchanger constructor.
+        /**	The exchanger constructor takes the ownership of the initial object.
+         
+            @param     value	The initial object.
+            @param     capacity	The number of replaced objects that can wait to be deleted.
+         */
+        Exchanger(T* value, unsigned int capacity = 16) : m_garbage(capacity)
+        {
+            m_current   = value;
+            m_latest    = value;
+            m_pending   = NULL;
+        };
+        
+        //! The exchanger destructor.
+        /**	The exchanger destructor deletes all the objects, the audio thread must not acquire anymore.
+         */
+        ~Exchanger()
+        {
+            collect();
+            if(m_pending)
+                delete m_pending;
+            delete m_current;
+        };
+        
+        //! Publish an object.
+        /**	Publish an object that the audio thread will acquire. If the previous published object hasn't been acquired, it is deleted. This method must only be called by the control thread.
+         
+            @param     value	The new object.
+         */
+        void publish(T* value)
+        {
+            collect();
+            T* previous = atomic_exchange(&m_pending, value);
+            if(previous)
+                delete previous;
+            m_latest = value;
+        };
+        
+        //! Delete the replaced objects.
+        /**	Delete the objects that the audio thread replaced, this method must only be called by the control thread.
+         */
+        void collect()
+        {
+            T* value;
+            while(m_garbage.pop(value))
+                delete value;
+        };
+        
+        /**	Retrieve the last published object, this method must only be called by the control thread.
+         */
+        inline T* getLatest() const
+        {
+            return m_latest;
+        };
+        
+        //! Acquire the last published object.
+        /**	Acquire the last published object and give back the replaced one. If the control thread hasn't collected the replaced objects and the queue is full, the current object is kept until the next call. This method must only be called by the audio thread.
+         
+            @return    The current object.
+         */
+        inline T* acquire()
+        {
+            bool changed;
+            return acquire(changed);
+        };
+        
+        //! Acquire the last published object and retrieve if it has changed.
+        /**	Acquire the last published object like the other acquire method and retrieve if it replaced the current object, so the audio thread can react to the change. The replaced object can't be used anymore because the control thread can delete it. This method must only be called by the audio thread.
+         
+            @param     changed  True if the current object has been replaced.
+            @return    The current object.
+         */
+        inline T* acquire(bool& changed)
+        {
+            changed = false;
+            if(atomic_load(&m_pending) && !m_garbage.isFull())
+            {
+                T* value = atomic_exchange(&m_pending, (T*)NULL);
+                if(value)
+                {
+                    m_garbage.push(m_current);
+                    m_current = value;
+                    changed = true;
+                }
+            }
+            return m_current;
+        };
+    };
+}
+
+#endif
+
+
@@ -20,6 +20,14 @@ namespace HoaCommon{};
 #include "Source.h"
 #include "SourcesGroup.h"
 #include "SourcesManager.h"
+#include "Convolver.h"
+#include "HrirSet.h"
+#include "BinauralCache.h"
+#include "MatrixCache.h"
+#include "Queue.h"
+#include "Exchanger.h"
+#include "TripleBuffer.h"
+#include "MatrixInterpolator.h"
 
 #endif
 
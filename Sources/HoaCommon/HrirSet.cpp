@@ -0,0 +1,215 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "HrirSet.h"
+#include <string.h>
+#include <new>
+
+#define HOA_HRIR_SINC_ZEROS         16
+#define HOA_HRIR_MAX_DIRECTIONS     65536
+#define HOA_HRIR_MAX_SIZE           65536
+#define HOA_HRIR_MAX_SAMPLE_RATE    1536000
+
+namespace Hoa
+{
+    static uint32_t read_uint32(const unsigned char* data)
+    {
+        return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    }
+    
+    static float read_float(const unsigned char* data)
+    {
+        const uint32_t bits = read_uint32(data);
+        float value;
+        memcpy(&value, &bits, sizeof(float));
+        return value;
+    }
+    
+    HrirSet::HrirSet()
+    {
+        m_number_of_directions  = 0;
+        m_size                  = 0;
+        m_sample_rate           = 0.;
+        m_hash                  = 0;
+        m_azimuths              = NULL;
+        m_elevations            = NULL;
+        m_impulses              = NULL;
+        m_data                  = NULL;
+    }
+    
+    void HrirSet::release()
+    {
+        if(m_azimuths)
+            delete [] m_azimuths;
+        if(m_elevations)
+            delete [] m_elevations;
+        if(m_impulses)
+            delete [] m_impulses;
+        if(m_data)
+            delete [] m_data;
+        m_azimuths              = NULL;
+        m_elevations            = NULL;
+        m_impulses              = NULL;
+        m_data                  = NULL;
+    }
+    
+    bool HrirSet::read(const std::string& path)
+    {
+        release();
+        m_number_of_directions  = 0;
+        m_size                  = 0;
+        m_sample_rate           = 0.;
+        m_hash                  = 0;
+        
+        FILE* file = fopen(path.c_str(), "rb");
+        if(!file)
+            return false;
+        unsigned char header[24];
+        if(fread(header, 1, 24, file) != 24 || memcmp(header, "HOAHRIR1", 8) != 0)
+        {
+            fclose(file);
+            return false;
+        }
+        const uint32_t number_of_directions = read_uint32(header + 8);
+        const uint32_t size                 = read_uint32(header + 12);
+        const uint32_t sample_rate          = read_uint32(header + 16);
+        if(!number_of_directions || number_of_directions > HOA_HRIR_MAX_DIRECTIONS || !size || size > HOA_HRIR_MAX_SIZE || !sample_rate || sample_rate > HOA_HRIR_MAX_SAMPLE_RATE)
+        {
+            fclose(file);
+            return false;
+        }
+        
+        // The counts are bounded so the size of the file can't overflow, but it can exceed the memory of the machine
+        const uint64_t record   = ((uint64_t)size * 2 + 2) * 4;
+        const uint64_t total    = 24 + record * number_of_directions;
+        unsigned char* data     = total <= (uint64_t)((size_t)-1) ? new (std::nothrow) unsigned char[(size_t)total] : NULL;
+        if(!data)
+        {
+            fclose(file);
+            return false;
+        }
+        memcpy(data, header, 24);
+        const bool valid = fread(data + 24, 1, (size_t)(total - 24), file) == (size_t)(total - 24) && fgetc(file) == EOF;
+        fclose(file);
+        if(!valid)
+        {
+            delete [] data;
+            return false;
+        }
+        
+        m_number_of_directions  = number_of_directions;
+        m_size                  = size;
+        m_sample_rate           = sample_rate;
+        m_data                  = data;
+        m_hash                  = 14695981039346656037ULL;
+        for(size_t i = 0; i < (size_t)total; i++)
+        {
+            m_hash ^= data[i];
+            m_hash *= 1099511628211ULL;
+        }
+        return true;
+    }
+    
+    bool HrirSet::decode()
+    {
+        if(m_impulses)
+            return true;
+        if(!m_data)
+            return false;
+        
+        // The file contains all the values, so their number fits in a size_t
+        const size_t length = (size_t)m_size * 2;
+        const size_t record = (length + 2) * 4;
+        m_azimuths      = new (std::nothrow) float[m_number_of_directions];
+        m_elevations    = new (std::nothrow) float[m_number_of_directions];
+        m_impulses      = new (std::nothrow) float[(size_t)m_number_of_directions * length];
+        if(!m_azimuths || !m_elevations || !m_impulses)
+        {
+            release();
+            m_number_of_directions  = 0;
+            m_size                  = 0;
+            return false;
+        }
+        for(size_t i = 0; i < m_number_of_directions; i++)
+        {
+            const unsigned char* values = m_data + 24 + record * i;
+            float* impulses = m_impulses + i * length;
+            m_azimuths[i]   = read_float(values);
+            m_elevations[i] = read_float(values + 4);
+            for(size_t j = 0; j < length; j++)
+                impulses[j] = read_float(values + 8 + j * 4);
+        }
+        delete [] m_data;
+        m_data = NULL;
+        return true;
+    }
+    
+    unsigned int HrirSet::getClosestDirection(const double azimuth, const double elevation) const
+    {
+        assert(m_azimuths && m_number_of_directions > 0);
+        const double x = cos(elevation) * cos(azimuth);
+        const double y = cos(elevation) * sin(azimuth);
+        const double z = sin(elevation);
+        unsigned int index = 0;
+        double closest = -2.;
+        for(unsigned int i = 0; i < m_number_of_directions; i++)
+        {
+            const double product = cos(m_elevations[i]) * cos(m_azimuths[i]) * x + cos(m_elevations[i]) * sin(m_azimuths[i]) * y + sin(m_elevations[i]) * z;
+            if(product > closest)
+            {
+                closest = product;
+                index = i;
+            }
+        }
+        return index;
+    }
+    
+    unsigned int HrirSet::getSize(const double sampleRate) const
+    {
+        if(!m_size || sampleRate == m_sample_rate)
+            return m_size;
+        return (unsigned int)ceil((double)m_size * sampleRate / m_sample_rate);
+    }
+    
+    void HrirSet::getImpulse(const unsigned int index, const bool right, const double sampleRate, float* impulse) const
+    {
+        assert(m_impulses && index < m_number_of_directions);
+        const float* input = m_impulses + ((size_t)index * 2 + (right ? 1 : 0)) * m_size;
+        const unsigned int size = getSize(sampleRate);
+        if(sampleRate == m_sample_rate)
+        {
+            memcpy(impulse, input, m_size * sizeof(float));
+            return;
+        }
+        
+        const double ratio  = m_sample_rate / sampleRate;
+        const double cutoff = ratio > 1. ? 1. / ratio : 1.;
+        const double width  = HOA_HRIR_SINC_ZEROS / cutoff;
+        for(unsigned int i = 0; i < size; i++)
+        {
+            const double time   = i * ratio;
+            const long start    = (long)ceil(time - width);
+            const long end      = (long)floor(time + width);
+            double sum = 0.;
+            for(long j = start > 0 ? start : 0; j <= end && j < (long)m_size; j++)
+            {
+                const double distance   = time - j;
+                const double window     = 0.5 + 0.5 * cos(HOA_PI * distance / width);
+                const double argument   = HOA_PI * distance * cutoff;
+                const double sinc       = fabs(argument) < 1e-9 ? 1. : sin(argument) / argument;
+                sum += input[j] * cutoff * sinc * window;
+            }
+            impulse[i] = sum;
+        }
+    }
+    
+    HrirSet::~HrirSet()
+    {
+        release();
+    }
+}
+
+
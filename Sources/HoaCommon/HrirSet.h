@@ -0,0 +1,137 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_HRIR_SET__
+#define __DEF_HOA_HRIR_SET__
+
+#include "../Hoa.h"
+
+namespace Hoa
+{
+    //! The set of head related impulse responses.
+    /** The set reads the head related impulse responses of several directions from a binary file. The file starts with a header of 24 bytes : the 8 characters "HOAHRIR1", the number of directions, the size of the impulse responses, the sample rate and a reserved value as unsigned 32 bits integers. Then, for each direction, the file contains the azimuth and the elevation in radian, the impulse response of the left ear and the impulse response of the right ear as 32 bits floats. All the values are little endian. The azimuth and the elevation follow the conventions of the library : the azimuth 0 is at the front and rotates counterclockwise, the elevation 0 is on the horizontal plane and Pi/2 is at the top.
+     */
+    class HrirSet
+    {
+    private:
+        
+        unsigned int        m_number_of_directions;
+        unsigned int        m_size;
+        double              m_sample_rate;
+        uint64_t            m_hash;
+        float*              m_azimuths;
+        float*              m_elevations;
+        float*              m_impulses;
+        unsigned char*      m_data;
+        
+        //! Free the content of the file and the impulse responses.
+        void release();
+        
+        HrirSet(const HrirSet& other);
+        HrirSet& operator=(const HrirSet& other);
+    
+    public:
+        
+        //! The set constructor.
+        /**	The set constructor initializes an empty set.
+         */
+        HrirSet();
+        
+        //! The set destructor.
+        /**	The set destructor free the memory.
+         */
+        ~HrirSet();
+        
+        //! Read a file.
+        /**	Read the content of a file, check its header and its size and compute the hash of the content. The impulse responses aren't converted until the set is decoded, so a decoder that finds its filters in a cache only reads and hashes the file. The number of directions and the size of the impulse responses are limited to 65536. If the file can't be read or isn't valid, the set is empty.
+         
+            @param     path     The path of the file.
+            @return    True if the file has been read.
+         
+            @see    decode
+         */
+        bool read(const std::string& path);
+        
+        //! Decode the file.
+        /**	Convert the directions and the impulse responses of the file that has been read and free the content of the file. The set must be decoded before retrieving the directions or the impulse responses.
+         
+            @return    True if the set is decoded.
+         */
+        bool decode();
+        
+        /**	Retrieve the number of directions.
+         */
+        inline unsigned int getNumberOfDirections() const
+        {
+            return m_number_of_directions;
+        };
+        
+        /**	Retrieve the sample rate of the impulse responses.
+         */
+        inline double getSampleRate() const
+        {
+            return m_sample_rate;
+        };
+        
+        /**	Retrieve the hash of the content of the file.
+         */
+        inline uint64_t getHash() const
+        {
+            return m_hash;
+        };
+        
+        /**	Retrieve the azimuth of a direction.
+         
+            @param     index	The index of the direction.
+         */
+        inline double getAzimuth(const unsigned int index) const
+        {
+            assert(m_azimuths && index < m_number_of_directions);
+            return m_azimuths[index];
+        };
+        
+        /**	Retrieve the elevation of a direction.
+         
+            @param     index	The index of the direction.
+         */
+        inline double getElevation(const unsigned int index) const
+        {
+            assert(m_elevations && index < m_number_of_directions);
+            return m_elevations[index];
+        };
+        
+        //! Retrieve the closest direction.
+        /**	Retrieve the index of the direction of the set that is the closest to an azimuth and an elevation.
+         
+            @param     azimuth      The azimuth in radian.
+            @param     elevation    The elevation in radian.
+            @return    The index of the closest direction.
+         */
+        unsigned int getClosestDirection(const double azimuth, const double elevation) const;
+        
+        //! Retrieve the size of the impulse responses at a sample rate.
+        /**	Retrieve the size of the impulse responses once they are resampled to a sample rate.
+         
+            @param     sampleRate   The sample rate.
+            @return    The size of the impulse responses.
+         */
+        unsigned int getSize(const double sampleRate) const;
+        
+        //! Retrieve an impulse response at a sample rate.
+        /**	Retrieve the impulse response of an ear for a direction, resampled to a sample rate with a windowed sinc interpolation if the sample rate differs from the one of the file.
+         
+            @param     index        The index of the direction.
+            @param     right        False for the left ear and true for the right ear.
+            @param     sampleRate   The sample rate.
+            @param     impulse      The impulse response array, its minimum size must be the size of the impulse responses at the sample rate.
+         */
+        void getImpulse(const unsigned int index, const bool right, const double sampleRate, float* impulse) const;
+    };
+}
+
+#endif
+
+
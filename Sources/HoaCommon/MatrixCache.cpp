@@ -0,0 +1,94 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "MatrixCache.h"
+
+// Bump the version whenever a design changes its output, the matrices cached by the previous versions are then recomputed
+#define HOA_MATRIX_CACHE_VERSION 2
+
+namespace Hoa
+{
+    //! The header of a cache file.
+    struct MatrixCacheHeader
+    {
+        char            magic[8];
+        uint64_t        hash;
+        uint32_t        version;
+        uint32_t        dimension;
+        uint32_t        order;
+        uint32_t        numberOfChannels;
+        uint32_t        mode;
+        uint32_t        size;
+    };
+    
+    uint64_t MatrixCache::getHash(const double* values, const unsigned int size, uint64_t hash)
+    {
+        const unsigned char* data = (const unsigned char *)values;
+        for(size_t i = 0; i < size * sizeof(double); i++)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+    
+    std::string MatrixCache::getPath(const std::string& directory, const Key& key)
+    {
+        char name[128];
+        sprintf(name, "hoa-%016llx-%ud-%u-%u-%u.matrix", (unsigned long long)key.hash, key.dimension, key.order, key.numberOfChannels, key.mode);
+        if(directory.empty())
+            return name;
+        const char last = directory[directory.size() - 1];
+        if(last == '/' || last == '\\')
+            return directory + name;
+        return directory + "/" + name;
+    }
+    
+    bool MatrixCache::write(const std::string& path, const Key& key, const double* matrix, const unsigned int size)
+    {
+        MatrixCacheHeader header;
+        memset(&header, 0, sizeof(MatrixCacheHeader));
+        memcpy(header.magic, "HOAMATRX", 8);
+        header.hash             = key.hash;
+        header.version          = HOA_MATRIX_CACHE_VERSION;
+        header.dimension        = key.dimension;
+        header.order            = key.order;
+        header.numberOfChannels = key.numberOfChannels;
+        header.mode             = key.mode;
+        header.size             = size;
+        
+        const std::string temporary = path + ".tmp";
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if(!file)
+            return false;
+        bool valid = fwrite(&header, sizeof(MatrixCacheHeader), 1, file) == 1;
+        valid = valid && fwrite(matrix, sizeof(double), size, file) == size;
+        valid = (fclose(file) == 0) && valid;
+        if(valid)
+        {
+#ifdef _WINDOWS
+            remove(path.c_str());
+#endif
+            valid = rename(temporary.c_str(), path.c_str()) == 0;
+        }
+        if(!valid)
+            remove(temporary.c_str());
+        return valid;
+    }
+    
+    bool MatrixCache::read(const std::string& path, const Key& key, double* matrix, const unsigned int size)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if(!file)
+            return false;
+        MatrixCacheHeader header;
+        bool valid = fread(&header, sizeof(MatrixCacheHeader), 1, file) == 1;
+        valid = valid && memcmp(header.magic, "HOAMATRX", 8) == 0 && header.version == HOA_MATRIX_CACHE_VERSION && header.hash == key.hash && header.dimension == key.dimension && header.order == key.order && header.numberOfChannels == key.numberOfChannels && header.mode == key.mode && header.size == size;
+        valid = valid && fread(matrix, sizeof(double), size, file) == size;
+        fclose(file);
+        return valid;
+    }
+}
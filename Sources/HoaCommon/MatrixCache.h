@@ -0,0 +1,76 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_MATRIX_CACHE__
+#define __DEF_HOA_MATRIX_CACHE__
+
+#include "../Hoa.h"
+
+namespace Hoa
+{
+    //! The cache of the decoding matrices.
+    /** The cache stores on the disk the decoding matrices that are expensive to design, like the matrices of the irregular decoders, and reads them instead of designing them again. A cache file is identified by the hash of the layout of the channels, the dimension, the order of decomposition, the number of channels and the mode of the design. The matrices are small so they are read in a buffer of the decoder.
+     */
+    class MatrixCache
+    {
+    public:
+        
+        //! The key of a cache file.
+        struct Key
+        {
+            uint64_t        hash;               /**< The hash of the layout of the channels */
+            unsigned int    dimension;          /**< The dimension, 2 or 3 */
+            unsigned int    order;              /**< The order of decomposition */
+            unsigned int    numberOfChannels;   /**< The number of channels */
+            unsigned int    mode;               /**< The mode of the design of the matrix */
+        };
+        
+        //! Compute the hash of a layout.
+        /**	Compute the FNV-1a hash of an array of values, the hash of the previous values can be given to hash several arrays.
+         
+            @param     values       The values.
+            @param     size         The number of values.
+            @param     hash         The hash of the previous values.
+            @return    The hash.
+         */
+        static uint64_t getHash(const double* values, const unsigned int size, uint64_t hash = 14695981039346656037ULL);
+        
+        //! Retrieve the path of a cache file.
+        /**	Retrieve the path of the cache file of a key in a directory.
+         
+            @param     directory    The directory of the cache files.
+            @param     key          The key of the cache file.
+            @return    The path of the cache file.
+         */
+        static std::string getPath(const std::string& directory, const Key& key);
+        
+        //! Write a cache file.
+        /**	Write a matrix in a cache file. The file is written in a temporary file and then renamed, so a decoder never reads a partial file. The values are written with the byte order of the machine.
+         
+            @param     path         The path of the cache file.
+            @param     key          The key of the cache file.
+            @param     matrix       The matrix with the number of channels by the number of harmonics coefficients.
+            @param     size         The number of coefficients.
+            @return    True if the file has been written.
+         */
+        static bool write(const std::string& path, const Key& key, const double* matrix, const unsigned int size);
+        
+        //! Read a cache file.
+        /**	Read a matrix in a cache file if it exists and matches the key and the number of coefficients.
+         
+            @param     path         The path of the cache file.
+            @param     key          The key of the cache file.
+            @param     matrix       The matrix.
+            @param     size         The number of coefficients.
+            @return    True if the matrix has been read.
+         */
+        static bool read(const std::string& path, const Key& key, double* matrix, const unsigned int size);
+    };
+}
+
+#endif
+
+
@@ -0,0 +1,203 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "MatrixInterpolator.h"
+
+namespace Hoa
+{
+    MatrixInterpolator::MatrixInterpolator(unsigned int numberOfRows, unsigned int numberOfColumns)
+    {
+        m_number_of_rows        = numberOfRows;
+        m_number_of_columns     = numberOfColumns;
+        m_matrix                = new Exchanger<Coefficients>(new Coefficients(m_number_of_rows * m_number_of_columns));
+        m_ramp_length           = NUMBEROFRAMPPOINTS;
+        m_ramp_size             = 0;
+        m_ramp_position         = 0;
+        m_processed             = false;
+        m_ramp_matrix_float     = new float[m_number_of_rows * m_number_of_columns * 2];
+        m_ramp_matrix_double    = new double[m_number_of_rows * m_number_of_columns * 2];
+        m_inputs_chunk_float    = new float[m_number_of_columns * 2 * NUMBEROFCHUNKPOINTS];
+        m_inputs_chunk_double   = new double[m_number_of_columns * 2 * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_float   = new float[m_number_of_rows * NUMBEROFCHUNKPOINTS];
+        m_outputs_chunk_double  = new double[m_number_of_rows * NUMBEROFCHUNKPOINTS];
+        m_frame_inputs_float    = new const float*[m_number_of_columns];
+        m_frame_inputs_double   = new const double*[m_number_of_columns];
+        m_frame_outputs_float   = new float*[m_number_of_rows];
+        m_frame_outputs_double  = new double*[m_number_of_rows];
+        for(unsigned int i = 0; i < m_number_of_rows * m_number_of_columns * 2; i++)
+        {
+            m_ramp_matrix_float[i]  = 0.f;
+            m_ramp_matrix_double[i] = 0.;
+        }
+    }
+    
+    void MatrixInterpolator::publish(Coefficients* matrix)
+    {
+        assert(matrix->getSize() == m_number_of_rows * m_number_of_columns);
+        m_matrix->publish(matrix);
+    }
+    
+    void MatrixInterpolator::setRampLength(unsigned int numberOfSamples)
+    {
+        atomic_store(&m_ramp_length, numberOfSamples);
+    }
+    
+    Coefficients* MatrixInterpolator::acquire()
+    {
+        bool changed;
+        Coefficients* matrix = m_matrix->acquire(changed);
+        if(changed)
+        {
+            const unsigned int length   = m_processed ? atomic_load(&m_ramp_length) : 0;
+            const double ramp           = (m_ramp_position < m_ramp_size) ? (double)m_ramp_position / (double)m_ramp_size : 1.;
+            const float* matrix_float   = matrix->getFloat();
+            const double* matrix_double = matrix->getDouble();
+            for(unsigned int i = 0; i < m_number_of_rows; i++)
+            {
+                float* from_float   = m_ramp_matrix_float + i * m_number_of_columns * 2;
+                float* delta_float  = from_float + m_number_of_columns;
+                double* from_double = m_ramp_matrix_double + i * m_number_of_columns * 2;
+                double* delta_double= from_double + m_number_of_columns;
+                for(unsigned int j = 0; j < m_number_of_columns; j++)
+                {
+                    const unsigned int index = i * m_number_of_columns + j;
+                    if(length)
+                    {
+                        from_float[j]   = from_float[j] + (float)ramp * delta_float[j];
+                        from_double[j]  = from_double[j] + ramp * delta_double[j];
+                    }
+                    else
+                    {
+                        from_float[j]   = matrix_float[index];
+                        from_double[j]  = matrix_double[index];
+                    }
+                    delta_float[j]  = matrix_float[index] - from_float[j];
+                    delta_double[j] = matrix_double[index] - from_double[j];
+                }
+            }
+            m_ramp_size     = length;
+            m_ramp_position = 0;
+        }
+        m_processed = true;
+        return matrix;
+    }
+    
+    void MatrixInterpolator::process(const float* input, float* output)
+    {
+        for(unsigned int j = 0; j < m_number_of_columns; j++)
+            m_frame_inputs_float[j] = input + j;
+        for(unsigned int i = 0; i < m_number_of_rows; i++)
+            m_frame_outputs_float[i] = output + i;
+        process(m_frame_inputs_float, m_frame_outputs_float, 1);
+    }
+    
+    void MatrixInterpolator::process(const double* input, double* output)
+    {
+        for(unsigned int j = 0; j < m_number_of_columns; j++)
+            m_frame_inputs_double[j] = input + j;
+        for(unsigned int i = 0; i < m_number_of_rows; i++)
+            m_frame_outputs_double[i] = output + i;
+        process(m_frame_inputs_double, m_frame_outputs_double, 1);
+    }
+    
+    void MatrixInterpolator::process(const float* const* inputs, float** outputs, const unsigned int vectorSize)
+    {
+        Coefficients* matrix = acquire();
+        if(m_ramp_position >= m_ramp_size)
+        {
+            matrix_vectors_product(matrix->getFloat(), m_number_of_rows, m_number_of_columns, inputs, outputs, vectorSize, m_inputs_chunk_float, m_outputs_chunk_float);
+            return;
+        }
+        
+        float gains[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0, size = 0; offset < vectorSize; offset += size)
+        {
+            // The chunk that contains the end of the ramp stops there so the next samples use the new matrix
+            size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            if(m_ramp_position < m_ramp_size && m_ramp_size - m_ramp_position < size)
+                size = m_ramp_size - m_ramp_position;
+            for(unsigned int j = 0; j < m_number_of_columns; j++)
+                memcpy(m_inputs_chunk_float + j * NUMBEROFCHUNKPOINTS, inputs[j] + offset, size * sizeof(float));
+            if(m_ramp_position < m_ramp_size)
+            {
+                for(unsigned int k = 0; k < size; k++)
+                    gains[k] = (float)(m_ramp_position + k + 1) / (float)m_ramp_size;
+                for(unsigned int j = 0; j < m_number_of_columns; j++)
+                {
+                    const float* input = m_inputs_chunk_float + j * NUMBEROFCHUNKPOINTS;
+                    float* weighted = m_inputs_chunk_float + (m_number_of_columns + j) * NUMBEROFCHUNKPOINTS;
+                    for(unsigned int k = 0; k < size; k++)
+                        weighted[k] = input[k] * gains[k];
+                }
+                matrix_chunk_product(m_ramp_matrix_float, m_number_of_rows, m_number_of_columns * 2, m_inputs_chunk_float, m_outputs_chunk_float, size);
+                m_ramp_position += size;
+            }
+            else
+            {
+                matrix_chunk_product(matrix->getFloat(), m_number_of_rows, m_number_of_columns, m_inputs_chunk_float, m_outputs_chunk_float, size);
+            }
+            for(unsigned int i = 0; i < m_number_of_rows; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_float + i * NUMBEROFCHUNKPOINTS, size * sizeof(float));
+        }
+    }
+    
+    void MatrixInterpolator::process(const double* const* inputs, double** outputs, const unsigned int vectorSize)
+    {
+        Coefficients* matrix = acquire();
+        if(m_ramp_position >= m_ramp_size)
+        {
+            matrix_vectors_product(matrix->getDouble(), m_number_of_rows, m_number_of_columns, inputs, outputs, vectorSize, m_inputs_chunk_double, m_outputs_chunk_double);
+            return;
+        }
+        
+        double gains[NUMBEROFCHUNKPOINTS];
+        for(unsigned int offset = 0, size = 0; offset < vectorSize; offset += size)
+        {
+            // The chunk that contains the end of the ramp stops there so the next samples use the new matrix
+            size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            if(m_ramp_position < m_ramp_size && m_ramp_size - m_ramp_position < size)
+                size = m_ramp_size - m_ramp_position;
+            for(unsigned int j = 0; j < m_number_of_columns; j++)
+                memcpy(m_inputs_chunk_double + j * NUMBEROFCHUNKPOINTS, inputs[j] + offset, size * sizeof(double));
+            if(m_ramp_position < m_ramp_size)
+            {
+                for(unsigned int k = 0; k < size; k++)
+                    gains[k] = (double)(m_ramp_position + k + 1) / (double)m_ramp_size;
+                for(unsigned int j = 0; j < m_number_of_columns; j++)
+                {
+                    const double* input = m_inputs_chunk_double + j * NUMBEROFCHUNKPOINTS;
+                    double* weighted = m_inputs_chunk_double + (m_number_of_columns + j) * NUMBEROFCHUNKPOINTS;
+                    for(unsigned int k = 0; k < size; k++)
+                        weighted[k] = input[k] * gains[k];
+                }
+                matrix_chunk_product(m_ramp_matrix_double, m_number_of_rows, m_number_of_columns * 2, m_inputs_chunk_double, m_outputs_chunk_double, size);
+                m_ramp_position += size;
+            }
+            else
+            {
+                matrix_chunk_product(matrix->getDouble(), m_number_of_rows, m_number_of_columns, m_inputs_chunk_double, m_outputs_chunk_double, size);
+            }
+            for(unsigned int i = 0; i < m_number_of_rows; i++)
+                memcpy(outputs[i] + offset, m_outputs_chunk_double + i * NUMBEROFCHUNKPOINTS, size * sizeof(double));
+        }
+    }
+    
+    MatrixInterpolator::~MatrixInterpolator()
+    {
+        delete m_matrix;
+        delete [] m_ramp_matrix_float;
+        delete [] m_ramp_matrix_double;
+        delete [] m_inputs_chunk_float;
+        delete [] m_inputs_chunk_double;
+        delete [] m_outputs_chunk_float;
+        delete [] m_outputs_chunk_double;
+        delete [] m_frame_inputs_float;
+        delete [] m_frame_inputs_double;
+        delete [] m_frame_outputs_float;
+        delete [] m_frame_outputs_double;
+    }
+}
+
@@ -0,0 +1,122 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_MATRIX_INTERPOLATOR__
+#define __DEF_HOA_MATRIX_INTERPOLATOR__
+
+#include "Exchanger.h"
+
+namespace Hoa
+{
+    //! The matrix interpolator.
+    /** The matrix interpolator multiplies a matrix by planar vectors like a decoder and interpolates linearly from the previous matrix to the new one over a number of samples when the control thread publishes a new matrix, so the changes of the matrix don't click. The interpolation is fused in a single product : the matrix is extended with the difference between the new matrix and the previous one and the inputs are extended with the inputs weighted by the ramp, so a chunk costs one product with twice the number of columns during the ramp and a normal product after. If a new matrix is published during a ramp, the new ramp starts from the current interpolated matrix.
+     */
+    class MatrixInterpolator
+    {
+    private:
+        
+        unsigned int                m_number_of_rows;
+        unsigned int                m_number_of_columns;
+        Exchanger<Coefficients>*    m_matrix;
+        unsigned int                m_ramp_length;
+        unsigned int                m_ramp_size;
+        unsigned int                m_ramp_position;
+        bool                        m_processed;
+        float*                      m_ramp_matrix_float;
+        double*                     m_ramp_matrix_double;
+        float*                      m_inputs_chunk_float;
+        double*                     m_inputs_chunk_double;
+        float*                      m_outputs_chunk_float;
+        double*                     m_outputs_chunk_double;
+        const float**               m_frame_inputs_float;
+        const double**              m_frame_inputs_double;
+        float**                     m_frame_outputs_float;
+        double**                    m_frame_outputs_double;
+        
+        //! Acquire the last published matrix and start a ramp if it has changed.
+        Coefficients* acquire();
+        
+        MatrixInterpolator(const MatrixInterpolator& other);
+        MatrixInterpolator& operator=(const MatrixInterpolator& other);
+    
+    public:
+        
+        //! The matrix interpolator constructor.
+        /**	The matrix interpolator constructor allocates a matrix of zeros. The first matrix published before the processing is used without ramp and the default length of the ramps is NUMBEROFRAMPPOINTS samples.
+         
+            @param     numberOfRows     The number of rows and output vectors.
+            @param     numberOfColumns  The number of columns and input vectors.
+         */
+        MatrixInterpolator(unsigned int numberOfRows, unsigned int numberOfColumns);
+        
+        //! The matrix interpolator destructor.
+        /**	The matrix interpolator destructor free the memory.
+         */
+        ~MatrixInterpolator();
+        
+        //! Publish a matrix.
+        /**	Publish a new matrix computed by the control thread, the interpolator takes the ownership of the matrix. This method must only be called by the control thread.
+         
+            @param     matrix   The new matrix.
+         */
+        void publish(Coefficients* matrix);
+        
+        /**	Retrieve the last matrix published by the control thread. This method must only be called by the control thread.
+         */
+        inline const Coefficients* getLatest() const
+        {
+            return m_matrix->getLatest();
+        };
+        
+        //! Set the length of the ramp.
+        /**	Set the number of samples of the interpolation between two matrices, 0 means that the new matrices are used immediately. The length is used by the next ramp.
+         
+            @param     numberOfSamples  The number of samples of the ramp.
+         */
+        void setRampLength(unsigned int numberOfSamples);
+        
+        /**	Retrieve the number of samples of the interpolation between two matrices.
+         */
+        inline unsigned int getRampLength() const
+        {
+            return atomic_load(&m_ramp_length);
+        };
+        
+        /**	This method performs the product with single precision sample by sample. The frame is processed as a block of one sample.
+         
+            @param     input    The inputs array.
+            @param     output   The outputs array.
+         */
+        void process(const float* input, float* output);
+        
+        /**	This method performs the product with double precision sample by sample. The frame is processed as a block of one sample.
+         
+            @param     input    The inputs array.
+            @param     output   The outputs array.
+         */
+        void process(const double* input, double* output);
+        
+        /**	This method performs the product with single precision on a block of samples. The outputs vectors can be the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const float* const* inputs, float** outputs, const unsigned int vectorSize);
+        
+        /**	This method performs the product with double precision on a block of samples. The outputs vectors can be the inputs vectors.
+         
+            @param     inputs       The input vectors.
+            @param     outputs      The output vectors.
+            @param     vectorSize   The number of samples to process.
+         */
+        void process(const double* const* inputs, double** outputs, const unsigned int vectorSize);
+    };
+}
+
+#endif
+
+
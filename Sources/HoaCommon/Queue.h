@@ -0,0 +1,168 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_QUEUE__
+#define __DEF_HOA_QUEUE__
+
+#include "../Hoa.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Hoa
+{
+    //! Load a value shared between threads.
+    /** Load a value with an acquire barrier : the reads and the writes that follow can't be moved before the load.
+     */
+    template <typename T> inline T atomic_load(T const* value)
+    {
+#ifdef _MSC_VER
+        T result = *(T const volatile*)value;
+        _ReadWriteBarrier();
+        return result;
+#else
+        return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+    }
+    
+    //! Store a value shared between threads.
+    /** Store a value with a release barrier : the reads and the writes that precede can't be moved after the store.
+     */
+    template <typename T> inline void atomic_store(T* value, T newValue)
+    {
+#ifdef _MSC_VER
+        _ReadWriteBarrier();
+        *(T volatile*)value = newValue;
+#else
+        __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+#endif
+    }
+    
+    //! Exchange a pointer shared between threads.
+    /** Store a pointer and retrieve the previous one in a single atomic operation with a full barrier.
+     */
+    template <typename T> inline T* atomic_exchange(T** value, T* newValue)
+    {
+#ifdef _MSC_VER
+        return (T*)_InterlockedExchangePointer((void* volatile*)value, (void*)newValue);
+#else
+        return __atomic_exchange_n(value, newValue, __ATOMIC_ACQ_REL);
+#endif
+    }
+    
+    //! Exchange an index shared between threads.
+    /** Store an index and retrieve the previous one in a single atomic operation with a full barrier.
+     */
+    inline unsigned int atomic_exchange(unsigned int* value, unsigned int newValue)
+    {
+#ifdef _MSC_VER
+        return (unsigned int)_InterlockedExchange((long volatile*)value, (long)newValue);
+#else
+        return __atomic_exchange_n(value, newValue, __ATOMIC_ACQ_REL);
+#endif
+    }
+    
+    //! The single producer single consumer queue.
+    /** The queue is a lock-free and wait-free ring buffer that transmits values from one thread to another thread. Only one thread can push the values and only one other thread can pop them, none of the methods allocates or frees memory, so the audio thread can be one of the two threads. The values should be small and copyable like the pointers or the commands.
+     */
+    template <typename T> class Queue
+    {
+    private:
+        
+        T*              m_values;
+        unsigned int    m_size;
+        unsigned int    m_mask;
+        unsigned int    m_write;
+        unsigned int    m_read;
+        
+        Queue(const Queue& other);
+        Queue& operator=(const Queue& other);
+    
+    public:
+        
+        //! The queue constructor.
+        /**	The queue constructor allocates the values, the capacity is rounded to the next power of 2.
+         
+            @param     capacity	The minimum number of values that the queue can contain.
+         */
+        Queue(unsigned int capacity)
+        {
+            m_size = 1;
+            while(m_size < capacity)
+                m_size *= 2;
+            m_mask      = m_size - 1;
+            m_values    = new T[m_size];
+            m_write     = 0;
+            m_read      = 0;
+        };
+        
+        //! The queue destructor.
+        /**	The queue destructor free the memory, the values that remain in the queue are lost.
+         */
+        ~Queue()
+        {
+            delete [] m_values;
+        };
+        
+        /**	Retrieve the number of values that the queue can contain.
+         */
+        inline unsigned int getCapacity() const
+        {
+            return m_size;
+        };
+        
+        //! Push a value.
+        /**	Push a value at the end of the queue, this method must only be called by the producer thread.
+         
+            @param     value	The value.
+            @return    False if the queue is full.
+         */
+        inline bool push(const T& value)
+        {
+            const unsigned int write = m_write;
+            if(write - atomic_load(&m_read) == m_size)
+                return false;
+            m_values[write & m_mask] = value;
+            atomic_store(&m_write, write + 1);
+            return true;
+        };
+        
+        //! Pop a value.
+        /**	Pop the value at the beginning of the queue, this method must only be called by the consumer thread.
+         
+            @param     value	The value.
+            @return    False if the queue is empty.
+         */
+        inline bool pop(T& value)
+        {
+            const unsigned int read = m_read;
+            if(atomic_load(&m_write) == read)
+                return false;
+            value = m_values[read & m_mask];
+            atomic_store(&m_read, read + 1);
+            return true;
+        };
+        
+        /**	Retrieve if the queue is full, this method must only be called by the producer thread.
+         */
+        inline bool isFull() const
+        {
+            return m_write - atomic_load(&m_read) == m_size;
+        };
+        
+        /**	Retrieve if the queue is empty, this method must only be called by the consumer thread.
+         */
+        inline bool isEmpty() const
+        {
+            return atomic_load(&m_write) == m_read;
+        };
+    };
+}
+
+#endif
+
+
@@ -0,0 +1,94 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_TRIPLE_BUFFER__
+#define __DEF_HOA_TRIPLE_BUFFER__
+
+#include "Queue.h"
+
+#define HOA_TRIPLE_BUFFER_FRESH 4
+
+namespace Hoa
+{
+    //! The triple buffer.
+    /** The triple buffer transmits snapshots of values, like the levels of a meter, from the audio thread to the graphical interface without lock. The writer fills its own buffer and publishes it by swapping it with the middle buffer, the reader takes the middle buffer in place of its own buffer only if a new snapshot has been published, so both threads are wait-free and the reader always gets a complete snapshot. The snapshots that the reader doesn't take in time are replaced by the next ones. Only one thread can write and only one other thread can read.
+     */
+    template <typename T> class TripleBuffer
+    {
+    private:
+        
+        T*              m_values;
+        unsigned int    m_size;
+        unsigned int    m_write;
+        unsigned int    m_middle;
+        unsigned int    m_read;
+        
+        TripleBuffer(const TripleBuffer& other);
+        TripleBuffer& operator=(const TripleBuffer& other);
+    
+    public:
+        
+        //! The triple buffer constructor.
+        /**	The triple buffer constructor allocates the three buffers and initializes them to zero.
+         
+            @param     size	The number of values of a snapshot.
+         */
+        TripleBuffer(unsigned int size)
+        {
+            m_size      = size;
+            m_values    = new T[3 * m_size];
+            for(unsigned int i = 0; i < 3 * m_size; i++)
+                m_values[i] = 0;
+            m_write     = 0;
+            m_middle    = 1;
+            m_read      = 2;
+        };
+        
+        //! The triple buffer destructor.
+        /**	The triple buffer destructor free the memory.
+         */
+        ~TripleBuffer()
+        {
+            delete [] m_values;
+        };
+        
+        /**	Retrieve the number of values of a snapshot.
+         */
+        inline unsigned int getSize() const
+        {
+            return m_size;
+        };
+        
+        /**	Retrieve the buffer of the writer, all its values must be written before each publication. This method must only be called by the writer thread.
+         */
+        inline T* getWrite() const
+        {
+            return m_values + m_write * m_size;
+        };
+        
+        //! Publish the buffer of the writer.
+        /**	Publish the buffer of the writer and take the middle buffer in exchange. This method must only be called by the writer thread.
+         */
+        inline void publish()
+        {
+            m_write = atomic_exchange(&m_middle, m_write | HOA_TRIPLE_BUFFER_FRESH) & 3;
+        };
+        
+        //! Read the last snapshot.
+        /**	Take the last published snapshot if there is a new one and retrieve the buffer of the reader. The values stay valid until the next call. This method must only be called by the reader thread.
+         
+            @return    The values of the last snapshot.
+         */
+        inline const T* read()
+        {
+            if(atomic_load(&m_middle) & HOA_TRIPLE_BUFFER_FRESH)
+                m_read = atomic_exchange(&m_middle, m_read) & 3;
+            return m_values + m_read * m_size;
+        };
+    };
+}
+
+#endif
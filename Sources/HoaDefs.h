@@ -19,6 +19,12 @@
 #include <assert.h>
 #include <algorithm>
 
+#ifdef HOA_BUILTIN_BLAS
+
+#include "HoaBlas.h"
+
+#else
+
 #ifdef __APPLE__
 
 #include <Accelerate/Accelerate.h>
@@ -35,6 +41,8 @@
 #include <cblas.h>
 #endif
 
+#endif
+
 #ifdef PD_DEBUG
 #include "../ThirdParty/PureData/Sources/cicm_wrapper.h"
 #endif
@@ -54,6 +62,9 @@
 #define NUMBEROFCIRCLEPOINTS 36000
 #define NUMBEROFCIRCLEPOINTS_UI 360
 #define NUMBEROFCIRCLEPOINTS_UI2 180
+#define NUMBEROFCHUNKPOINTS 64
+#define NUMBEROFRAMPPOINTS 256
+#define HOA_MAX_KERNELS_ORDER 15
 
 namespace Hoa
 {
@@ -18,6 +18,15 @@
 #include <string>
 #include <assert.h>
 #include <string.h>
+#include "HoaDefs.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 #ifdef _WINDOWS
 static inline double round(double val)
@@ -175,7 +184,7 @@ namespace Hoa
 	}
 
     //! The associated Legendre polynomials
-    /**	The function computes the associated Legendre polynomial \f$P(l, m)\f$ that is a part of the formula that compute the spherical harmonic coefficient where l is the band and the m is the argument of a spherical harmonic and x is the cosinus of the elevation. It uses three recurrence formulas :
+    /**	The function computes the associated Legendre polynomial \f$P(l, m)\f$ that is a part of the formula that compute the spherical harmonic coefficient where l is the band and the m is the argument of a spherical harmonic and x is the cosinus of the elevation. It uses three recurrence formulas, the polynomials are computed iteratively from \f$P(|m|, |m|)\f$ to \f$P(l, |m|)\f$ :
         \f[P(l, l)(x) = (-1)^l \times (2l - 1)!! \times (1 - x^2)^{0.5l}\f]
         \f[P(l + 1, l)(x) = x \times (2l + 1) \times P(l, l)\f]
         \f[P(l + 1, m)(x) = \frac{(2l + 1) \times x \times P(m, l) - (l + m) \times P(m, l - 1)}{(l - m + 1)}\f]
@@ -193,19 +202,25 @@ namespace Hoa
 	{
         l = abs(l);
         m = abs(m);
-
-		if(l == m)
-        {
-			return pow((double)-1.0, (double)m) * pow((double)(1. - x * x), (double)(0.5 * m)) * double_factorial(2. * m - 1);
-		}
-		else if(l == m + 1)
-        {
-			return x * associated_legendre(m, m, x) * (2 * m + 1);
-		}
-        else
+        if(l < m)
+            return 0.;
+
+        const double sine = sqrt(clip_min(1. - x * x, 0.));
+        double pmm = 1.;
+        for(int i = 1; i <= m; i++)
+            pmm *= -(double)(2 * i - 1) * sine;
+        if(l == m)
+            return pmm;
+
+        double p0 = pmm;
+        double p1 = x * (double)(2 * m + 1) * pmm;
+        for(int i = m + 2; i <= l; i++)
         {
-            return ((double)(2 * l - 1) * x *  associated_legendre(l - 1, m, x) - (double)(l + m - 1.) * associated_legendre(l - 2, m, x)) / (double)(l - m);
+            const double p2 = ((double)(2 * i - 1) * x * p1 - (double)(i + m - 1) * p0) / (double)(i - m);
+            p0 = p1;
+            p1 = p2;
         }
+        return p1;
 	}
 
     //! The legendre normalization
@@ -227,8 +242,12 @@ namespace Hoa
 	{
         if(m == 0)
             return sqrt((2. * l + 1.) / (4. * HOA_PI));
-        else
-            return sqrt((2. * l + 1.) / (4. * HOA_PI) * (long double)factorial(l - abs(m)) / (long double)factorial(l + abs(m))) * sqrt(2.);
+
+        // The ratio of the factorials (l - |m|)! / (l + |m|)! is the inverse of the product of the 2|m| integers between them.
+        double ratio = 1.;
+        for(int i = l - abs(m) + 1; i <= l + abs(m); i++)
+            ratio /= (double)i;
+        return sqrt((2. * l + 1.) / (4. * HOA_PI) * ratio) * sqrt(2.);
 	}
 
     /*
@@ -376,6 +395,606 @@ namespace Hoa
         return new_value;
     }
 
+    //! The vector sine and cosine function in single precision.
+    /** The function computes the sines and the cosines of a vector of angles in radian. The angles are reduced to \f$[-\pi/4, \pi/4]\f$ with a three parts Cody-Waite reduction over \f$\pi/2\f$ and the sine and the cosine are approximated with minimax polynomials of degree 7 and 8, the quadrant then selects and signs the results. The function is vectorized with AVX2, SSE2 or NEON when they are available and the remaining angles use the same approximation. For angles between \f$-8192\f$ and \f$8192\f$ radians, the absolute error is lower than \f$2 \times 10^{-7}\f$ relative to the double precision libm functions.
+
+	 @param     angles      The angles in radian.
+	 @param     sines       The sines of the angles.
+	 @param     cosines     The cosines of the angles.
+	 @param     size        The number of angles.
+
+	 @see    wrap_twopi
+     */
+    inline void vector_sincos(const float* angles, float* sines, float* cosines, const unsigned int size)
+    {
+        const float two_over_pi = 0.636619772367581343075535053490057448f;
+        const float dp1 = 1.5703125f;
+        const float dp2 = 4.837512969970703125e-4f;
+        const float dp3 = 7.54978995489188216e-8f;
+        const float s1  = -1.6666654611e-1f;
+        const float s2  = 8.3321608736e-3f;
+        const float s3  = -1.9515295891e-4f;
+        const float c1  = 4.166664568298827e-2f;
+        const float c2  = -1.388731625493765e-3f;
+        const float c3  = 2.443315711809948e-5f;
+        unsigned int i  = 0;
+#if defined(__AVX2__)
+        for(; i + 8 <= size; i += 8)
+        {
+            const __m256 x  = _mm256_loadu_ps(angles + i);
+            const __m256i j = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(two_over_pi)));
+            const __m256 jf = _mm256_cvtepi32_ps(j);
+            __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(jf, _mm256_set1_ps(dp1)));
+            r = _mm256_sub_ps(r, _mm256_mul_ps(jf, _mm256_set1_ps(dp2)));
+            r = _mm256_sub_ps(r, _mm256_mul_ps(jf, _mm256_set1_ps(dp3)));
+            const __m256 z  = _mm256_mul_ps(r, r);
+            
+            __m256 ps = _mm256_add_ps(_mm256_set1_ps(s2), _mm256_mul_ps(z, _mm256_set1_ps(s3)));
+            ps = _mm256_add_ps(_mm256_set1_ps(s1), _mm256_mul_ps(z, ps));
+            ps = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, z), ps));
+            __m256 pc = _mm256_add_ps(_mm256_set1_ps(c2), _mm256_mul_ps(z, _mm256_set1_ps(c3)));
+            pc = _mm256_add_ps(_mm256_set1_ps(c1), _mm256_mul_ps(z, pc));
+            pc = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_mul_ps(_mm256_set1_ps(0.5f), z)), _mm256_mul_ps(_mm256_mul_ps(z, z), pc));
+            
+            const __m256i one       = _mm256_set1_epi32(1);
+            const __m256i two       = _mm256_set1_epi32(2);
+            const __m256 swap       = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, one), one));
+            const __m256 sign_sin   = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, two), 30));
+            const __m256 sign_cos   = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(j, one), two), 30));
+            _mm256_storeu_ps(sines + i, _mm256_xor_ps(_mm256_blendv_ps(ps, pc, swap), sign_sin));
+            _mm256_storeu_ps(cosines + i, _mm256_xor_ps(_mm256_blendv_ps(pc, ps, swap), sign_cos));
+        }
+#endif
+#if defined(__SSE2__)
+        for(; i + 4 <= size; i += 4)
+        {
+            const __m128 x  = _mm_loadu_ps(angles + i);
+            const __m128i j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(two_over_pi)));
+            const __m128 jf = _mm_cvtepi32_ps(j);
+            __m128 r = _mm_sub_ps(x, _mm_mul_ps(jf, _mm_set1_ps(dp1)));
+            r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(dp2)));
+            r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(dp3)));
+            const __m128 z  = _mm_mul_ps(r, r);
+            
+            __m128 ps = _mm_add_ps(_mm_set1_ps(s2), _mm_mul_ps(z, _mm_set1_ps(s3)));
+            ps = _mm_add_ps(_mm_set1_ps(s1), _mm_mul_ps(z, ps));
+            ps = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), ps));
+            __m128 pc = _mm_add_ps(_mm_set1_ps(c2), _mm_mul_ps(z, _mm_set1_ps(c3)));
+            pc = _mm_add_ps(_mm_set1_ps(c1), _mm_mul_ps(z, pc));
+            pc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), pc));
+            
+            const __m128i one       = _mm_set1_epi32(1);
+            const __m128i two       = _mm_set1_epi32(2);
+            const __m128 swap       = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+            const __m128 sign_sin   = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+            const __m128 sign_cos   = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+            _mm_storeu_ps(sines + i, _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps)), sign_sin));
+            _mm_storeu_ps(cosines + i, _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc)), sign_cos));
+        }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        for(; i + 4 <= size; i += 4)
+        {
+            const float32x4_t x     = vld1q_f32(angles + i);
+            const float32x4_t y     = vmulq_n_f32(x, two_over_pi);
+            const float32x4_t half  = vbslq_f32(vcltq_f32(y, vdupq_n_f32(0.f)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+            const int32x4_t j       = vcvtq_s32_f32(vaddq_f32(y, half));
+            const float32x4_t jf    = vcvtq_f32_s32(j);
+            float32x4_t r = vmlsq_n_f32(x, jf, dp1);
+            r = vmlsq_n_f32(r, jf, dp2);
+            r = vmlsq_n_f32(r, jf, dp3);
+            const float32x4_t z     = vmulq_f32(r, r);
+            
+            float32x4_t ps = vmlaq_n_f32(vdupq_n_f32(s2), z, s3);
+            ps = vmlaq_f32(vdupq_n_f32(s1), z, ps);
+            ps = vmlaq_f32(r, vmulq_f32(r, z), ps);
+            float32x4_t pc = vmlaq_n_f32(vdupq_n_f32(c2), z, c3);
+            pc = vmlaq_f32(vdupq_n_f32(c1), z, pc);
+            pc = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.f), z, 0.5f), vmulq_f32(z, z), pc);
+            
+            const int32x4_t one     = vdupq_n_s32(1);
+            const int32x4_t two     = vdupq_n_s32(2);
+            const uint32x4_t swap   = vceqq_s32(vandq_s32(j, one), one);
+            const uint32x4_t sign_sin = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(j, two)), 30);
+            const uint32x4_t sign_cos = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(j, one), two)), 30);
+            vst1q_f32(sines + i, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, pc, ps)), sign_sin)));
+            vst1q_f32(cosines + i, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, ps, pc)), sign_cos)));
+        }
+#endif
+        for(; i < size; i++)
+        {
+            const float x   = angles[i];
+            const int j     = (int)floorf(x * two_over_pi + 0.5f);
+            const float jf  = (float)j;
+            const float r   = ((x - jf * dp1) - jf * dp2) - jf * dp3;
+            const float z   = r * r;
+            const float ps  = r + r * z * (s1 + z * (s2 + z * s3));
+            const float pc  = 1.f - 0.5f * z + z * z * (c1 + z * (c2 + z * c3));
+            const float sin_x = (j & 1) ? pc : ps;
+            const float cos_x = (j & 1) ? ps : pc;
+            sines[i]    = (j & 2) ? -sin_x : sin_x;
+            cosines[i]  = ((j + 1) & 2) ? -cos_x : cos_x;
+        }
+    }
+    
+    //! The vector sine and cosine function in double precision.
+    /** The function computes the sines and the cosines of a vector of angles in radian. The angles are reduced to \f$[-\pi/4, \pi/4]\f$ with a three parts Cody-Waite reduction over \f$\pi/2\f$ and the sine and the cosine are approximated with minimax polynomials of degree 13 and 14, the quadrant then selects and signs the results. The function is vectorized with AVX2 or SSE2 when they are available and the remaining angles use the same approximation. For angles between \f$-10^6\f$ and \f$10^6\f$ radians, the absolute error is lower than \f$3 \times 10^{-16}\f$ relative to the libm functions.
+
+	 @param     angles      The angles in radian.
+	 @param     sines       The sines of the angles.
+	 @param     cosines     The cosines of the angles.
+	 @param     size        The number of angles.
+
+	 @see    wrap_twopi
+     */
+    inline void vector_sincos(const double* angles, double* sines, double* cosines, const unsigned int size)
+    {
+        const double two_over_pi = 0.636619772367581343075535053490057448;
+        const double dp1 = 1.57079632673412561417e+00;
+        const double dp2 = 6.07710050630396597660e-11;
+        const double dp3 = 2.02226624879595063154e-21;
+        const double s1  = -1.66666666666666324348e-01;
+        const double s2  = 8.33333333332248946124e-03;
+        const double s3  = -1.98412698298579493134e-04;
+        const double s4  = 2.75573137070700676789e-06;
+        const double s5  = -2.50507602534068634195e-08;
+        const double s6  = 1.58969099521155010221e-10;
+        const double c1  = 4.16666666666666019037e-02;
+        const double c2  = -1.38888888888741095749e-03;
+        const double c3  = 2.48015872894767294178e-05;
+        const double c4  = -2.75573143513906633035e-07;
+        const double c5  = 2.08757232129817482790e-09;
+        const double c6  = -1.13596475577881948265e-11;
+        unsigned int i  = 0;
+#if defined(__AVX2__)
+        for(; i + 4 <= size; i += 4)
+        {
+            const __m256d x     = _mm256_loadu_pd(angles + i);
+            const __m128i j32   = _mm256_cvtpd_epi32(_mm256_mul_pd(x, _mm256_set1_pd(two_over_pi)));
+            const __m256d jf    = _mm256_cvtepi32_pd(j32);
+            const __m256i j     = _mm256_cvtepi32_epi64(j32);
+            __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(jf, _mm256_set1_pd(dp1)));
+            r = _mm256_sub_pd(r, _mm256_mul_pd(jf, _mm256_set1_pd(dp2)));
+            r = _mm256_sub_pd(r, _mm256_mul_pd(jf, _mm256_set1_pd(dp3)));
+            const __m256d z     = _mm256_mul_pd(r, r);
+            
+            __m256d ps = _mm256_add_pd(_mm256_set1_pd(s5), _mm256_mul_pd(z, _mm256_set1_pd(s6)));
+            ps = _mm256_add_pd(_mm256_set1_pd(s4), _mm256_mul_pd(z, ps));
+            ps = _mm256_add_pd(_mm256_set1_pd(s3), _mm256_mul_pd(z, ps));
+            ps = _mm256_add_pd(_mm256_set1_pd(s2), _mm256_mul_pd(z, ps));
+            ps = _mm256_add_pd(_mm256_set1_pd(s1), _mm256_mul_pd(z, ps));
+            ps = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), ps));
+            __m256d pc = _mm256_add_pd(_mm256_set1_pd(c5), _mm256_mul_pd(z, _mm256_set1_pd(c6)));
+            pc = _mm256_add_pd(_mm256_set1_pd(c4), _mm256_mul_pd(z, pc));
+            pc = _mm256_add_pd(_mm256_set1_pd(c3), _mm256_mul_pd(z, pc));
+            pc = _mm256_add_pd(_mm256_set1_pd(c2), _mm256_mul_pd(z, pc));
+            pc = _mm256_add_pd(_mm256_set1_pd(c1), _mm256_mul_pd(z, pc));
+            pc = _mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(1.), _mm256_mul_pd(_mm256_set1_pd(0.5), z)), _mm256_mul_pd(_mm256_mul_pd(z, z), pc));
+            
+            const __m256i one       = _mm256_set1_epi64x(1);
+            const __m256i two       = _mm256_set1_epi64x(2);
+            const __m256d swap      = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(j, one), one));
+            const __m256d sign_sin  = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(j, two), 62));
+            const __m256d sign_cos  = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(j, one), two), 62));
+            _mm256_storeu_pd(sines + i, _mm256_xor_pd(_mm256_blendv_pd(ps, pc, swap), sign_sin));
+            _mm256_storeu_pd(cosines + i, _mm256_xor_pd(_mm256_blendv_pd(pc, ps, swap), sign_cos));
+        }
+#endif
+#if defined(__SSE2__)
+        for(; i + 2 <= size; i += 2)
+        {
+            const __m128d x     = _mm_loadu_pd(angles + i);
+            const __m128i j32   = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(two_over_pi)));
+            const __m128d jf    = _mm_cvtepi32_pd(j32);
+            const __m128i j     = _mm_shuffle_epi32(j32, _MM_SHUFFLE(1, 1, 0, 0));
+            __m128d r = _mm_sub_pd(x, _mm_mul_pd(jf, _mm_set1_pd(dp1)));
+            r = _mm_sub_pd(r, _mm_mul_pd(jf, _mm_set1_pd(dp2)));
+            r = _mm_sub_pd(r, _mm_mul_pd(jf, _mm_set1_pd(dp3)));
+            const __m128d z     = _mm_mul_pd(r, r);
+            
+            __m128d ps = _mm_add_pd(_mm_set1_pd(s5), _mm_mul_pd(z, _mm_set1_pd(s6)));
+            ps = _mm_add_pd(_mm_set1_pd(s4), _mm_mul_pd(z, ps));
+            ps = _mm_add_pd(_mm_set1_pd(s3), _mm_mul_pd(z, ps));
+            ps = _mm_add_pd(_mm_set1_pd(s2), _mm_mul_pd(z, ps));
+            ps = _mm_add_pd(_mm_set1_pd(s1), _mm_mul_pd(z, ps));
+            ps = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, z), ps));
+            __m128d pc = _mm_add_pd(_mm_set1_pd(c5), _mm_mul_pd(z, _mm_set1_pd(c6)));
+            pc = _mm_add_pd(_mm_set1_pd(c4), _mm_mul_pd(z, pc));
+            pc = _mm_add_pd(_mm_set1_pd(c3), _mm_mul_pd(z, pc));
+            pc = _mm_add_pd(_mm_set1_pd(c2), _mm_mul_pd(z, pc));
+            pc = _mm_add_pd(_mm_set1_pd(c1), _mm_mul_pd(z, pc));
+            pc = _mm_add_pd(_mm_sub_pd(_mm_set1_pd(1.), _mm_mul_pd(_mm_set1_pd(0.5), z)), _mm_mul_pd(_mm_mul_pd(z, z), pc));
+            
+            // Each 32 bits quadrant is duplicated in the two halves of its 64 bits lane
+            const __m128i one       = _mm_set1_epi32(1);
+            const __m128i two       = _mm_set1_epi32(2);
+            const __m128d sign      = _mm_set1_pd(-0.);
+            const __m128d swap      = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+            const __m128d sign_sin  = _mm_and_pd(_mm_castsi128_pd(_mm_slli_epi32(_mm_and_si128(j, two), 30)), sign);
+            const __m128d sign_cos  = _mm_and_pd(_mm_castsi128_pd(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30)), sign);
+            _mm_storeu_pd(sines + i, _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, pc), _mm_andnot_pd(swap, ps)), sign_sin));
+            _mm_storeu_pd(cosines + i, _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, ps), _mm_andnot_pd(swap, pc)), sign_cos));
+        }
+#endif
+        for(; i < size; i++)
+        {
+            const double x  = angles[i];
+            const long j    = (long)floor(x * two_over_pi + 0.5);
+            const double jf = (double)j;
+            const double r  = ((x - jf * dp1) - jf * dp2) - jf * dp3;
+            const double z  = r * r;
+            const double ps = r + r * z * (s1 + z * (s2 + z * (s3 + z * (s4 + z * (s5 + z * s6)))));
+            const double pc = 1. - 0.5 * z + z * z * (c1 + z * (c2 + z * (c3 + z * (c4 + z * (c5 + z * c6)))));
+            const double sin_x = (j & 1) ? pc : ps;
+            const double cos_x = (j & 1) ? ps : pc;
+            sines[i]    = (j & 2) ? -sin_x : sin_x;
+            cosines[i]  = ((j + 1) & 2) ? -cos_x : cos_x;
+        }
+    }
+
+    //! The spherical harmonics function for a vector of directions
+    /** The function computes all the spherical harmonics of an order for a vector of directions, it is equivalent to the spherical_harmonics function called for each harmonic and each direction. The normalized associated Legendre polynomials are computed with their own recurrence over the degrees so they stay bounded at high orders :
+	 \f[\bar{P}(l, m)(x) = \sqrt{\frac{4l^2 - 1}{l^2 - m^2}} \times x \times \bar{P}(l - 1, m)(x) - \sqrt{\frac{(2l + 1)((l - 1)^2 - m^2)}{(2l - 3)(l^2 - m^2)}} \times \bar{P}(l - 2, m)(x)\f]
+	 and the azimuth coefficients with the rotation of the sines and the cosines. The harmonic of band l and argument m is stored in the row \f$l^2 + l + m\f$ of the harmonics, each row contains one value for each direction so the loops run over contiguous directions. The directions are processed by chunks of NUMBEROFCHUNKPOINTS. When the sine of theta is negative the azimuth is turned over the poles, like with the encoder.
+
+	 @param     order       The order of decomposition.
+	 @param     size        The number of directions.
+	 @param     phi         The azimuths of the directions.
+	 @param     theta       The elevations of the directions.
+	 @param     harmonics   The harmonics, its minimum size must be the number of harmonics by the number of directions.
+
+	 @see    spherical_harmonics
+	 @see    vector_sincos
+     */
+    inline void spherical_harmonics_batch(const unsigned int order, const unsigned int size, const double* phi, const double* theta, double* harmonics)
+    {
+        double cos_phi[NUMBEROFCHUNKPOINTS];
+        double sin_phi[NUMBEROFCHUNKPOINTS];
+        double cos_theta[NUMBEROFCHUNKPOINTS];
+        double sin_theta[NUMBEROFCHUNKPOINTS];
+        double cos_x[NUMBEROFCHUNKPOINTS];
+        double sin_x[NUMBEROFCHUNKPOINTS];
+        double pmm[NUMBEROFCHUNKPOINTS];
+        for(unsigned int k = 0; k < size; k += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int n = (size - k < NUMBEROFCHUNKPOINTS) ? size - k : NUMBEROFCHUNKPOINTS;
+            vector_sincos(phi + k, sin_phi, cos_phi, n);
+            vector_sincos(theta + k, sin_theta, cos_theta, n);
+            for(unsigned int i = 0; i < n; i++)
+            {
+                cos_x[i]    = 1.;
+                sin_x[i]    = 0.;
+                pmm[i]      = sqrt(1. / (4. * HOA_PI));
+            }
+
+            for(unsigned int m = 0; m <= order; m++)
+            {
+                if(m > 0)
+                {
+                    // N(m, m) P(m, m) = -sqrt((2m + 1) / 2m) * sin(theta) * N(m - 1, m - 1) P(m - 1, m - 1), and -sqrt(3) * sin(theta) * N(0, 0) P(0, 0) with the factor sqrt(2) of the first argument
+                    const double factor = (m == 1) ? -sqrt(3.) : -sqrt((double)(2 * m + 1) / (double)(2 * m));
+                    for(unsigned int i = 0; i < n; i++)
+                    {
+                        const double c = cos_x[i];
+                        pmm[i]     *= factor * sin_theta[i];
+                        cos_x[i]    = c * cos_phi[i] - sin_x[i] * sin_phi[i];
+                        sin_x[i]    = c * sin_phi[i] + sin_x[i] * cos_phi[i];
+                    }
+                }
+
+                double* row = harmonics + (m * m + m + m) * size + k;
+                for(unsigned int i = 0; i < n; i++)
+                    row[i] = pmm[i];
+                if(m < order)
+                {
+                    // N(m + 1, m) P(m + 1, m) = sqrt(2m + 3) * cos(theta) * N(m, m) P(m, m)
+                    const double factor = sqrt((double)(2 * m + 3));
+                    row = harmonics + ((m + 1) * (m + 1) + m + 1 + m) * size + k;
+                    for(unsigned int i = 0; i < n; i++)
+                        row[i] = factor * cos_theta[i] * pmm[i];
+                }
+                for(unsigned int l = m + 2; l <= order; l++)
+                {
+                    const double alpha  = sqrt((double)(4 * l * l - 1) / (double)(l * l - m * m));
+                    const double beta   = sqrt((double)(2 * l + 1) * (double)((l - 1) * (l - 1) - m * m) / ((double)(2 * l - 3) * (double)(l * l - m * m)));
+                    const double* p0    = harmonics + ((l - 2) * (l - 2) + l - 2 + m) * size + k;
+                    const double* p1    = harmonics + ((l - 1) * (l - 1) + l - 1 + m) * size + k;
+                    row = harmonics + (l * l + l + m) * size + k;
+                    for(unsigned int i = 0; i < n; i++)
+                        row[i] = alpha * cos_theta[i] * p1[i] - beta * p0[i];
+                }
+
+                if(m > 0)
+                {
+                    for(unsigned int l = m; l <= order; l++)
+                    {
+                        double* positive = harmonics + (l * l + l + m) * size + k;
+                        double* negative = harmonics + (l * l + l - m) * size + k;
+                        for(unsigned int i = 0; i < n; i++)
+                        {
+                            negative[i] = positive[i] * sin_x[i];
+                            positive[i] *= cos_x[i];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //! The chunk matrix product function in single precision.
+    /** The function multiplies a row-major matrix by a chunk of planar vectors stored contiguously with a stride of NUMBEROFCHUNKPOINTS samples, with a single gemm or, if HOA_NO_BLAS or HOA_BUILTIN_BLAS is defined, with the dispatched kernel that accumulates four input vectors at once.
+
+	 @param     matrix          The matrix with rows by columns coefficients.
+	 @param     rows            The number of rows and output vectors.
+	 @param     columns         The number of columns and input vectors.
+	 @param     inputsChunk     The chunk of the inputs.
+	 @param     outputsChunk    The chunk of the outputs.
+	 @param     size            The number of samples of the chunk, at most NUMBEROFCHUNKPOINTS.
+     */
+    inline void matrix_chunk_product(const float* matrix, const unsigned int rows, const unsigned int columns, const float* inputsChunk, float* outputsChunk, const unsigned int size)
+    {
+#if defined(HOA_NO_BLAS) || defined(HOA_BUILTIN_BLAS)
+        getSimdKernels()->chunk_product_float(matrix, rows, columns, inputsChunk, outputsChunk, size);
+#else
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, rows, size, columns, 1.f, matrix, columns, inputsChunk, NUMBEROFCHUNKPOINTS, 0.f, outputsChunk, NUMBEROFCHUNKPOINTS);
+#endif
+    }
+
+    //! The planar matrix product function in single precision.
+    /** The function multiplies a row-major matrix by a block of planar vectors, each output vector is the sum of the input vectors weighted by a row of the matrix. The vectors are copied by chunks of NUMBEROFCHUNKPOINTS samples in two contiguous buffers and each chunk is computed with a single gemm. If HOA_NO_BLAS or HOA_BUILTIN_BLAS is defined, the chunks are computed with a kernel that accumulates four input vectors at once. A chunk of the inputs is always copied before the chunk of the outputs is written so the output vectors can be the input vectors.
+
+	 @param     matrix          The matrix with rows by columns coefficients.
+	 @param     rows            The number of rows and output vectors.
+	 @param     columns         The number of columns and input vectors.
+	 @param     inputs          The input vectors.
+	 @param     outputs         The output vectors.
+	 @param     vectorSize      The number of samples of the vectors.
+	 @param     inputsChunk     The buffer of the inputs, its minimum size must be the number of columns by NUMBEROFCHUNKPOINTS.
+	 @param     outputsChunk    The buffer of the outputs, its minimum size must be the number of rows by NUMBEROFCHUNKPOINTS.
+     */
+    inline void matrix_vectors_product(const float* matrix, const unsigned int rows, const unsigned int columns, const float* const* inputs, float** outputs, const unsigned int vectorSize, float* inputsChunk, float* outputsChunk)
+    {
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int j = 0; j < columns; j++)
+                memcpy(inputsChunk + j * NUMBEROFCHUNKPOINTS, inputs[j] + offset, size * sizeof(float));
+            matrix_chunk_product(matrix, rows, columns, inputsChunk, outputsChunk, size);
+            for(unsigned int i = 0; i < rows; i++)
+                memcpy(outputs[i] + offset, outputsChunk + i * NUMBEROFCHUNKPOINTS, size * sizeof(float));
+        }
+    }
+
+    //! The chunk matrix product function in double precision.
+    /** The function multiplies a row-major matrix by a chunk of planar vectors stored contiguously with a stride of NUMBEROFCHUNKPOINTS samples, with a single gemm or, if HOA_NO_BLAS or HOA_BUILTIN_BLAS is defined, with the dispatched kernel that accumulates four input vectors at once.
+
+	 @param     matrix          The matrix with rows by columns coefficients.
+	 @param     rows            The number of rows and output vectors.
+	 @param     columns         The number of columns and input vectors.
+	 @param     inputsChunk     The chunk of the inputs.
+	 @param     outputsChunk    The chunk of the outputs.
+	 @param     size            The number of samples of the chunk, at most NUMBEROFCHUNKPOINTS.
+     */
+    inline void matrix_chunk_product(const double* matrix, const unsigned int rows, const unsigned int columns, const double* inputsChunk, double* outputsChunk, const unsigned int size)
+    {
+#if defined(HOA_NO_BLAS) || defined(HOA_BUILTIN_BLAS)
+        getSimdKernels()->chunk_product_double(matrix, rows, columns, inputsChunk, outputsChunk, size);
+#else
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, rows, size, columns, 1., matrix, columns, inputsChunk, NUMBEROFCHUNKPOINTS, 0., outputsChunk, NUMBEROFCHUNKPOINTS);
+#endif
+    }
+
+    //! The planar matrix product function in double precision.
+    /** The function multiplies a row-major matrix by a block of planar vectors, each output vector is the sum of the input vectors weighted by a row of the matrix. The vectors are copied by chunks of NUMBEROFCHUNKPOINTS samples in two contiguous buffers and each chunk is computed with a single gemm. If HOA_NO_BLAS or HOA_BUILTIN_BLAS is defined, the chunks are computed with a kernel that accumulates four input vectors at once. A chunk of the inputs is always copied before the chunk of the outputs is written so the output vectors can be the input vectors.
+
+	 @param     matrix          The matrix with rows by columns coefficients.
+	 @param     rows            The number of rows and output vectors.
+	 @param     columns         The number of columns and input vectors.
+	 @param     inputs          The input vectors.
+	 @param     outputs         The output vectors.
+	 @param     vectorSize      The number of samples of the vectors.
+	 @param     inputsChunk     The buffer of the inputs, its minimum size must be the number of columns by NUMBEROFCHUNKPOINTS.
+	 @param     outputsChunk    The buffer of the outputs, its minimum size must be the number of rows by NUMBEROFCHUNKPOINTS.
+     */
+    inline void matrix_vectors_product(const double* matrix, const unsigned int rows, const unsigned int columns, const double* const* inputs, double** outputs, const unsigned int vectorSize, double* inputsChunk, double* outputsChunk)
+    {
+        for(unsigned int offset = 0; offset < vectorSize; offset += NUMBEROFCHUNKPOINTS)
+        {
+            const unsigned int size = (vectorSize - offset) < NUMBEROFCHUNKPOINTS ? (vectorSize - offset) : NUMBEROFCHUNKPOINTS;
+            for(unsigned int j = 0; j < columns; j++)
+                memcpy(inputsChunk + j * NUMBEROFCHUNKPOINTS, inputs[j] + offset, size * sizeof(double));
+            matrix_chunk_product(matrix, rows, columns, inputsChunk, outputsChunk, size);
+            for(unsigned int i = 0; i < rows; i++)
+                memcpy(outputs[i] + offset, outputsChunk + i * NUMBEROFCHUNKPOINTS, size * sizeof(double));
+        }
+    }
+
+    //! The singular value decomposition function.
+    /** The function computes the thin singular value decomposition of a row-major matrix, matrix = u * diag(s) * v^T, with the one-sided Jacobi method. The singular values are positive or null and sorted in decreasing order. The function allocates its buffers, it should not be used in the audio thread.
+
+	 @param     matrix      The matrix with rows by columns coefficients.
+	 @param     rows        The number of rows.
+	 @param     columns     The number of columns.
+	 @param     u           The left singular vectors, a row-major matrix with rows by min(rows, columns) coefficients.
+	 @param     s           The singular values, min(rows, columns) values.
+	 @param     v           The right singular vectors, a row-major matrix with columns by min(rows, columns) coefficients.
+     */
+    inline void matrix_svd(const double* matrix, const unsigned int rows, const unsigned int columns, double* u, double* s, double* v)
+    {
+        // The rotations orthogonalize the columns of a tall matrix, a wide matrix is transposed
+        const bool transposed = rows < columns;
+        const unsigned int m = transposed ? columns : rows;
+        const unsigned int n = transposed ? rows : columns;
+        double* a = new double[m * n];
+        double* w = new double[n * n];
+        double* norms = new double[n];
+        unsigned int* order = new unsigned int[n];
+        for(unsigned int i = 0; i < m; i++)
+        {
+            for(unsigned int j = 0; j < n; j++)
+                a[i * n + j] = transposed ? matrix[j * columns + i] : matrix[i * columns + j];
+        }
+        for(unsigned int i = 0; i < n * n; i++)
+            w[i] = (i % (n + 1) == 0) ? 1. : 0.;
+
+        for(unsigned int sweep = 0; sweep < 64; sweep++)
+        {
+            double off = 0.;
+            for(unsigned int p = 0; p + 1 < n; p++)
+            {
+                for(unsigned int q = p + 1; q < n; q++)
+                {
+                    double alpha = 0., beta = 0., gamma = 0.;
+                    for(unsigned int i = 0; i < m; i++)
+                    {
+                        alpha += a[i * n + p] * a[i * n + p];
+                        beta  += a[i * n + q] * a[i * n + q];
+                        gamma += a[i * n + p] * a[i * n + q];
+                    }
+                    if(alpha == 0. || beta == 0. || fabs(gamma) <= 1e-15 * sqrt(alpha * beta))
+                        continue;
+                    off = std::max(off, fabs(gamma) / sqrt(alpha * beta));
+                    const double zeta = (beta - alpha) / (2. * gamma);
+                    const double t = (zeta < 0. ? -1. : 1.) / (fabs(zeta) + sqrt(1. + zeta * zeta));
+                    const double c = 1. / sqrt(1. + t * t);
+                    const double sn = c * t;
+                    for(unsigned int i = 0; i < m; i++)
+                    {
+                        const double ap = a[i * n + p], aq = a[i * n + q];
+                        a[i * n + p] = c * ap - sn * aq;
+                        a[i * n + q] = sn * ap + c * aq;
+                    }
+                    for(unsigned int i = 0; i < n; i++)
+                    {
+                        const double wp = w[i * n + p], wq = w[i * n + q];
+                        w[i * n + p] = c * wp - sn * wq;
+                        w[i * n + q] = sn * wp + c * wq;
+                    }
+                }
+            }
+            if(off < 1e-14)
+                break;
+        }
+
+        for(unsigned int j = 0; j < n; j++)
+        {
+            double norm = 0.;
+            for(unsigned int i = 0; i < m; i++)
+                norm += a[i * n + j] * a[i * n + j];
+            norms[j] = sqrt(norm);
+            order[j] = j;
+        }
+        for(unsigned int j = 1; j < n; j++)
+        {
+            for(unsigned int k = j; k > 0 && norms[order[k]] > norms[order[k - 1]]; k--)
+                std::swap(order[k], order[k - 1]);
+        }
+
+        // The normalized columns are the left vectors of the tall matrix and the rotations are its right vectors
+        double* left    = transposed ? v : u;
+        double* right   = transposed ? u : v;
+        for(unsigned int k = 0; k < n; k++)
+        {
+            const unsigned int j = order[k];
+            const double scale = norms[j] > 0. ? 1. / norms[j] : 0.;
+            s[k] = norms[j];
+            for(unsigned int i = 0; i < m; i++)
+                left[i * n + k] = a[i * n + j] * scale;
+            for(unsigned int i = 0; i < n; i++)
+                right[i * n + k] = w[i * n + j];
+        }
+        delete [] a;
+        delete [] w;
+        delete [] norms;
+        delete [] order;
+    }
+
+    //! The Cholesky factorization function for semi-definite matrices.
+    /** The function computes a factor of a symmetric positive semi-definite row-major matrix, matrix = factor^T * factor, with the pivoted Cholesky method so the factorization is stable even if the rank of the matrix is lower than its size. The rows of the factor are computed in the order of the greatest remaining diagonal coefficients, the factorization stops when they are below the threshold relative to the greatest diagonal coefficient of the matrix and the remaining rows are set to zero. The function allocates its buffer, it should not be used in the audio thread.
+
+	 @param     matrix      The matrix with size by size coefficients.
+	 @param     size        The size of the matrix.
+	 @param     factor      The factor with size by size coefficients, only the first rank rows are not null.
+	 @param     threshold   The relative threshold of the null pivots.
+	 @return    The function returns the rank of the matrix.
+     */
+    inline unsigned int matrix_cholesky(const double* matrix, const unsigned int size, double* factor, const double threshold = 1e-12)
+    {
+        double* diagonal = new double[size];
+        double greatest = 0.;
+        for(unsigned int i = 0; i < size; i++)
+        {
+            diagonal[i] = matrix[i * size + i];
+            greatest = std::max(greatest, diagonal[i]);
+        }
+        const double null = greatest * threshold;
+        for(unsigned int i = 0; i < size * size; i++)
+            factor[i] = 0.;
+
+        unsigned int rank = 0;
+        for(; rank < size; rank++)
+        {
+            unsigned int pivot = 0;
+            for(unsigned int i = 1; i < size; i++)
+            {
+                if(diagonal[i] > diagonal[pivot])
+                    pivot = i;
+            }
+            if(diagonal[pivot] <= null)
+                break;
+
+            // The row is the residual column of the pivot divided by the square root of its diagonal coefficient
+            double* row = factor + rank * size;
+            const double scale = 1. / sqrt(diagonal[pivot]);
+            for(unsigned int i = 0; i < size; i++)
+            {
+                double value = matrix[pivot * size + i];
+                for(unsigned int k = 0; k < rank; k++)
+                    value -= factor[k * size + pivot] * factor[k * size + i];
+                row[i] = value * scale;
+            }
+            for(unsigned int i = 0; i < size; i++)
+                diagonal[i] -= row[i] * row[i];
+            diagonal[pivot] = 0.;
+        }
+        delete [] diagonal;
+        return rank;
+    }
+
+    //! The Gauss-Legendre quadrature function.
+    /** The function computes the nodes and the weights of the Gauss-Legendre quadrature of a number of points on the interval [-1, 1], the nodes are the roots of the Legendre polynomial of this degree found with the Newton method. The quadrature is exact for the polynomials of degree 2 * size - 1 and the sum of the weights is 2.
+
+	 @param     size        The number of points.
+	 @param     nodes       The nodes in decreasing order.
+	 @param     weights     The weights of the nodes.
+     */
+    inline void gauss_legendre(const unsigned int size, double* nodes, double* weights)
+    {
+        for(unsigned int i = 0; i < (size + 1) / 2; i++)
+        {
+            double x = cos(HOA_PI * (i + 0.75) / (size + 0.5));
+            double derivative = 1.;
+            for(unsigned int k = 0; k < 100; k++)
+            {
+                double p0 = 1., p1 = x;
+                for(unsigned int j = 2; j <= size; j++)
+                {
+                    const double p2 = ((2. * j - 1.) * x * p1 - (j - 1.) * p0) / (double)j;
+                    p0 = p1;
+                    p1 = p2;
+                }
+                derivative = (size == 1) ? 1. : size * (x * p1 - p0) / (x * x - 1.);
+                const double delta = p1 / derivative;
+                x -= delta;
+                if(fabs(delta) < 1e-15)
+                    break;
+            }
+            nodes[i]                = x;
+            nodes[size - 1 - i]     = -x;
+            weights[i]              = 2. / ((1. - x * x) * derivative * derivative);
+            weights[size - 1 - i]   = weights[i];
+        }
+    }
+
 	//! The abscissa converter function.
     /** This function takes a radius and an azimuth value and convert them to an abscissa value.
 
@@ -622,46 +1241,8 @@ namespace Hoa
 
     inline void vector_sort(unsigned int size, double* vector)
 	{
-        int index;
-        double* temp = new double[size];
-        if(temp && size)
-        {
-            index  = 0;
-            temp[0] = vector[0];
-            temp[size - 1] = vector[0];
-
-            for(unsigned int i = 1; i < size; i++)
-            {
-                if(vector[i] < temp[0]) // Get the minimum
-                {
-                    temp[0] = vector[i];
-                    index = i;
-                }
-                if(vector[i] > temp[size - 1]) // Get the maximum
-                    temp[size - 1] = vector[i];
-            }
-            vector[index] -= 1;
-
-            for(unsigned int i = 1; i < size - 1; i++)
-            {
-                temp[i] = temp[size - 1];
-                index   = -1;
-                for(unsigned int j = 0; j < size; j++)
-                {
-                    if(vector[j] >= temp[i-1] && vector[j] <= temp[i])
-                    {
-                        temp[i] = vector[j];
-                        index = j;
-                    }
-                }
-                if(index > -1)
-                {
-                    vector[index] -= 1;
-                }
-            }
-            memcpy(vector, temp, size * sizeof(double));
-            delete [] temp;
-        }
+        // The vector is sorted in place in O(n log n) without allocation
+        std::sort(vector, vector + size);
 	}
 
 	inline void vector_sort_coordinates(unsigned int size, double* azimuths, double* elevations, double azymuth, double elevation)
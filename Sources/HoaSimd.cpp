@@ -0,0 +1,327 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#include "HoaSimd.h"
+#include "HoaCommon/Queue.h"
+
+#if defined(_MSC_VER)
+#define HOA_ALWAYS_INLINE __forceinline
+#else
+#define HOA_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HOA_SIMD_X86
+#define HOA_SIMD_TARGET(ISA) __attribute__((target(ISA)))
+#define HOA_SIMD_SSE2
+#define HOA_SIMD_AVX2
+#define HOA_SIMD_AVX512
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+// MSVC has no target attribute, the kernels are built for the instruction set of /arch so only the
+// instruction sets up to the one of the compilation have their own kernels
+#include <intrin.h>
+#define HOA_SIMD_X86
+#define HOA_SIMD_TARGET(ISA)
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HOA_SIMD_SSE2
+#endif
+#ifdef __AVX2__
+#define HOA_SIMD_AVX2
+#endif
+#ifdef __AVX512F__
+#define HOA_SIMD_AVX512
+#endif
+#endif
+
+namespace Hoa
+{
+    // The bodies of the kernels are written once and inlined in the functions of each instruction set,
+    // so the compiler vectorizes the same loops with the vectors of the target.
+    
+    template <typename T> HOA_ALWAYS_INLINE void weight_body(const T* input, const T weight, T* output, const unsigned int size)
+    {
+        for(unsigned int k = 0; k < size; k++)
+            output[k] = input[k] * weight;
+    }
+    
+    template <typename T> HOA_ALWAYS_INLINE void accumulate_body(const T* const* inputs, const unsigned int* indices, const T* coefficients, const unsigned int number, T* output, const unsigned int size)
+    {
+        for(unsigned int k = 0; k < size; k++)
+            output[k] = 0;
+        
+        unsigned int i = 0;
+        for(; i + 4 <= number; i += 4)
+        {
+            const T coef0 = coefficients[i];
+            const T coef1 = coefficients[i+1];
+            const T coef2 = coefficients[i+2];
+            const T coef3 = coefficients[i+3];
+            const T* input0 = inputs[indices[i]];
+            const T* input1 = inputs[indices[i+1]];
+            const T* input2 = inputs[indices[i+2]];
+            const T* input3 = inputs[indices[i+3]];
+            for(unsigned int k = 0; k < size; k++)
+                output[k] += input0[k] * coef0 + input1[k] * coef1 + input2[k] * coef2 + input3[k] * coef3;
+        }
+        for(; i < number; i++)
+        {
+            const T coef = coefficients[i];
+            const T* input = inputs[indices[i]];
+            for(unsigned int k = 0; k < size; k++)
+                output[k] += input[k] * coef;
+        }
+    }
+    
+    template <typename T> HOA_ALWAYS_INLINE void chunk_product_body(const T* matrix, const unsigned int rows, const unsigned int columns, const T* inputsChunk, T* outputsChunk, const unsigned int size)
+    {
+        for(unsigned int i = 0; i < rows; i++)
+        {
+            const T* row = matrix + i * columns;
+            T* output = outputsChunk + i * NUMBEROFCHUNKPOINTS;
+            for(unsigned int k = 0; k < size; k++)
+                output[k] = 0;
+            unsigned int j = 0;
+            for(; j + 4 <= columns; j += 4)
+            {
+                const T* input = inputsChunk + j * NUMBEROFCHUNKPOINTS;
+                const T coef0 = row[j];
+                const T coef1 = row[j+1];
+                const T coef2 = row[j+2];
+                const T coef3 = row[j+3];
+                for(unsigned int k = 0; k < size; k++)
+                    output[k] += input[k] * coef0 + input[k + NUMBEROFCHUNKPOINTS] * coef1 + input[k + 2 * NUMBEROFCHUNKPOINTS] * coef2 + input[k + 3 * NUMBEROFCHUNKPOINTS] * coef3;
+            }
+            for(; j < columns; j++)
+            {
+                const T* input = inputsChunk + j * NUMBEROFCHUNKPOINTS;
+                const T coef = row[j];
+                for(unsigned int k = 0; k < size; k++)
+                    output[k] += input[k] * coef;
+            }
+        }
+    }
+    
+    template <typename T> HOA_ALWAYS_INLINE void peak_body(const T* inputs, double* peaks, double* squares, const unsigned int size)
+    {
+        for(unsigned int i = 0; i < size; i++)
+        {
+            const double value = fabs(inputs[i]);
+            peaks[i] = (value > peaks[i]) ? value : peaks[i];
+            squares[i] += value * value;
+        }
+    }
+    
+    template <typename T> HOA_ALWAYS_INLINE void meter_body(const T* input, double* peak, double* square, const unsigned int size)
+    {
+        // The samples are tracked in 32 partial maxima and sums, the loop over the partials has no dependency so
+        // it fills the vectors, the remaining samples update the first partials and the partials are folded by halves.
+        T maxima[32];
+        T sums[32];
+        for(unsigned int k = 0; k < 32; k++)
+        {
+            maxima[k]   = 0;
+            sums[k]     = 0;
+        }
+        unsigned int i = 0;
+        for(; i + 32 <= size; i += 32)
+        {
+            const T* samples = input + i;
+            for(unsigned int k = 0; k < 32; k++)
+            {
+                const T value = fabs(samples[k]);
+                maxima[k] = (value > maxima[k]) ? value : maxima[k];
+                sums[k] += value * value;
+            }
+        }
+        const T* samples = input + i;
+        for(unsigned int k = 0; k < size - i; k++)
+        {
+            const T value = fabs(samples[k]);
+            maxima[k] = (value > maxima[k]) ? value : maxima[k];
+            sums[k] += value * value;
+        }
+        for(unsigned int width = 16; width > 0; width >>= 1)
+        {
+            for(unsigned int k = 0; k < width; k++)
+            {
+                maxima[k] = (maxima[k + width] > maxima[k]) ? maxima[k + width] : maxima[k];
+                sums[k] += sums[k + width];
+            }
+        }
+        if((double)maxima[0] > *peak)
+            *peak = maxima[0];
+        *square += sums[0];
+    }
+    
+    template <typename T> HOA_ALWAYS_INLINE T dot_body(const T* a, const T* b, const unsigned int size)
+    {
+        // Eight partial sums break the dependency of the additions so the products fill the vectors
+        T sums[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        unsigned int i = 0;
+        for(; i + 8 <= size; i += 8)
+        {
+            for(unsigned int k = 0; k < 8; k++)
+                sums[k] += a[i + k] * b[i + k];
+        }
+        for(; i < size; i++)
+            sums[0] += a[i] * b[i];
+        return ((sums[0] + sums[4]) + (sums[1] + sums[5])) + ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+    }
+
+#define HOA_SIMD_KERNELS(SUFFIX, ATTRIBUTE, ISA) \
+    ATTRIBUTE static void weight_float_##SUFFIX(const float* input, const float weight, float* output, const unsigned int size) \
+    {weight_body(input, weight, output, size);} \
+    ATTRIBUTE static void weight_double_##SUFFIX(const double* input, const double weight, double* output, const unsigned int size) \
+    {weight_body(input, weight, output, size);} \
+    ATTRIBUTE static void accumulate_float_##SUFFIX(const float* const* inputs, const unsigned int* indices, const float* coefficients, const unsigned int number, float* output, const unsigned int size) \
+    {accumulate_body(inputs, indices, coefficients, number, output, size);} \
+    ATTRIBUTE static void accumulate_double_##SUFFIX(const double* const* inputs, const unsigned int* indices, const double* coefficients, const unsigned int number, double* output, const unsigned int size) \
+    {accumulate_body(inputs, indices, coefficients, number, output, size);} \
+    ATTRIBUTE static void chunk_product_float_##SUFFIX(const float* matrix, const unsigned int rows, const unsigned int columns, const float* inputsChunk, float* outputsChunk, const unsigned int size) \
+    {chunk_product_body(matrix, rows, columns, inputsChunk, outputsChunk, size);} \
+    ATTRIBUTE static void chunk_product_double_##SUFFIX(const double* matrix, const unsigned int rows, const unsigned int columns, const double* inputsChunk, double* outputsChunk, const unsigned int size) \
+    {chunk_product_body(matrix, rows, columns, inputsChunk, outputsChunk, size);} \
+    ATTRIBUTE static void peak_float_##SUFFIX(const float* inputs, double* peaks, double* squares, const unsigned int size) \
+    {peak_body(inputs, peaks, squares, size);} \
+    ATTRIBUTE static void peak_double_##SUFFIX(const double* inputs, double* peaks, double* squares, const unsigned int size) \
+    {peak_body(inputs, peaks, squares, size);} \
+    ATTRIBUTE static void meter_float_##SUFFIX(const float* input, double* peak, double* square, const unsigned int size) \
+    {meter_body(input, peak, square, size);} \
+    ATTRIBUTE static void meter_double_##SUFFIX(const double* input, double* peak, double* square, const unsigned int size) \
+    {meter_body(input, peak, square, size);} \
+    ATTRIBUTE static float dot_float_##SUFFIX(const float* a, const float* b, const unsigned int size) \
+    {return dot_body(a, b, size);} \
+    ATTRIBUTE static double dot_double_##SUFFIX(const double* a, const double* b, const unsigned int size) \
+    {return dot_body(a, b, size);} \
+    static const SimdKernels kernels_##SUFFIX = \
+    { \
+        ISA, \
+        &weight_float_##SUFFIX, &weight_double_##SUFFIX, \
+        &accumulate_float_##SUFFIX, &accumulate_double_##SUFFIX, \
+        &chunk_product_float_##SUFFIX, &chunk_product_double_##SUFFIX, \
+        &peak_float_##SUFFIX, &peak_double_##SUFFIX, \
+        &meter_float_##SUFFIX, &meter_double_##SUFFIX, \
+        &dot_float_##SUFFIX, &dot_double_##SUFFIX \
+    };
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    // NEON is part of the instruction set of the compilation on ARM
+    HOA_SIMD_KERNELS(generic, , IsaNeon)
+#else
+    HOA_SIMD_KERNELS(generic, , IsaGeneric)
+#endif
+
+#ifdef HOA_SIMD_SSE2
+    HOA_SIMD_KERNELS(sse2, HOA_SIMD_TARGET("sse2"), IsaSse2)
+#endif
+#ifdef HOA_SIMD_AVX2
+    HOA_SIMD_KERNELS(avx2, HOA_SIMD_TARGET("avx2"), IsaAvx2)
+#endif
+#ifdef HOA_SIMD_AVX512
+    HOA_SIMD_KERNELS(avx512, HOA_SIMD_TARGET("avx512f"), IsaAvx512)
+#endif
+    
+#ifdef HOA_SIMD_X86
+    static bool simd_supports(const Isa isa)
+    {
+#ifdef _MSC_VER
+        // The registers of the vectors must also be saved by the system, XCR0 tells which ones are
+        int infos[4];
+        __cpuid(infos, 0);
+        const int maximum = infos[0];
+        __cpuid(infos, 1);
+        if(isa == IsaSse2)
+            return (infos[3] & (1 << 26)) != 0;
+        if(!(infos[2] & (1 << 27)) || !(infos[2] & (1 << 28)) || maximum < 7)
+            return false;
+        const unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(infos, 7, 0);
+        if(isa == IsaAvx2)
+            return (xcr0 & 0x6) == 0x6 && (infos[1] & (1 << 5)) != 0;
+        if(isa == IsaAvx512)
+            return (xcr0 & 0xe6) == 0xe6 && (infos[1] & (1 << 16)) != 0;
+        return false;
+#else
+        __builtin_cpu_init();
+        if(isa == IsaAvx512)
+            return __builtin_cpu_supports("avx512f");
+        if(isa == IsaAvx2)
+            return __builtin_cpu_supports("avx2");
+        if(isa == IsaSse2)
+            return __builtin_cpu_supports("sse2");
+        return false;
+#endif
+    }
+#endif
+    
+    static const SimdKernels* simd_kernels_of(const Isa isa)
+    {
+#ifdef HOA_SIMD_AVX512
+        if(isa == IsaAvx512 && simd_supports(IsaAvx512))
+            return &kernels_avx512;
+#endif
+#ifdef HOA_SIMD_AVX2
+        if(isa == IsaAvx2 && simd_supports(IsaAvx2))
+            return &kernels_avx2;
+#endif
+#ifdef HOA_SIMD_SSE2
+        if(isa == IsaSse2 && simd_supports(IsaSse2))
+            return &kernels_sse2;
+#endif
+        if(isa == kernels_generic.isa)
+            return &kernels_generic;
+        return NULL;
+    }
+    
+    static const SimdKernels* simd_kernels_detect()
+    {
+        const Isa isas[4] = {IsaAvx512, IsaAvx2, IsaSse2, IsaNeon};
+        for(int i = 0; i < 4; i++)
+        {
+            const SimdKernels* kernels = simd_kernels_of(isas[i]);
+            if(kernels)
+                return kernels;
+        }
+        return &kernels_generic;
+    }
+    
+    // The features are detected when the library is loaded, the getter detects them if it is called by the
+    // initialization of another translation unit before. The pointer is read by the audio threads while
+    // setSimdIsa can write it, so it is always loaded and stored atomically.
+    static const SimdKernels* simd_kernels = simd_kernels_detect();
+    
+    const SimdKernels* getSimdKernels()
+    {
+        const SimdKernels* kernels = atomic_load(&simd_kernels);
+        if(!kernels)
+        {
+            kernels = simd_kernels_detect();
+            atomic_store(&simd_kernels, kernels);
+        }
+        return kernels;
+    }
+    
+    bool setSimdIsa(const Isa isa)
+    {
+        const SimdKernels* kernels = simd_kernels_of(isa);
+        if(!kernels)
+            return false;
+        atomic_store(&simd_kernels, kernels);
+        return true;
+    }
+    
+    const char* getIsaName(const Isa isa)
+    {
+        switch(isa)
+        {
+            case IsaSse2:   return "sse2";
+            case IsaAvx2:   return "avx2";
+            case IsaAvx512: return "avx512";
+            case IsaNeon:   return "neon";
+            default:        return "generic";
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef __DEF_HOA_SIMD__
+#define __DEF_HOA_SIMD__
+
+#include "HoaDefs.h"
+
+namespace Hoa
+{
+    //! The instruction sets.
+    /** The instruction sets of the dispatched kernels, the generic kernels are built for the instruction set of the compilation.
+     */
+    enum Isa
+    {
+        IsaGeneric  = 0,    /**< The instruction set of the compilation. */
+        IsaSse2     = 1,    /**< SSE2 on x86. */
+        IsaAvx2     = 2,    /**< AVX2 on x86. */
+        IsaAvx512   = 3,    /**< AVX-512 foundation on x86. */
+        IsaNeon     = 4     /**< NEON on ARM. */
+    };
+    
+    //! The dispatched kernels.
+    /** The dispatched kernels are the hot loops of the library built from the same source for several instruction sets with the target attributes of the compiler. The features of the processor are detected once when the library is loaded and the kernels of the best instruction set are used by all the classes, so one binary uses the widest vectors of each machine.
+     */
+    struct SimdKernels
+    {
+        //! The instruction set of the kernels.
+        Isa isa;
+        
+        //! The weighting of a vector, output[k] = input[k] * weight, used by the wider of the 3D.
+        void (*weight_float)(const float* input, const float weight, float* output, const unsigned int size);
+        void (*weight_double)(const double* input, const double weight, double* output, const unsigned int size);
+        
+        //! The accumulation of indexed vectors, output[k] = sum of inputs[indices[i]][k] * coefficients[i], used by the Map.
+        void (*accumulate_float)(const float* const* inputs, const unsigned int* indices, const float* coefficients, const unsigned int number, float* output, const unsigned int size);
+        void (*accumulate_double)(const double* const* inputs, const unsigned int* indices, const double* coefficients, const unsigned int number, double* output, const unsigned int size);
+        
+        //! The product of a matrix by a chunk of vectors without BLAS, used by the decoders and the rotations.
+        void (*chunk_product_float)(const float* matrix, const unsigned int rows, const unsigned int columns, const float* inputsChunk, float* outputsChunk, const unsigned int size);
+        void (*chunk_product_double)(const double* matrix, const unsigned int rows, const unsigned int columns, const double* inputsChunk, double* outputsChunk, const unsigned int size);
+        
+        //! The tracking of the peaks and of the energies of a frame of channels, peaks[i] = max(peaks[i], |inputs[i]|) and squares[i] += inputs[i]^2, used by the Meter.
+        void (*peak_float)(const float* inputs, double* peaks, double* squares, const unsigned int size);
+        void (*peak_double)(const double* inputs, double* peaks, double* squares, const unsigned int size);
+        
+        //! The tracking of the peak and of the energy of a vector of one channel, peak = max(peak, |input[k]|) and square += sum of input[k]^2, used by the Meter.
+        void (*meter_float)(const float* input, double* peak, double* square, const unsigned int size);
+        void (*meter_double)(const double* input, double* peak, double* square, const unsigned int size);
+        
+        //! The dot product of two vectors, used by the Vector.
+        float (*dot_float)(const float* a, const float* b, const unsigned int size);
+        double (*dot_double)(const double* a, const double* b, const unsigned int size);
+    };
+    
+    //! Retrieve the dispatched kernels.
+    /** Retrieve the kernels of the best instruction set supported by the processor, or the kernels set with setSimdIsa().
+     
+        @return    The kernels.
+     */
+    const SimdKernels* getSimdKernels();
+    
+    //! Force the instruction set of the kernels.
+    /** Force the instruction set of the kernels to compare the implementations. This method must be called before the processing.
+     
+        @param     isa      The instruction set.
+        @return    False if the processor or the build doesn't support the instruction set.
+     */
+    bool setSimdIsa(const Isa isa);
+    
+    //! Retrieve the name of an instruction set.
+    const char* getIsaName(const Isa isa);
+}
+
+#endif
@@ -0,0 +1,1401 @@
+/*
+// Copyright (c) 2012-2014 Eliott Paris, Julien Colafrancesco & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+// The regression test runs deterministic signals through the classes of Hoa2D and Hoa3D in single and double precision
+// and compares the outputs of the sample by sample methods and of the block methods with the reference outputs stored
+// in References/HoaRegression.ref. The reference outputs are the outputs of the sample by sample methods, or of the
+// block methods for the classes that only process blocks, generated with --generate. The references of the tests that
+// the original scalar code can run, except the 3D rotation that was redefined, were generated by these tests built
+// against that code, so the optimized code is compared with it. The error is the greatest absolute difference relative
+// to the peak of the reference, a test passes if the error is below its tolerance in ULPs of the precision or in
+// decibels. The test returns 1 if a test fails. The kernels of an instruction set are tested with --isa.
+//
+// Usage : HoaRegression references [--generate] [--filter=name] [--isa=name] [--verbose]
+
+#include "../Hoa2D/Hoa2D.h"
+#include "../Hoa3D/Hoa3D.h"
+#include <string.h>
+#include <float.h>
+#include <limits>
+
+#define HOA_REGRESSION_SIZE 96
+#define HOA_REGRESSION_SNAPSHOT 32
+#define HOA_REGRESSION_SPLIT 20
+#define HOA_REGRESSION_IMPULSE_SIZE 128
+#define HOA_REGRESSION_SOURCES 4
+
+namespace Hoa
+{
+    //! The frames of the sample by sample processing.
+    template <typename T> class Frames
+    {
+        unsigned int    m_number_of_inputs;
+        unsigned int    m_number_of_outputs;
+        T*              m_inputs;
+        T*              m_outputs;
+    public:
+        Frames(const unsigned int numberOfInputs, const unsigned int numberOfOutputs)
+        {
+            m_number_of_inputs  = numberOfInputs;
+            m_number_of_outputs = numberOfOutputs;
+            m_inputs            = new T[m_number_of_inputs];
+            m_outputs           = new T[m_number_of_outputs];
+        }
+        
+        ~Frames()
+        {
+            delete [] m_inputs;
+            delete [] m_outputs;
+        }
+        
+        inline T* inputs(T** vectors, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_number_of_inputs; i++)
+                m_inputs[i] = vectors[i][k];
+            return m_inputs;
+        };
+        
+        inline T* outputs()
+        {
+            return m_outputs;
+        };
+        
+        inline void scatter(T** vectors, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_number_of_outputs; i++)
+                vectors[i][k] = m_outputs[i];
+        };
+    };
+    
+    //! Process the frames of the inputs with the sample by sample method of a processor.
+    template <typename T, class Processor> void processFrames(Processor& processor, T** inputs, T** outputs, const unsigned int numberOfInputs, const unsigned int numberOfOutputs, const unsigned int size)
+    {
+        Frames<T> frames(numberOfInputs, numberOfOutputs);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            processor.process(frames.inputs(inputs, k), frames.outputs());
+            frames.scatter(outputs, k);
+        }
+    }
+    
+    //! The result of a check of the outputs, a failed check is a NaN so the test fails whatever the reference.
+    template <typename T> inline T check(const bool passed)
+    {
+        return passed ? T(0) : std::numeric_limits<T>::quiet_NaN();
+    }
+    
+    //! The azimuth of a moving source.
+    inline double trajectoryAzimuth(const unsigned int index, const unsigned int k)
+    {
+        return 0.7 * index + 0.05 * k;
+    }
+    
+    //! The elevation of a moving source, it goes over the poles.
+    inline double trajectoryElevation(const unsigned int index, const unsigned int k)
+    {
+        return 1.8 * sin(0.4 * index + 0.03 * k);
+    }
+    
+    //! The radius of a moving source, it goes inside the circle.
+    inline double trajectoryRadius(const unsigned int index, const unsigned int k)
+    {
+        return 0.6 + 0.5 * sin(0.3 * index + 0.02 * k);
+    }
+    
+    //! Synthetic impulse responses with a decay and a delay that depends on the channel.
+    inline void fillImpulses(float* impulses, float** left, float** right, const unsigned int numberOfChannels)
+    {
+        for(unsigned int i = 0; i < numberOfChannels; i++)
+        {
+            left[i]     = impulses + (2 * i) * HOA_REGRESSION_IMPULSE_SIZE;
+            right[i]    = impulses + (2 * i + 1) * HOA_REGRESSION_IMPULSE_SIZE;
+            for(unsigned int k = 0; k < HOA_REGRESSION_IMPULSE_SIZE; k++)
+            {
+                const double decay = exp(-(double)k / 16.);
+                left[i][k]  = decay * sin(0.13 * (k + i));
+                right[i][k] = decay * cos(0.17 * (k + 2 * i));
+            }
+        }
+    }
+    
+    template <class Decoder> void setImpulses(Decoder& decoder)
+    {
+        const unsigned int number_of_channels = decoder.getNumberOfVirtualChannels();
+        float* impulses = new float[2 * number_of_channels * HOA_REGRESSION_IMPULSE_SIZE];
+        float** left    = new float*[number_of_channels];
+        float** right   = new float*[number_of_channels];
+        fillImpulses(impulses, left, right, number_of_channels);
+        decoder.setImpulses(left, right, HOA_REGRESSION_IMPULSE_SIZE);
+        delete [] impulses;
+        delete [] left;
+        delete [] right;
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Tests 2D //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    inline unsigned int one(unsigned int)           {return 1;}
+    inline unsigned int two(unsigned int)           {return 2;}
+    inline unsigned int five(unsigned int)          {return 5;}
+    inline unsigned int sources(unsigned int)       {return HOA_REGRESSION_SOURCES;}
+    inline unsigned int harmonics2D(unsigned int o) {return 2 * o + 1;}
+    inline unsigned int channels2D(unsigned int o)  {return 2 * o + 2;}
+    inline unsigned int vector2D(unsigned int)      {return 4;}
+    inline unsigned int scope2D(unsigned int)       {return 72;}
+    inline unsigned int channelsRamp2D(unsigned int o)  {return 2 * o + 3;}
+    inline unsigned int harmonicsRamp2D(unsigned int o) {return 2 * o + 2;}
+    inline unsigned int harmonics3D(unsigned int o) {return (o + 1) * (o + 1);}
+    inline unsigned int channels3D(unsigned int o)  {return (o + 1) * (o + 1) + 4;}
+    inline unsigned int vector3D(unsigned int)      {return 6;}
+    inline unsigned int scope3D(unsigned int)       {return 10 * 20;}
+    inline unsigned int scopeChecked3D(unsigned int o)  {return scope3D(o) + 1;}
+    
+    template <typename T> void encoder2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Encoder encoder(order);
+        encoder.setAzimuth(1.3);
+        if(block)
+        {
+            encoder.process(inputs[0], outputs, size);
+            return;
+        }
+        T* harmonics = new T[encoder.getNumberOfHarmonics()];
+        for(unsigned int k = 0; k < size; k++)
+        {
+            encoder.process(inputs[0][k], harmonics);
+            for(unsigned int i = 0; i < encoder.getNumberOfHarmonics(); i++)
+                outputs[i][k] = harmonics[i];
+        }
+        delete [] harmonics;
+    }
+    
+    template <typename T> void encoderSignal2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Encoder encoder(order);
+        T* azimuths = new T[size];
+        for(unsigned int k = 0; k < size; k++)
+            azimuths[k] = trajectoryAzimuth(1, k);
+        if(block)
+        {
+            encoder.process(inputs[0], azimuths, outputs, size);
+        }
+        else
+        {
+            T* harmonics = new T[encoder.getNumberOfHarmonics()];
+            for(unsigned int k = 0; k < size; k++)
+            {
+                encoder.setAzimuth(azimuths[k]);
+                encoder.process(inputs[0][k], harmonics);
+                for(unsigned int i = 0; i < encoder.getNumberOfHarmonics(); i++)
+                    outputs[i][k] = harmonics[i];
+            }
+            delete [] harmonics;
+        }
+        delete [] azimuths;
+    }
+    
+    template <typename T> void rotate2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Rotate rotate(order);
+        rotate.setYaw(2.3);
+        if(block)
+            rotate.process(inputs, outputs, size);
+        else
+            processFrames(rotate, inputs, outputs, harmonics2D(order), harmonics2D(order), size);
+    }
+    
+    template <typename T> void wider2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Wider wider(order);
+        wider.setWideningValue(0.3);
+        if(block)
+            wider.process(inputs, outputs, size);
+        else
+            processFrames(wider, inputs, outputs, harmonics2D(order), harmonics2D(order), size);
+    }
+    
+    template <typename T> void optim2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Optim optim(order, Hoa2D::Optim::InPhase);
+        if(block)
+            optim.process(inputs, outputs, size);
+        else
+            processFrames(optim, inputs, outputs, harmonics2D(order), harmonics2D(order), size);
+    }
+    
+    template <typename T> void decoderRegular2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::DecoderRegular decoder(order, channels2D(order));
+        decoder.setChannelsOffset(0.2);
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics2D(order), channels2D(order), size);
+    }
+    
+    template <typename T> void decoderRamp2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The offset changes at the sample 24 and again at the sample 44, in the middle of the first ramp, so the second
+        // ramp starts from the interpolated matrix and ends at the sample 84, inside the last block. The last output is
+        // the check of the ramps : the outputs follow the interpolation of the matrices of the three offsets without
+        // jump and they are the outputs of the last matrix from the end of the ramp.
+        const unsigned int harmonics = harmonics2D(order), channels = channels2D(order);
+        const unsigned int length = 40, changes[2] = {24, 44}, end = changes[1] + length;
+        const double offsets[3] = {0.2, 0.7, 1.1};
+        Hoa2D::DecoderRegular decoder(order, channels);
+        decoder.setRampLength(length);
+        decoder.setChannelsOffset(offsets[0]);
+        if(block)
+        {
+            const unsigned int bounds[5] = {0, changes[0], changes[1], 70, size};
+            std::vector<const T*> ins(harmonics);
+            std::vector<T*> outs(channels);
+            for(unsigned int b = 0; b < 4; b++)
+            {
+                if(bounds[b] == changes[0])
+                    decoder.setChannelsOffset(offsets[1]);
+                else if(bounds[b] == changes[1])
+                    decoder.setChannelsOffset(offsets[2]);
+                for(unsigned int i = 0; i < harmonics; i++)
+                    ins[i] = inputs[i] + bounds[b];
+                for(unsigned int i = 0; i < channels; i++)
+                    outs[i] = outputs[i] + bounds[b];
+                decoder.process(&ins[0], &outs[0], bounds[b+1] - bounds[b]);
+            }
+        }
+        else
+        {
+            Frames<T> frames(harmonics, channels);
+            for(unsigned int k = 0; k < size; k++)
+            {
+                if(k == changes[0])
+                    decoder.setChannelsOffset(offsets[1]);
+                else if(k == changes[1])
+                    decoder.setChannelsOffset(offsets[2]);
+                decoder.process(frames.inputs(inputs, k), frames.outputs());
+                frames.scatter(outputs, k);
+            }
+        }
+        
+        // The outputs of the three matrices, the outputs after the ramp are computed like the outputs of the decoder
+        std::vector<T> samples(4 * channels * size);
+        std::vector<T*> matrices[4];
+        for(unsigned int m = 0; m < 4; m++)
+        {
+            for(unsigned int i = 0; i < channels; i++)
+                matrices[m].push_back(&samples[(m * channels + i) * size]);
+        }
+        for(unsigned int m = 0; m < 3; m++)
+        {
+            Hoa2D::DecoderRegular reference(order, channels);
+            reference.setChannelsOffset(offsets[m]);
+            processFrames(reference, inputs, &matrices[m][0], harmonics, channels, size);
+        }
+        Hoa2D::DecoderRegular last(order, channels);
+        last.setChannelsOffset(offsets[2]);
+        if(block)
+        {
+            std::vector<const T*> ins(harmonics);
+            std::vector<T*> outs(channels);
+            for(unsigned int i = 0; i < harmonics; i++)
+                ins[i] = inputs[i] + end;
+            for(unsigned int i = 0; i < channels; i++)
+                outs[i] = matrices[3][i] + end;
+            last.process(&ins[0], &outs[0], size - end);
+        }
+        else
+            processFrames(last, inputs, &matrices[3][0], harmonics, channels, size);
+        
+        const T tolerance = 256 * std::numeric_limits<T>::epsilon();
+        for(unsigned int k = 0; k < size; k++)
+        {
+            bool passed = true;
+            for(unsigned int i = 0; i < channels; i++)
+            {
+                const T first = matrices[0][i][k], second = matrices[1][i][k], third = matrices[2][i][k];
+                if(k >= end)
+                {
+                    passed = passed && outputs[i][k] == matrices[3][i][k];
+                    continue;
+                }
+                T expected = first;
+                if(k >= changes[1])
+                {
+                    const T from = first + T(0.5) * (second - first);
+                    expected = from + (T)(k - changes[1] + 1) / (T)length * (third - from);
+                }
+                else if(k >= changes[0])
+                    expected = first + (T)(k - changes[0] + 1) / (T)length * (second - first);
+                passed = passed && fabs(outputs[i][k] - expected) <= tolerance;
+            }
+            outputs[channels][k] = check<T>(passed);
+        }
+    }
+    
+    template <typename T> void decoderIrregular2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The channels of a 5.0 setup
+        double azimuths[5] = {0., HOA_PI / 6., HOA_2PI - HOA_PI / 6., 110. / 180. * HOA_PI, HOA_2PI - 110. / 180. * HOA_PI};
+        Hoa2D::DecoderIrregular decoder(order, 5);
+        decoder.setChannelsAzimuth(azimuths);
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics2D(order), 5, size);
+    }
+    
+    template <typename T> void decoderBinaural2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::DecoderBinaural decoder(order);
+        setImpulses(decoder);
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics2D(order), 2, size);
+    }
+    
+    template <typename T> void decoderMulti2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        double azimuths[5] = {0., HOA_PI / 6., HOA_2PI - HOA_PI / 6., 110. / 180. * HOA_PI, HOA_2PI - 110. / 180. * HOA_PI};
+        Hoa2D::DecoderMulti decoder(order);
+        decoder.setDecodingMode(Hoa2D::DecoderMulti::Irregular);
+        decoder.setNumberOfChannels(5);
+        decoder.setChannelsAzimuth(azimuths);
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics2D(order), 5, size);
+    }
+    
+    template <typename T> void map2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Map map(order, HOA_REGRESSION_SOURCES);
+        for(unsigned int i = 0; i < HOA_REGRESSION_SOURCES; i++)
+        {
+            map.setAzimuth(i, trajectoryAzimuth(i, 0));
+            map.setRadius(i, trajectoryRadius(i, 0));
+        }
+        if(block)
+            map.process(inputs, outputs, size);
+        else
+            processFrames(map, inputs, outputs, HOA_REGRESSION_SOURCES, harmonics2D(order), size);
+    }
+    
+    template <typename T> void mapSignal2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Map map(order, HOA_REGRESSION_SOURCES);
+        T* positions = new T[2 * HOA_REGRESSION_SOURCES * size];
+        T* azimuths[HOA_REGRESSION_SOURCES];
+        T* radius[HOA_REGRESSION_SOURCES];
+        for(unsigned int i = 0; i < HOA_REGRESSION_SOURCES; i++)
+        {
+            azimuths[i] = positions + (2 * i) * size;
+            radius[i]   = positions + (2 * i + 1) * size;
+            for(unsigned int k = 0; k < size; k++)
+            {
+                azimuths[i][k]  = trajectoryAzimuth(i, k);
+                radius[i][k]    = trajectoryRadius(i, k);
+            }
+        }
+        if(block)
+        {
+            map.process(inputs, azimuths, radius, outputs, size);
+        }
+        else
+        {
+            Frames<T> frames(HOA_REGRESSION_SOURCES, harmonics2D(order));
+            for(unsigned int k = 0; k < size; k++)
+            {
+                for(unsigned int i = 0; i < HOA_REGRESSION_SOURCES; i++)
+                {
+                    map.setAzimuth(i, azimuths[i][k]);
+                    map.setRadius(i, radius[i][k]);
+                }
+                map.process(frames.inputs(inputs, k), frames.outputs());
+                frames.scatter(outputs, k);
+            }
+        }
+        delete [] positions;
+    }
+    
+    template <typename T> void projector2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Projector projector(order, channels2D(order));
+        if(block)
+            projector.process(inputs, outputs, size);
+        else
+            processFrames(projector, inputs, outputs, harmonics2D(order), channels2D(order), size);
+    }
+    
+    template <typename T> void recomposer2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Recomposer recomposer(order, channels2D(order));
+        for(unsigned int i = 0; i < channels2D(order); i++)
+        {
+            recomposer.setAzimuth(i, trajectoryAzimuth(i, 0));
+            recomposer.setWideningValue(i, 0.2 + 0.1 * i);
+        }
+        if(block)
+        {
+            recomposer.processFree(inputs, outputs, size);
+        }
+        else
+        {
+            Frames<T> frames(channels2D(order), harmonics2D(order));
+            for(unsigned int k = 0; k < size; k++)
+            {
+                recomposer.processFree(frames.inputs(inputs, k), frames.outputs());
+                frames.scatter(outputs, k);
+            }
+        }
+    }
+    
+    //! Set the channels of a recomposer, the channel 1 has other coordinates after the change.
+    inline void setRecomposer(Hoa2D::Recomposer& recomposer, const bool changed)
+    {
+        for(unsigned int i = 0; i < recomposer.getNumberOfChannels(); i++)
+        {
+            recomposer.setAzimuth(i, trajectoryAzimuth(i, 0));
+            recomposer.setWideningValue(i, 0.2 + 0.1 * i);
+        }
+        if(changed)
+        {
+            recomposer.setAzimuth(1, 2.1);
+            recomposer.setWideningValue(1, 0.9);
+        }
+    }
+    
+    //! Process a part of the vectors with the block method of a recomposer.
+    template <typename T> void processRecomposer(Hoa2D::Recomposer& recomposer, const bool fisheye, T** inputs, T** outputs, const unsigned int offset, const unsigned int size)
+    {
+        std::vector<const T*> ins(recomposer.getNumberOfChannels());
+        std::vector<T*> outs(recomposer.getNumberOfHarmonics());
+        for(unsigned int i = 0; i < ins.size(); i++)
+            ins[i] = inputs[i] + offset;
+        for(unsigned int i = 0; i < outs.size(); i++)
+            outs[i] = outputs[i] + offset;
+        if(fisheye)
+            recomposer.processFisheye(&ins[0], &outs[0], size);
+        else
+            recomposer.processFree(&ins[0], &outs[0], size);
+    }
+    
+    //! Process the frames of the vectors with the sample by sample method of a recomposer, the change occurs at a sample.
+    template <typename T> void processRecomposerFrames(Hoa2D::Recomposer& recomposer, const bool fisheye, T** inputs, T** outputs, const unsigned int size, const unsigned int change)
+    {
+        Frames<T> frames(recomposer.getNumberOfChannels(), recomposer.getNumberOfHarmonics());
+        for(unsigned int k = 0; k < size; k++)
+        {
+            if(k == change)
+                setRecomposer(recomposer, true);
+            if(fisheye)
+                recomposer.processFisheye(frames.inputs(inputs, k), frames.outputs());
+            else
+                recomposer.processFree(frames.inputs(inputs, k), frames.outputs());
+            frames.scatter(outputs, k);
+        }
+    }
+    
+    template <typename T> void recomposerRamp2D(const unsigned int order, const bool block, const bool fisheye, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The coordinates of the channel 1 change at the sample 20, the block process ramps its column over the block of
+        // the change from the sample 20 to 90 and the sample process changes it at once, so the outputs of the samples
+        // are mixed from the outputs of the previous matrix with the gains of the ramp. The last output is the check of
+        // the change : when the input of the channel 1 is muted the outputs don't ramp so the other columns don't change,
+        // and the outputs are the outputs of a recomposer computed with the new coordinates after the ramp.
+        const unsigned int harmonics = harmonics2D(order), channels = channels2D(order);
+        const unsigned int bounds[4] = {0, 20, 90, size}, length = bounds[2] - bounds[1];
+        std::vector<T> samples((3 * harmonics + channels) * size);
+        std::vector<T*> previous(harmonics), next(harmonics), muted(harmonics), silent(channels);
+        for(unsigned int i = 0; i < harmonics; i++)
+        {
+            previous[i] = &samples[i * size];
+            next[i]     = &samples[(harmonics + i) * size];
+            muted[i]    = &samples[(2 * harmonics + i) * size];
+        }
+        for(unsigned int i = 0; i < channels; i++)
+        {
+            silent[i] = &samples[(3 * harmonics + i) * size];
+            for(unsigned int k = 0; k < size; k++)
+                silent[i][k] = (i == 1) ? T(0) : inputs[i][k];
+        }
+        
+        Hoa2D::Recomposer recomposer(order, channels), reference(order, channels);
+        setRecomposer(recomposer, false);
+        setRecomposer(reference, true);
+        const T tolerance = 256 * std::numeric_limits<T>::epsilon();
+        if(block)
+        {
+            Hoa2D::Recomposer silenced(order, channels);
+            setRecomposer(silenced, false);
+            for(unsigned int b = 0; b < 3; b++)
+            {
+                if(b == 1)
+                {
+                    setRecomposer(recomposer, true);
+                    setRecomposer(silenced, true);
+                }
+                processRecomposer(recomposer, fisheye, inputs, outputs, bounds[b], bounds[b+1] - bounds[b]);
+                processRecomposer(silenced, fisheye, &silent[0], &muted[0], bounds[b], bounds[b+1] - bounds[b]);
+                processRecomposer(reference, fisheye, inputs, &next[0], bounds[b], bounds[b+1] - bounds[b]);
+                // The previous matrix and the new one only differ by the column of the muted channel
+                processRecomposer(reference, fisheye, &silent[0], &previous[0], bounds[b], bounds[b+1] - bounds[b]);
+            }
+            for(unsigned int k = 0; k < size; k++)
+            {
+                bool passed = true;
+                for(unsigned int i = 0; i < harmonics; i++)
+                {
+                    if(k >= bounds[2])
+                        passed = passed && outputs[i][k] == next[i][k];
+                    else if(k >= bounds[1])
+                        passed = passed && fabs(muted[i][k] - previous[i][k]) <= tolerance;
+                }
+                outputs[harmonics][k] = check<T>(passed);
+            }
+            return;
+        }
+        
+        Hoa2D::Recomposer initial(order, channels);
+        setRecomposer(initial, false);
+        processRecomposerFrames(recomposer, fisheye, inputs, outputs, size, bounds[1]);
+        processRecomposerFrames(initial, fisheye, inputs, &previous[0], size, size);
+        processRecomposerFrames(reference, fisheye, inputs, &next[0], size, size);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            bool passed = true;
+            for(unsigned int i = 0; i < harmonics; i++)
+            {
+                passed = passed && outputs[i][k] == (k >= bounds[1] ? next[i][k] : previous[i][k]);
+                if(k >= bounds[1] && k < bounds[2])
+                    outputs[i][k] = previous[i][k] + (T)(k - bounds[1] + 1) / (T)length * (outputs[i][k] - previous[i][k]);
+            }
+            outputs[harmonics][k] = check<T>(passed);
+        }
+    }
+    
+    template <typename T> void recomposerFreeRamp2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        recomposerRamp2D(order, block, false, inputs, outputs, size);
+    }
+    
+    template <typename T> void recomposerFisheyeRamp2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        recomposerRamp2D(order, block, true, inputs, outputs, size);
+    }
+    
+    template <typename T> void meter2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Meter meter(channels2D(order));
+        meter.setVectorSize(HOA_REGRESSION_SNAPSHOT);
+        if(block)
+        {
+            // The blocks are shorter than the windows and don't match them so the windows are split between the blocks
+            std::vector<const T*> vectors(channels2D(order));
+            for(unsigned int k = 0; k < size; k += HOA_REGRESSION_SPLIT)
+            {
+                const unsigned int length = std::min((unsigned int)HOA_REGRESSION_SPLIT, size - k);
+                for(unsigned int i = 0; i < channels2D(order); i++)
+                    vectors[i] = inputs[i] + k;
+                meter.process(&vectors[0], length);
+                if((k + length) / HOA_REGRESSION_SNAPSHOT > k / HOA_REGRESSION_SNAPSHOT)
+                {
+                    meter.update();
+                    for(unsigned int i = 0; i < channels2D(order); i++)
+                        outputs[i][(k + length) / HOA_REGRESSION_SNAPSHOT - 1] = meter.getChannelPeak(i);
+                }
+            }
+            return;
+        }
+        Frames<T> frames(channels2D(order), 0);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            meter.process(frames.inputs(inputs, k));
+            if(k % HOA_REGRESSION_SNAPSHOT == HOA_REGRESSION_SNAPSHOT - 1)
+            {
+                meter.update();
+                for(unsigned int i = 0; i < channels2D(order); i++)
+                    outputs[i][k / HOA_REGRESSION_SNAPSHOT] = meter.getChannelPeak(i);
+            }
+        }
+    }
+    
+    template <typename T> void meterLegacy2D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The meter used to restart its windows one sample after their ends, so the snapshots of the references
+        // miss the first samples of the windows after the first one. Each snapshot is a window of its own here.
+        Hoa2D::Meter meter(channels2D(order));
+        Frames<T> frames(channels2D(order), 0);
+        for(unsigned int j = 0; j < size / HOA_REGRESSION_SNAPSHOT; j++)
+        {
+            const unsigned int start = j ? j * (HOA_REGRESSION_SNAPSHOT + 1) - 1 : 0;
+            const unsigned int end   = (j + 1) * HOA_REGRESSION_SNAPSHOT;
+            meter.setVectorSize(end - start);
+            for(unsigned int k = start; k < end; k++)
+                meter.process(frames.inputs(inputs, k));
+            meter.update();
+            for(unsigned int i = 0; i < channels2D(order); i++)
+                outputs[i][j] = meter.getChannelPeak(i);
+        }
+    }
+    
+    template <typename T> void scope2D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Scope scope(order, scope2D(order));
+        Frames<T> frames(harmonics2D(order), 0);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            scope.process(frames.inputs(inputs, k));
+            if(k % HOA_REGRESSION_SNAPSHOT == HOA_REGRESSION_SNAPSHOT - 1)
+            {
+                for(unsigned int i = 0; i < scope2D(order); i++)
+                    outputs[i][k / HOA_REGRESSION_SNAPSHOT] = scope.getValue(i);
+            }
+        }
+    }
+    
+    template <typename T> void scopeCovariance2D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Scope scope(order, scope2D(order));
+        scope.setVectorSize(HOA_REGRESSION_SNAPSHOT);
+        if(block)
+        {
+            std::vector<const T*> vectors(harmonics2D(order));
+            for(unsigned int k = 0; k < size; k += HOA_REGRESSION_SPLIT)
+            {
+                const unsigned int length = std::min((unsigned int)HOA_REGRESSION_SPLIT, size - k);
+                for(unsigned int i = 0; i < harmonics2D(order); i++)
+                    vectors[i] = inputs[i] + k;
+                scope.accumulate(&vectors[0], length);
+                if((k + length) / HOA_REGRESSION_SNAPSHOT > k / HOA_REGRESSION_SNAPSHOT)
+                {
+                    scope.evaluate();
+                    for(unsigned int i = 0; i < scope2D(order); i++)
+                        outputs[i][(k + length) / HOA_REGRESSION_SNAPSHOT - 1] = scope.getValue(i);
+                }
+            }
+            return;
+        }
+        Frames<T> frames(harmonics2D(order), 0);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            scope.accumulate(frames.inputs(inputs, k));
+            if(k % HOA_REGRESSION_SNAPSHOT == HOA_REGRESSION_SNAPSHOT - 1)
+            {
+                scope.evaluate();
+                for(unsigned int i = 0; i < scope2D(order); i++)
+                    outputs[i][k / HOA_REGRESSION_SNAPSHOT] = scope.getValue(i);
+            }
+        }
+    }
+    
+    template <typename T> void vector2D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa2D::Vector vector(channels2D(order));
+        processFrames(vector, inputs, outputs, channels2D(order), 4, size);
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Tests 3D //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    template <typename T> void encoder3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size, const Hoa3D::Encoder::Mode mode)
+    {
+        Hoa3D::Encoder encoder(order, mode);
+        T* positions = new T[2 * size];
+        for(unsigned int k = 0; k < size; k++)
+        {
+            positions[k]        = trajectoryAzimuth(1, k);
+            positions[size + k] = trajectoryElevation(1, k);
+        }
+        if(block)
+        {
+            encoder.process(inputs[0], positions, positions + size, outputs, size);
+        }
+        else
+        {
+            T* harmonics = new T[encoder.getNumberOfHarmonics()];
+            for(unsigned int k = 0; k < size; k++)
+            {
+                encoder.setAzimuth(positions[k]);
+                encoder.setElevation(positions[size + k]);
+                encoder.process(inputs[0][k], harmonics);
+                for(unsigned int i = 0; i < encoder.getNumberOfHarmonics(); i++)
+                    outputs[i][k] = harmonics[i];
+            }
+            delete [] harmonics;
+        }
+        delete [] positions;
+    }
+    
+    template <typename T> void encoderTabulated3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        encoder3D(order, block, inputs, outputs, size, Hoa3D::Encoder::Tabulated);
+    }
+    
+    template <typename T> void encoderRecurrence3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        encoder3D(order, block, inputs, outputs, size, Hoa3D::Encoder::Recurrence);
+    }
+    
+    template <typename T> void rotate3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::Rotate rotate(order);
+        rotate.setRotations(0.4, -0.7, 2.3);
+        if(block)
+            rotate.process(inputs, outputs, size);
+        else
+            processFrames(rotate, inputs, outputs, harmonics3D(order), harmonics3D(order), size);
+    }
+    
+    template <typename T> void headTracker3D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::HeadTracker tracker(order);
+        tracker.setDelay(0);
+        tracker.setSubBlockSize(16);
+        tracker.push(0., 1., 0., 0., 0.);
+        tracker.push(size / 2, cos(0.4), 0.3 * sin(0.4), 0.5 * sin(0.4), sqrt(0.66) * sin(0.4));
+        tracker.push(size, cos(0.9), -0.6 * sin(0.9), 0.8 * sin(0.9), 0.);
+        tracker.process(inputs, outputs, size);
+    }
+    
+    template <typename T> void wider3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::Wider wider(order);
+        wider.setWideningValue(0.3);
+        if(block)
+            wider.process(inputs, outputs, size);
+        else
+            processFrames(wider, inputs, outputs, harmonics3D(order), harmonics3D(order), size);
+    }
+    
+    template <typename T> void optim3D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::Optim optim(order, Hoa3D::Optim::InPhase);
+        processFrames(optim, inputs, outputs, harmonics3D(order), harmonics3D(order), size);
+    }
+    
+    template <typename T> void decoderRegular3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::DecoderRegular decoder(order, channels3D(order));
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics3D(order), channels3D(order), size);
+    }
+    
+    template <typename T> void decoderBinaural3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::DecoderBinaural decoder(order);
+        setImpulses(decoder);
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics3D(order), 2, size);
+    }
+    
+    template <typename T> void decoderMulti3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::DecoderMulti decoder(order, channels3D(order));
+        if(block)
+            decoder.process(inputs, outputs, size);
+        else
+            processFrames(decoder, inputs, outputs, harmonics3D(order), channels3D(order), size);
+    }
+    
+    template <typename T> void map3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::Map map(order, HOA_REGRESSION_SOURCES);
+        T* positions = new T[2 * HOA_REGRESSION_SOURCES * size];
+        T* azimuths[HOA_REGRESSION_SOURCES];
+        T* elevations[HOA_REGRESSION_SOURCES];
+        for(unsigned int i = 0; i < HOA_REGRESSION_SOURCES; i++)
+        {
+            azimuths[i]     = positions + (2 * i) * size;
+            elevations[i]   = positions + (2 * i + 1) * size;
+            for(unsigned int k = 0; k < size; k++)
+            {
+                azimuths[i][k]      = trajectoryAzimuth(i, k);
+                elevations[i][k]    = trajectoryElevation(i, k);
+            }
+            map.setRadius(i, trajectoryRadius(i, 0));
+        }
+        if(block)
+        {
+            map.process(inputs, azimuths, elevations, outputs, size);
+        }
+        else
+        {
+            Frames<T> frames(HOA_REGRESSION_SOURCES, harmonics3D(order));
+            for(unsigned int k = 0; k < size; k++)
+            {
+                for(unsigned int i = 0; i < HOA_REGRESSION_SOURCES; i++)
+                {
+                    map.setAzimuth(i, azimuths[i][k]);
+                    map.setElevation(i, elevations[i][k]);
+                }
+                map.process(frames.inputs(inputs, k), frames.outputs());
+                frames.scatter(outputs, k);
+            }
+        }
+        delete [] positions;
+    }
+    
+    template <typename T> void meter3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::Meter meter(channels3D(order), 10, 20);
+        meter.setVectorSize(HOA_REGRESSION_SNAPSHOT);
+        if(block)
+        {
+            // The blocks are shorter than the windows and don't match them so the windows are split between the blocks
+            std::vector<const T*> vectors(channels3D(order));
+            for(unsigned int k = 0; k < size; k += HOA_REGRESSION_SPLIT)
+            {
+                const unsigned int length = std::min((unsigned int)HOA_REGRESSION_SPLIT, size - k);
+                for(unsigned int i = 0; i < channels3D(order); i++)
+                    vectors[i] = inputs[i] + k;
+                meter.process(&vectors[0], length);
+                if((k + length) / HOA_REGRESSION_SNAPSHOT > k / HOA_REGRESSION_SNAPSHOT)
+                {
+                    meter.update();
+                    for(unsigned int i = 0; i < channels3D(order); i++)
+                        outputs[i][(k + length) / HOA_REGRESSION_SNAPSHOT - 1] = meter.getChannelPeak(i);
+                }
+            }
+            return;
+        }
+        Frames<T> frames(channels3D(order), 0);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            meter.process(frames.inputs(inputs, k));
+            if(k % HOA_REGRESSION_SNAPSHOT == HOA_REGRESSION_SNAPSHOT - 1)
+            {
+                meter.update();
+                for(unsigned int i = 0; i < channels3D(order); i++)
+                    outputs[i][k / HOA_REGRESSION_SNAPSHOT] = meter.getChannelPeak(i);
+            }
+        }
+    }
+    
+    template <typename T> void meterLegacy3D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The meter used to restart its windows one sample after their ends, so the snapshots of the references
+        // miss the first samples of the windows after the first one. Each snapshot is a window of its own here.
+        Hoa3D::Meter meter(channels3D(order), 10, 20);
+        Frames<T> frames(channels3D(order), 0);
+        for(unsigned int j = 0; j < size / HOA_REGRESSION_SNAPSHOT; j++)
+        {
+            const unsigned int start = j ? j * (HOA_REGRESSION_SNAPSHOT + 1) - 1 : 0;
+            const unsigned int end   = (j + 1) * HOA_REGRESSION_SNAPSHOT;
+            meter.setVectorSize(end - start);
+            for(unsigned int k = start; k < end; k++)
+                meter.process(frames.inputs(inputs, k));
+            meter.update();
+            for(unsigned int i = 0; i < channels3D(order); i++)
+                outputs[i][j] = meter.getChannelPeak(i);
+        }
+    }
+    
+    //! The exact values of the points of a 3D scope.
+    /** The coefficients of the points are the ones of a regular decoder computed with the recurrence of the encoder, the
+        values are normalized like the values of the scope when they exceed 1.
+     */
+    class ScopeValues3D
+    {
+        unsigned int        m_number_of_harmonics;
+        std::vector<double> m_coefficients;
+        std::vector<double> m_values;
+    public:
+        ScopeValues3D(const unsigned int order) : m_number_of_harmonics(harmonics3D(order)), m_coefficients(scope3D(order) * harmonics3D(order)), m_values(scope3D(order))
+        {
+            Hoa3D::Scope scope(order, 10, 20);
+            Hoa3D::Encoder encoder(order, Hoa3D::Encoder::Recurrence);
+            for(unsigned int i = 0; i < scope3D(order); i++)
+            {
+                double* coefficients = &m_coefficients[i * m_number_of_harmonics];
+                encoder.setAzimuth(scope.getAzimuth(i % 20));
+                encoder.setElevation(scope.getElevation(i / 20));
+                encoder.process(12.5 / (double)((order + 1.) * (order + 1.)), coefficients);
+                for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                    coefficients[j] *= encoder.getNormalization(j) * encoder.getNormalization(j);
+            }
+        }
+        
+        //! Compute the values of the points for the harmonics of a frame.
+        template <typename T> void project(T** inputs, const unsigned int k)
+        {
+            for(unsigned int i = 0; i < m_values.size(); i++)
+            {
+                m_values[i] = 0.;
+                for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                    m_values[i] += m_coefficients[i * m_number_of_harmonics + j] * (double)inputs[j][k];
+            }
+            normalize();
+        }
+        
+        //! Compute the energies of the points for the harmonics of the frames of a window.
+        template <typename T> void energy(T** inputs, const unsigned int start, const unsigned int length)
+        {
+            for(unsigned int i = 0; i < m_values.size(); i++)
+            {
+                double energy = 0.;
+                for(unsigned int k = start; k < start + length; k++)
+                {
+                    double value = 0.;
+                    for(unsigned int j = 0; j < m_number_of_harmonics; j++)
+                        value += m_coefficients[i * m_number_of_harmonics + j] * (double)inputs[j][k];
+                    energy += value * value;
+                }
+                m_values[i] = sqrt(energy / (double)length);
+            }
+            normalize();
+        }
+        
+        //! Check the values of a scope, the tolerance is relative to 1 that is the maximum of the normalized values.
+        template <typename T> bool check(const Hoa3D::Scope& scope) const
+        {
+            bool passed = true;
+            for(unsigned int i = 0; i < m_values.size(); i++)
+                passed = passed && fabs(scope.getValue(i / 20, i % 20) - m_values[i]) <= 256. * std::numeric_limits<T>::epsilon();
+            return passed;
+        }
+        
+    private:
+        void normalize()
+        {
+            double max = 0.;
+            for(unsigned int i = 0; i < m_values.size(); i++)
+                max = std::max(max, fabs(m_values[i]));
+            if(max > 1.)
+            {
+                for(unsigned int i = 0; i < m_values.size(); i++)
+                    m_values[i] /= max;
+            }
+        }
+    };
+    
+    template <typename T> void scope3D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The last output is the check of the values against the exact values of the points
+        Hoa3D::Scope scope(order, 10, 20);
+        ScopeValues3D values(order);
+        Frames<T> frames(harmonics3D(order), 0);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            scope.process(frames.inputs(inputs, k));
+            if(k % HOA_REGRESSION_SNAPSHOT == HOA_REGRESSION_SNAPSHOT - 1)
+            {
+                for(unsigned int i = 0; i < scope3D(order); i++)
+                    outputs[i][k / HOA_REGRESSION_SNAPSHOT] = scope.getValue(i / 20, i % 20);
+                values.project(inputs, k);
+                outputs[scope3D(order)][k / HOA_REGRESSION_SNAPSHOT] = check<T>(values.check<T>(scope));
+            }
+        }
+    }
+    
+    template <typename T> void scopeCovariance3D(const unsigned int order, const bool block, T** inputs, T** outputs, const unsigned int size)
+    {
+        // The last output is the check of the energies against the exact energies of the points over the windows
+        Hoa3D::Scope scope(order, 10, 20);
+        ScopeValues3D values(order);
+        scope.setVectorSize(HOA_REGRESSION_SNAPSHOT);
+        if(block)
+        {
+            std::vector<const T*> vectors(harmonics3D(order));
+            for(unsigned int k = 0; k < size; k += HOA_REGRESSION_SPLIT)
+            {
+                const unsigned int length = std::min((unsigned int)HOA_REGRESSION_SPLIT, size - k);
+                for(unsigned int i = 0; i < harmonics3D(order); i++)
+                    vectors[i] = inputs[i] + k;
+                scope.accumulate(&vectors[0], length);
+                if((k + length) / HOA_REGRESSION_SNAPSHOT > k / HOA_REGRESSION_SNAPSHOT)
+                {
+                    const unsigned int window = (k + length) / HOA_REGRESSION_SNAPSHOT - 1;
+                    scope.evaluate();
+                    for(unsigned int i = 0; i < scope3D(order); i++)
+                        outputs[i][window] = scope.getValue(i / 20, i % 20);
+                    values.energy(inputs, window * HOA_REGRESSION_SNAPSHOT, HOA_REGRESSION_SNAPSHOT);
+                    outputs[scope3D(order)][window] = check<T>(values.check<T>(scope));
+                }
+            }
+            return;
+        }
+        Frames<T> frames(harmonics3D(order), 0);
+        for(unsigned int k = 0; k < size; k++)
+        {
+            scope.accumulate(frames.inputs(inputs, k));
+            if(k % HOA_REGRESSION_SNAPSHOT == HOA_REGRESSION_SNAPSHOT - 1)
+            {
+                const unsigned int window = k / HOA_REGRESSION_SNAPSHOT;
+                scope.evaluate();
+                for(unsigned int i = 0; i < scope3D(order); i++)
+                    outputs[i][window] = scope.getValue(i / 20, i % 20);
+                values.energy(inputs, window * HOA_REGRESSION_SNAPSHOT, HOA_REGRESSION_SNAPSHOT);
+                outputs[scope3D(order)][window] = check<T>(values.check<T>(scope));
+            }
+        }
+    }
+    
+    template <typename T> void vector3D(const unsigned int order, const bool, T** inputs, T** outputs, const unsigned int size)
+    {
+        Hoa3D::Vector vector(channels3D(order));
+        processFrames(vector, inputs, outputs, channels3D(order), 6, size);
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Runner //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    //! The tolerance of a test.
+    /** The error passes if it is below the number of ULPs of the precision or below the level in decibels, both relative to the peak of the reference.
+     */
+    struct Tolerance
+    {
+        double ulps;
+        double decibels;
+    };
+    
+    //! A test.
+    /** The processing of a test is performed by the sample by sample methods and by the block methods. A test that has no sample by sample methods uses the block methods for the reference outputs, a test that has no block methods is only performed by the sample by sample methods. The outputs of the analyzers are snapshots of their state every HOA_REGRESSION_SNAPSHOT samples.
+     */
+    struct Test
+    {
+        const char*     name;
+        unsigned int    dimension;
+        bool            sample;
+        bool            block;
+        bool            snapshots;
+        unsigned int    (*inputs)(unsigned int order);
+        unsigned int    (*outputs)(unsigned int order);
+        Tolerance       tolerance_sample;
+        Tolerance       tolerance_block;
+        void            (*processFloat)(const unsigned int order, const bool block, float** inputs, float** outputs, const unsigned int size);
+        void            (*processDouble)(const unsigned int order, const bool block, double** inputs, double** outputs, const unsigned int size);
+    };
+
+#define HOA_REGRESSION_TEST(NAME, DIMENSION, SAMPLE, BLOCK, SNAPSHOTS, INPUTS, OUTPUTS, ULPS_SAMPLE, DB_SAMPLE, ULPS_BLOCK, DB_BLOCK, FUNCTION) \
+    {NAME, DIMENSION, SAMPLE, BLOCK, SNAPSHOTS, &INPUTS, &OUTPUTS, {ULPS_SAMPLE, DB_SAMPLE}, {ULPS_BLOCK, DB_BLOCK}, &FUNCTION<float>, &FUNCTION<double>}
+    
+    // The tables of the original 3D encoder computed the sine of the elevation as sqrt(1 - cos^2), it loses digits near
+    // the poles and its outputs differ from the outputs with the sine by up to 235 ULPs in double precision at the
+    // order 5, the tables now use the sine that is exact to 0.5 ULP. The binaural decoders convolve in single
+    // precision. The 3D encoders and maps compute the harmonics of the blocks with the recurrence and the harmonics of
+    // the samples with the tables, the tables have a step of 0.01 degree. The references of the 3D scope were computed
+    // by the original scope that sampled the harmonics from the tables, the angles of the points were rounded to the
+    // steps of the tables and the values differ by -74.3, -67.5 and -62.6 dB at the orders 1, 3 and 5 in both
+    // precisions. The last output of the scopes checks the values against the exact projections within 256 epsilons of
+    // the precision, the float block covariance accumulates in single precision. The meters are checked against the windows of their references
+    // and against the exact windows.
+    static const Test tests[] =
+    {
+        HOA_REGRESSION_TEST("Hoa2D::Encoder",             2, true,  true,  false, one,        harmonics2D,    64, -300,   64, -300,   encoder2D),
+        HOA_REGRESSION_TEST("Hoa2D::Encoder/signal",      2, true,  true,  false, one,        harmonics2D,    64, -300,   256, -300,  encoderSignal2D),
+        HOA_REGRESSION_TEST("Hoa2D::Rotate",              2, true,  true,  false, harmonics2D, harmonics2D,   64, -300,   64, -300,   rotate2D),
+        HOA_REGRESSION_TEST("Hoa2D::Wider",               2, true,  true,  false, harmonics2D, harmonics2D,   64, -300,   64, -300,   wider2D),
+        HOA_REGRESSION_TEST("Hoa2D::Optim",               2, true,  true,  false, harmonics2D, harmonics2D,   64, -300,   64, -300,   optim2D),
+        HOA_REGRESSION_TEST("Hoa2D::DecoderRegular",      2, true,  true,  false, harmonics2D, channels2D,    64, -300,   256, -300,  decoderRegular2D),
+        HOA_REGRESSION_TEST("Hoa2D::DecoderRegular/ramp", 2, true,  true,  false, harmonics2D, channelsRamp2D, 64, -300,   256, -300,  decoderRamp2D),
+        HOA_REGRESSION_TEST("Hoa2D::DecoderIrregular",    2, true,  true,  false, harmonics2D, five,          64, -300,   256, -300,  decoderIrregular2D),
+        HOA_REGRESSION_TEST("Hoa2D::DecoderBinaural",     2, true,  true,  false, harmonics2D, two,           64, -120,   64, -120,   decoderBinaural2D),
+        HOA_REGRESSION_TEST("Hoa2D::DecoderMulti",        2, true,  true,  false, harmonics2D, five,          64, -300,   256, -300,  decoderMulti2D),
+        HOA_REGRESSION_TEST("Hoa2D::Map",                 2, true,  true,  false, sources,    harmonics2D,    64, -300,   256, -300,  map2D),
+        HOA_REGRESSION_TEST("Hoa2D::Map/signal",          2, true,  true,  false, sources,    harmonics2D,    64, -300,   256, -300,  mapSignal2D),
+        HOA_REGRESSION_TEST("Hoa2D::Projector",           2, true,  true,  false, harmonics2D, channels2D,    64, -300,   256, -300,  projector2D),
+        HOA_REGRESSION_TEST("Hoa2D::Recomposer",          2, true,  true,  false, channels2D, harmonics2D,    64, -300,   256, -300,  recomposer2D),
+        HOA_REGRESSION_TEST("Hoa2D::Recomposer/free",     2, true,  true,  false, channels2D, harmonicsRamp2D, 64, -300,   256, -300,  recomposerFreeRamp2D),
+        HOA_REGRESSION_TEST("Hoa2D::Recomposer/fisheye",  2, true,  true,  false, channels2D, harmonicsRamp2D, 64, -300,   256, -300,  recomposerFisheyeRamp2D),
+        HOA_REGRESSION_TEST("Hoa2D::Meter",               2, true,  false, true,  channels2D, channels2D,     64, -300,   64, -300,   meterLegacy2D),
+        HOA_REGRESSION_TEST("Hoa2D::Meter/window",        2, true,  true,  true,  channels2D, channels2D,     64, -300,   64, -300,   meter2D),
+        HOA_REGRESSION_TEST("Hoa2D::Scope",               2, true,  false, true,  harmonics2D, scope2D,       64, -300,   64, -300,   scope2D),
+        HOA_REGRESSION_TEST("Hoa2D::Scope/covariance",    2, true,  true,  true,  harmonics2D, scope2D,       64, -300,   256, -300,  scopeCovariance2D),
+        HOA_REGRESSION_TEST("Hoa2D::Vector",              2, true,  false, false, channels2D, vector2D,       64, -300,   64, -300,   vector2D),
+        HOA_REGRESSION_TEST("Hoa3D::Encoder",             3, true,  true,  false, one,        harmonics3D,    256, -300,  64, -54,    encoderTabulated3D),
+        HOA_REGRESSION_TEST("Hoa3D::Encoder/recurrence",  3, true,  true,  false, one,        harmonics3D,    64, -300,   256, -300,  encoderRecurrence3D),
+        HOA_REGRESSION_TEST("Hoa3D::Rotate",              3, true,  true,  false, harmonics3D, harmonics3D,   64, -300,   256, -300,  rotate3D),
+        HOA_REGRESSION_TEST("Hoa3D::HeadTracker",         3, false, true,  false, harmonics3D, harmonics3D,   64, -300,   256, -300,  headTracker3D),
+        HOA_REGRESSION_TEST("Hoa3D::Wider",               3, true,  true,  false, harmonics3D, harmonics3D,   64, -300,   64, -300,   wider3D),
+        HOA_REGRESSION_TEST("Hoa3D::Optim",               3, true,  false, false, harmonics3D, harmonics3D,   64, -300,   64, -300,   optim3D),
+        HOA_REGRESSION_TEST("Hoa3D::DecoderRegular",      3, true,  true,  false, harmonics3D, channels3D,    64, -300,   256, -300,  decoderRegular3D),
+        HOA_REGRESSION_TEST("Hoa3D::DecoderBinaural",     3, true,  true,  false, harmonics3D, two,           64, -120,   64, -120,   decoderBinaural3D),
+        HOA_REGRESSION_TEST("Hoa3D::DecoderMulti",        3, true,  true,  false, harmonics3D, channels3D,    64, -300,   256, -300,  decoderMulti3D),
+        HOA_REGRESSION_TEST("Hoa3D::Map",                 3, true,  true,  false, sources,    harmonics3D,    64, -300,   64, -50,    map3D),
+        HOA_REGRESSION_TEST("Hoa3D::Meter",               3, true,  false, true,  channels3D, channels3D,     64, -300,   64, -300,   meterLegacy3D),
+        HOA_REGRESSION_TEST("Hoa3D::Meter/window",        3, true,  true,  true,  channels3D, channels3D,     64, -300,   64, -300,   meter3D),
+        HOA_REGRESSION_TEST("Hoa3D::Scope",               3, true,  false, true,  harmonics3D, scopeChecked3D, 64, -60,   64, -60,    scope3D),
+        HOA_REGRESSION_TEST("Hoa3D::Scope/covariance",    3, true,  true,  true,  harmonics3D, scopeChecked3D, 64, -300,  256, -300,  scopeCovariance3D),
+        HOA_REGRESSION_TEST("Hoa3D::Vector",              3, true,  false, false, channels3D, vector3D,       64, -300,   64, -300,   vector3D)
+    };
+    
+    //! The orders of the tests.
+    static const unsigned int orders2D[3] = {1, 4, 7};
+    static const unsigned int orders3D[3] = {1, 3, 5};
+    
+    //! A set of planar vectors.
+    template <typename T> class Vectors
+    {
+        unsigned int    m_number_of_vectors;
+        unsigned int    m_size;
+        T*              m_samples;
+        T**             m_vectors;
+    public:
+        Vectors(const unsigned int numberOfVectors, const unsigned int size)
+        {
+            m_number_of_vectors = numberOfVectors;
+            m_size              = size;
+            m_samples           = new T[m_number_of_vectors * m_size];
+            m_vectors           = new T*[m_number_of_vectors];
+            for(unsigned int i = 0; i < m_number_of_vectors; i++)
+                m_vectors[i] = m_samples + i * m_size;
+            for(unsigned int i = 0; i < m_number_of_vectors * m_size; i++)
+                m_samples[i] = 0;
+        }
+        
+        ~Vectors()
+        {
+            delete [] m_samples;
+            delete [] m_vectors;
+        }
+        
+        inline T** get() const
+        {
+            return m_vectors;
+        };
+        
+        inline const T* getSamples() const
+        {
+            return m_samples;
+        };
+        
+        inline unsigned int getNumberOfSamples() const
+        {
+            return m_number_of_vectors * m_size;
+        };
+    };
+    
+    //! The deterministic test signal, two sines with frequencies and phases that depend on the vector and a click.
+    template <typename T> void fillSignals(Vectors<T>& vectors, const unsigned int numberOfVectors)
+    {
+        for(unsigned int i = 0; i < numberOfVectors; i++)
+        {
+            for(unsigned int k = 0; k < HOA_REGRESSION_SIZE; k++)
+                vectors.get()[i][k] = 0.5 * sin(0.05 * (i + 1) * k + i) + 0.25 * sin(0.9 * k + 0.5 * i);
+            vectors.get()[i][(7 * i + 3) % HOA_REGRESSION_SIZE] += 0.5;
+        }
+    }
+    
+    //! The reference outputs.
+    /** The file contains a record for each test, each order and each precision : the size of the name, the name, the size of the samples, the number of samples and the samples, the integers are 32 bits and all the values are little endian.
+     */
+    typedef std::map<std::string, std::vector<double> > References;
+    
+    bool readReferences(const std::string& path, References& references)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if(!file)
+            return false;
+        bool valid = true;
+        uint32_t header[3];
+        while(valid && fread(header, sizeof(uint32_t), 1, file) == 1)
+        {
+            std::string name(header[0], ' ');
+            valid = fread(&name[0], 1, header[0], file) == header[0] && fread(header + 1, sizeof(uint32_t), 2, file) == 2;
+            if(!valid)
+                break;
+            std::vector<double>& samples = references[name];
+            samples.resize(header[2]);
+            for(uint32_t i = 0; i < header[2] && valid; i++)
+            {
+                if(header[1] == sizeof(float))
+                {
+                    float value;
+                    valid = fread(&value, sizeof(float), 1, file) == 1;
+                    samples[i] = value;
+                }
+                else
+                {
+                    valid = fread(&samples[i], sizeof(double), 1, file) == 1;
+                }
+            }
+        }
+        fclose(file);
+        return valid;
+    }
+    
+    template <typename T> void writeReference(FILE* file, const std::string& name, const Vectors<T>& outputs)
+    {
+        const uint32_t header[3] = {(uint32_t)name.size(), (uint32_t)sizeof(T), outputs.getNumberOfSamples()};
+        fwrite(header, sizeof(uint32_t), 1, file);
+        fwrite(name.c_str(), 1, name.size(), file);
+        fwrite(header + 1, sizeof(uint32_t), 2, file);
+        fwrite(outputs.getSamples(), sizeof(T), outputs.getNumberOfSamples(), file);
+    }
+    
+    //! Compare the outputs with the reference.
+    /** @return    The greatest absolute difference relative to the peak of the reference.
+     */
+    template <typename T> double compare(const Vectors<T>& outputs, const std::vector<double>& reference)
+    {
+        if(reference.size() != outputs.getNumberOfSamples())
+            return HUGE_VAL;
+        double difference = 0., peak = 0.;
+        for(unsigned int i = 0; i < reference.size(); i++)
+        {
+            const double value = outputs.getSamples()[i];
+            if(value != value)
+                return HUGE_VAL;
+            difference  = std::max(difference, fabs(value - reference[i]));
+            peak        = std::max(peak, fabs(reference[i]));
+        }
+        return (peak > 0.) ? difference / peak : difference;
+    }
+    
+    struct Options
+    {
+        std::string path;
+        std::string filter;
+        bool        generate;
+        bool        verbose;
+    };
+    
+    template <typename T> bool run(const Test& test, void (*process)(const unsigned int, const bool, T**, T**, const unsigned int), const char* precision, const unsigned int order, const Options& options, References& references, FILE* file)
+    {
+        char name[256];
+        sprintf(name, "%s/order:%u/%s", test.name, order, precision);
+        if(!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos)
+            return true;
+        
+        const unsigned int length = test.snapshots ? HOA_REGRESSION_SIZE / HOA_REGRESSION_SNAPSHOT : HOA_REGRESSION_SIZE;
+        Vectors<T> inputs(test.inputs(order), HOA_REGRESSION_SIZE);
+        fillSignals(inputs, test.inputs(order));
+        
+        if(options.generate)
+        {
+            Vectors<T> outputs(test.outputs(order), length);
+            process(order, !test.sample, inputs.get(), outputs.get(), HOA_REGRESSION_SIZE);
+            writeReference(file, name, outputs);
+            return true;
+        }
+        
+        References::const_iterator it = references.find(name);
+        if(it == references.end())
+        {
+            printf("%-56s missing reference\n", name);
+            return false;
+        }
+        
+        bool valid = true;
+        const double epsilon = (sizeof(T) == sizeof(float)) ? FLT_EPSILON : DBL_EPSILON;
+        for(int block = 0; block < 2; block++)
+        {
+            if((block && !test.block) || (!block && !test.sample))
+                continue;
+            
+            Vectors<T> outputs(test.outputs(order), length);
+            process(order, block, inputs.get(), outputs.get(), HOA_REGRESSION_SIZE);
+            const double error = compare(outputs, it->second);
+            const Tolerance& tolerance = block ? test.tolerance_block : test.tolerance_sample;
+            const double ulps = error / epsilon;
+            const double decibels = (error > 0.) ? 20. * log10(error) : -HUGE_VAL;
+            const bool passed = (ulps <= tolerance.ulps) || (decibels <= tolerance.decibels);
+            if(!passed || options.verbose)
+                printf("%-56s %-6s %12.1f ulps %8.1f dB %s\n", name, block ? "block" : "sample", ulps, decibels, passed ? "ok" : "FAILED");
+            valid = valid && passed;
+        }
+        return valid;
+    }
+    
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        options.generate    = false;
+        options.verbose     = false;
+        for(int i = 1; i < argc; i++)
+        {
+            const char* argument = argv[i];
+            if(!strcmp(argument, "--generate"))
+                options.generate = true;
+            else if(!strcmp(argument, "--verbose"))
+                options.verbose = true;
+            else if(!strncmp(argument, "--filter=", 9))
+                options.filter = argument + 9;
+            else if(!strncmp(argument, "--isa=", 6))
+            {
+                bool found = false;
+                for(int isa = IsaGeneric; isa <= IsaNeon && !found; isa++)
+                {
+                    if(!strcmp(argument + 6, getIsaName((Isa)isa)))
+                    {
+                        if(!setSimdIsa((Isa)isa))
+                        {
+                            fprintf(stderr, "The instruction set %s is not supported.\n", argument + 6);
+                            return false;
+                        }
+                        found = true;
+                    }
+                }
+                if(!found)
+                    return false;
+            }
+            else if(argument[0] != '-' && options.path.empty())
+                options.path = argument;
+            else
+                return false;
+        }
+        return !options.path.empty();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Hoa::Options options;
+    if(!Hoa::parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "Usage : %s references [--generate] [--filter=name] [--isa=name] [--verbose]\n", argv[0]);
+        return 2;
+    }
+    
+    printf("Instruction set : %s\n", Hoa::getIsaName(Hoa::getSimdKernels()->isa));
+    Hoa::References references;
+    FILE* file = NULL;
+    if(options.generate)
+    {
+        file = fopen(options.path.c_str(), "wb");
+        if(!file)
+        {
+            fprintf(stderr, "Can't write the references %s.\n", options.path.c_str());
+            return 2;
+        }
+    }
+    else if(!Hoa::readReferences(options.path, references))
+    {
+        fprintf(stderr, "Can't read the references %s.\n", options.path.c_str());
+        return 2;
+    }
+    
+    unsigned int number_of_failures = 0;
+    const unsigned int number_of_tests = sizeof(Hoa::tests) / sizeof(Hoa::Test);
+    for(unsigned int i = 0; i < number_of_tests; i++)
+    {
+        const Hoa::Test& test = Hoa::tests[i];
+        const unsigned int* orders = (test.dimension == 2) ? Hoa::orders2D : Hoa::orders3D;
+        for(unsigned int j = 0; j < 3; j++)
+        {
+            if(!Hoa::run(test, test.processFloat, "float", orders[j], options, references, file))
+                number_of_failures++;
+            if(!Hoa::run(test, test.processDouble, "double", orders[j], options, references, file))
+                number_of_failures++;
+        }
+    }
+    
+    if(file)
+    {
+        fclose(file);
+        printf("The references are written in %s.\n", options.path.c_str());
+        return 0;
+    }
+    printf("%u failures.\n", number_of_failures);
+    return number_of_failures ? 1 : 0;
+}